@@ -102,6 +102,15 @@ OB_EXPORT void ob_enable_device_clock_sync(ob_context *context, uint64_t repeat_
  */
 OB_EXPORT void ob_free_idle_memory(ob_context *context, ob_error **error);
 
+/**
+ * @brief Get the statistics of the internal frame memory pool
+ *
+ * @param[in] context Pointer to the context object
+ * @param[out] error Pointer to an error object that will be populated if an error occurs during execution
+ * @return ob_frame_memory_pool_statistics The hit/miss counters and memory usage of the frame memory pool
+ */
+OB_EXPORT ob_frame_memory_pool_statistics ob_get_frame_memory_pool_statistics(ob_context *context, ob_error **error);
+
 /**
  * @brief Set the global log level
  *
@@ -196,6 +196,33 @@ OB_EXPORT ob_property_item ob_device_get_supported_property_item(const ob_device
  */
 OB_EXPORT bool ob_device_is_property_supported(const ob_device *device, ob_property_id property_id, ob_permission_type permission, ob_error **error);
 
+/**
+ * @brief Execute a batch of property operations on the device.
+ * @brief The operations are executed in order, without any other property access of the device interleaved. A failed operation does not stop the
+ * batch, its status is set to OB_STATUS_ERROR and the following operations are still executed. Repeated reads of a property which is not written
+ * in between are served without another request to the device.
+ *
+ * @param[in] device The device object.
+ * @param[in,out] operations The operations to execute, the results of the get operations and the status of each operation are written back.
+ * @param[in] count The number of operations.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return The number of failed operations.
+ */
+OB_EXPORT uint32_t ob_device_execute_property_operations(ob_device *device, ob_property_operation *operations, uint32_t count, ob_error **error);
+
+/**
+ * @brief Execute a batch of property operations on each of the devices, the devices are accessed concurrently.
+ *
+ * @param[in] devices The device objects.
+ * @param[in] device_count The number of devices.
+ * @param[in,out] operations The operations to execute, device_count * count items: the operations of the device i start at operations[i * count].
+ * @param[in] count The number of operations per device.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return The total number of failed operations.
+ */
+OB_EXPORT uint32_t ob_devices_execute_property_operations(ob_device **devices, uint32_t device_count, ob_property_operation *operations, uint32_t count,
+                                                          ob_error **error);
+
 /**
  * @brief Check if the device supports global timestamp.
  *
@@ -578,6 +605,22 @@ OB_EXPORT ob_device *ob_device_list_get_device_by_serial_number(const ob_device_
  */
 OB_EXPORT ob_device *ob_device_list_get_device_by_uid(const ob_device_list *list, const char *uid, ob_error **error);
 
+/**
+ * @brief Create the first count devices of the device list concurrently.
+ * @brief Opening a device takes a number of round-trips to read its info and parameters, creating the devices concurrently makes the time to open all
+ * devices close to the time to open the slowest one instead of the sum of them.
+ *
+ * @attention The devices which failed to be created (for example, acquired elsewhere) are set to NULL and the error is logged, the other devices are still
+ * created. The created devices should be deleted by @ref ob_delete_device.
+ *
+ * @param[in] list Device list object.
+ * @param[out] devices The array to receive the created devices, with at least count elements.
+ * @param[in] count The number of devices to create, which must not be greater than the device count of the list.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return uint32_t The number of devices created successfully.
+ */
+OB_EXPORT uint32_t ob_device_list_get_devices(const ob_device_list *list, ob_device **devices, uint32_t count, ob_error **error);
+
 /**
  * @brief Get the original parameter list of camera calibration saved on the device.
  *
@@ -243,6 +243,8 @@ OB_EXPORT uint64_t ob_frame_get_global_timestamp_us(const ob_frame *frame, ob_er
  *
  * @attention The returned data buffer is mutable, but it is not recommended to modify it directly. Modifying the data directly may cause issues if the frame is
  * being used in other threads  or future use. If you need to modify the data, it is recommended to create a new frame object.
+ * @attention If the frame shares its data with other frames (for example, the output of a disabled or pass-through filter), the data is copied to a
+ * buffer of the frame on this call, so that the write does not change the other frames.
  *
  * @param[in] frame The frame object from which to retrieve the data.
  * @param[out] error Pointer to an error object that will be set if an error occurs.
@@ -336,6 +338,22 @@ OB_EXPORT bool ob_frame_has_metadata(const ob_frame *frame, ob_frame_metadata_ty
  */
 OB_EXPORT int64_t ob_frame_get_metadata_value(const ob_frame *frame, ob_frame_metadata_type type, ob_error **error);
 
+/**
+ * @brief Get all the metadata values of the frame
+ * @brief The metadata is decoded once on the first query and cached by the frame, the later queries of this function, @ref ob_frame_has_metadata and
+ * @ref ob_frame_get_metadata_value don't decode the metadata again.
+ *
+ * @attention The cached values are not updated if the metadata is modified through the pointer returned by @ref ob_frame_get_metadata, use
+ * @ref ob_frame_update_metadata instead.
+ * @attention The values depending on the device state rather than the metadata itself (such as the actual frame rate, the settings read from the
+ * device properties and the timestamps converted with the device clock) are not included, get them with @ref ob_frame_get_metadata_value.
+ *
+ * @param[in] frame frame object
+ * @param[out] values The metadata values, refer to @ref ob_frame_metadata_values
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_frame_get_metadata_values(const ob_frame *frame, ob_frame_metadata_values *values, ob_error **error);
+
 /**
  * @brief Get the stream profile of the frame
  *
@@ -477,6 +495,16 @@ OB_EXPORT void ob_depth_frame_set_value_scale(ob_frame *frame, float value_scale
  */
 OB_EXPORT float ob_points_frame_get_coordinate_value_scale(const ob_frame *frame, ob_error **error);
 
+/**
+ * @brief Get the point index data of the points frame created by the PointCloudFilter in the compact output mode with point index (compactOutputMode = 2).
+ * The point index is the pixel index (v * width + u) of the depth frame of each point, the number of indexes is the number of points of the frame.
+ *
+ * @param[in] frame Frame object
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return const uint32_t* The point index data, NULL if the frame has no point index.
+ */
+OB_EXPORT const uint32_t *ob_points_frame_get_point_index_data(const ob_frame *frame, ob_error **error);
+
 /**
  * @brief Get accelerometer frame data.
  *
@@ -513,6 +541,18 @@ OB_EXPORT ob_gyro_value ob_gyro_frame_get_value(const ob_frame *frame, ob_error
  */
 OB_EXPORT float ob_gyro_frame_get_temperature(const ob_frame *frame, ob_error **error);
 
+/**
+ * @brief Get the samples carried by an accelerometer or gyroscope frame.
+ *
+ * @attention A frame carries more than one sample only in the batched IMU output mode (see @ref OB_PROP_SDK_IMU_BATCH_SIZE_INT), otherwise the
+ * single sample is the value, temperature and timestamp of the frame.
+ *
+ * @param[in] frame Accelerometer or gyroscope frame.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_imu_samples The samples in structure-of-arrays layout, the arrays are valid as long as the frame is not released.
+ */
+OB_EXPORT ob_imu_samples ob_imu_frame_get_samples(const ob_frame *frame, ob_error **error);
+
 /**
  * @brief Get the number of frames contained in the frameset
  *
@@ -122,6 +122,17 @@ OB_EXPORT void ob_device_timestamp_reset(ob_device *device, ob_error **error);
  */
 OB_EXPORT void ob_device_timer_sync_with_host(ob_device *device, ob_error **error);
 
+/**
+ * @brief Get the status of the last synchronization of the device timer with the host.
+ * @brief The synchronization is done by @ref ob_device_timer_sync_with_host or periodically by the multi-device clock sync enabled by
+ * @ref ob_enable_device_clock_sync.
+ *
+ * @param[in] device The device handle.
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_device_clock_sync_status The offset of the device timer to the host timer and its uncertainty measured after the last synchronization.
+ */
+OB_EXPORT ob_device_clock_sync_status ob_device_get_clock_sync_status(ob_device *device, ob_error **error);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -36,6 +36,7 @@ typedef struct ob_filter_t                    ob_filter;
 typedef struct ob_filter_list_t               ob_filter_list;
 typedef struct ob_pipeline_t                  ob_pipeline;
 typedef struct ob_config_t                    ob_config;
+typedef struct ob_multi_device_pipeline_t     ob_multi_device_pipeline;
 typedef struct ob_depth_work_mode_list_t      ob_depth_work_mode_list;
 typedef struct ob_device_preset_list_t        ob_device_preset_list;
 typedef struct ob_filter_config_schema_list_t ob_filter_config_schema_list;
@@ -598,6 +599,21 @@ typedef struct {
     float z;  ///< Z-direction component
 } OBAccelValue, OBGyroValue, OBFloat3D, ob_accel_value, ob_gyro_value, ob_float_3d;
 
+/**
+ * @brief The samples carried by an accelerometer or gyroscope frame, in structure-of-arrays layout
+ *
+ * @attention A frame carries more than one sample only in the batched IMU output mode (see @ref OB_PROP_SDK_IMU_BATCH_SIZE_INT). The arrays are owned
+ * by the frame and are valid as long as the frame is not released.
+ */
+typedef struct {
+    uint32_t        count;        ///< Number of samples, in ascending order of timestamp
+    const uint64_t *timestampUs;  ///< Device timestamp of each sample, unit: microsecond
+    const float    *x;            ///< X-direction component of each sample
+    const float    *y;            ///< Y-direction component of each sample
+    const float    *z;            ///< Z-direction component of each sample
+    const float    *temperature;  ///< Temperature of each sample, unit: Celsius
+} OBImuSamples, ob_imu_samples;
+
 /**
  * @brief Device state
  */
@@ -1328,6 +1344,93 @@ typedef struct {
     bool timestamp_reset_signal_output_enable;
 } ob_device_timestamp_reset_config, OBDeviceTimestampResetConfig;
 
+/**
+ * @brief The status of the last synchronization of the device timer with the host.
+ * @brief The offset and its uncertainty can be used to weight the timestamps of the devices when fusing the data of multiple devices.
+ */
+typedef struct {
+    /**
+     * @brief The offset of the device timer to the host timer measured after the last synchronization in microseconds (device time minus host time).
+     */
+    int64_t offset_us;
+
+    /**
+     * @brief The uncertainty of the offset in microseconds, which is half of the round-trip time of the measurement.
+     */
+    uint64_t uncertainty_us;
+
+    /**
+     * @brief The round-trip time to the device in microseconds, sent to the device to compensate the latency of the timer synchronization command.
+     */
+    uint64_t rtt_us;
+
+    /**
+     * @brief The host time of the last synchronization in microseconds, 0 if the device timer has never been synchronized.
+     */
+    uint64_t sync_time_us;
+
+    /**
+     * @brief Whether the last synchronization succeeded, that is the measured offset is within the tolerance.
+     */
+    bool success;
+} ob_device_clock_sync_status, OBDeviceClockSyncStatus;
+
+/**
+ * @brief The timestamp used to group the framesets of multiple devices in the multi-device pipeline
+ */
+typedef enum {
+    /**
+     * @brief Global timestamp, the device timestamp converted to the host clock domain
+     * @brief The global timestamp of the devices supporting it is enabled by the multi-device pipeline on start, the device timestamp is used for the frames
+     * without global timestamp.
+     */
+    OB_MULTI_DEVICE_FRAME_SYNC_GLOBAL_TIMESTAMP = 0,
+
+    /**
+     * @brief Device timestamp, requires the timers of the devices to be reset at the same time (see @ref ob_device_timestamp_reset)
+     */
+    OB_MULTI_DEVICE_FRAME_SYNC_DEVICE_TIMESTAMP = 1,
+
+    /**
+     * @brief System timestamp, the host time when the frame is received, the accuracy is affected by the transmission delay
+     */
+    OB_MULTI_DEVICE_FRAME_SYNC_SYSTEM_TIMESTAMP = 2,
+} ob_multi_device_frame_sync_timestamp_type,
+    OBMultiDeviceFrameSyncTimestampType;
+
+/**
+ * @brief The frame synchronization configuration of the multi-device pipeline
+ */
+typedef struct {
+    /**
+     * @brief The timestamp used to group the framesets of the devices
+     */
+    OBMultiDeviceFrameSyncTimestampType timestampType;
+
+    /**
+     * @brief The max timestamp difference between the framesets of a group in microseconds
+     * @brief It should be less than half of the frame interval of the streams, the default is 8000us.
+     */
+    uint32_t toleranceUs;
+
+    /**
+     * @brief The max time to wait for the framesets of the other devices in microseconds, measured by the timestamps of the framesets
+     * @brief A frameset which can not be grouped with the framesets of all the other devices within this time is dropped, so a device that stops
+     * streaming delays the output by at most this time. The default is 200000us.
+     */
+    uint32_t maxLatencyUs;
+} ob_multi_device_frame_sync_config, OBMultiDeviceFrameSyncConfig;
+
+/**
+ * @brief The frame synchronization statistics of the multi-device pipeline
+ */
+typedef struct {
+    uint64_t inputFramesetCount;    ///< The framesets received from the devices
+    uint64_t outputFramesetCount;   ///< The composite framesets output
+    uint64_t droppedFramesetCount;  ///< The framesets of the devices dropped as their groups are incomplete
+    uint64_t maxTimestampSpreadUs;  ///< The max timestamp difference between the framesets of a composite frameset
+} ob_multi_device_frame_sync_statistics, OBMultiDeviceFrameSyncStatistics;
+
 /**
  * @brief Baseline calibration parameters
  */
@@ -1399,6 +1502,19 @@ typedef struct {
     char numberStr[16];
 } OBDeviceSerialNumber, ob_device_serial_number, OBSerialNumber, ob_serial_number;
 
+/**
+ * @brief Statistics of the internal frame memory pool
+ *
+ * @attention The counters are accumulated since the frame memory pool is created. A frame buffer acquired from the idle buffers is counted as a hit,
+ * and a frame buffer allocated from system memory is counted as a miss, so that no miss increase on steady state means no memory allocation.
+ */
+typedef struct {
+    uint64_t hitCount;       ///< Number of frame buffers reused from the idle buffers of the pool
+    uint64_t missCount;      ///< Number of frame buffers newly allocated from system memory
+    uint64_t allocatedSize;  ///< Size of the frame memory currently allocated, in bytes
+    uint64_t maxSize;        ///< Max size of the frame memory can be allocated, in bytes
+} OBFrameMemoryPoolStatistics, ob_frame_memory_pool_statistics;
+
 /**
  * @brief Frame metadata types
  * @brief The frame metadata is a set of meta info generated by the device for current individual frame.
@@ -1594,6 +1710,26 @@ typedef enum {
 #define OB_FRAME_METADATA_TYPE_LASER_POWER_MODE OB_FRAME_METADATA_TYPE_LASER_POWER_LEVEL
 #define OB_FRAME_METADATA_TYPE_EMITTER_MODE OB_FRAME_METADATA_TYPE_LASER_STATUS
 
+/**
+ * @brief The max count of the frame metadata types that can be held by @ref ob_frame_metadata_values
+ */
+#define OB_FRAME_METADATA_VALUES_CAPACITY 64
+
+/**
+ * @brief All the metadata values of a frame, decoded in one pass
+ */
+typedef struct {
+    /**
+     * @brief Bit i is set if the frame contains the metadata of type i (refer to @ref ob_frame_metadata_type)
+     */
+    uint64_t supportedMask;
+
+    /**
+     * @brief The value of the metadata of type i is at index i, it is 0 if the frame does not contain the metadata
+     */
+    int64_t values[OB_FRAME_METADATA_VALUES_CAPACITY];
+} ob_frame_metadata_values, OBFrameMetadataValues;
+
 /**
  * @brief Callback for file transfer
  *
@@ -326,6 +326,119 @@ OB_EXPORT ob_camera_param ob_pipeline_get_camera_param_with_profile(ob_pipeline
  */
 OB_EXPORT ob_calibration_param ob_pipeline_get_calibration_param(ob_pipeline *pipeline, ob_config *config, ob_error **error);
 
+/**
+ * @brief Create a multi-device pipeline, which streams the devices at the same time and outputs the framesets of all the devices captured at the
+ * same time as one composite frameset.
+ * @brief The frameset of the i-th device is at index i of the composite frameset, use @ref ob_frameset_get_frame to get it.
+ *
+ * @param[in] devices The devices to be streamed
+ * @param[in] device_count The count of the devices
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_multi_device_pipeline* return the multi-device pipeline object
+ */
+OB_EXPORT ob_multi_device_pipeline *ob_create_multi_device_pipeline(ob_device **devices, uint32_t device_count, ob_error **error);
+
+/**
+ * @brief Delete the multi-device pipeline object
+ *
+ * @param[in] pipeline The multi-device pipeline object to be deleted
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_delete_multi_device_pipeline(ob_multi_device_pipeline *pipeline, ob_error **error);
+
+/**
+ * @brief Set the configuration of grouping the framesets of the devices.
+ * @brief The global timestamp is enabled on the supported devices when the pipeline is started with @ref OB_MULTI_DEVICE_FRAME_SYNC_GLOBAL_TIMESTAMP.
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[in] config The frame sync configuration
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_multi_device_pipeline_set_frame_sync_config(ob_multi_device_pipeline *pipeline, const ob_multi_device_frame_sync_config *config,
+                                                              ob_error **error);
+
+/**
+ * @brief Get the configuration of grouping the framesets of the devices
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_multi_device_frame_sync_config The frame sync configuration
+ */
+OB_EXPORT ob_multi_device_frame_sync_config ob_multi_device_pipeline_get_frame_sync_config(ob_multi_device_pipeline *pipeline, ob_error **error);
+
+/**
+ * @brief Start the multi-device pipeline
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[in] configs The configurations of the devices, NULL to start all the devices with the default configuration. Otherwise the count must be
+ * equal to the count of the devices, and a NULL configuration starts the device with the default configuration.
+ * @param[in] config_count The count of the configurations
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_multi_device_pipeline_start(ob_multi_device_pipeline *pipeline, ob_config **configs, uint32_t config_count, ob_error **error);
+
+/**
+ * @brief Start the multi-device pipeline and set the composite frameset callback
+ *
+ * @attention After start the pipeline with this interface, the composite framesets will be output to the callback function and cannot be obtained
+ * by calling @ref ob_multi_device_pipeline_wait_for_frameset
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[in] configs The configurations of the devices, see @ref ob_multi_device_pipeline_start
+ * @param[in] config_count The count of the configurations
+ * @param[in] callback Triggered when the framesets of all the devices captured at the same time arrive
+ * @param[in] user_data Pass in any user data and get it from the callback
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_multi_device_pipeline_start_with_callback(ob_multi_device_pipeline *pipeline, ob_config **configs, uint32_t config_count,
+                                                            ob_frameset_callback callback, void *user_data, ob_error **error);
+
+/**
+ * @brief Stop the multi-device pipeline
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ */
+OB_EXPORT void ob_multi_device_pipeline_stop(ob_multi_device_pipeline *pipeline, ob_error **error);
+
+/**
+ * @brief Wait for a composite frameset to be returned synchronously
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[in] timeout_ms The timeout for waiting (in milliseconds)
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_frame* The composite frameset, the frameset of the i-th device is at index i.
+ */
+OB_EXPORT ob_frame *ob_multi_device_pipeline_wait_for_frameset(ob_multi_device_pipeline *pipeline, uint32_t timeout_ms, ob_error **error);
+
+/**
+ * @brief Get the count of the devices of the multi-device pipeline
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return uint32_t The count of the devices
+ */
+OB_EXPORT uint32_t ob_multi_device_pipeline_get_device_count(const ob_multi_device_pipeline *pipeline, ob_error **error);
+
+/**
+ * @brief Get the device of the multi-device pipeline
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[in] index The index of the device
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_device* The device object
+ */
+OB_EXPORT ob_device *ob_multi_device_pipeline_get_device(const ob_multi_device_pipeline *pipeline, uint32_t index, ob_error **error);
+
+/**
+ * @brief Get the statistics of grouping the framesets of the devices
+ *
+ * @param[in] pipeline The multi-device pipeline object
+ * @param[out] error Pointer to an error object that will be set if an error occurs.
+ * @return ob_multi_device_frame_sync_statistics The statistics
+ */
+OB_EXPORT ob_multi_device_frame_sync_statistics ob_multi_device_pipeline_get_statistics(ob_multi_device_pipeline *pipeline, ob_error **error);
+
 // The following interfaces are deprecated and are retained here for compatibility purposes.
 #define ob_config_set_depth_scale_require ob_config_set_depth_scale_after_align_require
 
@@ -732,6 +732,13 @@ typedef enum {
      */
     OB_PROP_SDK_IR_RIGHT_FRAME_UNPACK_BOOL = 3012,
 
+    /**
+     * @brief Number of IMU samples batched into one accel/gyro frame (1 by default, no batching)
+     * @attention Each accel/gyro frame carries the samples in structure-of-arrays layout, get them by @ref ob_imu_frame_get_samples. The value
+     * and temperature of the frame are those of the latest sample. Takes effect on the next start of the IMU streams.
+     */
+    OB_PROP_SDK_IMU_BATCH_SIZE_INT = 3013,
+
     /**
      * @brief Calibration JSON file read from device (Femto Mega, read only)
      */
@@ -768,6 +775,38 @@ typedef struct OBPropertyItem {
     OBPermissionType permission; /**< Property read and write permission */
 } OBPropertyItem, ob_property_item;
 
+/**
+ * @brief The operation type of a property operation executed in a batch
+ */
+typedef enum OBPropertyOperationType {
+    OB_PROPERTY_OPERATION_SET       = 0, /**< Set the property value */
+    OB_PROPERTY_OPERATION_GET       = 1, /**< Get the property value */
+    OB_PROPERTY_OPERATION_GET_RANGE = 2, /**< Get the property range (including the current value) */
+} OBPropertyOperationType,
+    ob_property_operation_type;
+
+/**
+ * @brief The value of a property operation, the member used depends on the property type
+ */
+typedef union OBPropertyOperationValue {
+    int32_t intValue;   /**< Value of the integer and boolean properties (0 or 1) */
+    float   floatValue; /**< Value of the float properties */
+} OBPropertyOperationValue, ob_property_operation_value;
+
+/**
+ * @brief A property operation executed in a batch
+ */
+typedef struct OBPropertyOperation {
+    OBPropertyID             id;        /**< Property ID */
+    OBPropertyOperationType  operation; /**< Operation type */
+    OBPropertyOperationValue value;     /**< [in] The value to set for OB_PROPERTY_OPERATION_SET, [out] the current value for the get operations */
+    OBPropertyOperationValue max;       /**< [out] Maximum value, only for OB_PROPERTY_OPERATION_GET_RANGE */
+    OBPropertyOperationValue min;       /**< [out] Minimum value, only for OB_PROPERTY_OPERATION_GET_RANGE */
+    OBPropertyOperationValue step;      /**< [out] Step value, only for OB_PROPERTY_OPERATION_GET_RANGE */
+    OBPropertyOperationValue def;       /**< [out] Default value, only for OB_PROPERTY_OPERATION_GET_RANGE */
+    ob_status                status;    /**< [out] OB_STATUS_OK if the operation succeeded, OB_STATUS_ERROR otherwise */
+} OBPropertyOperation, ob_property_operation;
+
 #ifdef __cplusplus
 }
 #endif
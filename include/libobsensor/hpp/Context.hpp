@@ -144,6 +144,19 @@ public:
         Error::handle(&error);
     }
 
+    /**
+     * @brief Get the statistics of the internal frame memory pool.
+     * @brief The miss count stays unchanged on steady state if the frame buffers are reused (eg. Memory.PreallocateFrameBuffers is enabled).
+     *
+     * @return OBFrameMemoryPoolStatistics The hit/miss counters and memory usage of the frame memory pool.
+     */
+    OBFrameMemoryPoolStatistics getFrameMemoryPoolStatistics() const {
+        ob_error *error = nullptr;
+        auto      stats = ob_get_frame_memory_pool_statistics(impl_, &error);
+        Error::handle(&error);
+        return stats;
+    }
+
     /**
      * @brief Set the level of the global log, which affects both the log level output to the console, output to the file and output the user defined callback.
      *
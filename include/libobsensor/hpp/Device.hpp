@@ -330,6 +330,53 @@ public:
         return result;
     }
 
+    /**
+     * @brief Execute a batch of property operations in order, without any other property access of the device interleaved
+     * @brief A failed operation does not stop the batch, its status is set to OB_STATUS_ERROR.
+     *
+     * @param operations The operations to execute, the results of the get operations and the status of each operation are written back
+     * @return uint32_t The number of failed operations
+     */
+    uint32_t executePropertyOperations(std::vector<OBPropertyOperation> &operations) const {
+        ob_error *error  = nullptr;
+        auto      result = ob_device_execute_property_operations(impl_, operations.data(), static_cast<uint32_t>(operations.size()), &error);
+        Error::handle(&error);
+        return result;
+    }
+
+    /**
+     * @brief Execute the same batch of property operations on each of the devices, the devices are accessed concurrently
+     *
+     * @param devices The devices
+     * @param operations The operations to execute on each device
+     * @return std::vector<std::vector<OBPropertyOperation>> The executed operations of each device, with the results and the status of each operation
+     */
+    static std::vector<std::vector<OBPropertyOperation>> executePropertyOperations(const std::vector<std::shared_ptr<Device>> &devices,
+                                                                                   const std::vector<OBPropertyOperation>     &operations) {
+        std::vector<std::vector<OBPropertyOperation>> results;
+        if(devices.empty() || operations.empty()) {
+            return results;
+        }
+
+        std::vector<ob_device *>         impls;
+        std::vector<OBPropertyOperation> allOperations;
+        for(auto &device: devices) {
+            impls.push_back(device->impl_);
+            allOperations.insert(allOperations.end(), operations.begin(), operations.end());
+        }
+
+        ob_error *error = nullptr;
+        ob_devices_execute_property_operations(impls.data(), static_cast<uint32_t>(impls.size()), allOperations.data(), static_cast<uint32_t>(operations.size()),
+                                               &error);
+        Error::handle(&error);
+
+        for(size_t i = 0; i < devices.size(); i++) {
+            auto begin = allOperations.begin() + i * operations.size();
+            results.emplace_back(begin, begin + operations.size());
+        }
+        return results;
+    }
+
     /**
      * @brief Check if the global timestamp is supported for the device
      *
@@ -619,6 +666,19 @@ public:
         Error::handle(&error);
     }
 
+    /**
+     * @brief get the status of the last synchronization of the device timer with the host.
+     * @brief The offset and its uncertainty can be used to weight the timestamps of the devices when fusing the data of multiple devices.
+     *
+     * @return OBDeviceClockSyncStatus the offset of the device timer to the host timer and its uncertainty measured after the last synchronization.
+     */
+    OBDeviceClockSyncStatus getClockSyncStatus() const {
+        ob_error *error  = nullptr;
+        auto      status = ob_device_get_clock_sync_status(impl_, &error);
+        Error::handle(&error);
+        return status;
+    }
+
     /**
      * @brief Get current preset name
      * @brief The preset mean a set of parameters or configurations that can be applied to the device to achieve a specific effect or function.
@@ -1164,6 +1224,32 @@ public:
         return std::make_shared<Device>(device);
     }
 
+    /**
+     * @brief Create all devices of the device list concurrently
+     * @brief Creating the devices concurrently makes the time to open all devices close to the time to open the slowest one instead of the sum of them.
+     *
+     * @attention The devices which failed to be created (for example, acquired elsewhere) are nullptr in the returned list, no exception is thrown for them
+     *
+     * @return std::vector<std::shared_ptr<Device>> the device objects, in the order of the device list
+     */
+    std::vector<std::shared_ptr<Device>> getDevices() const {
+        std::vector<std::shared_ptr<Device>> rst;
+        auto                                 count = getCount();
+        if(count == 0) {
+            return rst;  // the data of an empty vector may be nullptr, which is rejected by ob_device_list_get_devices
+        }
+
+        ob_error                *error = nullptr;
+        std::vector<ob_device *> devices(count, nullptr);
+        ob_device_list_get_devices(impl_, devices.data(), count, &error);
+        Error::handle(&error);
+
+        for(auto device: devices) {
+            rst.push_back(device ? std::make_shared<Device>(device) : nullptr);
+        }
+        return rst;
+    }
+
 public:
     // The following interfaces are deprecated and are retained here for compatibility purposes.
     uint32_t deviceCount() const {
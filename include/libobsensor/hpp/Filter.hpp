@@ -391,6 +391,18 @@ public:
         setConfigValue("coordinateSystemType", static_cast<double>(type));
     }
 
+    /**
+     * @brief Set the point cloud compact output mode.
+     * @brief In the compact output mode, the output point cloud frame only contains the valid points (the invalid points with zero depth are skipped), the
+     * number of points is the data size of the frame divided by the size of a point.
+     *
+     * @param enable Whether to output the valid points only.
+     * @param withPointIndex Whether to output the pixel index of each point as well, which can be obtained via @ref PointsFrame::getPointIndexData.
+     */
+    void setCompactOutput(bool enable, bool withPointIndex = false) {
+        setConfigValue("compactOutputMode", enable ? (withPointIndex ? 2 : 1) : 0);
+    }
+
 public:
     // The following interfaces are deprecated and are retained here for compatibility purposes.
     void setPositionDataScaled(float scale) {
@@ -450,6 +462,17 @@ public:
     void setFormatConvertType(OBConvertFormat type) {
         setConfigValue("convertType", static_cast<double>(type));
     }
+
+    /**
+     * @brief Set the decode scale of the MJPEG to RGB/BGR/BGRA conversions.
+     * The MJPEG frames are decoded at 1/scale of the resolution, which is several times faster than decoding at full resolution. The output
+     * frames have a stream profile with the scaled resolution and intrinsics, so they can be aligned or used to generate point clouds.
+     *
+     * @param scale The decode scale: 1 (full resolution, default), 2, 4 or 8.
+     */
+    void setDecodeScale(uint32_t scale) {
+        setConfigValue("decodeScale", static_cast<double>(scale));
+    }
 };
 
 /**
@@ -252,6 +252,21 @@ public:
         return value;
     }
 
+    /**
+     * @brief Get all the metadata values of the frame in one call, the metadata is decoded once and cached by the frame.
+     * @brief The values depending on the device state rather than the metadata itself are not included, use getMetadataValue() for them.
+     *
+     * @return OBFrameMetadataValues The metadata values, the value of type i is valid if bit i of supportedMask is set.
+     */
+    OBFrameMetadataValues getMetadataValues() const {
+        OBFrameMetadataValues values;
+        ob_error             *error = nullptr;
+        ob_frame_get_metadata_values(impl_, &values, &error);
+        Error::handle(&error);
+
+        return values;
+    }
+
     /**
      * @brief get StreamProfile of the frame
      *
@@ -593,6 +608,20 @@ public:
         return scale;
     }
 
+    /**
+     * @brief Get the point index data of the points frame created by the PointCloudFilter in the compact output mode with point index. The point index is the
+     * pixel index (v * width + u) of the depth frame of each point.
+     *
+     * @return const uint32_t* The point index data, nullptr if the frame has no point index.
+     */
+    const uint32_t *getPointIndexData() const {
+        ob_error *error = nullptr;
+        auto      data  = ob_points_frame_get_point_index_data(impl_, &error);
+        Error::handle(&error);
+
+        return data;
+    }
+
 public:
     // The following interfaces are deprecated and are retained here for compatibility purposes.
 #define getPositionValueScale getCoordinateValueScale
@@ -635,6 +664,19 @@ public:
         return temp;
     }
 
+    /**
+     * @brief Get the samples carried by the frame, more than one only in the batched IMU output mode (see @ref OB_PROP_SDK_IMU_BATCH_SIZE_INT)
+     *
+     * @return OBImuSamples The samples in structure-of-arrays layout, valid as long as the frame is alive
+     */
+    OBImuSamples getSamples() const {
+        ob_error *error   = nullptr;
+        auto      samples = ob_imu_frame_get_samples(impl_, &error);
+        Error::handle(&error);
+
+        return samples;
+    }
+
 public:
     // The following interfaces are deprecated and are retained here for compatibility purposes.
     OBAccelValue value() {
@@ -682,6 +724,19 @@ public:
         return temperature;
     }
 
+    /**
+     * @brief Get the samples carried by the frame, more than one only in the batched IMU output mode (see @ref OB_PROP_SDK_IMU_BATCH_SIZE_INT)
+     *
+     * @return OBImuSamples The samples in structure-of-arrays layout, valid as long as the frame is alive
+     */
+    OBImuSamples getSamples() const {
+        ob_error *error   = nullptr;
+        auto      samples = ob_imu_frame_get_samples(impl_, &error);
+        Error::handle(&error);
+
+        return samples;
+    }
+
 public:
     // The following interfaces are deprecated and are retained here for compatibility purposes.
     OBGyroValue value() {
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <functional>
+#include <vector>
 namespace ob {
 
 /**
@@ -448,5 +449,149 @@ public:
     }
 };
 
+
+/**
+ * @brief MultiDevicePipeline streams several devices at the same time and outputs the framesets of all the devices captured at the same time as one
+ * composite frameset. The frameset of the i-th device is at index i of the composite frameset, it can be obtained by FrameSet::getFrameByIndex() and
+ * converted by Frame::as<FrameSet>().
+ */
+class MultiDevicePipeline {
+public:
+    typedef std::function<void(std::shared_ptr<FrameSet> frame)> FrameSetCallback;
+
+private:
+    ob_multi_device_pipeline_t *impl_;
+    FrameSetCallback            callback_;
+
+public:
+    /**
+     * @brief Create a multi-device pipeline with the devices obtained through the DeviceList
+     *
+     * @param devices The devices to be streamed
+     */
+    explicit MultiDevicePipeline(const std::vector<std::shared_ptr<Device>> &devices) {
+        std::vector<ob_device_t *> deviceImpls;
+        for(auto &device: devices) {
+            deviceImpls.push_back(device->getImpl());
+        }
+        ob_error *error = nullptr;
+        impl_           = ob_create_multi_device_pipeline(deviceImpls.data(), static_cast<uint32_t>(deviceImpls.size()), &error);
+        Error::handle(&error);
+    }
+
+    ~MultiDevicePipeline() noexcept {
+        ob_error *error = nullptr;
+        ob_delete_multi_device_pipeline(impl_, &error);
+        Error::handle(&error, false);
+    }
+
+    /**
+     * @brief Start the pipeline
+     *
+     * @param configs The configurations of the devices, empty to start all the devices with the default configuration. Otherwise one configuration
+     * (may be nullptr) per device.
+     */
+    void start(const std::vector<std::shared_ptr<Config>> &configs = {}) {
+        auto      configImpls = getConfigImpls(configs);
+        ob_error *error       = nullptr;
+        ob_multi_device_pipeline_start(impl_, configImpls.empty() ? nullptr : configImpls.data(), static_cast<uint32_t>(configImpls.size()), &error);
+        Error::handle(&error);
+    }
+
+    /**
+     * @brief Start the pipeline and set the composite frameset callback
+     *
+     * @param configs The configurations of the devices, see start()
+     * @param callback The callback to be triggered when the framesets of all the devices captured at the same time arrive
+     */
+    void start(const std::vector<std::shared_ptr<Config>> &configs, FrameSetCallback callback) {
+        callback_             = callback;
+        auto      configImpls = getConfigImpls(configs);
+        ob_error *error       = nullptr;
+        ob_multi_device_pipeline_start_with_callback(impl_, configImpls.empty() ? nullptr : configImpls.data(), static_cast<uint32_t>(configImpls.size()),
+                                                     &MultiDevicePipeline::frameSetCallback, this, &error);
+        Error::handle(&error);
+    }
+
+    static void frameSetCallback(ob_frame_t *frameSet, void *userData) {
+        auto pipeline = static_cast<MultiDevicePipeline *>(userData);
+        pipeline->callback_(std::make_shared<FrameSet>(frameSet));
+    }
+
+    /**
+     * @brief Stop the pipeline
+     */
+    void stop() const {
+        ob_error *error = nullptr;
+        ob_multi_device_pipeline_stop(impl_, &error);
+        Error::handle(&error);
+    }
+
+    /**
+     * @brief Wait for a composite frameset
+     *
+     * @param timeoutMs The waiting timeout in milliseconds
+     * @return std::shared_ptr<FrameSet> The composite frameset, nullptr if timeout
+     */
+    std::shared_ptr<FrameSet> waitForFrameset(uint32_t timeoutMs = 1000) const {
+        ob_error *error    = nullptr;
+        auto      frameSet = ob_multi_device_pipeline_wait_for_frameset(impl_, timeoutMs, &error);
+        Error::handle(&error);
+        if(frameSet == nullptr) {
+            return nullptr;
+        }
+        return std::make_shared<FrameSet>(frameSet);
+    }
+
+    uint32_t getDeviceCount() const {
+        ob_error *error = nullptr;
+        auto      count = ob_multi_device_pipeline_get_device_count(impl_, &error);
+        Error::handle(&error);
+        return count;
+    }
+
+    std::shared_ptr<Device> getDevice(uint32_t index) const {
+        ob_error *error  = nullptr;
+        auto      device = ob_multi_device_pipeline_get_device(impl_, index, &error);
+        Error::handle(&error);
+        return std::make_shared<Device>(device);
+    }
+
+    /**
+     * @brief Set the configuration of grouping the framesets of the devices, such as the timestamp type, the tolerance and the max latency
+     */
+    void setFrameSyncConfig(const OBMultiDeviceFrameSyncConfig &config) {
+        ob_error *error = nullptr;
+        ob_multi_device_pipeline_set_frame_sync_config(impl_, &config, &error);
+        Error::handle(&error);
+    }
+
+    OBMultiDeviceFrameSyncConfig getFrameSyncConfig() const {
+        ob_error *error  = nullptr;
+        auto      config = ob_multi_device_pipeline_get_frame_sync_config(impl_, &error);
+        Error::handle(&error);
+        return config;
+    }
+
+    /**
+     * @brief Get the statistics of grouping the framesets, such as the count of the dropped framesets which could not be grouped in time
+     */
+    OBMultiDeviceFrameSyncStatistics getStatistics() const {
+        ob_error *error      = nullptr;
+        auto      statistics = ob_multi_device_pipeline_get_statistics(impl_, &error);
+        Error::handle(&error);
+        return statistics;
+    }
+
+private:
+    static std::vector<ob_config_t *> getConfigImpls(const std::vector<std::shared_ptr<Config>> &configs) {
+        std::vector<ob_config_t *> configImpls;
+        for(auto &config: configs) {
+            configImpls.push_back(config ? config->getImpl() : nullptr);
+        }
+        return configImpls;
+    }
+};
+
 }  // namespace ob
 
@@ -16,6 +16,11 @@ public:
     virtual ~IFrameMetadataParser()                                       = default;
     virtual int64_t getValue(const uint8_t *metadata, size_t dataSize)    = 0;
     virtual bool    isSupported(const uint8_t *metadata, size_t dataSize) = 0;
+    // True if the value is decoded from the metadata bytes only, such values are decoded in bulk and cached by the frame. The parsers reading the
+    // device state (properties, the active stream profile, the device clock) are queried per field.
+    virtual bool isPureMetadataParser() const {
+        return false;
+    }
 };
 
 typedef std::function<int64_t(const int64_t &param)> FrameMetadataModifier;
@@ -27,6 +32,8 @@ public:
     virtual void                                  registerParser(OBFrameMetadataType type, std::shared_ptr<IFrameMetadataParser> phaser) = 0;
     virtual bool                                  isContained(OBFrameMetadataType type)                                                  = 0;
     virtual std::shared_ptr<IFrameMetadataParser> get(OBFrameMetadataType type)                                                          = 0;
+    // Decode the values of all the registered pure metadata parsers of the supported types, the values of the other types are left untouched
+    virtual void                                  decodeAll(const uint8_t *metadata, size_t dataSize, OBFrameMetadataValues &values)     = 0;
 };
 
 class Frame;
@@ -3,13 +3,20 @@
 
 #include "Frame.hpp"
 #include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
 #include "utils/Utils.hpp"
 #include "stream/StreamProfile.hpp"
 #include "frame/FrameMemoryPool.hpp"
 #include "frame/FrameBufferManager.hpp"
+#include "frame/FrameFactory.hpp"
 
 namespace libobsensor {
 
+FrameCopyStatistics &getThreadFrameCopyStatistics() {
+    static thread_local FrameCopyStatistics statistics = { 0, 0 };
+    return statistics;
+}
+
 FrameBackendLifeSpan::FrameBackendLifeSpan()
     : logger_(Logger::getInstance()), memoryPool_(FrameMemoryPool::getInstance()), memoryAllocator_(FrameMemoryAllocator::getInstance()) {}
 
@@ -28,7 +35,9 @@ Frame::Frame(uint8_t *data, size_t dataBufSize, OBFrameType type, FrameBufferRec
       metadataSize_(0),
       metadataPhasers_(nullptr),
       streamProfile_(nullptr),
+      metadataValuesDecoded_(false),
       type_(type),
+      buffer_(data),
       frameData_(data),
       dataBufSize_(dataBufSize),
       bufferReclaimFunc_(bufferReclaimFunc) {}
@@ -40,7 +49,7 @@ Frame::~Frame() noexcept {
         bufferReclaimFunc_();
     }
     else {
-        delete[] frameData_;
+        delete[] buffer_;
     }
 }
 
@@ -72,19 +81,70 @@ void Frame::setDataSize(size_t dataSize) {
 }
 
 const uint8_t *Frame::getData() const {
-    return frameData_;
+    return frameData_.load(std::memory_order_acquire);
 }
 
 uint8_t *Frame::getDataMutable() const {
-    return const_cast<uint8_t *>(frameData_);
+    detachData(true);
+    return const_cast<uint8_t *>(frameData_.load(std::memory_order_acquire));
 }
 
 void Frame::updateData(const uint8_t *data, size_t dataSize) {
     if(dataSize > dataBufSize_) {
         throw memory_exception(utils::string::to_string() << "Update data size(" << dataSize << ") > data buffer size! (" << dataBufSize_ << ")");
     }
+    detachData(false);
     dataSize_ = dataSize;
-    memcpy(const_cast<uint8_t *>(frameData_), data, dataSize);
+    memcpy(const_cast<uint8_t *>(frameData_.load(std::memory_order_acquire)), data, dataSize);
+    getThreadFrameCopyStatistics().dataBytes += dataSize;
+}
+
+bool Frame::isDataShared() const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    return dataShare_ && dataShare_.use_count() > 1;
+}
+
+void Frame::shareData(std::shared_ptr<const Frame> otherFrame) {
+    std::lock_guard<std::mutex> lock(otherFrame->dataMutex_);
+    if(!otherFrame->dataShare_) {
+        otherFrame->dataShare_ = std::make_shared<DataShare>();
+    }
+    dataShare_ = otherFrame->dataShare_;
+    // always borrow from the frame holding the buffer memory, so that the chain of the shared frames does not grow
+    dataOwner_   = otherFrame->dataOwner_ ? otherFrame->dataOwner_ : otherFrame;
+    dataBufSize_ = otherFrame->dataBufSize_;
+    dataSize_    = otherFrame->dataSize_;
+    frameData_.store(otherFrame->frameData_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+void Frame::detachData(bool copyData) const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    if(!dataShare_) {
+        return;
+    }
+    if(dataShare_.use_count() == 1) {
+        // the other frames have been released or have copied the data, so it can be changed in place. A new share needs the lock of a frame
+        // using the buffer, which is this one only.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return;
+    }
+
+    auto holder = FrameFactory::createDataHolderFrame(type_, dataBufSize_);
+    auto data   = holder->getDataMutable();
+    if(copyData) {
+        getThreadFrameCopyStatistics().dataBytes += copyBufferData(frameData_.load(std::memory_order_relaxed), data);
+    }
+    if(dataOwner_) {
+        retiredDataOwners_.push_back(dataOwner_);
+    }
+    dataOwner_ = holder;
+    dataShare_.reset();
+    frameData_.store(data, std::memory_order_release);
+}
+
+size_t Frame::copyBufferData(const uint8_t *src, uint8_t *dst) const {
+    memcpy(dst, src, dataSize_);
+    return dataSize_;
 }
 
 uint64_t Frame::getTimeStampUsec() const {
@@ -160,6 +220,7 @@ size_t Frame::getMetadataSize() const {
 
 void Frame::setMetadataSize(size_t metadataSize) {
     metadataSize_ = metadataSize;
+    metadataValuesDecoded_.store(false, std::memory_order_release);
 }
 
 void Frame::updateMetadata(const uint8_t *metadata, size_t metadataSize) {
@@ -172,6 +233,7 @@ void Frame::updateMetadata(const uint8_t *metadata, size_t metadataSize) {
     }
     memcpy(metadata_, metadata, metadataSize);
     metadataSize_ = metadataSize;
+    metadataValuesDecoded_.store(false, std::memory_order_release);
 }
 
 void Frame::appendMetadata(const uint8_t *metadata, size_t metadataSize) {
@@ -184,6 +246,7 @@ void Frame::appendMetadata(const uint8_t *metadata, size_t metadataSize) {
     }
     memcpy(metadata_ + metadataSize_, metadata, metadataSize);
     metadataSize_ += metadataSize;
+    metadataValuesDecoded_.store(false, std::memory_order_release);
 }
 
 const uint8_t *Frame::getMetadata() const {
@@ -196,17 +259,23 @@ uint8_t *Frame::getMetadataMutable() const {
 
 void Frame::registerMetadataParsers(std::shared_ptr<IFrameMetadataParserContainer> parsers) {
     metadataPhasers_ = parsers;
+    metadataValuesDecoded_.store(false, std::memory_order_release);
 }
 
 bool Frame::hasMetadata(OBFrameMetadataType type) const {
-    if(!metadataPhasers_) {
+    if(!metadataPhasers_ || static_cast<uint32_t>(type) >= OB_FRAME_METADATA_TYPE_COUNT) {
         return false;
     }
+    if(getMetadataValues().supportedMask & (1ull << type)) {
+        return true;
+    }
+
+    // the values depending on the device state are not decoded in bulk
     if(!metadataPhasers_->isContained(type)) {
         return false;
     }
     auto parser = metadataPhasers_->get(type);
-    return parser->isSupported(metadata_, metadataSize_);
+    return !parser->isPureMetadataParser() && parser->isSupported(metadata_, metadataSize_);
 }
 
 int64_t Frame::getMetadataValue(OBFrameMetadataType type) const {
@@ -214,6 +283,14 @@ int64_t Frame::getMetadataValue(OBFrameMetadataType type) const {
         throw unsupported_operation_exception(utils::string::to_string()
                                               << "Metadata phasers are not registered! Unsupported to get metadata for type: " << type);
     }
+    if(static_cast<uint32_t>(type) < OB_FRAME_METADATA_TYPE_COUNT) {
+        auto &values = getMetadataValues();
+        if(values.supportedMask & (1ull << type)) {
+            return values.values[type];
+        }
+    }
+
+    // not decoded in bulk, query the parser for the value or the error
     auto parser = metadataPhasers_->get(type);
     if(!parser->isSupported(metadata_, metadataSize_)) {
         throw unsupported_operation_exception(utils::string::to_string() << "Current metadata does not contain metadata for type: " << type);
@@ -221,6 +298,21 @@ int64_t Frame::getMetadataValue(OBFrameMetadataType type) const {
     return parser->getValue(metadata_, metadataSize_);
 }
 
+const OBFrameMetadataValues &Frame::getMetadataValues() const {
+    static_assert(OB_FRAME_METADATA_TYPE_COUNT <= OB_FRAME_METADATA_VALUES_CAPACITY, "OBFrameMetadataValues can not hold all the metadata types");
+    if(!metadataValuesDecoded_.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(metadataValuesMutex_);
+        if(!metadataValuesDecoded_.load(std::memory_order_relaxed)) {
+            memset(&metadataValues_, 0, sizeof(metadataValues_));
+            if(metadataPhasers_) {
+                metadataPhasers_->decodeAll(metadata_, metadataSize_, metadataValues_);
+            }
+            metadataValuesDecoded_.store(true, std::memory_order_release);
+        }
+    }
+    return metadataValues_;
+}
+
 std::shared_ptr<const StreamProfile> Frame::getStreamProfile() const {
     return streamProfile_;
 }
@@ -238,6 +330,17 @@ void Frame::copyInfoFromOther(const std::shared_ptr<const Frame> otherFrame) {
     metadataSize_ = otherFrame->metadataSize_;
     memcpy(metadata_, otherFrame->metadata_, metadataSize_);
     metadataPhasers_ = otherFrame->metadataPhasers_;
+    getThreadFrameCopyStatistics().metadataBytes += metadataSize_;
+
+    // the decoded values are still valid for the same metadata and parsers
+    if(otherFrame->metadataValuesDecoded_.load(std::memory_order_acquire)) {
+        metadataValues_ = otherFrame->metadataValues_;
+        metadataValuesDecoded_.store(true, std::memory_order_release);
+        getThreadFrameCopyStatistics().metadataBytes += sizeof(metadataValues_);
+    }
+    else {
+        metadataValuesDecoded_.store(false, std::memory_order_release);
+    }
 }
 
 size_t Frame::getDataBufSize() const {
@@ -314,7 +417,7 @@ IRRightFrame::IRRightFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaim
     : IRFrame(data, dataBufSize, bufferReclaimFunc, OB_FRAME_IR_RIGHT) {}
 
 PointsFrame::PointsFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
-    : Frame(data, dataBufSize, OB_FRAME_POINTS, bufferReclaimFunc) {}
+    : Frame(data, dataBufSize, OB_FRAME_POINTS, bufferReclaimFunc), coordValueScale_(1.0f), pointIndexOffset_(0) {}
 
 void PointsFrame::setCoordinateValueScale(float valueScale) {
     coordValueScale_ = valueScale;
@@ -324,6 +427,116 @@ float PointsFrame::getCoordinateValueScale() const {
     return coordValueScale_;
 }
 
+void PointsFrame::setPointIndexOffset(size_t offset) {
+    if(offset >= getDataBufSize()) {
+        throw invalid_value_exception(utils::string::to_string() << "Point index offset(" << offset << ") >= data buffer size! (" << getDataBufSize()
+                                                                 << ")");
+    }
+    pointIndexOffset_ = offset;
+}
+
+const uint32_t *PointsFrame::getPointIndexData() const {
+    if(pointIndexOffset_ == 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint32_t *>(getData() + pointIndexOffset_);
+}
+
+void PointsFrame::copyInfoFromOther(std::shared_ptr<const Frame> sourceFrame) {
+    Frame::copyInfoFromOther(sourceFrame);
+    if(!sourceFrame->is<PointsFrame>()) {
+        return;
+    }
+    auto pf           = sourceFrame->as<PointsFrame>();
+    coordValueScale_  = pf->coordValueScale_;
+    pointIndexOffset_ = 0;
+    if(pf->pointIndexOffset_ == 0) {
+        return;
+    }
+
+    // the point index is stored out of the data size, copy it if the data buffer is not shared with the source frame
+    auto indexSize = pf->getDataBufSize() - pf->pointIndexOffset_;
+    if(getData() != pf->getData()) {
+        if(getDataBufSize() < pf->getDataBufSize()) {
+            LOG_WARN_INTVL("Data buffer is too small to hold the point index, the point index of the copied frame is not available");
+            return;
+        }
+        memcpy(getDataMutable() + pf->pointIndexOffset_, pf->getData() + pf->pointIndexOffset_, indexSize);
+        getThreadFrameCopyStatistics().dataBytes += indexSize;
+    }
+    pointIndexOffset_ = pf->pointIndexOffset_;
+}
+
+size_t PointsFrame::copyBufferData(const uint8_t *src, uint8_t *dst) const {
+    auto copiedSize = Frame::copyBufferData(src, dst);
+    if(pointIndexOffset_ != 0) {
+        auto indexSize = getDataBufSize() - pointIndexOffset_;
+        memcpy(dst + pointIndexOffset_, src + pointIndexOffset_, indexSize);
+        copiedSize += indexSize;
+    }
+    return copiedSize;
+}
+
+size_t ImuSampleBatch::calcDataSize(uint32_t count) {
+    // The Data of the accel and gyro frames have the same size, and the header keeps the timestamp array 8 bytes aligned
+    return sizeof(AccelFrame::Data) + 2 * sizeof(uint32_t) + count * (sizeof(uint64_t) + 4 * sizeof(float));
+}
+
+ImuSampleBatch ImuSampleBatch::init(Frame *frame, uint32_t count) {
+    auto dataSize = calcDataSize(count);
+    if(dataSize > frame->getDataBufSize()) {
+        throw memory_exception(utils::string::to_string() << "Imu sample batch size(" << dataSize << ") > data buffer size! (" << frame->getDataBufSize()
+                                                          << ")");
+    }
+    auto header = reinterpret_cast<uint32_t *>(frame->getDataMutable() + sizeof(AccelFrame::Data));
+    header[0]   = count;
+    header[1]   = 0;
+    frame->setDataSize(dataSize);
+    return get(frame);
+}
+
+ImuSampleBatch ImuSampleBatch::get(const Frame *frame) {
+    ImuSampleBatch batch = {};
+    if(frame->getDataSize() < calcDataSize(0)) {
+        return batch;
+    }
+    auto header = reinterpret_cast<uint32_t *>(const_cast<uint8_t *>(frame->getData()) + sizeof(AccelFrame::Data));
+    auto count  = header[0];
+    if(count == 0 || frame->getDataSize() < calcDataSize(count)) {
+        return batch;
+    }
+    batch.count       = count;
+    batch.timestampUs = reinterpret_cast<uint64_t *>(header + 2);
+    batch.x           = reinterpret_cast<float *>(batch.timestampUs + count);
+    batch.y           = batch.x + count;
+    batch.z           = batch.y + count;
+    batch.temperature = batch.z + count;
+    return batch;
+}
+
+// A frame without batch carries one sample: its own value, temperature and timestamp
+template <typename T> static OBImuSamples getImuFrameSamples(const Frame *frame, const uint64_t *timestampUs) {
+    OBImuSamples samples = {};
+    auto         batch   = ImuSampleBatch::get(frame);
+    if(batch.count > 0) {
+        samples.count       = batch.count;
+        samples.timestampUs = batch.timestampUs;
+        samples.x           = batch.x;
+        samples.y           = batch.y;
+        samples.z           = batch.z;
+        samples.temperature = batch.temperature;
+        return samples;
+    }
+    auto data           = reinterpret_cast<const typename T::Data *>(frame->getData());
+    samples.count       = 1;
+    samples.timestampUs = timestampUs;
+    samples.x           = &data->value.x;
+    samples.y           = &data->value.y;
+    samples.z           = &data->value.z;
+    samples.temperature = &data->temp;
+    return samples;
+}
+
 AccelFrame::AccelFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
     : Frame(data, dataBufSize, OB_FRAME_ACCEL, bufferReclaimFunc) {}
 
@@ -335,6 +548,10 @@ float AccelFrame::temperature() {
     return ((AccelFrame::Data *)getData())->temp;
 }
 
+OBImuSamples AccelFrame::getSamples() const {
+    return getImuFrameSamples<AccelFrame>(this, &timeStampUsec_);
+}
+
 GyroFrame::GyroFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc)
     : Frame(data, dataBufSize, OB_FRAME_GYRO, bufferReclaimFunc) {}
 
@@ -346,7 +563,14 @@ float GyroFrame ::temperature() {
     return ((GyroFrame::Data *)getData())->temp;
 }
 
-FrameSet::FrameSet(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc) : Frame(data, dataBufSize, OB_FRAME_SET, bufferReclaimFunc) {}
+OBImuSamples GyroFrame::getSamples() const {
+    return getImuFrameSamples<GyroFrame>(this, &timeStampUsec_);
+}
+
+FrameSet::FrameSet(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc) : Frame(data, dataBufSize, OB_FRAME_SET, bufferReclaimFunc) {
+    // The frame buffer is not zero-filled on allocation, make sure all the frame slots are empty
+    memset(data, 0, dataBufSize);
+}
 
 FrameSet::~FrameSet() noexcept {
     clearAllFrame();
@@ -423,6 +647,22 @@ void FrameSet::pushFrame(std::shared_ptr<const Frame> &&frame) {
     });
 }
 
+void FrameSet::appendFrame(std::shared_ptr<const Frame> &&frame) {
+    bool appended = false;
+    foreachFrame([&](void *item) {
+        auto pFrame = (std::shared_ptr<const Frame> *)item;
+        if(!(*pFrame)) {
+            *pFrame  = std::move(frame);
+            appended = true;
+            return true;
+        }
+        return false;
+    });
+    if(!appended) {
+        throw invalid_value_exception("FrameSet::appendFrame() frameset is full");
+    }
+}
+
 void FrameSet::clearAllFrame() {
     foreachFrame([](void *item) {
         auto pFrame = (std::shared_ptr<Frame> *)item;
@@ -41,6 +41,14 @@ class GyroFrame;
 
 using FrameBufferReclaimFunc = std::function<void(void)>;
 
+// Bytes of frame data and metadata copied on the calling thread by updateData(), copyInfoFromOther() and the copy-on-write of shared data,
+// FilterExtension reports the bytes copied by each filter from the difference before and after processing a frame
+struct FrameCopyStatistics {
+    uint64_t dataBytes;
+    uint64_t metadataBytes;
+};
+FrameCopyStatistics &getThreadFrameCopyStatistics();
+
 class Frame : public std::enable_shared_from_this<Frame>, private FrameBackendLifeSpan {
 public:
     Frame(uint8_t *data, size_t dataBufSize, OBFrameType type, FrameBufferReclaimFunc bufferReclaimFunc = nullptr);
@@ -53,9 +61,13 @@ public:
     void           setNumber(const uint64_t number);
     size_t         getDataSize() const;
     void           setDataSize(size_t dataSize);
+    size_t         getDataBufSize() const;
     const uint8_t *getData() const;
+    // Copies the data first if it is shared with other frames (see FrameFactory::cloneFrame), use getData() to read the data. The pointers
+    // returned by getData() before the copy stay valid until the frame is destroyed.
     uint8_t       *getDataMutable() const;
     void           updateData(const uint8_t *data, size_t dataSize);
+    bool           isDataShared() const;  // whether the data buffer is also used by other frames
     uint64_t       getTimeStampUsec() const;
     void           setTimeStampUsec(uint64_t ts);
     uint64_t       getSystemTimeStampUsec() const;
@@ -74,6 +86,9 @@ public:
     void    registerMetadataParsers(std::shared_ptr<IFrameMetadataParserContainer> parsers);
     bool    hasMetadata(OBFrameMetadataType type) const;
     int64_t getMetadataValue(OBFrameMetadataType type) const;
+    // The metadata values decoded from the metadata bytes, decoded on the first query and cached until the metadata or the parsers are changed. The
+    // values depending on the device state are not included, getMetadataValue() queries them per field.
+    const OBFrameMetadataValues &getMetadataValues() const;
 
     std::shared_ptr<const StreamProfile> getStreamProfile() const;
     void                                 setStreamProfile(std::shared_ptr<const StreamProfile> streamProfile);
@@ -104,9 +119,6 @@ public:
         return std::dynamic_pointer_cast<const T>(shared_from_this());
     }
 
-protected:
-    size_t getDataBufSize() const;
-
 protected:
     size_t                                         dataSize_;
     uint64_t                                       number_;
@@ -118,12 +130,37 @@ protected:
     std::shared_ptr<IFrameMetadataParserContainer> metadataPhasers_;
     std::shared_ptr<const StreamProfile>           streamProfile_;
 
+    mutable std::atomic<bool>     metadataValuesDecoded_;
+    mutable std::mutex            metadataValuesMutex_;
+    mutable OBFrameMetadataValues metadataValues_;
+
     const OBFrameType type_;  // Determined during construction, it is an inherent property of the object and cannot be changed.
 
+    // Copy the data held by the frame from src to dst, both of the data buffer size, returns the bytes copied. Used by the copy on write of the
+    // shared data.
+    virtual size_t copyBufferData(const uint8_t *src, uint8_t *dst) const;
+
+private:
+    friend class FrameFactory;
+
+    // Share the data buffer of the other frame, the data is copied by detachData() when it is about to be changed through any of the frames
+    void shareData(std::shared_ptr<const Frame> otherFrame);
+    void detachData(bool copyData) const;
+
+    // Held by all the frames using the same data buffer, so that its use count is the number of these frames
+    struct DataShare {};
+
 private:
-    uint8_t const         *frameData_;
-    const size_t           dataBufSize_;
-    FrameBufferReclaimFunc bufferReclaimFunc_;
+    uint8_t *const                       buffer_;  // own data buffer, given on construction
+    mutable std::atomic<const uint8_t *> frameData_;
+    size_t                               dataBufSize_;
+    FrameBufferReclaimFunc               bufferReclaimFunc_;
+
+    // copy-on-write state, guarded by dataMutex_
+    mutable std::mutex                                dataMutex_;
+    mutable std::shared_ptr<DataShare>                dataShare_;  // null if the buffer has never been shared
+    mutable std::shared_ptr<const Frame>              dataOwner_;  // the frame holding the buffer memory, null if it is the own buffer
+    mutable std::vector<std::shared_ptr<const Frame>> retiredDataOwners_;  // keep the data returned by getData() before a copy valid
 };
 
 class VideoFrame : public Frame {
@@ -191,8 +228,37 @@ public:
     void  setCoordinateValueScale(float valueScale);
     float getCoordinateValueScale() const;
 
+    // Compact point cloud: the pixel index (v * width + u of the depth frame) of each point is stored in the frame buffer at the offset, after the space
+    // of the points. 0 if the point index is not available.
+    void            setPointIndexOffset(size_t offset);
+    const uint32_t *getPointIndexData() const;  // nullptr if the point index is not available
+
+    virtual void copyInfoFromOther(std::shared_ptr<const Frame> sourceFrame) override;
+
+protected:
+    size_t copyBufferData(const uint8_t *src, uint8_t *dst) const override;
+
 private:
-    float coordValueScale_;  // coordinate value scale, multiply by this value to get actual coordinate value in mm
+    float  coordValueScale_;   // coordinate value scale, multiply by this value to get actual coordinate value in mm
+    size_t pointIndexOffset_;
+};
+
+// Samples batched into one accel/gyro frame (OB_PROP_SDK_IMU_BATCH_SIZE_INT), stored after the Data of the latest sample as:
+// uint32_t count, uint32_t reserved, uint64_t timestampUs[count], float x[count], float y[count], float z[count], float temperature[count]
+struct ImuSampleBatch {
+    uint32_t  count;  // 0 if the frame does not carry a batch
+    uint64_t *timestampUs;
+    float    *x;
+    float    *y;
+    float    *z;
+    float    *temperature;
+
+    // Data size of a frame carrying count samples
+    static size_t calcDataSize(uint32_t count);
+    // Lay out a batch of count samples in the frame, whose data buffer must be at least calcDataSize(count) bytes
+    static ImuSampleBatch init(Frame *frame, uint32_t count);
+    // The arrays point into the current data of the frame, call getDataMutable() first to change the samples of a frame that may share its data
+    static ImuSampleBatch get(const Frame *frame);
 };
 
 class AccelFrame : public Frame {
@@ -209,6 +275,8 @@ public:
 
     OBAccelValue value();
     float        temperature();
+    // The samples of the batch, or the frame's own value if it is not batched
+    OBImuSamples getSamples() const;
 };
 
 class GyroFrame : public Frame {
@@ -223,8 +291,10 @@ public:
 public:
     GyroFrame(uint8_t *data, size_t dataBufSize, FrameBufferReclaimFunc bufferReclaimFunc = nullptr);
 
-    OBGyroValue value();
-    float       temperature();
+    OBGyroValue  value();
+    float        temperature();
+    // The samples of the batch, or the frame's own value if it is not batched
+    OBImuSamples getSamples() const;
 };
 
 class FrameSet : public Frame {
@@ -245,6 +315,8 @@ public:
     // It is recommended to use the rvalue reference interface. If you really need it, you can uncomment the following
     // void pushFrame(std::shared_ptr<Frame> frame);
     void pushFrame(std::shared_ptr<const Frame> &&frame);
+    // Put the frame to the first empty slot, unlike pushFrame the frame of the same type is kept. Throws if the frameset is full.
+    void appendFrame(std::shared_ptr<const Frame> &&frame);
     void clearAllFrame();
 
 public:
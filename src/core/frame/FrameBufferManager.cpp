@@ -8,11 +8,26 @@
 #include "exception/ObException.hpp"
 #include "logger/Logger.hpp"
 
+#include <string.h>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 namespace libobsensor {
 
 #define DEFAULT_MAX_FRAME_MEMORY_SIZE ((uint64_t)2 * 1024 * 1024 * 1024)  // 2GB
+#define MAX_IDLE_FRAME_BUFFER_COUNT 100                                  // Release the memory in time when there are enough idle buffers
 
-FrameMemoryAllocator::FrameMemoryAllocator() : maxSizeInByte_(DEFAULT_MAX_FRAME_MEMORY_SIZE), usedSize_(0), logger_(Logger::getInstance()) {
+FrameMemoryAllocator::FrameMemoryAllocator()
+    : maxSizeInByte_(DEFAULT_MAX_FRAME_MEMORY_SIZE),
+      usedSize_(0),
+      hitCount_(0),
+      missCount_(0),
+      lockMemory_(false),
+      anyBufferLocked_(false),
+      backend_(createFrameMemoryBackend()),
+      logger_(Logger::getInstance()) {
     auto envConfig = EnvConfig::getInstance();
 
     if(envConfig->isNodeContained("Memory.MaxFrameBufferSize")) {
@@ -24,7 +39,18 @@ FrameMemoryAllocator::FrameMemoryAllocator() : maxSizeInByte_(DEFAULT_MAX_FRAME_
         }
         maxSizeInByte_ = static_cast<uint64_t>(frameBufferSize) * 1024 * 1024;  // MB to Byte
     }
-    LOG_DEBUG("FrameMemoryAllocator created! The max frame memory size has been set to {:.3f}MB", byteToMB(maxSizeInByte_));
+
+    bool lockMemory = false;
+    envConfig->getBooleanValue("Memory.LockFrameBufferMemory", lockMemory);
+#ifdef _WIN32
+    if(lockMemory) {
+        LOG_WARN("Memory.LockFrameBufferMemory is not supported on Windows, ignored");
+        lockMemory = false;
+    }
+#endif
+    lockMemory_ = lockMemory;
+    LOG_DEBUG("FrameMemoryAllocator created! The max frame memory size has been set to {:.3f}MB, backend: {}", byteToMB(maxSizeInByte_),
+              backend_->getName());
 }
 
 FrameMemoryAllocator::~FrameMemoryAllocator() noexcept {
@@ -46,7 +72,6 @@ std::shared_ptr<FrameMemoryAllocator> FrameMemoryAllocator::getInstance() {
 }
 
 void FrameMemoryAllocator::setMaxFrameMemorySize(uint64_t sizeInMb) {
-    std::unique_lock<std::mutex> lock(mutex_);
     maxSizeInByte_ = sizeInMb * 1024 * 1024;
     if(maxSizeInByte_ < usedSize_) {
         LOG_WARN("The max frame memory size you set is {:.3f}MB,  less than the current used size, will set to {:.3f}MB instead", byteToMB(maxSizeInByte_),
@@ -60,56 +85,142 @@ void FrameMemoryAllocator::setMaxFrameMemorySize(uint64_t sizeInMb) {
 }
 
 uint8_t *FrameMemoryAllocator::allocate(size_t size) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if(usedSize_ + size > maxSizeInByte_) {
-        LOG_WARN("FrameMemoryAllocator out of memory! require={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size),
-                 byteToMB(usedSize_), byteToMB(maxSizeInByte_));
+    // reserve the size first, so that concurrent allocations can not exceed the limit
+    uint64_t usedSize = usedSize_.load();
+    do {
+        if(usedSize + size > maxSizeInByte_) {
+            LOG_WARN("FrameMemoryAllocator out of memory! require={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size),
+                     byteToMB(usedSize), byteToMB(maxSizeInByte_));
+            return nullptr;
+        }
+    } while(!usedSize_.compare_exchange_weak(usedSize, usedSize + size));
+
+    // The buffer is not zero-filled: frame data is always written by the producer, and the recycled buffers are not zero-filled either.
+    void *ptr = backend_->allocate(size);
+    if(ptr == nullptr) {
+        usedSize_ -= size;
+        LOG_ERROR("FrameMemoryAllocator allocate failed! size={0:.3f}MB", byteToMB(size));
         return nullptr;
     }
 
-    void *ptr = malloc(size);
-    if(ptr == nullptr && reinterpret_cast<uintptr_t>(ptr) == 0xdddddddd) {
-        LOG_ERROR("FrameMemoryAllocator malloc failed! ptr={0:x}", (uintptr_t)ptr);
+#ifndef _WIN32
+    if(lockMemory_) {
+        if(mlock(ptr, size) == 0) {
+            std::lock_guard<std::mutex> lock(lockedBuffersMutex_);
+            lockedBuffers_.insert(static_cast<const uint8_t *>(ptr));
+            anyBufferLocked_.store(true, std::memory_order_release);
+        }
+        else {
+            // Usually caused by the RLIMIT_MEMLOCK limit, stop trying to avoid the overhead of failed syscalls on every allocation
+            lockMemory_ = false;
+            LOG_WARN("Lock frame buffer memory failed, the frame buffers will not be locked anymore! error={}", strerror(errno));
+        }
     }
+#endif
 
-    memset(ptr, 0, size);
-    usedSize_ += size;
-    LOG_DEBUG("New frame buffer allocated={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize_),
+    LOG_DEBUG("New frame buffer allocated={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize + size),
               byteToMB(maxSizeInByte_));
     return (uint8_t *)ptr;
 }
 
 void FrameMemoryAllocator::deallocate(uint8_t *ptr, size_t size) {
-    std::unique_lock<std::mutex> lock(mutex_);
     usedSize_ -= size;
-    free(ptr);
+#ifndef _WIN32
+    // The set is only looked up if a buffer has ever been locked: the allocation of a locked buffer happens before its deallocation, so the flag
+    // is seen set by then.
+    bool locked = false;
+    if(anyBufferLocked_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(lockedBuffersMutex_);
+        locked = lockedBuffers_.erase(ptr) > 0;
+    }
+    if(locked) {
+        munlock(ptr, size);
+    }
+#endif
+    backend_->deallocate(ptr, size);
     LOG_DEBUG("Frame buffer released={0:.3f}MB, total usage: allocated={1:.3f}MB, max limit={2:.3f}MB", byteToMB(size), byteToMB(usedSize_),
               byteToMB(maxSizeInByte_));
 }
 
+void FrameMemoryAllocator::recordBufferAcquired(bool hit) {
+    if(hit) {
+        hitCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        missCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+OBFrameMemoryPoolStatistics FrameMemoryAllocator::getStatistics() const {
+    OBFrameMemoryPoolStatistics stats;
+    stats.hitCount      = hitCount_.load(std::memory_order_relaxed);
+    stats.missCount     = missCount_.load(std::memory_order_relaxed);
+    stats.allocatedSize = usedSize_.load();
+    stats.maxSize       = maxSizeInByte_.load();
+    return stats;
+}
+
+LockFreeIndexStack::LockFreeIndexStack(uint32_t capacity) : head_(pack(INVALID_INDEX, 0)), next_(new std::atomic<uint32_t>[capacity]) {
+    for(uint32_t i = 0; i < capacity; i++) {
+        next_[i] = INVALID_INDEX;
+    }
+}
+
+void LockFreeIndexStack::push(uint32_t index) {
+    uint64_t oldHead = head_.load(std::memory_order_relaxed);
+    uint64_t newHead;
+    do {
+        next_[index].store(static_cast<uint32_t>(oldHead), std::memory_order_relaxed);
+        newHead = pack(index, static_cast<uint32_t>(oldHead >> 32) + 1);
+    } while(!head_.compare_exchange_weak(oldHead, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+uint32_t LockFreeIndexStack::pop() {
+    uint64_t oldHead = head_.load(std::memory_order_acquire);
+    uint64_t newHead;
+    do {
+        auto index = static_cast<uint32_t>(oldHead);
+        if(index == INVALID_INDEX) {
+            return INVALID_INDEX;
+        }
+        // next_[index] may be changed by other thread after the index is popped, the tag of head guarantees the CAS fails in that case
+        newHead = pack(next_[index].load(std::memory_order_relaxed), static_cast<uint32_t>(oldHead >> 32) + 1);
+    } while(!head_.compare_exchange_weak(oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire));
+    return static_cast<uint32_t>(oldHead);
+}
+
 FrameBufferManagerBase::FrameBufferManagerBase(size_t frameDataBufferSize, size_t frameObjSize)
-    : frameDataBufferSize_(frameDataBufferSize), frameObjSize_(frameObjSize), frameMemoryAllocator_(FrameMemoryAllocator::getInstance()) {
+    : frameDataBufferSize_(frameDataBufferSize),
+      frameObjSize_(frameObjSize),
+      idleBufferSlots_(new std::atomic<uint8_t *>[MAX_IDLE_FRAME_BUFFER_COUNT]),
+      emptySlots_(MAX_IDLE_FRAME_BUFFER_COUNT),
+      idleBuffers_(MAX_IDLE_FRAME_BUFFER_COUNT),
+      idleBufferCount_(0),
+      frameMemoryAllocator_(FrameMemoryAllocator::getInstance()) {
     frameTotalSize_ = frameDataBufferSize_ + frameObjSize_ + FRAME_DATA_ALIGN_IN_BYTE
                       - 1;  // Apply for more FRAME_DATA_ALIGN_IN_BYTE-1 to facilitate offset part of the data address and achieve alignment
+    for(uint32_t i = MAX_IDLE_FRAME_BUFFER_COUNT; i > 0; i--) {
+        idleBufferSlots_[i - 1] = nullptr;
+        emptySlots_.push(i - 1);
+    }
 }
 
 FrameBufferManagerBase::~FrameBufferManagerBase() noexcept {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    while(!availableFrameBuffers_.empty()) {
-        frameMemoryAllocator_->deallocate(availableFrameBuffers_.front(), frameTotalSize_);
-        availableFrameBuffers_.erase(availableFrameBuffers_.begin());
-    }
+    releaseIdleBuffer();
     LOG_DEBUG("FrameBufferManagerBase destroyed! manager type:{0},  obj addr:0x{1:x}", typeid(*this).name(), uint64_t(this));
 }
 
 uint8_t *FrameBufferManagerBase::acquireBuffer() {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    uint8_t                               *bufferPtr = nullptr;
-    if(!availableFrameBuffers_.empty()) {
-        bufferPtr = *availableFrameBuffers_.begin();
-        availableFrameBuffers_.erase(availableFrameBuffers_.begin());
+    uint8_t *bufferPtr = nullptr;
+    auto     slot      = idleBuffers_.pop();
+    if(slot != LockFreeIndexStack::INVALID_INDEX) {
+        idleBufferCount_--;
+        bufferPtr = idleBufferSlots_[slot].exchange(nullptr, std::memory_order_acquire);
+        emptySlots_.push(slot);
+        frameMemoryAllocator_->recordBufferAcquired(true);
     }
     else {
+        frameMemoryAllocator_->recordBufferAcquired(false);
         bufferPtr = frameMemoryAllocator_->allocate(frameTotalSize_);
         if(bufferPtr == nullptr) {
             LOG_WARN("allocBuffer failed! Will retry after release idle memory on FrameMemoryPool");
@@ -126,30 +237,42 @@ uint8_t *FrameBufferManagerBase::acquireBuffer() {
     return bufferPtr;
 }
 
-std::unique_lock<std::recursive_mutex> FrameBufferManagerBase::lockBuffers() {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    return lock_;
-}
-
 void FrameBufferManagerBase::reclaimBuffer(void *buffer) {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    availableFrameBuffers_.push_back((uint8_t *)buffer);
+    auto slot = emptySlots_.pop();
+    if(slot == LockFreeIndexStack::INVALID_INDEX) {
+        // Release the memory in time when there are enough idle buffers
+        frameMemoryAllocator_->deallocate((uint8_t *)buffer, frameTotalSize_);
+        return;
+    }
+    idleBufferSlots_[slot].store((uint8_t *)buffer, std::memory_order_release);
+    idleBufferCount_++;
+    idleBuffers_.push(slot);
+}
 
-    if(availableFrameBuffers_.size() > 100) {
-        // Release the memory in time when there are enough availableFrameBuffers_
-        // The current buffer cannot be deleted directly, which will cause frame destruction and crash.
-        frameMemoryAllocator_->deallocate(availableFrameBuffers_.front(), frameTotalSize_);
-        availableFrameBuffers_.erase(availableFrameBuffers_.begin());
+void FrameBufferManagerBase::reserveBuffers(uint32_t count) {
+    count = std::min<uint32_t>(count, MAX_IDLE_FRAME_BUFFER_COUNT);
+    for(uint32_t i = idleBufferCount_; i < count; i++) {
+        auto bufferPtr = frameMemoryAllocator_->allocate(frameTotalSize_);
+        if(bufferPtr == nullptr) {
+            LOG_WARN("Reserve frame buffers failed, out of memory! reserved={}, required={}", i, count);
+            break;
+        }
+        // Touch all pages to make the page faults happen now instead of on the first frames
+        memset(bufferPtr, 0, frameTotalSize_);
+        reclaimBuffer(bufferPtr);
     }
+    LOG_DEBUG("Frame buffers reserved! manager type:{0}, idle buffer count:{1}, buffer size:{2:.3f}MB", typeid(*this).name(), idleBufferCount_.load(),
+              byteToMB(frameTotalSize_));
 }
 
 void FrameBufferManagerBase::releaseIdleBuffer() {
-    std::unique_lock<std::recursive_mutex> lock_(mutex_);
-    while(!availableFrameBuffers_.empty()) {
-        // Release the memory in time when there are enough availableFrameBuffers_
-        // The current buffer cannot be deleted directly, which will cause frame destruction and crash.
-        frameMemoryAllocator_->deallocate(availableFrameBuffers_.front(), frameTotalSize_);
-        availableFrameBuffers_.erase(availableFrameBuffers_.begin());
+    auto slot = idleBuffers_.pop();
+    while(slot != LockFreeIndexStack::INVALID_INDEX) {
+        idleBufferCount_--;
+        auto bufferPtr = idleBufferSlots_[slot].exchange(nullptr, std::memory_order_acquire);
+        emptySlots_.push(slot);
+        frameMemoryAllocator_->deallocate(bufferPtr, frameTotalSize_);
+        slot = idleBuffers_.pop();
     }
 }
 
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 #include "frame/Frame.hpp"
+#include "frame/FrameMemoryBackend.hpp"
 #include "logger/Logger.hpp"
 
 #define FRAME_DATA_ALIGN_IN_BYTE 16  // 16-byte alignment
@@ -28,10 +31,24 @@ public:
     uint8_t *allocate(size_t size);
     void     deallocate(uint8_t *ptr, size_t size);
 
+    // Hit: the frame buffer is reused from idle buffers; miss: the frame buffer is newly allocated.
+    void recordBufferAcquired(bool hit);
+
+    OBFrameMemoryPoolStatistics getStatistics() const;
+
 private:
-    uint64_t   maxSizeInByte_;
-    uint64_t   usedSize_;
-    std::mutex mutex_;
+    std::atomic<uint64_t> maxSizeInByte_;
+    std::atomic<uint64_t> usedSize_;
+    std::atomic<uint64_t> hitCount_;
+    std::atomic<uint64_t> missCount_;
+    std::atomic<bool>     lockMemory_;  // mlock the allocated memory, Memory.LockFrameBufferMemory
+
+    // The buffers locked by mlock, they are unlocked on deallocation even after the locking is stopped by a failure
+    std::atomic<bool>                   anyBufferLocked_;  // so that the deallocations skip the set while locking is not used
+    std::mutex                          lockedBuffersMutex_;
+    std::unordered_set<const uint8_t *> lockedBuffers_;
+
+    std::unique_ptr<IFrameMemoryBackend> backend_;  // Memory.FrameMemoryBackend
 
     std::shared_ptr<Logger> logger_;  // Manages the lifecycle of the logger object.
 };
@@ -39,9 +56,10 @@ private:
 class IFrameBufferManager {
 public:
     virtual ~IFrameBufferManager() noexcept {};
-    virtual void   reclaimBuffer(void *buffer) = 0;
-    virtual void   releaseIdleBuffer()         = 0;
-    virtual size_t getFrameDataBufferSize()    = 0;
+    virtual void   reclaimBuffer(void *buffer)    = 0;
+    virtual void   releaseIdleBuffer()            = 0;
+    virtual void   reserveBuffers(uint32_t count) = 0;  // allocate buffers in advance until there are at least count idle buffers
+    virtual size_t getFrameDataBufferSize()       = 0;
 
 private:
     virtual std::shared_ptr<Frame> acquireFrame() = 0;
@@ -52,6 +70,31 @@ inline double byteToMB(uint64_t sizeInByte) {
     return (double)sizeInByte / 1024.0 / 1024.0;
 }
 
+/**
+ * @brief Lock-free LIFO stack of slot indices in range [0, capacity).
+ *
+ * The head is a 64-bit word packing the top index and a modification tag, the tag is increased on every push/pop to avoid the ABA problem, so that
+ * push and pop are O(1) and never block. Each index must be pushed at most once before being popped.
+ */
+class LockFreeIndexStack {
+public:
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    explicit LockFreeIndexStack(uint32_t capacity);
+
+    void     push(uint32_t index);
+    uint32_t pop();  // return INVALID_INDEX if the stack is empty
+
+private:
+    static uint64_t pack(uint32_t index, uint32_t tag) {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+
+private:
+    std::atomic<uint64_t>                    head_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;
+};
+
 class FrameBufferManagerBase : public IFrameBufferManager {
 public:
     FrameBufferManagerBase(size_t frameDataBufferSize, size_t frameObjSize);
@@ -59,24 +102,27 @@ public:
     virtual ~FrameBufferManagerBase() noexcept;
     void   reclaimBuffer(void *buffer) override;
     void   releaseIdleBuffer() override;
+    void   reserveBuffers(uint32_t count) override;
     size_t getFrameDataBufferSize() override {
         return frameDataBufferSize_;
     }
 
-    std::unique_lock<std::recursive_mutex> lockBuffers();
-
 protected:
     uint8_t *acquireBuffer();
 
 protected:
-    std::recursive_mutex mutex_;
-    size_t               frameDataBufferSize_;
-    size_t               frameObjSize_;
-    size_t               frameTotalSize_;
+    size_t frameDataBufferSize_;
+    size_t frameObjSize_;
+    size_t frameTotalSize_;
 
 private:
-    std::vector<uint8_t *>                availableFrameBuffers_;
-    std::shared_ptr<FrameMemoryAllocator> frameMemoryAllocator_;
+    // Idle buffers are kept in fixed slots: a slot index moves between the empty slot stack and the idle buffer stack, so that both acquire and
+    // reclaim are O(1) lock-free operations. If there is no empty slot (too many idle buffers), the reclaimed buffer is released directly.
+    std::unique_ptr<std::atomic<uint8_t *>[]> idleBufferSlots_;
+    LockFreeIndexStack                        emptySlots_;
+    LockFreeIndexStack                        idleBuffers_;
+    std::atomic<uint32_t>                     idleBufferCount_;
+    std::shared_ptr<FrameMemoryAllocator>     frameMemoryAllocator_;
 };
 
 class FrameMemoryPool;
@@ -106,18 +152,14 @@ private:
             // 2. Custom deletion function construction of shared_ptr
             // 3. You need to pass bufMgr into the smart pointer custom deletion function lambda to add a reference, otherwise bufMgr may be destructed first
             // when frame->~T(), the memory will be recycled in advance, and the frame destructor will crash.
+            // 4. The buffer must be reclaimed after the whole frame object (include base class and members) has been destroyed, otherwise the buffer
+            // may be used to create a new frame while the destruction of the original frame is still in progress. So the frame is constructed with an
+            // empty reclaim function and the buffer is reclaimed in the custom shared_ptr delete function.
             auto bufMgr = this->shared_from_this();
-            return std::shared_ptr<T>(new(bufferPtr) T(bufferPtr + frameObjSize_ + alignOffset, frameDataBufferSize_,
-                                                       [bufMgr, bufferPtr]() {  // Customized frame buffer release function
-                                                           bufMgr->reclaimBuffer(bufferPtr);
-                                                       }),
-                                      [bufMgr](T *frame) mutable {  // Custom shared_pt delete function
-                                          // Purpose of locking: To solve the problem of the buffer being used to create a new frame just after it is returned,
-                                          // causing the subsequent destruction operation of the original frame to modify the new frame and causing the program
-                                          // to crash.
-                                          auto lk = bufMgr->lockBuffers();
+            return std::shared_ptr<T>(new(bufferPtr) T(bufferPtr + frameObjSize_ + alignOffset, frameDataBufferSize_, []() {}),
+                                      [bufMgr, bufferPtr](T *frame) mutable {  // Custom shared_pt delete function
                                           frame->~T();
-                                          lk.unlock();
+                                          bufMgr->reclaimBuffer(bufferPtr);
                                           bufMgr.reset();
                                       });
         }
@@ -26,6 +26,20 @@ std::shared_ptr<Frame> FrameFactory::createFrame(OBFrameType frameType, OBFormat
     return frame;
 }
 
+// A frame to copy the data of the other frame into; the accel/gyro frames carrying a batch of samples are larger than the size derived from the profile,
+// and the points frames have neither a stream type nor a size derived from the profile
+static std::shared_ptr<Frame> createFrameForCopy(const std::shared_ptr<const Frame> &frame) {
+    if((frame->is<AccelFrame>() || frame->is<GyroFrame>()) && frame->getDataSize() > sizeof(AccelFrame::Data)) {
+        return FrameFactory::createFrameFromStreamProfile(frame->getStreamProfile(), frame->getDataSize());
+    }
+    if(frame->is<PointsFrame>()) {
+        auto newFrame = FrameFactory::createFrame(OB_FRAME_POINTS, frame->getFormat(), frame->getDataBufSize());
+        newFrame->setStreamProfile(frame->getStreamProfile());
+        return newFrame;
+    }
+    return FrameFactory::createFrameFromStreamProfile(frame->getStreamProfile());
+}
+
 std::shared_ptr<Frame> FrameFactory::createFrameFromOtherFrame(std::shared_ptr<const Frame> frame, bool shouldCopyData) {
     if(frame->is<FrameSet>()) {
         auto newFrameSet = createFrameSet();
@@ -34,7 +48,7 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromOtherFrame(std::shared_ptr<c
         for(uint32_t i = 0; i < frameCount; i++) {
             std::shared_ptr<const Frame> oldFrame = frameSet->getFrame(i);
             if(shouldCopyData) {
-                auto newFrame = createFrameFromStreamProfile(oldFrame->getStreamProfile());
+                auto newFrame = createFrameForCopy(oldFrame);
                 newFrame->updateData(oldFrame->getData(), oldFrame->getDataSize());
                 newFrame->copyInfoFromOther(oldFrame);
                 newFrameSet->pushFrame(std::move(newFrame));
@@ -46,7 +60,7 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromOtherFrame(std::shared_ptr<c
         return newFrameSet;
     }
     else {
-        auto newFrame = createFrameFromStreamProfile(frame->getStreamProfile());
+        auto newFrame = shouldCopyData ? createFrameForCopy(frame) : createFrameFromStreamProfile(frame->getStreamProfile());
         if(shouldCopyData) {
             newFrame->updateData(frame->getData(), frame->getDataSize());
         }
@@ -55,6 +69,35 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromOtherFrame(std::shared_ptr<c
     }
 }
 
+std::shared_ptr<Frame> FrameFactory::cloneFrame(std::shared_ptr<const Frame> frame) {
+    if(frame->is<FrameSet>()) {
+        auto newFrameSet = createFrameSet();
+        auto frameSet    = frame->as<FrameSet>();
+        auto frameCount  = frameSet->getCount();
+        for(uint32_t i = 0; i < frameCount; i++) {
+            newFrameSet->pushFrame(cloneFrame(frameSet->getFrame(i)));
+        }
+        return newFrameSet;
+    }
+
+    auto newFrame = createDataHolderFrame(frame->getType(), 0);
+    newFrame->shareData(frame);
+    newFrame->setStreamProfile(frame->getStreamProfile());
+    newFrame->copyInfoFromOther(frame);
+    return newFrame;
+}
+
+std::shared_ptr<Frame> FrameFactory::createDataHolderFrame(OBFrameType frameType, size_t dataBufSize) {
+    auto memoryPool    = FrameMemoryPool::getInstance();
+    auto bufferManager = memoryPool->createFrameBufferManager(frameType, dataBufSize);
+
+    auto frame = bufferManager->acquireFrame();
+    if(frame == nullptr) {
+        throw libobsensor::memory_exception("Failed to create frame, out of memory or other memory allocation error.");
+    }
+    return frame;
+}
+
 std::shared_ptr<Frame> FrameFactory::createVideoFrame(OBFrameType frameType, OBFormat frameFormat, uint32_t width, uint32_t height, uint32_t strideBytes) {
     if(frameType == OB_FRAME_UNKNOWN || frameType == OB_FRAME_ACCEL || frameType == OB_FRAME_GYRO || frameType == OB_FRAME_SET) {
         throw libobsensor::invalid_value_exception("Invalid frame type for video frame.");
@@ -167,9 +210,27 @@ std::shared_ptr<Frame> FrameFactory::createFrameFromStreamProfile(std::shared_pt
     return frame;
 }
 
+std::shared_ptr<Frame> FrameFactory::createFrameFromStreamProfile(std::shared_ptr<const StreamProfile> sp, size_t dataSize) {
+    auto memoryPool    = libobsensor::FrameMemoryPool::getInstance();
+    auto frameType     = utils::mapStreamTypeToFrameType(sp->getType());
+    auto bufferManager = memoryPool->createFrameBufferManager(frameType, dataSize);
+
+    auto frame = bufferManager->acquireFrame();
+    if(frame == nullptr) {
+        throw libobsensor::memory_exception("Failed to create frame, out of memory or other memory allocation error.");
+    }
+
+    frame->setStreamProfile(sp);
+    return frame;
+}
+
 std::shared_ptr<FrameSet> FrameFactory::createFrameSet() {
+    return createFrameSet(OB_FRAME_TYPE_COUNT);
+}
+
+std::shared_ptr<FrameSet> FrameFactory::createFrameSet(uint32_t maxFrameCount) {
     auto memoryPool            = libobsensor::FrameMemoryPool::getInstance();
-    auto frameSetBufferManager = memoryPool->createFrameBufferManager(OB_FRAME_SET, OB_FRAME_TYPE_COUNT * sizeof(std::shared_ptr<Frame>));
+    auto frameSetBufferManager = memoryPool->createFrameBufferManager(OB_FRAME_SET, maxFrameCount * sizeof(std::shared_ptr<Frame>));
 
     auto frame = frameSetBufferManager->acquireFrame();
     if(frame == nullptr) {
@@ -13,6 +13,8 @@ public:
     static std::shared_ptr<Frame> createFrame(OBFrameType frameType, OBFormat frameFormat, size_t datasize);
     static std::shared_ptr<Frame> createVideoFrame(OBFrameType frameType, OBFormat frameFormat, uint32_t width, uint32_t height, uint32_t strideBytes);
     static std::shared_ptr<Frame> createFrameFromOtherFrame(std::shared_ptr<const Frame> frame, bool shouldCopyData = false);
+    // A frame with the info of the other frame sharing its data, the data is only copied if the new frame is changed (see Frame::getDataMutable)
+    static std::shared_ptr<Frame> cloneFrame(std::shared_ptr<const Frame> frame);
 
     static std::shared_ptr<Frame> createFrameFromUserBuffer(OBFrameType frameType, OBFormat format, uint8_t *buffer, size_t bufferSize,
                                                             FrameBufferReclaimFunc bufferReclaimFunc);
@@ -20,8 +22,17 @@ public:
                                                                  uint8_t *buffer, size_t bufferSize, FrameBufferReclaimFunc bufferReclaimFunc);
 
     static std::shared_ptr<Frame> createFrameFromStreamProfile(std::shared_ptr<const StreamProfile> sp);
+    // A frame with a data buffer of dataSize bytes instead of the size derived from the stream profile, such as an accel/gyro frame carrying a batch of samples
+    static std::shared_ptr<Frame> createFrameFromStreamProfile(std::shared_ptr<const StreamProfile> sp, size_t dataSize);
 
     static std::shared_ptr<FrameSet> createFrameSet();
+    // A frameset with room for maxFrameCount frames, used with FrameSet::appendFrame to hold several frames of the same type
+    static std::shared_ptr<FrameSet> createFrameSet(uint32_t maxFrameCount);
+
+private:
+    friend class Frame;
+    // A bare frame of the frame type owning a data buffer of dataBufSize bytes, used to hold the data detached from the shared data
+    static std::shared_ptr<Frame> createDataHolderFrame(OBFrameType frameType, size_t dataBufSize);
 };
 }  // namespace libobsensor
 
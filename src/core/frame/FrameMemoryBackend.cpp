@@ -0,0 +1,259 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "FrameMemoryBackend.hpp"
+
+#include "environment/EnvConfig.hpp"
+#include "logger/Logger.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+namespace libobsensor {
+
+#define HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)               // 2MB
+#define DEFAULT_ARENA_REGION_SIZE ((size_t)64 * 1024 * 1024)  // 64MB
+#define ARENA_SMALL_BLOCK_ALIGN 64                             // cache line size
+#define ARENA_LARGE_BLOCK_ALIGN 4096                           // page size
+
+static size_t alignUp(size_t size, size_t align) {
+    return (size + align - 1) / align * align;
+}
+
+uint8_t *MallocFrameMemoryBackend::allocate(size_t size) {
+    return (uint8_t *)malloc(size);
+}
+
+void MallocFrameMemoryBackend::deallocate(uint8_t *ptr, size_t size) {
+    (void)size;
+    free(ptr);
+}
+
+std::string MallocFrameMemoryBackend::getName() const {
+    return "Malloc";
+}
+
+ArenaFrameMemoryBackend::ArenaFrameMemoryBackend(size_t regionSize, int numaNode)
+    : regionSize_(alignUp(regionSize, HUGE_PAGE_SIZE)), numaNode_(numaNode) {
+    LOG_DEBUG("ArenaFrameMemoryBackend created! region size: {}MB, numa node: {}", regionSize_ / 1024 / 1024, numaNode_);
+}
+
+ArenaFrameMemoryBackend::~ArenaFrameMemoryBackend() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(auto &item: regions_) {
+        if(item.second.blockCount > 0) {
+            LOG_WARN("ArenaFrameMemoryBackend destroyed while still has {} buffers in use!", item.second.blockCount);
+        }
+        destroyRegion(item.second);
+    }
+    regions_.clear();
+}
+
+bool ArenaFrameMemoryBackend::isSupported() {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string ArenaFrameMemoryBackend::getName() const {
+    return "Arena";
+}
+
+size_t ArenaFrameMemoryBackend::getMappedSize() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t                      size = 0;
+    for(auto &item: regions_) {
+        size += item.second.size;
+    }
+    return size;
+}
+
+uint8_t *ArenaFrameMemoryBackend::allocate(size_t size) {
+    auto align     = size < ARENA_LARGE_BLOCK_ALIGN ? ARENA_SMALL_BLOCK_ALIGN : ARENA_LARGE_BLOCK_ALIGN;
+    auto blockSize = alignUp(size, align);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(int attempt = 0; attempt < 2; attempt++) {
+        // Best fit: the smallest free block which can hold the buffer at an aligned address, the frame buffers of a stream always have the same
+        // size so it is usually an exact fit
+        for(auto iter = freeBySize_.lower_bound(blockSize); iter != freeBySize_.end(); iter++) {
+            auto freePtr  = iter->second;
+            auto freeSize = iter->first;
+            auto ptr      = (uint8_t *)alignUp((size_t)freePtr, align);
+            if(ptr + blockSize > freePtr + freeSize) {
+                continue;
+            }
+
+            auto &region = findRegion(freePtr)->second;
+            removeFreeBlock(region, region.freeBlocks.find(freePtr));
+            if(ptr > freePtr) {
+                addFreeBlock(region, freePtr, ptr - freePtr);
+            }
+            if(ptr + blockSize < freePtr + freeSize) {
+                addFreeBlock(region, ptr + blockSize, freePtr + freeSize - ptr - blockSize);
+            }
+            region.blockCount++;
+            return ptr;
+        }
+
+        // No free block fits: map a new region and take the buffer from it
+        if(attempt == 0 && createRegion(blockSize) == regions_.end()) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+void ArenaFrameMemoryBackend::deallocate(uint8_t *ptr, size_t size) {
+    auto blockSize = alignUp(size, size < ARENA_LARGE_BLOCK_ALIGN ? ARENA_SMALL_BLOCK_ALIGN : ARENA_LARGE_BLOCK_ALIGN);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        iter = findRegion(ptr);
+    if(iter == regions_.end()) {
+        LOG_ERROR("ArenaFrameMemoryBackend: deallocate a buffer not belong to the arena! ptr=0x{:x}", (uint64_t)ptr);
+        return;
+    }
+
+    auto &region = iter->second;
+    region.blockCount--;
+    addFreeBlock(region, ptr, blockSize);
+    if(region.blockCount == 0) {
+        // All buffers of the region are released: keep one empty region as spare to avoid re-mapping when the pool refills, and return the memory
+        // of the others to system.
+        bool hasSpare = std::any_of(regions_.begin(), regions_.end(), [&region](const std::pair<uint8_t *const, Region> &item) {
+            return &item.second != &region && item.second.blockCount == 0;
+        });
+        if(hasSpare) {
+            while(!region.freeBlocks.empty()) {
+                removeFreeBlock(region, region.freeBlocks.begin());
+            }
+            destroyRegion(region);
+            regions_.erase(iter);
+        }
+    }
+}
+
+ArenaFrameMemoryBackend::RegionIterator ArenaFrameMemoryBackend::createRegion(size_t minSize) {
+#ifdef __linux__
+    Region region  = {};
+    region.size    = std::max(regionSize_, alignUp(minSize, HUGE_PAGE_SIZE));
+    region.hugeTlb = true;
+
+    // Use the reserved huge pages first (/proc/sys/vm/nr_hugepages), fall back to normal pages and let the kernel promote them to transparent huge
+    // pages.
+    void *ptr = mmap(nullptr, region.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(ptr == MAP_FAILED) {
+        region.hugeTlb = false;
+        ptr            = mmap(nullptr, region.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(ptr == MAP_FAILED) {
+            LOG_ERROR("ArenaFrameMemoryBackend: mmap region failed! size={}MB, error={}", region.size / 1024 / 1024, strerror(errno));
+            return regions_.end();
+        }
+        madvise(ptr, region.size, MADV_HUGEPAGE);
+    }
+
+    // The memory policy must be set before the pages are touched. The kernel reads maxnode - 1 bits of the node mask, so one more than the mask bits.
+    if(numaNode_ >= 0) {
+        unsigned long nodeMask = 1UL << numaNode_;
+        if(syscall(SYS_mbind, ptr, region.size, MPOL_BIND, &nodeMask, sizeof(nodeMask) * 8 + 1, 0) != 0) {
+            LOG_WARN("ArenaFrameMemoryBackend: bind region to numa node {} failed, error={}", numaNode_, strerror(errno));
+        }
+    }
+
+    region.base = (uint8_t *)ptr;
+    LOG_DEBUG("ArenaFrameMemoryBackend: new region mapped, size={}MB, huge tlb={}", region.size / 1024 / 1024, region.hugeTlb);
+    auto iter = regions_.insert({ region.base, region }).first;
+    addFreeBlock(iter->second, region.base, region.size);
+    return iter;
+#else
+    (void)minSize;
+    LOG_ERROR("ArenaFrameMemoryBackend is not supported on this platform!");
+    return regions_.end();
+#endif
+}
+
+void ArenaFrameMemoryBackend::destroyRegion(Region &region) {
+#ifdef __linux__
+    munmap(region.base, region.size);
+#endif
+    region.base = nullptr;
+}
+
+ArenaFrameMemoryBackend::RegionIterator ArenaFrameMemoryBackend::findRegion(uint8_t *ptr) {
+    auto iter = regions_.upper_bound(ptr);
+    if(iter == regions_.begin()) {
+        return regions_.end();
+    }
+    iter--;
+    if(ptr >= iter->second.base + iter->second.size) {
+        return regions_.end();
+    }
+    return iter;
+}
+
+void ArenaFrameMemoryBackend::addFreeBlock(Region &region, uint8_t *ptr, size_t size) {
+    // Merge with the free blocks right after and right before, which are in the same region since the lookup is per region
+    auto next = region.freeBlocks.lower_bound(ptr);
+    if(next != region.freeBlocks.end() && next->first == ptr + size) {
+        size += next->second;
+        removeFreeBlock(region, next);
+    }
+    auto prev = region.freeBlocks.lower_bound(ptr);
+    if(prev != region.freeBlocks.begin()) {
+        prev--;
+        if(prev->first + prev->second == ptr) {
+            ptr = prev->first;
+            size += prev->second;
+            removeFreeBlock(region, prev);
+        }
+    }
+    region.freeBlocks[ptr] = size;
+    freeBySize_.insert({ size, ptr });
+}
+
+void ArenaFrameMemoryBackend::removeFreeBlock(Region &region, std::map<uint8_t *, size_t>::iterator iter) {
+    auto range = freeBySize_.equal_range(iter->second);
+    for(auto it = range.first; it != range.second; it++) {
+        if(it->second == iter->first) {
+            freeBySize_.erase(it);
+            break;
+        }
+    }
+    region.freeBlocks.erase(iter);
+}
+
+std::unique_ptr<IFrameMemoryBackend> createFrameMemoryBackend() {
+    auto        envConfig = EnvConfig::getInstance();
+    std::string backend   = "Malloc";
+    envConfig->getStringValue("Memory.FrameMemoryBackend", backend);
+
+    if(backend == "Arena") {
+        if(ArenaFrameMemoryBackend::isSupported()) {
+            int numaNode = -1;
+            envConfig->getIntValue("Memory.ArenaNumaNode", numaNode);
+            if(numaNode >= 64) {
+                LOG_WARN("Memory.ArenaNumaNode {} is out of range, the arena memory will not be bound to numa node", numaNode);
+                numaNode = -1;
+            }
+            return std::unique_ptr<IFrameMemoryBackend>(new ArenaFrameMemoryBackend(DEFAULT_ARENA_REGION_SIZE, numaNode));
+        }
+        LOG_WARN("Arena frame memory backend is not supported on this platform, use Malloc instead");
+    }
+    else if(backend != "Malloc") {
+        LOG_WARN("Invalid Memory.FrameMemoryBackend: {}, use Malloc instead", backend);
+    }
+    return std::unique_ptr<IFrameMemoryBackend>(new MallocFrameMemoryBackend());
+}
+
+}  // namespace libobsensor
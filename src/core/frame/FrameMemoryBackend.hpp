@@ -0,0 +1,91 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief The system memory source of FrameMemoryAllocator.
+ *
+ * The backend only provides the memory, the usage accounting (Memory.MaxFrameBufferSize) is done by FrameMemoryAllocator.
+ */
+class IFrameMemoryBackend {
+public:
+    virtual ~IFrameMemoryBackend() noexcept = default;
+
+    virtual uint8_t    *allocate(size_t size)                = 0;  // return nullptr on failure
+    virtual void        deallocate(uint8_t *ptr, size_t size) = 0;
+    virtual std::string getName() const                       = 0;
+};
+
+// Allocate each frame buffer by malloc, the default backend
+class MallocFrameMemoryBackend : public IFrameMemoryBackend {
+public:
+    uint8_t    *allocate(size_t size) override;
+    void        deallocate(uint8_t *ptr, size_t size) override;
+    std::string getName() const override;
+};
+
+/**
+ * @brief Carve frame buffers out of large mmap'd regions.
+ *
+ * The regions are backed by 2MB huge pages if the system has huge pages reserved (falling back to transparent huge pages), and are bound to the
+ * configured NUMA node so that the frame data stays local to the processing threads. A released buffer is merged with the free memory next to it,
+ * and an allocation takes the smallest free block of all regions that fits it (split if larger), so a smaller frame reuses the memory released by a
+ * larger one after a resolution change. Once all buffers of a region are released, the region is unmapped, except one empty region kept as spare.
+ *
+ * Only supported on Linux.
+ */
+class ArenaFrameMemoryBackend : public IFrameMemoryBackend {
+public:
+    // numaNode: the NUMA node to bind the memory to, -1 for no binding
+    ArenaFrameMemoryBackend(size_t regionSize, int numaNode);
+    ~ArenaFrameMemoryBackend() noexcept override;
+
+    uint8_t    *allocate(size_t size) override;
+    void        deallocate(uint8_t *ptr, size_t size) override;
+    std::string getName() const override;
+
+    // Total size of the mapped regions
+    size_t getMappedSize();
+
+    static bool isSupported();
+
+private:
+    struct Region {
+        uint8_t                    *base;
+        size_t                      size;
+        uint32_t                    blockCount;  // number of buffers in use
+        bool                        hugeTlb;
+        std::map<uint8_t *, size_t> freeBlocks;  // free memory by address, the neighbouring blocks are always merged
+    };
+    typedef std::map<uint8_t *, Region>::iterator RegionIterator;
+
+    RegionIterator createRegion(size_t minSize);
+    void           destroyRegion(Region &region);
+    RegionIterator findRegion(uint8_t *ptr);
+    void           addFreeBlock(Region &region, uint8_t *ptr, size_t size);
+    void           removeFreeBlock(Region &region, std::map<uint8_t *, size_t>::iterator iter);
+
+private:
+    const size_t regionSize_;
+    const int    numaNode_;
+
+    std::mutex                       mutex_;
+    std::map<uint8_t *, Region>      regions_;     // key: region base address
+    std::multimap<size_t, uint8_t *> freeBySize_;  // free blocks of all regions by size, for the best fit lookup
+};
+
+// Create the backend configured by Memory.FrameMemoryBackend
+std::unique_ptr<IFrameMemoryBackend> createFrameMemoryBackend();
+
+}  // namespace libobsensor
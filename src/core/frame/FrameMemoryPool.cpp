@@ -123,6 +123,22 @@ std::shared_ptr<IFrameBufferManager> FrameMemoryPool::createFrameBufferManager(O
     return createFrameBufferManager(type, frameBufferSize);
 }
 
+void FrameMemoryPool::reserveFrameBuffers(OBFrameType type, std::shared_ptr<const StreamProfile> streamProfile, uint32_t count) {
+    auto bufMgr = createFrameBufferManager(type, streamProfile);
+    if(bufMgr) {
+        bufMgr->reserveBuffers(count);
+    }
+}
+
+void FrameMemoryPool::reserveFrameSetBuffers(uint32_t count) {
+    auto bufMgr = createFrameBufferManager(OB_FRAME_SET, FRAME_SET_DATA_BUFFER_SIZE);
+    bufMgr->reserveBuffers(count);
+}
+
+OBFrameMemoryPoolStatistics FrameMemoryPool::getStatistics() const {
+    return FrameMemoryAllocator::getInstance()->getStatistics();
+}
+
 void FrameMemoryPool::freeIdleMemory() {
     std::unique_lock<std::mutex> lock(bufMgrMapMutex_);
     auto                         iter = bufMgrMap_.begin();
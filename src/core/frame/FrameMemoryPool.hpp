@@ -11,6 +11,9 @@
 #include "FrameBufferManager.hpp"
 #include "logger/Logger.hpp"
 
+// The frame set stores the shared pointers of the frames it contains in the frame data buffer
+#define FRAME_SET_DATA_BUFFER_SIZE (OB_FRAME_TYPE_COUNT * sizeof(std::shared_ptr<Frame>))
+
 namespace libobsensor {
 
 struct FrameBufferManagerInfo {
@@ -43,8 +46,14 @@ public:
     std::shared_ptr<IFrameBufferManager> createFrameBufferManager(OBFrameType type, std::shared_ptr<const StreamProfile> streamProfile);
     std::shared_ptr<IFrameBufferManager> createFrameBufferManager(OBFrameType type, OBFormat format, uint32_t width, uint32_t height);
 
+    // Pre-allocate the frame buffers, so that the first count frames acquired from the buffer manager do not allocate memory
+    void reserveFrameBuffers(OBFrameType type, std::shared_ptr<const StreamProfile> streamProfile, uint32_t count);
+    void reserveFrameSetBuffers(uint32_t count);
+
     void freeIdleMemory();
 
+    OBFrameMemoryPoolStatistics getStatistics() const;
+
 private:
     std::map<FrameBufferManagerInfo, std::shared_ptr<IFrameBufferManager>, FrameBufferManagerInfoCompare> bufMgrMap_;
     std::mutex                                                                                            bufMgrMapMutex_;
@@ -4,14 +4,19 @@
 #pragma once
 
 #include "frame/Frame.hpp"
+#include "logger/Logger.hpp"
+#include "utils/TaskExecutor.hpp"
 
 #include <queue>
 
 namespace libobsensor {
 
+#define FRAME_QUEUE_EXECUTOR_BATCH_SIZE 4  // max frames called back in one executor task, to share the executor threads with the other queues
+
 template <typename T = Frame> class FrameQueue {
 public:
-    explicit FrameQueue(size_t capacity) : capacity_(capacity), stoped_(true), stopping_(false), callback_(nullptr), flushing_(false) {}
+    explicit FrameQueue(size_t capacity)
+        : capacity_(capacity), stoped_(true), stopping_(false), callback_(nullptr), flushing_(false), executor_(nullptr), draining_(false) {}
 
     ~FrameQueue() noexcept {
         reset();
@@ -44,6 +49,9 @@ public:
         }
         queue_.push(frame);
         condition_.notify_all();
+        if(executor_ && !stoped_) {
+            scheduleDrain();
+        }
         return true;
     }
 
@@ -70,14 +78,30 @@ public:
     }
 
     // async methods
+    // Call back the frames on the executor instead of a dedicated dequeue thread, the frames are still called back one by one in order.
+    // Must be set before start(), nullptr to use the dedicated thread.
+    void setExecutor(std::shared_ptr<TaskExecutor> executor) {
+        if(isStarted()) {
+            throw libobsensor::wrong_api_call_sequence_exception("FrameQueue have already started!");
+        }
+        executor_ = executor;
+    }
+
     void start(std::function<void(std::shared_ptr<T>)> callback) {  // start async dequeue
         if(isStarted()) {
             throw libobsensor::wrong_api_call_sequence_exception("FrameQueue have already started!");
         }
-        callback_      = callback;
-        stoped_        = false;
-        stopping_      = false;
-        flushing_      = false;
+        callback_ = callback;
+        stoped_   = false;
+        stopping_ = false;
+        flushing_ = false;
+        if(executor_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if(!queue_.empty()) {
+                scheduleDrain();
+            }
+            return;
+        }
         dequeueThread_ = std::thread([&] {
             std::unique_lock<std::mutex> lock(mutex_);
             while(true) {
@@ -103,6 +127,15 @@ public:
     }
 
     void flush() {  // stop until all frames are called back
+        if(executor_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            flushing_ = true;
+            if(!isDrainThread()) {  // called from the callback, the drain task goes on calling back the rest frames after it returns
+                condition_.wait(lock, [this] { return (queue_.empty() && !draining_) || stopping_; });
+            }
+            stoped_ = true;
+            return;
+        }
         {
             std::unique_lock<std::mutex> lock(mutex_);
             flushing_ = true;
@@ -114,6 +147,19 @@ public:
     }
 
     void stop() {  // stop immediately
+        if(executor_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stopping_ = true;
+            condition_.notify_all();
+            if(!isDrainThread()) {  // called from the callback, the drain task finishes once it returns
+                condition_.wait(lock, [this] { return !draining_; });  // wait for the frame being called back
+            }
+            while(!queue_.empty()) {
+                queue_.pop();
+            }
+            stoped_ = true;
+            return;
+        }
         {
             std::unique_lock<std::mutex> lock(mutex_);
             stopping_ = true;
@@ -138,6 +184,47 @@ public:
         stoped_   = true;
     }
 
+private:
+    // Must be called with mutex_ locked. At most one drain task is scheduled at a time, which guarantees the in-order callback.
+    void scheduleDrain() {
+        if(draining_ || stopping_) {
+            return;
+        }
+        draining_ = true;
+        executor_->post([this] { drain(); });
+    }
+
+    // Must be called with mutex_ locked. Returns true if called from the callback on the running drain task, which must not wait for itself.
+    bool isDrainThread() const {
+        return draining_ && drainThreadId_ == std::this_thread::get_id();
+    }
+
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        drainThreadId_ = std::this_thread::get_id();
+        for(int i = 0; i < FRAME_QUEUE_EXECUTOR_BATCH_SIZE && !queue_.empty() && !stopping_; i++) {
+            std::shared_ptr<T> frame = queue_.front();
+            queue_.pop();
+            lock.unlock();
+            if(frame) {
+                try {
+                    callback_(frame);
+                }
+                catch(...) {  // the drain state must be kept consistent, otherwise stop() will be blocked forever
+                    LOG_WARN("FrameQueue: exception caught while calling back frame on executor, the frame is dropped");
+                }
+            }
+            lock.lock();
+        }
+        drainThreadId_ = std::thread::id();
+        if(!queue_.empty() && !stopping_) {
+            executor_->post([this] { drain(); });  // re-schedule to let the other queues run
+            return;
+        }
+        draining_ = false;
+        condition_.notify_all();
+    }
+
 private:
     std::mutex                     mutex_;
     std::condition_variable        condition_;
@@ -149,6 +236,10 @@ private:
     std::atomic<bool>                       stopping_;
     std::function<void(std::shared_ptr<T>)> callback_;
     std::atomic<bool>                       flushing_;
+
+    std::shared_ptr<TaskExecutor> executor_;
+    bool                          draining_;       // a drain task is scheduled or running on the executor, guarded by mutex_
+    std::thread::id               drainThreadId_;  // the thread running the drain task, guarded by mutex_
 };
 
 }  // namespace libobsensor
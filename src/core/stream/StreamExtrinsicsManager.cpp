@@ -6,6 +6,9 @@
 #include "exception/ObException.hpp"
 #include "utils/Utils.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace libobsensor {
 
 OBExtrinsic multiplyExtrinsics(const OBExtrinsic &a, const OBExtrinsic &b) {
@@ -70,7 +73,7 @@ std::shared_ptr<StreamExtrinsicsManager> StreamExtrinsicsManager::getInstance()
     return instance;
 }
 
-StreamExtrinsicsManager::StreamExtrinsicsManager() {}
+StreamExtrinsicsManager::StreamExtrinsicsManager() : nextNodeId_(1), registerCountSinceClean_(0), profileCountAfterClean_(0) {}
 
 StreamExtrinsicsManager::~StreamExtrinsicsManager() noexcept = default;
 
@@ -80,24 +83,18 @@ void StreamExtrinsicsManager::registerExtrinsics(const std::shared_ptr<const Str
         throw invalid_value_exception("Invalid stream profile, from or to is null");
     }
 
-    std::unique_lock<std::recursive_mutex> lock(mutex_);
-    cleanExpiredStreamProfiles();  // clean expired stream profiles first
+    std::unique_lock<std::mutex> lock(mutex_);
+    // clean expired stream profiles first, amortized over the registrations as it walks all the stream profiles
+    if(++registerCountSinceClean_ > std::max<size_t>(profileCountAfterClean_, 64)) {
+        cleanExpiredStreamProfiles();
+    }
 
     // judge if already registered and if the extrinsics is the same
-    bool alreadyRegistered   = false;
-    bool differentExtrinsics = false;
-    try {
-        if(hasExtrinsics(from, to)) {
-            auto tryResult    = getExtrinsics(from, to);  // try to get the extrinsics
-            alreadyRegistered = true;
-            if(memcmp(&tryResult, &extrinsics, sizeof(OBExtrinsic)) != 0) {
-                differentExtrinsics = true;
-            }
-        }
-    }
-    catch(...) {
-        alreadyRegistered = false;
-    }
+    OBExtrinsic registeredExtrinsics;
+    auto        registeredFromId  = getStreamProfileId(from);
+    auto        registeredToId    = getStreamProfileId(to);
+    bool        alreadyRegistered = registeredFromId != 0 && registeredToId != 0 && findExtrinsics(registeredFromId, registeredToId, registeredExtrinsics);
+    bool        differentExtrinsics = alreadyRegistered && memcmp(&registeredExtrinsics, &extrinsics, sizeof(OBExtrinsic)) != 0;
 
     // if already registered, and the extrinsics is the same, then return
     if(alreadyRegistered && !differentExtrinsics) {
@@ -116,11 +113,11 @@ void StreamExtrinsicsManager::registerExtrinsics(const std::shared_ptr<const Str
         if(isIdentityExtrinsics) {
             // if the extrinsics is identity, we can just push the `from` stream profile to the list of `toId`
             streamProfileMap_[toId].push_back(std::weak_ptr<const StreamProfile>(from));
+            from->extrinsicsNodeId_ = toId;
         }
         else {
-            auto fromId = getOrRegisterStreamProfileId(from);                             // get or create the id of `from`
-            extrinsicsGraph_[fromId].push_back({ toId, extrinsics });                     // add the extrinsics to the graph: from -> to
-            extrinsicsGraph_[toId].push_back({ fromId, inverseExtrinsics(extrinsics) });  // add the inverse extrinsics to the graph: to -> from
+            auto fromId = getOrRegisterStreamProfileId(from);  // get or create the id of `from`
+            addExtrinsicsEdge(fromId, toId, extrinsics);
         }
     }
     else {
@@ -130,27 +127,42 @@ void StreamExtrinsicsManager::registerExtrinsics(const std::shared_ptr<const Str
         if(isIdentityExtrinsics) {
             if(fromId == 0) {
                 // if is identity extrinsics, and the `from` stream profile is not registered, we can just push the `from` stream profile to the list of `toId`
+                // the graph is not changed, so the cached extrinsics are still valid
                 streamProfileMap_[toId].push_back(std::weak_ptr<const StreamProfile>(from));
+                from->extrinsicsNodeId_ = toId;
             }
             else {
                 // if is identity extrinsics, and the `from` stream profile is registered, we need to move oll the stream profiles from `fromId` to `toId`
                 auto spList = streamProfileMap_[fromId];
                 for(auto it = spList.begin(); it != spList.end(); ++it) {
-                    streamProfileMap_[toId].push_back(*it);
+                    auto sp = it->lock();
+                    if(sp) {
+                        sp->extrinsicsNodeId_ = toId;
+                        streamProfileMap_[toId].push_back(*it);
+                    }
                 }
                 streamProfileMap_.erase(fromId);
 
                 // after moving the stream profiles, we need to update the extrinsics graph with the new id： `toId`
-                auto &extrPairVec = extrinsicsGraph_[fromId];
+                auto extrPairVec = extrinsicsGraph_[fromId];
                 for(auto &extrPair: extrPairVec) {
                     auto &toExtrPairVec = extrinsicsGraph_[extrPair.first];
-                    for(auto it = toExtrPairVec.begin(); it != toExtrPairVec.end(); ++it) {
+                    for(auto it = toExtrPairVec.begin(); it != toExtrPairVec.end();) {
+                        if(it->first == fromId && extrPair.first == toId) {
+                            it = toExtrPairVec.erase(it);  // would be an edge from `toId` to itself
+                            continue;
+                        }
                         if(it->first == fromId) {
                             it->first = toId;
                         }
+                        ++it;
+                    }
+                    if(extrPair.first != toId) {
+                        extrinsicsGraph_[toId].push_back(extrPair);  // `from` and `to` share the extrinsics to the other nodes
                     }
                 }
                 extrinsicsGraph_.erase(fromId);
+                extrinsicsCache_.clear();
             }
         }
         else {
@@ -159,8 +171,7 @@ void StreamExtrinsicsManager::registerExtrinsics(const std::shared_ptr<const Str
                 // if the `from` stream profile is not registered, we need to register it first
                 fromId = getOrRegisterStreamProfileId(from);
             }
-            extrinsicsGraph_[fromId].push_back({ toId, extrinsics });                     // add the extrinsics to the graph: from -> to
-            extrinsicsGraph_[toId].push_back({ fromId, inverseExtrinsics(extrinsics) });  // add the inverse extrinsics to the graph: to -> from
+            addExtrinsicsEdge(fromId, toId, extrinsics);
         }
     }
 }
@@ -174,8 +185,8 @@ bool StreamExtrinsicsManager::hasExtrinsics(std::shared_ptr<const StreamProfile>
         return false;
     }
 
-    std::unique_lock<std::recursive_mutex> lock(mutex_);
-    auto                                   fromId = getStreamProfileId(from);
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto                         fromId = getStreamProfileId(from);
     if(fromId == 0) {
         return false;
     }
@@ -184,16 +195,8 @@ bool StreamExtrinsicsManager::hasExtrinsics(std::shared_ptr<const StreamProfile>
         return false;
     }
 
-    if(fromId == toId) {
-        return true;
-    }
-
-    std::vector<std::pair<uint64_t, OBExtrinsic>> path = { { fromId, IdentityExtrinsics } };
-    if(!searchPath(path, fromId, toId)) {
-        return false;
-    }
-
-    return true;
+    OBExtrinsic extrinsics;
+    return findExtrinsics(fromId, toId, extrinsics);
 }
 
 OBExtrinsic StreamExtrinsicsManager::getExtrinsics(std::shared_ptr<const StreamProfile> from, std::shared_ptr<const StreamProfile> to) {
@@ -201,8 +204,8 @@ OBExtrinsic StreamExtrinsicsManager::getExtrinsics(std::shared_ptr<const StreamP
         throw invalid_value_exception("Invalid stream profile");
     }
 
-    std::unique_lock<std::recursive_mutex> lock(mutex_);
-    auto                                   fromId = getStreamProfileId(from);
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto                         fromId = getStreamProfileId(from);
     if(fromId == 0) {
         throw invalid_value_exception("From Stream profile not registered!");
     }
@@ -210,13 +213,30 @@ OBExtrinsic StreamExtrinsicsManager::getExtrinsics(std::shared_ptr<const StreamP
     if(toId == 0) {
         throw invalid_value_exception("To Stream profile not registered!");
     }
+
+    OBExtrinsic extrinsics;
+    if(!findExtrinsics(fromId, toId, extrinsics)) {
+        throw invalid_value_exception(utils::string::to_string() << "Can not find path to calculate the extrinsics from" << fromId << "to" << toId);
+    }
+    return extrinsics;
+}
+
+// Called with mutex_ locked
+bool StreamExtrinsicsManager::findExtrinsics(uint64_t fromId, uint64_t toId, OBExtrinsic &extrinsics) {
     if(fromId == toId) {
-        return IdentityExtrinsics;
+        extrinsics = IdentityExtrinsics;
+        return true;
+    }
+
+    auto iter = extrinsicsCache_.find({ fromId, toId });
+    if(iter != extrinsicsCache_.end()) {
+        extrinsics = iter->second;
+        return true;
     }
 
     std::vector<std::pair<uint64_t, OBExtrinsic>> path = { { fromId, IdentityExtrinsics } };
     if(!searchPath(path, fromId, toId)) {
-        throw invalid_value_exception(utils::string::to_string() << "Can not find path to calculate the extrinsics from" << fromId << "to" << toId);
+        return false;
     }
 
     // LOG_TRACE("Extrinsics path:");
@@ -227,26 +247,23 @@ OBExtrinsic StreamExtrinsicsManager::getExtrinsics(std::shared_ptr<const StreamP
     //     }
     //     LOG_TRACE(" - {} -> {} ", iter->first, target->first);
     // }
-    if(path.size() == 2) {
-        return path[1].second;
-    }
-
-    // Calculate the extrinsics according to the path
-    auto extrinsics = calculateExtrinsics(path);
 
-    // register the extrinsics `from`->`to` directly to avoid redundant calculation
-    // registerExtrinsics(from, to, extrinsics);
-    extrinsicsGraph_[fromId].push_back({ toId, extrinsics });                     // add the extrinsics to the graph: from -> to
-    extrinsicsGraph_[toId].push_back({ fromId, inverseExtrinsics(extrinsics) });  // add the inverse extrinsics to the graph: to -> from
-
-    return extrinsics;
+    // Calculate the extrinsics according to the path, and cache it to avoid redundant searching and calculation
+    extrinsics = path.size() == 2 ? path[1].second : calculateExtrinsics(path);
+    extrinsicsCache_[{ fromId, toId }] = extrinsics;
+    extrinsicsCache_[{ toId, fromId }] = inverseExtrinsics(extrinsics);
+    return true;
 }
 
 bool StreamExtrinsicsManager::searchPath(std::vector<std::pair<uint64_t, OBExtrinsic>> &path, uint64_t fromId, uint64_t toId) const {
 
     // LOG_TRACE("searchPath: {} -> {}", fromId, toId);
     // Check if the from node is directly connected to the to node
-    auto extList = extrinsicsGraph_.at(fromId);
+    auto extIter = extrinsicsGraph_.find(fromId);
+    if(extIter == extrinsicsGraph_.end()) {
+        return false;
+    }
+    const auto &extList = extIter->second;
     for(const auto &extPair: extList) {
         if(extPair.first == toId) {
             path.push_back(extPair);
@@ -285,6 +302,12 @@ bool StreamExtrinsicsManager::searchPath(std::vector<std::pair<uint64_t, OBExtri
     return false;
 }
 
+void StreamExtrinsicsManager::addExtrinsicsEdge(uint64_t fromId, uint64_t toId, const OBExtrinsic &extrinsics) {
+    extrinsicsGraph_[fromId].push_back({ toId, extrinsics });                     // add the extrinsics to the graph: from -> to
+    extrinsicsGraph_[toId].push_back({ fromId, inverseExtrinsics(extrinsics) });  // add the inverse extrinsics to the graph: to -> from
+    extrinsicsCache_.clear();
+}
+
 void StreamExtrinsicsManager::eraseStreamProfile(std::shared_ptr<const StreamProfile> sp) {
     if(!sp) {
         return;
@@ -307,6 +330,7 @@ void StreamExtrinsicsManager::eraseStreamProfile(std::shared_ptr<const StreamPro
             ++iter;
         }
     }
+    sp->extrinsicsNodeId_ = 0;
 
     // If the list is empty, erase the node
     if(spListIter->second.empty()) {
@@ -315,6 +339,21 @@ void StreamExtrinsicsManager::eraseStreamProfile(std::shared_ptr<const StreamPro
     }
 }
 
+// Erase the node and unregister its stream profiles
+void StreamExtrinsicsManager::eraseNode(uint64_t id) {
+    auto spListIter = streamProfileMap_.find(id);
+    if(spListIter != streamProfileMap_.end()) {
+        for(auto &weakSp: spListIter->second) {
+            auto sp = weakSp.lock();
+            if(sp) {
+                sp->extrinsicsNodeId_ = 0;
+            }
+        }
+        streamProfileMap_.erase(spListIter);
+    }
+    eraseNodeFromExtrinsicsGraph(id);
+}
+
 void StreamExtrinsicsManager::eraseNodeFromExtrinsicsGraph(uint64_t id) {
     for(auto extIter = extrinsicsGraph_.begin(); extIter != extrinsicsGraph_.end();) {
         if(extIter->first == id) {  // erase the node
@@ -332,10 +371,13 @@ void StreamExtrinsicsManager::eraseNodeFromExtrinsicsGraph(uint64_t id) {
             ++extIter;
         }
     }
+    extrinsicsCache_.clear();
 }
 
 void StreamExtrinsicsManager::cleanExpiredStreamProfiles() {
-    for(auto profileEntry = streamProfileMap_.begin(); profileEntry != streamProfileMap_.end();) {
+    std::vector<uint64_t> erasedIds;
+    size_t                profileCount = 0;
+    for(auto profileEntry = streamProfileMap_.begin(); profileEntry != streamProfileMap_.end(); ++profileEntry) {
         auto &profileId            = profileEntry->first;
         auto &profileSharedPtrList = profileEntry->second;
         for(auto weakProfileIter = profileSharedPtrList.begin(); weakProfileIter != profileSharedPtrList.end();) {
@@ -348,54 +390,38 @@ void StreamExtrinsicsManager::cleanExpiredStreamProfiles() {
         }
 
         if(profileSharedPtrList.empty()) {
-            eraseNodeFromExtrinsicsGraph(profileId);
-            profileEntry = streamProfileMap_.erase(profileEntry);
+            erasedIds.push_back(profileId);
             continue;
         }
 
         if(profileSharedPtrList.size() == 1) {
             auto iter = extrinsicsGraph_.find(profileId);
             if(iter == extrinsicsGraph_.end() || iter->second.empty()) {
-                eraseNodeFromExtrinsicsGraph(profileId);
-                profileEntry = streamProfileMap_.erase(profileEntry);
+                erasedIds.push_back(profileId);
                 continue;
             }
         }
+        profileCount += profileSharedPtrList.size();
+    }
 
-        ++profileEntry;
+    for(auto id: erasedIds) {
+        eraseNode(id);
     }
+    registerCountSinceClean_ = 0;
+    profileCountAfterClean_  = profileCount;
 }
 
 uint64_t StreamExtrinsicsManager::getStreamProfileId(std::shared_ptr<const StreamProfile> profile) const {
-    for(auto spIter = streamProfileMap_.begin(); spIter != streamProfileMap_.end();) {
-        const auto &spList = spIter->second;
-        for(auto weakSp: spList) {
-            if(weakSp.lock() == profile) {
-                return spIter->first;
-            }
-        }
-        ++spIter;
-    }
-    return 0;  // return 0 if the stream profile is not registered
+    return profile->extrinsicsNodeId_;  // 0 if the stream profile is not registered
 }
 
 uint64_t StreamExtrinsicsManager::getOrRegisterStreamProfileId(std::shared_ptr<const StreamProfile> profile) {
-    for(auto spIter = streamProfileMap_.begin(); spIter != streamProfileMap_.end();) {
-        for(auto weakSp: spIter->second) {
-            if(weakSp.lock() == profile) {
-                return spIter->first;
-            }
-        }
-        ++spIter;
-    }
-    uint64_t uid = 1;
-    for(uint64_t i = 1; i < 0xFFFFFFFFFFFFFFFF; ++i) {
-        if(streamProfileMap_.find(i) == streamProfileMap_.end()) {
-            uid = i;  // find a unique id
-            break;
-        }
+    if(profile->extrinsicsNodeId_ != 0) {
+        return profile->extrinsicsNodeId_;
     }
+    uint64_t uid = nextNodeId_++;
     streamProfileMap_[uid].push_back(std::weak_ptr<const StreamProfile>(profile));
+    profile->extrinsicsNodeId_ = uid;
     return uid;
 }
 
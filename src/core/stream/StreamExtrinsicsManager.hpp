@@ -7,6 +7,8 @@
 #include "StreamProfile.hpp"
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace libobsensor {
@@ -32,17 +34,32 @@ public:
 private:
     void cleanExpiredStreamProfiles();
     void eraseStreamProfile(std::shared_ptr<const StreamProfile> sp);
+    void eraseNode(uint64_t id);
     void eraseNodeFromExtrinsicsGraph(uint64_t id);
+    void addExtrinsicsEdge(uint64_t fromId, uint64_t toId, const OBExtrinsic &extrinsics);
 
+    bool findExtrinsics(uint64_t fromId, uint64_t toId, OBExtrinsic &extrinsics);
     bool searchPath(std::vector<std::pair<uint64_t, OBExtrinsic>> &path, uint64_t fromId, uint64_t toId) const;
 
     uint64_t getOrRegisterStreamProfileId(std::shared_ptr<const StreamProfile> profile);
     uint64_t getStreamProfileId(std::shared_ptr<const StreamProfile> profile) const;
 
 private:
-    std::recursive_mutex                                                mutex_;
+    struct NodePairHash {
+        size_t operator()(const std::pair<uint64_t, uint64_t> &nodes) const {
+            return std::hash<uint64_t>()(nodes.first * 0x9E3779B97F4A7C15ull ^ nodes.second);
+        }
+    };
+
+    std::mutex                                                          mutex_;
+    uint64_t                                                            nextNodeId_;  // ids are not reused, so the cached results stay valid
+    size_t                                                              registerCountSinceClean_;
+    size_t                                                              profileCountAfterClean_;
     std::map<uint64_t, std::vector<std::weak_ptr<const StreamProfile>>> streamProfileMap_;  // vertices
     std::map<uint64_t, std::vector<std::pair<uint64_t, OBExtrinsic>>>   extrinsicsGraph_;   // graph adjacency list
+
+    // the extrinsics between the nodes found by searching the graph, cleared when the graph is changed
+    std::unordered_map<std::pair<uint64_t, uint64_t>, OBExtrinsic, NodePairHash> extrinsicsCache_;
 };
 
 }  // namespace libobsensor
@@ -4,6 +4,9 @@
 #include "StreamIntrinsicsManager.hpp"
 #include "logger/Logger.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace libobsensor {
 
 std::mutex                             StreamIntrinsicsManager::instanceMutex_;
@@ -23,65 +26,122 @@ StreamIntrinsicsManager::StreamIntrinsicsManager() {}
 
 StreamIntrinsicsManager::~StreamIntrinsicsManager() noexcept = default;
 
-void StreamIntrinsicsManager::registerVideoStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile, const OBCameraIntrinsic &intrinsics) {
+// Hazard pointers of the parameter readers: each thread publishes the parameters it reads in its own slot, and the updates only release the
+// replaced parameters which are in no slot. The slots are written by their thread only, so a read does not contend with the other threads.
+struct IntrinsicsHazardSlots {
+    std::mutex                                                 mutex;
+    std::vector<std::atomic<const StreamIntrinsicParams *> *> slots;
+};
+
+static IntrinsicsHazardSlots &getIntrinsicsHazardSlots() {
+    // Never destroyed, the threads which are still running at exit unregister their slot after the static objects are destroyed
+    static IntrinsicsHazardSlots *hazardSlots = new IntrinsicsHazardSlots();
+    return *hazardSlots;
+}
+
+class ThreadIntrinsicsHazardSlot {
+public:
+    ThreadIntrinsicsHazardSlot() : ptr(nullptr) {
+        auto                       &hazardSlots = getIntrinsicsHazardSlots();
+        std::lock_guard<std::mutex> lock(hazardSlots.mutex);
+        hazardSlots.slots.push_back(&ptr);
+    }
+
+    ~ThreadIntrinsicsHazardSlot() noexcept {
+        auto                       &hazardSlots = getIntrinsicsHazardSlots();
+        std::lock_guard<std::mutex> lock(hazardSlots.mutex);
+        hazardSlots.slots.erase(std::find(hazardSlots.slots.begin(), hazardSlots.slots.end(), &ptr));
+    }
+
+    std::atomic<const StreamIntrinsicParams *> ptr;
+};
+
+StreamIntrinsicsManager::ParamsReader::ParamsReader(const std::shared_ptr<const StreamProfile> &profile) {
     if(!profile) {
         throw invalid_value_exception("Input stream profile is null.");
     }
-    if(!profile->is<const VideoStreamProfile>()) {
-        throw invalid_value_exception("Input stream profile is not a video stream profile.");
-    }
-    std::lock_guard<std::mutex> lock(mutex_);
-    // remove expired stream profiles
-    for(auto it = videoStreamIntrinsicsMap_.begin(); it != videoStreamIntrinsicsMap_.end();) {
-        if(it->first.expired()) {
-            it = videoStreamIntrinsicsMap_.erase(it);
-        }
-        else {
-            it++;
+    static thread_local ThreadIntrinsicsHazardSlot threadSlot;
+    slot_ = &threadSlot.ptr;
+
+    // Publish the parameters before reading them, and check that they are still the current ones: if so, updateParams() sees them in the slot
+    auto params = profile->intrinsicParams_.load(std::memory_order_acquire);
+    while(true) {
+        slot_->store(params, std::memory_order_seq_cst);
+        auto current = profile->intrinsicParams_.load(std::memory_order_seq_cst);
+        if(current == params) {
+            break;
         }
+        params = current;
     }
+    params_ = params;
+}
 
-    for(auto &pair: videoStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            pair.second = intrinsics;
-            return;
-        }
+StreamIntrinsicsManager::ParamsReader::~ParamsReader() noexcept {
+    slot_->store(nullptr, std::memory_order_release);
+}
+
+// The readers may still read the current parameters, so a modified copy is published instead of updating them in place. The replaced parameters
+// are released as soon as no reader holds them, so that the history only keeps the current parameters and the few being read.
+void StreamIntrinsicsManager::updateParams(const std::shared_ptr<const StreamProfile>        &profile,
+                                           const std::function<bool(StreamIntrinsicParams &)> &update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        current = profile->intrinsicParams_.load(std::memory_order_relaxed);
+    std::unique_ptr<StreamIntrinsicParams> params(current ? new StreamIntrinsicParams(*current) : new StreamIntrinsicParams());
+    if(!update(*params)) {
+        return;  // the same parameters are already bound
     }
+    profile->intrinsicParams_.store(params.get(), std::memory_order_seq_cst);
 
-    videoStreamIntrinsicsMap_[std::weak_ptr<const StreamProfile>(profile)] = intrinsics;
+    auto &history = profile->intrinsicParamsHistory_;
+    history.emplace_back(std::move(params));
+
+    auto                       &hazardSlots = getIntrinsicsHazardSlots();
+    std::lock_guard<std::mutex> slotsLock(hazardSlots.mutex);
+    for(auto iter = history.begin(); iter != history.end() - 1;) {
+        auto params = iter->get();
+        bool inUse  = std::any_of(hazardSlots.slots.begin(), hazardSlots.slots.end(), [params](const std::atomic<const StreamIntrinsicParams *> *slot) {
+            return slot->load(std::memory_order_seq_cst) == params;
+        });
+        iter        = inUse ? iter + 1 : history.erase(iter);
+    }
 }
 
-OBCameraIntrinsic StreamIntrinsicsManager::getVideoStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
+void StreamIntrinsicsManager::registerVideoStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile, const OBCameraIntrinsic &intrinsics) {
     if(!profile) {
         throw invalid_value_exception("Input stream profile is null.");
     }
     if(!profile->is<const VideoStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a video stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: videoStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            return pair.second;
+    updateParams(profile, [&intrinsics](StreamIntrinsicParams &params) {
+        if(params.hasVideoIntrinsic && memcmp(&params.videoIntrinsic, &intrinsics, sizeof(intrinsics)) == 0) {
+            return false;
         }
+        params.hasVideoIntrinsic = true;
+        params.videoIntrinsic    = intrinsics;
+        return true;
+    });
+}
+
+OBCameraIntrinsic StreamIntrinsicsManager::getVideoStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
+    ParamsReader params(profile);
+    if(params && params->hasVideoIntrinsic) {
+        return params->videoIntrinsic;
+    }
+    if(!profile->is<const VideoStreamProfile>()) {
+        throw invalid_value_exception("Input stream profile is not a video stream profile.");
     }
     throw invalid_value_exception("Intrinsics for the input stream profile is not found.");
 }
 
 bool StreamIntrinsicsManager::containsVideoStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasVideoIntrinsic) {
+        return true;
     }
     if(!profile->is<const VideoStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a video stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: videoStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            return true;
-        }
-    }
     return false;
 }
 
@@ -92,51 +152,35 @@ void StreamIntrinsicsManager::registerVideoStreamDistortion(const std::shared_pt
     if(!profile->is<const VideoStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a video stream profile.");
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    // remove expired stream profiles
-    for(auto it = videoStreamDistortionMap_.begin(); it != videoStreamDistortionMap_.end();) {
-        if(it->first.expired()) {
-            it = videoStreamDistortionMap_.erase(it);
+    updateParams(profile, [&distortion](StreamIntrinsicParams &params) {
+        if(params.hasVideoDistortion && memcmp(&params.videoDistortion, &distortion, sizeof(distortion)) == 0) {
+            return false;
         }
-        else {
-            it++;
-        }
-    }
-
-    videoStreamDistortionMap_[std::weak_ptr<const StreamProfile>(profile)] = distortion;
+        params.hasVideoDistortion = true;
+        params.videoDistortion    = distortion;
+        return true;
+    });
 }
 
 OBCameraDistortion StreamIntrinsicsManager::getVideoStreamDistortion(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasVideoDistortion) {
+        return params->videoDistortion;
     }
     if(!profile->is<const VideoStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a video stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: videoStreamDistortionMap_) {
-        if(pair.first.lock() == profile) {
-            return pair.second;
-        }
-    }
     throw invalid_value_exception("Distortion for the input stream profile is not found.");
 }
 
 bool StreamIntrinsicsManager::containsVideoStreamDistortion(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasVideoDistortion) {
+        return true;
     }
     if(!profile->is<const VideoStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a video stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: videoStreamDistortionMap_) {
-        if(pair.first.lock() == profile) {
-            return true;
-        }
-    }
     return false;
 }
 
@@ -147,51 +191,35 @@ void StreamIntrinsicsManager::registerGyroStreamIntrinsics(const std::shared_ptr
     if(!profile->is<const GyroStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a gyro stream profile.");
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    // remove expired stream profiles
-    for(auto it = gyroStreamIntrinsicsMap_.begin(); it != gyroStreamIntrinsicsMap_.end();) {
-        if(it->first.expired()) {
-            it = gyroStreamIntrinsicsMap_.erase(it);
+    updateParams(profile, [&intrinsics](StreamIntrinsicParams &params) {
+        if(params.hasGyroIntrinsic && memcmp(&params.gyroIntrinsic, &intrinsics, sizeof(intrinsics)) == 0) {
+            return false;
         }
-        else {
-            it++;
-        }
-    }
-
-    gyroStreamIntrinsicsMap_[std::weak_ptr<const StreamProfile>(profile)] = intrinsics;
+        params.hasGyroIntrinsic = true;
+        params.gyroIntrinsic    = intrinsics;
+        return true;
+    });
 }
 
 OBGyroIntrinsic StreamIntrinsicsManager::getGyroStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasGyroIntrinsic) {
+        return params->gyroIntrinsic;
     }
     if(!profile->is<const GyroStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a gyro stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: gyroStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            return pair.second;
-        }
-    }
     throw invalid_value_exception("Intrinsics for the input stream profile is not found.");
 }
 
 bool StreamIntrinsicsManager::containsGyroStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasGyroIntrinsic) {
+        return true;
     }
     if(!profile->is<const GyroStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a gyro stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: gyroStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            return true;
-        }
-    }
     return false;
 }
 
@@ -202,51 +230,35 @@ void StreamIntrinsicsManager::registerAccelStreamIntrinsics(const std::shared_pt
     if(!profile->is<const AccelStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a accel stream profile.");
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    // remove expired stream profiles
-    for(auto it = accelStreamIntrinsicsMap_.begin(); it != accelStreamIntrinsicsMap_.end();) {
-        if(it->first.expired()) {
-            it = accelStreamIntrinsicsMap_.erase(it);
+    updateParams(profile, [&intrinsics](StreamIntrinsicParams &params) {
+        if(params.hasAccelIntrinsic && memcmp(&params.accelIntrinsic, &intrinsics, sizeof(intrinsics)) == 0) {
+            return false;
         }
-        else {
-            ++it;
-        }
-    }
-
-    accelStreamIntrinsicsMap_[std::weak_ptr<const StreamProfile>(profile)] = intrinsics;
+        params.hasAccelIntrinsic = true;
+        params.accelIntrinsic    = intrinsics;
+        return true;
+    });
 }
 
 OBAccelIntrinsic StreamIntrinsicsManager::getAccelStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasAccelIntrinsic) {
+        return params->accelIntrinsic;
     }
     if(!profile->is<const AccelStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a accel stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: accelStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            return pair.second;
-        }
-    }
     throw invalid_value_exception("Intrinsics for the input stream profile is not found.");
 }
 
 bool StreamIntrinsicsManager::containsAccelStreamIntrinsics(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasAccelIntrinsic) {
+        return true;
     }
     if(!profile->is<const AccelStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a accel stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: accelStreamIntrinsicsMap_) {
-        if(pair.first.lock() == profile) {
-            return true;
-        }
-    }
     return false;
 }
 
@@ -258,51 +270,35 @@ void StreamIntrinsicsManager::registerDisparityBasedStreamDisparityParam(const s
     if(!profile->is<const DisparityBasedStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a disparity based stream profile.");
     }
-    std::lock_guard<std::mutex> lock(mutex_);
-    // remove expired stream profiles
-    for(auto it = disparityParamMap_.begin(); it != disparityParamMap_.end();) {
-        if(it->first.expired()) {
-            it = disparityParamMap_.erase(it);
+    updateParams(profile, [&disparityParam](StreamIntrinsicParams &params) {
+        if(params.hasDisparityParam && memcmp(&params.disparityParam, &disparityParam, sizeof(disparityParam)) == 0) {
+            return false;
         }
-        else {
-            ++it;
-        }
-    }
-
-    disparityParamMap_[std::weak_ptr<const StreamProfile>(profile)] = disparityParam;
+        params.hasDisparityParam = true;
+        params.disparityParam    = disparityParam;
+        return true;
+    });
 }
 
 OBDisparityParam StreamIntrinsicsManager::getDisparityBasedStreamDisparityParam(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasDisparityParam) {
+        return params->disparityParam;
     }
     if(!profile->is<const DisparityBasedStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a disparity based stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: disparityParamMap_) {
-        if(pair.first.lock() == profile) {
-            return pair.second;
-        }
-    }
     throw invalid_value_exception("Disparity parameter for the input stream profile is not found.");
 }
 
 bool StreamIntrinsicsManager::containsDisparityBasedStreamDisparityParam(const std::shared_ptr<const StreamProfile> &profile) {
-    if(!profile) {
-        throw invalid_value_exception("Input stream profile is null.");
+    ParamsReader params(profile);
+    if(params && params->hasDisparityParam) {
+        return true;
     }
     if(!profile->is<const DisparityBasedStreamProfile>()) {
         throw invalid_value_exception("Input stream profile is not a disparity based stream profile.");
     }
-
-    std::lock_guard<std::mutex> lock(mutex_);
-    for(const auto &pair: disparityParamMap_) {
-        if(pair.first.lock() == profile) {
-            return true;
-        }
-    }
     return false;
 }
 }  // namespace libobsensor
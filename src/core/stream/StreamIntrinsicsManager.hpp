@@ -5,7 +5,8 @@
 
 #include "libobsensor/h/ObTypes.h"
 #include "StreamProfile.hpp"
-#include <map>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <mutex>
@@ -41,13 +42,31 @@ public:
     bool               containsDisparityBasedStreamDisparityParam(const std::shared_ptr<const StreamProfile> &profile);
 
 private:
-    std::mutex mutex_;
+    // Reads the current parameters of a profile, which are not released by the updates while the reader is alive
+    class ParamsReader {
+    public:
+        explicit ParamsReader(const std::shared_ptr<const StreamProfile> &profile);
+        ~ParamsReader() noexcept;
 
-    std::map<std::weak_ptr<const StreamProfile>, OBCameraIntrinsic, std::owner_less<std::weak_ptr<const StreamProfile>>>  videoStreamIntrinsicsMap_;
-    std::map<std::weak_ptr<const StreamProfile>, OBCameraDistortion, std::owner_less<std::weak_ptr<const StreamProfile>>> videoStreamDistortionMap_;
-    std::map<std::weak_ptr<const StreamProfile>, OBGyroIntrinsic, std::owner_less<std::weak_ptr<const StreamProfile>>>    gyroStreamIntrinsicsMap_;
-    std::map<std::weak_ptr<const StreamProfile>, OBAccelIntrinsic, std::owner_less<std::weak_ptr<const StreamProfile>>>   accelStreamIntrinsicsMap_;
-    std::map<std::weak_ptr<const StreamProfile>, OBDisparityParam, std::owner_less<std::weak_ptr<const StreamProfile>>>   disparityParamMap_;
+        ParamsReader(const ParamsReader &)            = delete;
+        ParamsReader &operator=(const ParamsReader &) = delete;
+
+        const StreamIntrinsicParams *operator->() const {
+            return params_;
+        }
+        explicit operator bool() const {
+            return params_ != nullptr;
+        }
+
+    private:
+        std::atomic<const StreamIntrinsicParams *> *slot_;  // hazard pointer of the thread
+        const StreamIntrinsicParams                *params_;
+    };
+
+    void updateParams(const std::shared_ptr<const StreamProfile> &profile, const std::function<bool(StreamIntrinsicParams &)> &update);
+
+private:
+    std::mutex mutex_;  // serializes the bindings, the parameters are read without lock
 };
 
 }  // namespace libobsensor
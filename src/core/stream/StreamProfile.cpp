@@ -19,7 +19,8 @@ StreamProfileBackendLifeSpan::~StreamProfileBackendLifeSpan() {
     logger_.reset();
 }
 
-StreamProfile::StreamProfile(std::shared_ptr<LazySensor> owner, OBStreamType type, OBFormat format) : owner_(owner), type_(type), format_(format), index_(0) {}
+StreamProfile::StreamProfile(std::shared_ptr<LazySensor> owner, OBStreamType type, OBFormat format)
+    : owner_(owner), type_(type), format_(format), index_(0), intrinsicParams_(nullptr), extrinsicsNodeId_(0) {}
 
 std::shared_ptr<LazySensor> StreamProfile::getOwner() const {
     return owner_.lock();
@@ -5,6 +5,7 @@
 #include "IStreamProfile.hpp"
 #include "libobsensor/h/ObTypes.h"
 #include "exception/ObException.hpp"
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -15,6 +16,21 @@ class StreamIntrinsicsManager;
 class StreamExtrinsicsManager;
 struct LazySensor;
 
+// The intrinsic parameters bound to a stream profile by StreamIntrinsicsManager. Each binding publishes a new copy, and the previous copies are kept
+// until the profile is destroyed, so the readers never take a lock.
+struct StreamIntrinsicParams {
+    bool               hasVideoIntrinsic  = false;
+    bool               hasVideoDistortion = false;
+    bool               hasGyroIntrinsic   = false;
+    bool               hasAccelIntrinsic  = false;
+    bool               hasDisparityParam  = false;
+    OBCameraIntrinsic  videoIntrinsic     = {};
+    OBCameraDistortion videoDistortion    = {};
+    OBGyroIntrinsic    gyroIntrinsic      = {};
+    OBAccelIntrinsic   accelIntrinsic     = {};
+    OBDisparityParam   disparityParam     = {};
+};
+
 class StreamProfileBackendLifeSpan {
 public:
     StreamProfileBackendLifeSpan();
@@ -80,6 +96,18 @@ protected:
     OBStreamType              type_;
     OBFormat                  format_;
     uint8_t                   index_;  // for multi-stream sensor (multi pin uvc device)
+
+private:
+    friend class StreamIntrinsicsManager;
+    friend class StreamExtrinsicsManager;
+
+    // Written by StreamIntrinsicsManager under its lock, read without lock. The history owns the current parameters and the replaced ones which
+    // were still being read at the last update.
+    mutable std::atomic<const StreamIntrinsicParams *>                intrinsicParams_;
+    mutable std::vector<std::unique_ptr<const StreamIntrinsicParams>> intrinsicParamsHistory_;
+
+    // The node of the profile in the extrinsics graph of StreamExtrinsicsManager, 0 if not registered. Guarded by the lock of the manager.
+    mutable uint64_t extrinsicsNodeId_;
 };
 
 class VideoStreamProfile : public StreamProfile {
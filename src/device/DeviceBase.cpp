@@ -135,6 +135,8 @@ void DeviceBase::reboot() {
     else {
         throw invalid_value_exception("Device does not support reboot!");
     }
+    // The settings are reset by the reboot, which completes after the write dropped the cache
+    propServer->invalidatePropertyCache();
     deactivate();
 }
 
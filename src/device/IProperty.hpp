@@ -80,6 +80,24 @@ enum PropertyOperationType {
     PROP_OP_READ_WRITE = 3,  // Read/Write operation
 };
 
+// How the property server may serve reads of a property without going to its accessor (a device round-trip for most accessors)
+enum PropertyCacheType {
+    PROP_CACHE_NONE        = 0,  // Always read from the accessor
+    PROP_CACHE_STATIC      = 1,  // Never changes while the device is connected (serial number, version, preset lists...)
+    PROP_CACHE_UNTIL_WRITE = 2,  // Only changes when properties are written, the cache is dropped on every write through the property server
+    PROP_CACHE_TTL         = 3,  // Also changes on its own (temperature, auto controlled values...), served from the cache for ttlMs after being read
+};
+
+struct PropertyCachePolicy {
+    PropertyCacheType type;
+    uint32_t          ttlMs;  // Only used by PROP_CACHE_TTL
+};
+
+struct PropertyCacheStatistics {
+    uint64_t hitCount;   // Reads served from the cache
+    uint64_t missCount;  // Reads of cacheable properties that went to the accessor
+};
+
 typedef std::function<void(uint32_t propertyId, const uint8_t *data, size_t dataSize, PropertyOperationType operationType)> PropertyAccessCallback;
 class IPropertyServer {
 public:
@@ -91,8 +109,16 @@ public:
     virtual void registerProperty(uint32_t propertyId, OBPermissionType userPerms, OBPermissionType intPerms, std::shared_ptr<IPropertyAccessor> accessor) = 0;
     virtual void registerProperty(uint32_t propertyId, const std::string &userPerms, const std::string &intPerms,
                                   std::shared_ptr<IPropertyAccessor> accessor)                                                                             = 0;
+    // Register a property whose value, range and structure data reads are served from a cache according to the policy
+    virtual void registerProperty(uint32_t propertyId, const std::string &userPerms, const std::string &intPerms, std::shared_ptr<IPropertyAccessor> accessor,
+                                  const PropertyCachePolicy &cachePolicy)                                                                                  = 0;
     virtual void aliasProperty(uint32_t aliasId, uint32_t propertyId)                                                                                      = 0;
 
+    // Drop all the cached values, including the static ones, for events which change the device state outside of the property server
+    virtual void                    invalidatePropertyCache()                             = 0;
+    virtual PropertyCacheStatistics getPropertyCacheStatistics() const                    = 0;
+    virtual PropertyCacheStatistics getPropertyCacheStatistics(uint32_t propertyId) const = 0;
+
     virtual bool isPropertySupported(uint32_t propertyId, PropertyOperationType operationType, PropertyAccessType accessType) const = 0;
     virtual const std::vector<OBPropertyItem> &getAvailableProperties(PropertyAccessType accessType)                                = 0;
     virtual OBPropertyItem                     getPropertyItem(uint32_t propertyId, PropertyAccessType accessType)                  = 0;
@@ -106,6 +132,9 @@ public:
 
     virtual void getRawData(uint32_t propertyId, GetDataCallback callback, PropertyAccessType accessType) = 0;
 
+    // Execute the operations in order without any other property access interleaved, returns the number of failed operations (status set to error)
+    virtual uint32_t executePropertyOperations(OBPropertyOperation *operations, uint32_t count, PropertyAccessType accessType) = 0;
+
     virtual uint16_t getCmdVersionProtoV1_1(uint32_t propertyId, PropertyAccessType accessType) = 0;
 
     virtual const std::vector<uint8_t> &getStructureDataProtoV1_1(uint32_t propertyId, uint16_t cmdVersion, PropertyAccessType accessType)            = 0;
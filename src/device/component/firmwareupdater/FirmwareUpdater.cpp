@@ -43,6 +43,8 @@ void FirmwareUpdater::updateFirmwareExt(const std::string &path, DeviceFwUpdateC
         if(error) {
             throw libobsensor_exception(std::string(error->message), error->exception_type);
         }
+        // The new firmware may come with other settings, the cached property values are not valid anymore
+        TRY_EXECUTE(getOwner()->getPropertyServer()->invalidatePropertyCache());
     };
     if(async) {
         std::thread([func]() {
@@ -73,6 +75,8 @@ void FirmwareUpdater::updateFirmwareFromRawDataExt(const uint8_t *firmwareData,
         if(error) {
             throw libobsensor_exception(std::string(error->message), error->exception_type);
         }
+        // The new firmware may come with other settings, the cached property values are not valid anymore
+        TRY_EXECUTE(getOwner()->getPropertyServer()->invalidatePropertyCache());
     };
     if(async) {
         std::thread([func]() {
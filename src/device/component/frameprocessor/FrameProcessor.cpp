@@ -116,7 +116,7 @@ FrameProcessor::~FrameProcessor() noexcept {
 
 std::shared_ptr<Frame> FrameProcessor::process(std::shared_ptr<const Frame> frame) {
     if(!context_->process_frame || !privateProcessor_) {
-        return FrameFactory::createFrameFromOtherFrame(frame, true);
+        return FrameFactory::cloneFrame(frame);
     }
 
     checkAndUpdateConfig();
@@ -135,7 +135,7 @@ std::shared_ptr<Frame> FrameProcessor::process(std::shared_ptr<const Frame> fram
 
     if(error) {
         delete error;
-        return FrameFactory::createFrameFromOtherFrame(frame, true);
+        return FrameFactory::cloneFrame(frame);
     }
 
     return resultFrame;
@@ -8,7 +8,7 @@
 #include "exception/ObException.hpp"
 #include "utils/Utils.hpp"
 
-#include <map>
+#include <array>
 
 namespace libobsensor {
 
@@ -22,11 +22,14 @@ public:
     }
 
     virtual void registerParser(OBFrameMetadataType type, std::shared_ptr<IFrameMetadataParser> phaser) {
+        if(static_cast<uint32_t>(type) >= parsers.size()) {
+            throw invalid_value_exception(utils::string::to_string() << "Invalid metadata type: " << type);
+        }
         parsers[type] = phaser;
     }
 
     virtual bool isContained(OBFrameMetadataType type) {
-        return parsers.find(type) != parsers.end();
+        return static_cast<uint32_t>(type) < parsers.size() && parsers[type] != nullptr;
     }
 
     virtual std::shared_ptr<IFrameMetadataParser> get(OBFrameMetadataType type) {
@@ -36,8 +39,25 @@ public:
         return parsers[type];
     }
 
+    virtual void decodeAll(const uint8_t *metadata, size_t dataSize, OBFrameMetadataValues &values) {
+        for(uint32_t type = 0; type < parsers.size(); type++) {
+            auto &parser = parsers[type];
+            if(!parser || !parser->isPureMetadataParser() || !parser->isSupported(metadata, dataSize)) {
+                continue;
+            }
+            try {
+                values.values[type] = parser->getValue(metadata, dataSize);
+                values.supportedMask |= 1ull << type;
+            }
+            catch(...) {
+                // leave it unsupported, getting the value of the type alone reports the error
+            }
+        }
+    }
+
 protected:
-    std::map<OBFrameMetadataType, std::shared_ptr<IFrameMetadataParser>> parsers;
+    // indexed by the metadata type
+    std::array<std::shared_ptr<IFrameMetadataParser>, OB_FRAME_METADATA_TYPE_COUNT> parsers;
 
 private:
     IDevice *owner_ = nullptr;
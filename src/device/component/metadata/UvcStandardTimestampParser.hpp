@@ -26,6 +26,10 @@ public:
         return dataSize >= sizeof(StandardUvcFramePayloadHeader);
     }
 
+    bool isPureMetadataParser() const override {
+        return true;
+    }
+
 private:
     uint64_t clockFrequency_;
 };
@@ -58,6 +62,10 @@ public:
         return dataSize >= sizeof(StandardUvcFramePayloadHeader);
     }
 
+    bool isPureMetadataParser() const override {
+        return true;
+    }
+
 private:
     uint64_t clockFrequency_;
 };
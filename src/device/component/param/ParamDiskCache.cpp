@@ -0,0 +1,97 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "ParamDiskCache.hpp"
+#include "environment/EnvConfig.hpp"
+#include "logger/Logger.hpp"
+#include "utils/FileUtils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace libobsensor {
+
+ParamDiskCache::ParamDiskCache(const IDevice *owner) {
+    std::string rootDir;
+    auto        envConfig = EnvConfig::getInstance();
+    if(!envConfig->getStringValue("Device.ParamCacheDirectory", rootDir) || rootDir.empty()) {
+        return;
+    }
+
+    auto info = owner->getInfo();
+    if(info->deviceSn_.empty() || info->fwVersion_.empty()) {
+        return;  // Can not tell the cached params of different devices or firmware apart
+    }
+    dir_ = utils::joinPaths(rootDir, info->deviceSn_ + "_" + info->fwVersion_);
+}
+
+bool ParamDiskCache::isEnabled() const {
+    return !dir_.empty();
+}
+
+std::vector<uint8_t> ParamDiskCache::getOrFetch(uint32_t id, size_t itemSize, const std::function<std::vector<uint8_t>()> &fetcher) {
+    if(dir_.empty()) {
+        return fetcher();
+    }
+
+    std::vector<uint8_t> data;
+    auto                 filePath = utils::joinPaths(dir_, std::to_string(id) + ".bin");
+    if(utils::fileExists(filePath.c_str())) {
+        if(loadEntry(filePath, itemSize, data)) {
+            LOG_DEBUG("Param {} loaded from disk cache: {}", id, filePath);
+            return data;
+        }
+        LOG_WARN("Invalid param {} in disk cache, fetch it from the device again: {}", id, filePath);
+        std::remove(filePath.c_str());
+    }
+
+    data = fetcher();
+    if(data.empty()) {
+        return data;
+    }
+    if(data.size() % itemSize != 0) {
+        LOG_WARN("Param {} fetched from the device is not made of whole items, not cached: size {}, item size {}", id, data.size(), itemSize);
+        return data;
+    }
+
+    if(!utils::checkDir(dir_.c_str()) && utils::mkDirs(dir_.c_str()) != 0) {
+        LOG_WARN("Failed to create param cache directory: {}", dir_);
+        return data;
+    }
+    storeEntry(filePath, itemSize, data);
+    return data;
+}
+
+bool ParamDiskCache::loadEntry(const std::string &filePath, size_t itemSize, std::vector<uint8_t> &data) const {
+    auto        fileData = utils::readFile(filePath);
+    EntryHeader header   = {};
+    if(fileData.size() <= sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, fileData.data(), sizeof(header));
+    auto dataSize = fileData.size() - sizeof(header);
+    if(header.magic != PARAM_DISK_CACHE_MAGIC || header.version != PARAM_DISK_CACHE_VERSION || header.itemSize != itemSize
+       || header.dataSize != dataSize || dataSize % itemSize != 0) {
+        return false;
+    }
+    data.assign(fileData.begin() + sizeof(header), fileData.end());
+    return true;
+}
+
+void ParamDiskCache::storeEntry(const std::string &filePath, size_t itemSize, const std::vector<uint8_t> &data) const {
+    EntryHeader header = { PARAM_DISK_CACHE_MAGIC, PARAM_DISK_CACHE_VERSION, static_cast<uint32_t>(itemSize), static_cast<uint32_t>(data.size()) };
+
+    // Write to a temporary file and rename it, so that an interrupted write never leaves a truncated entry
+    auto          tmpPath = filePath + ".tmp";
+    std::ofstream ofs(tmpPath, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    ofs.close();
+    if(!ofs || std::rename(tmpPath.c_str(), filePath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        LOG_WARN("Failed to write param to disk cache: {}", filePath);
+    }
+}
+
+}  // namespace libobsensor
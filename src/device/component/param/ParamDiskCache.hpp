@@ -0,0 +1,59 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "IDevice.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace libobsensor {
+
+#define PARAM_DISK_CACHE_MAGIC 0x4350424f  // "OBPC"
+#define PARAM_DISK_CACHE_VERSION 1         // increase it if the layout of the entry file is changed
+
+// On-disk cache of the parameters which never change for a given device and firmware (calibration params, supported profile lists...), so that
+// opening the device again does not read them from the device. The entries are stored in "<dir>/<serial number>_<firmware version>/<id>.bin".
+// The cache is disabled unless the Device.ParamCacheDirectory item is configured.
+class ParamDiskCache {
+public:
+    explicit ParamDiskCache(const IDevice *owner);
+
+    bool isEnabled() const;
+
+    // Return the cached data of the id, or the data returned by the fetcher, which is stored to the cache if it is not empty and is made of whole
+    // items. An entry which does not match the item size or is not of the current version is deleted and fetched again.
+    std::vector<uint8_t> getOrFetch(uint32_t id, size_t itemSize, const std::function<std::vector<uint8_t>()> &fetcher);
+
+    template <typename T> std::vector<T> getOrFetchList(uint32_t id, const std::function<std::vector<uint8_t>()> &fetcher) {
+        auto           data = getOrFetch(id, sizeof(T), fetcher);
+        std::vector<T> rst;
+        for(size_t i = 0; i + sizeof(T) <= data.size(); i += sizeof(T)) {  // the trailing bytes of the data from the device are ignored as before
+            T item;
+            std::memcpy(&item, data.data() + i, sizeof(T));
+            rst.emplace_back(item);
+        }
+        return rst;
+    }
+
+private:
+    // Stored before the data in the entry file
+    struct EntryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t itemSize;
+        uint32_t dataSize;
+    };
+
+    bool loadEntry(const std::string &filePath, size_t itemSize, std::vector<uint8_t> &data) const;
+    void storeEntry(const std::string &filePath, size_t itemSize, const std::vector<uint8_t> &data) const;
+
+private:
+    std::string dir_;  // empty if the cache is disabled
+};
+
+}  // namespace libobsensor
@@ -199,6 +199,7 @@ const std::map<uint32_t, OBPropertyBaseInfo> OBPropertyBaseInfoMap = {
     PROP_INFO_PAIR(OB_PROP_SDK_GYRO_FRAME_TRANSFORMED_BOOL, OB_BOOL_PROPERTY),
     PROP_INFO_PAIR(OB_PROP_SDK_IR_LEFT_FRAME_UNPACK_BOOL, OB_BOOL_PROPERTY),
     PROP_INFO_PAIR(OB_PROP_SDK_IR_RIGHT_FRAME_UNPACK_BOOL, OB_BOOL_PROPERTY),
+    PROP_INFO_PAIR(OB_PROP_SDK_IMU_BATCH_SIZE_INT, OB_INT_PROPERTY),
     // PROP_INFO_PAIR(OB_RAW_DATA_MULTIPLE_DISTANCE_CALIBRATION_PARAM, OB_RAW_DATA_PROPERTY),
     // PROP_INFO_PAIR(OB_RAW_DATA_REFERENCE_IMAGE, OB_RAW_DATA_PROPERTY),
     // PROP_INFO_PAIR(OB_RAW_DATA_HARDWARE_ALIGN_PARAM, OB_RAW_DATA_PROPERTY),
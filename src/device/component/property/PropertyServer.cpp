@@ -5,12 +5,30 @@
 #include "exception/ObException.hpp"
 #include "logger/Logger.hpp"
 #include "utils/Utils.hpp"
+#include <chrono>
 #include <memory>
 
 namespace libobsensor {
 
+namespace {
+uint64_t steadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool isCacheFresh(const PropertyCachePolicy &policy, bool valid, uint64_t readTimeMs) {
+    return valid && (policy.type != PROP_CACHE_TTL || steadyNowMs() - readTimeMs < policy.ttlMs);
+}
+}  // namespace
+
 PropertyServer::PropertyServer(IDevice *owner) : DeviceComponentBase(owner) {}
 
+PropertyServer::~PropertyServer() noexcept {
+    auto statistics = getPropertyCacheStatistics();
+    if(statistics.hitCount + statistics.missCount > 0) {
+        LOG_DEBUG("Property cache statistics: {} hits, {} misses", statistics.hitCount, statistics.missCount);
+    }
+}
+
 void PropertyServer::registerProperty(uint32_t propertyId, OBPermissionType userPerms, OBPermissionType intPerms, std::shared_ptr<IPropertyAccessor> accessor) {
     properties_[propertyId] = { propertyId, userPerms, intPerms, accessor };
 
@@ -82,6 +100,17 @@ void PropertyServer::appendToPropertyMap(uint32_t propertyId, OBPermissionType u
     }
 }
 
+void PropertyServer::registerProperty(uint32_t propertyId, const std::string &userPermsStr, const std::string &intPermsStr,
+                                      std::shared_ptr<IPropertyAccessor> accessor, const PropertyCachePolicy &cachePolicy) {
+    registerProperty(propertyId, userPermsStr, intPermsStr, accessor);
+    if(cachePolicy.type == PROP_CACHE_NONE) {
+        return;
+    }
+    auto cache                    = std::make_shared<PropertyCache>(cachePolicy);
+    properties_[propertyId].cache = cache;
+    caches_.push_back(cache);
+}
+
 void PropertyServer::aliasProperty(uint32_t aliasId, uint32_t propertyId) {
     auto it = properties_.find(propertyId);
     if(it == properties_.end()) {
@@ -149,6 +178,7 @@ void PropertyServer::setPropertyValue(uint32_t propertyId, OBPropertyValue value
 
     auto basicAccessor = std::dynamic_pointer_cast<IBasicPropertyAccessor>(accessor);
     basicAccessor->setPropertyValue(propId, value);
+    invalidateCacheOnWrite();
 
     for(auto &callback: it->second.accessCallbacks) {
         auto data = reinterpret_cast<uint8_t *>(&value);
@@ -159,20 +189,44 @@ void PropertyServer::setPropertyValue(uint32_t propertyId, OBPropertyValue value
 }
 
 void PropertyServer::getPropertyValue(uint32_t propertyId, OBPropertyValue *value, PropertyAccessType accessType) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if(!isPropertySupported(propertyId, PROP_OP_READ, accessType)) {
         throw invalid_value_exception(utils::string::to_string() << "Property not readable: " << propertyId);
     }
 
-    auto  it       = properties_.find(propertyId);
-    auto &accessor = it->second.accessor;
-    auto &propId   = it->second.propertyId;
+    // The properties are only registered while the device is initialized, so the lookup does not need the lock
+    auto  it     = properties_.find(propertyId);
+    auto &cache  = it->second.cache;
+    auto &propId = it->second.propertyId;
+    if(cache) {
+        std::unique_lock<std::mutex> cacheLock(cache->mutex);
+        if(isCacheFresh(cache->policy, cache->valueValid, cache->valueTimeMs)) {
+            *value = cache->value;
+            cache->hitCount++;
+            cacheLock.unlock();
+            for(auto &callback: it->second.accessCallbacks) {
+                auto data = reinterpret_cast<uint8_t *>(value);
+                callback(propertyId, data, sizeof(OBPropertyValue), PROP_OP_READ);
+            }
+            return;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto                                 &accessor = it->second.accessor;
     if(propId != propertyId) {
         LOG_DEBUG("Property {} alias to {}", propId, propertyId);
     }
 
     auto basicAccessor = std::dynamic_pointer_cast<IBasicPropertyAccessor>(accessor);
     basicAccessor->getPropertyValue(propId, value);
+    if(cache) {
+        // Stored under the accessor lock, so that a value read before a write can not be stored after the write dropped the cache
+        std::lock_guard<std::mutex> cacheLock(cache->mutex);
+        cache->value       = *value;
+        cache->valueValid  = true;
+        cache->valueTimeMs = steadyNowMs();
+        cache->missCount++;
+    }
 
     for(auto &callback: it->second.accessCallbacks) {
         auto data = reinterpret_cast<uint8_t *>(value);
@@ -188,20 +242,50 @@ void PropertyServer::getPropertyValue(uint32_t propertyId, OBPropertyValue *valu
 // }
 
 void PropertyServer::getPropertyRange(uint32_t propertyId, OBPropertyRange *range, PropertyAccessType accessType) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if(!isPropertySupported(propertyId, PROP_OP_READ, accessType)) {
         throw invalid_value_exception(utils::string::to_string() << "Property not readable: " << propertyId);
     }
 
-    auto  it       = properties_.find(propertyId);
-    auto &accessor = it->second.accessor;
-    auto &propId   = it->second.propertyId;
+    auto  it     = properties_.find(propertyId);
+    auto &cache  = it->second.cache;
+    auto &propId = it->second.propertyId;
+    if(cache) {
+        std::unique_lock<std::mutex> cacheLock(cache->mutex);
+        if(isCacheFresh(cache->policy, cache->rangeValid, cache->rangeTimeMs)) {
+            *range = cache->range;
+            if(isCacheFresh(cache->policy, cache->valueValid, cache->valueTimeMs)) {
+                range->cur = cache->value;  // may have been read after the range
+            }
+            cache->hitCount++;
+            cacheLock.unlock();
+            for(auto &callback: it->second.accessCallbacks) {
+                auto data = reinterpret_cast<uint8_t *>(range);
+                callback(propertyId, data, sizeof(OBPropertyRange), PROP_OP_READ);
+            }
+            return;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto                                 &accessor = it->second.accessor;
     if(propId != propertyId) {
         LOG_DEBUG("Property {} alias to {}", propId, propertyId);
     }
 
     auto basicAccessor = std::dynamic_pointer_cast<IBasicPropertyAccessor>(accessor);
     basicAccessor->getPropertyRange(propId, range);
+    if(cache) {
+        std::lock_guard<std::mutex> cacheLock(cache->mutex);
+        cache->range       = *range;
+        cache->rangeValid  = true;
+        cache->rangeTimeMs = steadyNowMs();
+        cache->missCount++;
+    }
+
+    for(auto &callback: it->second.accessCallbacks) {
+        auto data = reinterpret_cast<uint8_t *>(range);
+        callback(propertyId, data, sizeof(OBPropertyRange), PROP_OP_READ);
+    }
     LOG_DEBUG("Property {} range as {}-{} step {} def {}|{}-{} step {} def {}", propId, range->min.intValue, range->max.intValue, range->step.intValue,
               range->def.intValue, range->min.floatValue, range->max.floatValue, range->step.floatValue, range->def.floatValue);
 }
@@ -223,6 +307,7 @@ void PropertyServer::setStructureData(uint32_t propertyId, const std::vector<uin
         throw invalid_value_exception(utils::string::to_string() << "Property" << propId << " does not support structure data setting");
     }
     structAccessor->setStructureData(propId, data);
+    invalidateCacheOnWrite();
 
     for(auto &callback: it->second.accessCallbacks) {
         callback(propertyId, data.data(), data.size(), PROP_OP_WRITE);
@@ -231,14 +316,33 @@ void PropertyServer::setStructureData(uint32_t propertyId, const std::vector<uin
 }
 
 const std::vector<uint8_t> &PropertyServer::getStructureData(uint32_t propertyId, PropertyAccessType accessType) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if(!isPropertySupported(propertyId, PROP_OP_READ, accessType)) {
         throw invalid_value_exception(utils::string::to_string() << "Property not readable: " << propertyId);
     }
 
-    auto  it       = properties_.find(propertyId);
-    auto &accessor = it->second.accessor;
-    auto &propId   = it->second.propertyId;
+    // The returned cached data is a snapshot kept for the calling thread until its next call, as the accessors keep their buffers until their
+    // next read. A refill by another thread replaces the cached snapshot instead of changing it.
+    static thread_local std::shared_ptr<const std::vector<uint8_t>> threadDataSnapshot;
+
+    auto  it     = properties_.find(propertyId);
+    auto &cache  = it->second.cache;
+    auto &propId = it->second.propertyId;
+    if(cache) {
+        std::unique_lock<std::mutex> cacheLock(cache->mutex);
+        if(isCacheFresh(cache->policy, cache->dataValid, cache->dataTimeMs)) {
+            auto data = cache->data;
+            cache->hitCount++;
+            cacheLock.unlock();
+            for(auto &callback: it->second.accessCallbacks) {
+                callback(propertyId, data->data(), data->size(), PROP_OP_READ);
+            }
+            threadDataSnapshot = std::move(data);
+            return *threadDataSnapshot;
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto                                 &accessor = it->second.accessor;
     if(propId != propertyId) {
         LOG_DEBUG("Property {} alias to {}", propId, propertyId);
     }
@@ -247,7 +351,21 @@ const std::vector<uint8_t> &PropertyServer::getStructureData(uint32_t propertyId
     if(structAccessor == nullptr) {
         throw invalid_value_exception(utils::string::to_string() << "Property " << propId << " does not support structure data getting");
     }
-    const auto &data = structAccessor->getStructureData(propId);
+    const auto &accessorData = structAccessor->getStructureData(propId);
+    const auto *dataPtr      = &accessorData;
+    if(cache) {
+        auto snapshot = std::make_shared<const std::vector<uint8_t>>(accessorData);
+        {
+            std::lock_guard<std::mutex> cacheLock(cache->mutex);
+            cache->data       = snapshot;
+            cache->dataValid  = true;
+            cache->dataTimeMs = steadyNowMs();
+            cache->missCount++;
+        }
+        threadDataSnapshot = std::move(snapshot);
+        dataPtr            = threadDataSnapshot.get();
+    }
+    const auto &data = *dataPtr;
     for(auto &callback: it->second.accessCallbacks) {
         callback(propertyId, data.data(), data.size(), PROP_OP_READ);
     }
@@ -279,6 +397,65 @@ void PropertyServer::getRawData(uint32_t propertyId, GetDataCallback callback, P
     LOG_DEBUG("Property {} get raw data successfully", propId);
 }
 
+uint32_t PropertyServer::executePropertyOperations(OBPropertyOperation *operations, uint32_t count, PropertyAccessType accessType) {
+    // The whole batch holds the accessor lock, so the operations are not interleaved with the other accesses of the device
+    std::lock_guard<std::recursive_mutex>           lock(mutex_);
+    std::map<uint32_t, const OBPropertyOperation *> readResults;  // reads since the last write, reused by the repeated reads of the batch
+    uint32_t                                        failedCount = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        auto &op = operations[i];
+        try {
+            auto read = readResults.find(op.id);
+            if(op.operation == OB_PROPERTY_OPERATION_SET) {
+                OBPropertyValue value;
+                value.intValue = op.value.intValue;  // the float value is copied bitwise
+                setPropertyValue(op.id, value, accessType);
+                readResults.clear();
+            }
+            else if(op.operation == OB_PROPERTY_OPERATION_GET) {
+                if(read != readResults.end()) {
+                    op.value = read->second->value;
+                }
+                else {
+                    OBPropertyValue value;
+                    getPropertyValue(op.id, &value, accessType);
+                    op.value.intValue = value.intValue;
+                    readResults[op.id] = &op;
+                }
+            }
+            else if(op.operation == OB_PROPERTY_OPERATION_GET_RANGE) {
+                if(read != readResults.end() && read->second->operation == OB_PROPERTY_OPERATION_GET_RANGE) {
+                    op.value = read->second->value;
+                    op.max   = read->second->max;
+                    op.min   = read->second->min;
+                    op.step  = read->second->step;
+                    op.def   = read->second->def;
+                }
+                else {
+                    OBPropertyRange range;
+                    getPropertyRange(op.id, &range, accessType);
+                    op.value.intValue  = range.cur.intValue;
+                    op.max.intValue    = range.max.intValue;
+                    op.min.intValue    = range.min.intValue;
+                    op.step.intValue   = range.step.intValue;
+                    op.def.intValue    = range.def.intValue;
+                    readResults[op.id] = &op;
+                }
+            }
+            else {
+                throw invalid_value_exception(utils::string::to_string() << "Invalid property operation type: " << op.operation);
+            }
+            op.status = OB_STATUS_OK;
+        }
+        catch(const std::exception &e) {
+            LOG_WARN("Property operation {} of the batch failed, propertyId: {}, {}", i, op.id, e.what());
+            op.status = OB_STATUS_ERROR;
+            failedCount++;
+        }
+    }
+    return failedCount;
+}
+
 uint16_t PropertyServer::getCmdVersionProtoV1_1(uint32_t propertyId, PropertyAccessType accessType) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     if(!isPropertySupported(propertyId, PROP_OP_READ, accessType)) {
@@ -342,6 +519,7 @@ void PropertyServer::setStructureDataProtoV1_1(uint32_t propertyId, const std::v
         throw invalid_value_exception(utils::string::to_string() << "Property" << propId << " does not support structure data setting over proto v1.1");
     }
     structAccessor->setStructureDataProtoV1_1(propId, data, cmdVersion);
+    invalidateCacheOnWrite();
     for(auto callback: it->second.accessCallbacks) {
         callback(propertyId, data.data(), data.size(), PROP_OP_WRITE);
     }
@@ -372,6 +550,48 @@ const std::vector<uint8_t> &PropertyServer::getStructureDataListProtoV1_1(uint32
     return data;
 }
 
+void PropertyServer::invalidateCacheOnWrite() {
+    // A write may change other properties too (presets, work modes, auto controls...), only the static values are kept
+    for(auto &cache: caches_) {
+        if(cache->policy.type == PROP_CACHE_STATIC) {
+            continue;
+        }
+        std::lock_guard<std::mutex> cacheLock(cache->mutex);
+        cache->valueValid = false;
+        cache->rangeValid = false;
+        cache->dataValid  = false;
+    }
+}
+
+void PropertyServer::invalidatePropertyCache() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    for(auto &cache: caches_) {
+        std::lock_guard<std::mutex> cacheLock(cache->mutex);
+        cache->valueValid = false;
+        cache->rangeValid = false;
+        cache->dataValid  = false;
+    }
+}
+
+PropertyCacheStatistics PropertyServer::getPropertyCacheStatistics() const {
+    PropertyCacheStatistics statistics = { 0, 0 };
+    for(auto &cache: caches_) {
+        statistics.hitCount += cache->hitCount;
+        statistics.missCount += cache->missCount;
+    }
+    return statistics;
+}
+
+PropertyCacheStatistics PropertyServer::getPropertyCacheStatistics(uint32_t propertyId) const {
+    PropertyCacheStatistics statistics = { 0, 0 };
+    auto                    it         = properties_.find(propertyId);
+    if(it != properties_.end() && it->second.cache) {
+        statistics.hitCount  = it->second.cache->hitCount;
+        statistics.missCount = it->second.cache->missCount;
+    }
+    return statistics;
+}
+
 const std::vector<OBPropertyItem> &PropertyServer::getAvailableProperties(PropertyAccessType accessType) {
     if(accessType == PROP_ACCESS_USER) {
         return userPropertiesVec_;
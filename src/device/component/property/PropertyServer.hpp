@@ -9,21 +9,56 @@
 #include "PropertyHelper.hpp"
 #include "DeviceComponentBase.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace libobsensor {
 
 class PropertyServer : public IPropertyServer, public DeviceComponentBase {
 
+    // Cached reads of a property, shared by the property and its aliases
+    struct PropertyCache {
+        PropertyCachePolicy   policy;
+        std::mutex            mutex;
+        bool                  valueValid;
+        OBPropertyValue       value;
+        uint64_t              valueTimeMs;  // steady clock time of the read, for the TTL
+        bool                  rangeValid;
+        OBPropertyRange       range;
+        uint64_t              rangeTimeMs;
+        bool                  dataValid;
+        uint64_t              dataTimeMs;
+        std::atomic<uint64_t> hitCount;
+        std::atomic<uint64_t> missCount;
+
+        std::shared_ptr<const std::vector<uint8_t>> data;  // replaced on refill, so that the snapshots being read are never changed
+
+        explicit PropertyCache(const PropertyCachePolicy &cachePolicy)
+            : policy(cachePolicy),
+              valueValid(false),
+              value(),
+              valueTimeMs(0),
+              rangeValid(false),
+              range(),
+              rangeTimeMs(0),
+              dataValid(false),
+              dataTimeMs(0),
+              hitCount(0),
+              missCount(0) {}
+    };
+
     struct PropertyItem {
         uint32_t                            propertyId;
         OBPermissionType                    userPermission;
         OBPermissionType                    InternalPermission;
         std::shared_ptr<IPropertyAccessor>  accessor;
         std::vector<PropertyAccessCallback> accessCallbacks;
+        std::shared_ptr<PropertyCache>      cache;  // nullptr if the property is not cached
     };
 
 public:
     PropertyServer(IDevice *owner);
-    ~PropertyServer() noexcept = default;
+    ~PropertyServer() noexcept;
 
     virtual void registerAccessCallback(uint32_t propertyId, PropertyAccessCallback callback) override;
     virtual void registerAccessCallback(std::vector<uint32_t> propertyIds, PropertyAccessCallback callback) override;
@@ -31,8 +66,14 @@ public:
     void registerProperty(uint32_t propertyId, OBPermissionType userPerms, OBPermissionType intPerms, std::shared_ptr<IPropertyAccessor> accessor) override;
     void registerProperty(uint32_t propertyId, const std::string &userPermsStr, const std::string &intPermsStr,
                           std::shared_ptr<IPropertyAccessor> accessor) override;
+    void registerProperty(uint32_t propertyId, const std::string &userPermsStr, const std::string &intPermsStr, std::shared_ptr<IPropertyAccessor> accessor,
+                          const PropertyCachePolicy &cachePolicy) override;
     void aliasProperty(uint32_t aliasId, uint32_t propertyId) override;
 
+    void                    invalidatePropertyCache() override;
+    PropertyCacheStatistics getPropertyCacheStatistics() const override;
+    PropertyCacheStatistics getPropertyCacheStatistics(uint32_t propertyId) const override;
+
     bool isPropertySupported(uint32_t propertyId, PropertyOperationType operationType, PropertyAccessType accessType) const override;
     const std::vector<OBPropertyItem> &getAvailableProperties(PropertyAccessType accessType) override;
     virtual OBPropertyItem             getPropertyItem(uint32_t propertyId, PropertyAccessType accessType) override;
@@ -46,6 +87,8 @@ public:
 
     void getRawData(uint32_t propertyId, GetDataCallback callback, PropertyAccessType accessType) override;
 
+    uint32_t executePropertyOperations(OBPropertyOperation *operations, uint32_t count, PropertyAccessType accessType) override;
+
     uint16_t                    getCmdVersionProtoV1_1(uint32_t propertyId, PropertyAccessType accessType) override;
     const std::vector<uint8_t> &getStructureDataProtoV1_1(uint32_t propertyId, uint16_t cmdVersion, PropertyAccessType accessType) override;
     void setStructureDataProtoV1_1(uint32_t propertyId, const std::vector<uint8_t> &data, uint16_t cmdVersion, PropertyAccessType accessType) override;
@@ -53,12 +96,14 @@ public:
 
 private:
     void appendToPropertyMap(uint32_t propertyId, OBPermissionType userPerms, OBPermissionType intPerms);
+    void invalidateCacheOnWrite();
 
 private:
-    std::recursive_mutex             mutex_;
-    std::map<uint32_t, PropertyItem> properties_;
-    std::vector<OBPropertyItem>      userPropertiesVec_;
-    std::vector<OBPropertyItem>      innerPropertiesVec_;
+    std::recursive_mutex                        mutex_;  // serializes the accesses to the accessors, not taken by the reads served from the cache
+    std::map<uint32_t, PropertyItem>            properties_;
+    std::vector<std::shared_ptr<PropertyCache>> caches_;
+    std::vector<OBPropertyItem>                 userPropertiesVec_;
+    std::vector<OBPropertyItem>                 innerPropertiesVec_;
 };
 
 }  // namespace libobsensor
@@ -12,13 +12,21 @@
 
 namespace libobsensor {
 
-const size_t IMU_FILTER_FRAME_QUEUE_SIZE = 100;
+const size_t   IMU_FILTER_FRAME_QUEUE_SIZE = 100;
+const uint32_t IMU_MAX_BATCH_SIZE          = 256;
 
 ImuStreamer::ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort> &backend, const std::shared_ptr<IFilter> &filter)
     : ImuStreamer(owner, backend, std::vector<std::shared_ptr<IFilter>>({ filter })) {}
 
 ImuStreamer::ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort> &backend, std::vector<std::shared_ptr<IFilter>> filters)
-    : owner_(owner), backend_(backend), filters_(std::move(filters)), running_(false) {
+    : owner_(owner),
+      backend_(backend),
+      filters_(std::move(filters)),
+      running_(false),
+      frameIndex_(0),
+      batchSize_(1),
+      activeBatchSize_(1),
+      batchSampleCount_(0) {
     auto iter = filters_.begin();
     while(iter != filters_.end()) {
         (*iter)->resizeFrameQueue(IMU_FILTER_FRAME_QUEUE_SIZE);
@@ -59,7 +67,9 @@ void ImuStreamer::start(std::shared_ptr<const StreamProfile> sp, MutableFrameCal
             return;
         }
     }
-    running_ = true;
+    running_         = true;
+    activeBatchSize_ = batchSize_;
+    resetBatch();
 
     backend_->startStream([this](std::shared_ptr<Frame> frame) { ImuStreamer::parseIMUData(frame); });
 }
@@ -85,6 +95,7 @@ void ImuStreamer::stop(std::shared_ptr<const StreamProfile> sp) {
     for(auto &filter: filters_) {
         filter->reset();
     }
+    resetBatch();  // the incomplete batch is dropped
     running_ = false;
     LOG_DEBUG("ImuStreamer stop finished.");
 }
@@ -129,13 +140,17 @@ void ImuStreamer::parseIMUData(std::shared_ptr<Frame> frame) {
 
     uint8_t *imuOrgData = (uint8_t *)data + sizeof(OBImuHeader);
     for(int groupIndex = 0; groupIndex < header->groupCount; groupIndex++) {
-        auto frameSet = FrameFactory::createFrameSet();
-
         OBImuOriginData *imuData    = (OBImuOriginData *)((uint8_t *)imuOrgData + groupIndex * sizeof(OBImuOriginData));
         uint64_t         timestamp  = ((uint64_t)imuData->timestamp[0] | ((uint64_t)imuData->timestamp[1] << 32));
         auto             sysTspUs   = frame->getSystemTimeStampUsec();
         auto             frameIndex = frameIndex_++;
 
+        if(activeBatchSize_ > 1) {
+            appendBatchSample(imuData, timestamp, sysTspUs, frameIndex, accelStreamProfile, gyroStreamProfile);
+            continue;
+        }
+
+        auto frameSet = FrameFactory::createFrameSet();
         if(accelStreamProfile) {
             auto accelFrame     = FrameFactory::createFrameFromStreamProfile(accelStreamProfile);
             auto accelFrameData = (AccelFrame::Data *)accelFrame->getData();
@@ -175,6 +190,91 @@ void ImuStreamer::parseIMUData(std::shared_ptr<Frame> frame) {
     }
 }
 
+// Fill the sample at the index of the batch, the value and temperature of the frame are always those of the latest sample
+static void fillBatchSample(Frame *frame, uint32_t index, uint64_t timestamp, float x, float y, float z, float temperature) {
+    auto batch               = ImuSampleBatch::get(frame);
+    batch.timestampUs[index] = timestamp;
+    batch.x[index]           = x;
+    batch.y[index]           = y;
+    batch.z[index]           = z;
+    batch.temperature[index] = temperature;
+
+    auto frameData   = reinterpret_cast<AccelFrame::Data *>(frame->getDataMutable());
+    frameData->value = { x, y, z };
+    frameData->temp  = temperature;
+}
+
+void ImuStreamer::appendBatchSample(const OBImuOriginData *imuData, uint64_t timestamp, uint64_t sysTspUs, uint64_t frameIndex,
+                                    const std::shared_ptr<const AccelStreamProfile> &accelStreamProfile,
+                                    const std::shared_ptr<const GyroStreamProfile>  &gyroStreamProfile) {
+    if(!accelStreamProfile && !gyroStreamProfile) {
+        return;
+    }
+
+    // Restart the batch if the streams are changed in the middle of it
+    if(batchSampleCount_ > 0
+       && ((batchAccelFrame_ ? batchAccelFrame_->getStreamProfile() : nullptr) != accelStreamProfile
+           || (batchGyroFrame_ ? batchGyroFrame_->getStreamProfile() : nullptr) != gyroStreamProfile)) {
+        resetBatch();
+    }
+
+    if(batchSampleCount_ == 0) {
+        auto dataSize = ImuSampleBatch::calcDataSize(activeBatchSize_);
+        if(accelStreamProfile) {
+            batchAccelFrame_ = FrameFactory::createFrameFromStreamProfile(accelStreamProfile, dataSize);
+            ImuSampleBatch::init(batchAccelFrame_.get(), activeBatchSize_);
+        }
+        if(gyroStreamProfile) {
+            batchGyroFrame_ = FrameFactory::createFrameFromStreamProfile(gyroStreamProfile, dataSize);
+            ImuSampleBatch::init(batchGyroFrame_.get(), activeBatchSize_);
+        }
+    }
+
+    auto index       = batchSampleCount_++;
+    auto temperature = IMUCorrector::calculateRegisterTemperature(imuData->temperature);
+    if(batchAccelFrame_) {
+        auto fs = static_cast<uint8_t>(accelStreamProfile->getFullScaleRange());
+        fillBatchSample(batchAccelFrame_.get(), index, timestamp, IMUCorrector::calculateAccelGravity(static_cast<int16_t>(imuData->accelX), fs),
+                        IMUCorrector::calculateAccelGravity(static_cast<int16_t>(imuData->accelY), fs),
+                        IMUCorrector::calculateAccelGravity(static_cast<int16_t>(imuData->accelZ), fs), temperature);
+    }
+    if(batchGyroFrame_) {
+        auto fs = static_cast<uint8_t>(gyroStreamProfile->getFullScaleRange());
+        fillBatchSample(batchGyroFrame_.get(), index, timestamp, IMUCorrector::calculateGyroDPS(static_cast<int16_t>(imuData->gyroX), fs),
+                        IMUCorrector::calculateGyroDPS(static_cast<int16_t>(imuData->gyroY), fs),
+                        IMUCorrector::calculateGyroDPS(static_cast<int16_t>(imuData->gyroZ), fs), temperature);
+    }
+    if(batchSampleCount_ < activeBatchSize_) {
+        return;
+    }
+
+    // The batch is complete, the frames are stamped with the latest sample
+    auto frameSet = FrameFactory::createFrameSet();
+    for(auto batchFrame: { batchAccelFrame_, batchGyroFrame_ }) {
+        if(!batchFrame) {
+            continue;
+        }
+        batchFrame->setNumber(frameIndex);
+        batchFrame->setTimeStampUsec(timestamp);
+        batchFrame->setSystemTimeStampUsec(sysTspUs);
+        frameSet->pushFrame(std::move(batchFrame));
+    }
+    resetBatch();
+
+    if(!filters_.empty()) {
+        filters_.front()->pushFrame(frameSet);
+    }
+    else {
+        outputFrame(frameSet);
+    }
+}
+
+void ImuStreamer::resetBatch() {
+    batchSampleCount_ = 0;
+    batchAccelFrame_.reset();
+    batchGyroFrame_.reset();
+}
+
 void ImuStreamer::outputFrame(std::shared_ptr<Frame> frame) {
     if(!frame) {
         return;
@@ -202,4 +302,34 @@ IDevice *ImuStreamer::getOwner() const {
     return owner_;
 }
 
+void ImuStreamer::setPropertyValue(uint32_t propertyId, const OBPropertyValue &value) {
+    if(propertyId != OB_PROP_SDK_IMU_BATCH_SIZE_INT) {
+        throw invalid_value_exception("ImuStreamer: unsupported property id " + std::to_string(propertyId));
+    }
+    if(value.intValue < 1 || value.intValue > static_cast<int32_t>(IMU_MAX_BATCH_SIZE)) {
+        throw invalid_value_exception("ImuStreamer: invalid imu batch size " + std::to_string(value.intValue) + ", valid range: [1, "
+                                      + std::to_string(IMU_MAX_BATCH_SIZE) + "]");
+    }
+    batchSize_ = static_cast<uint32_t>(value.intValue);
+    LOG_DEBUG("ImuStreamer: imu batch size set to {}, applied when the imu streams are started", value.intValue);
+}
+
+void ImuStreamer::getPropertyValue(uint32_t propertyId, OBPropertyValue *value) {
+    if(propertyId != OB_PROP_SDK_IMU_BATCH_SIZE_INT) {
+        throw invalid_value_exception("ImuStreamer: unsupported property id " + std::to_string(propertyId));
+    }
+    value->intValue = static_cast<int32_t>(batchSize_.load());
+}
+
+void ImuStreamer::getPropertyRange(uint32_t propertyId, OBPropertyRange *range) {
+    if(propertyId != OB_PROP_SDK_IMU_BATCH_SIZE_INT) {
+        throw invalid_value_exception("ImuStreamer: unsupported property id " + std::to_string(propertyId));
+    }
+    range->cur.intValue  = static_cast<int32_t>(batchSize_.load());
+    range->min.intValue  = 1;
+    range->max.intValue  = static_cast<int32_t>(IMU_MAX_BATCH_SIZE);
+    range->step.intValue = 1;
+    range->def.intValue  = 1;
+}
+
 }  // namespace libobsensor
\ No newline at end of file
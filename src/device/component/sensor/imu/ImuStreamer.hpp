@@ -6,6 +6,7 @@
 #include "IFilter.hpp"
 #include "ISourcePort.hpp"
 #include "IDeviceComponent.hpp"
+#include "IProperty.hpp"
 
 #include <atomic>
 #include <map>
@@ -13,6 +14,9 @@
 
 namespace libobsensor {
 
+class AccelStreamProfile;
+class GyroStreamProfile;
+
 // Original imu data, software packaging method, needs to be calculated on the sdk side
 typedef struct {
     uint8_t  reportId;    // Firmware fixed transmission 1
@@ -34,7 +38,7 @@ typedef struct {
     uint32_t timestamp[2];
 } OBImuOriginData;
 
-class ImuStreamer : public IDeviceComponent {
+class ImuStreamer : public IDeviceComponent, public IBasicPropertyAccessor {
 public:
     ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort> &backend, const std::shared_ptr<IFilter> &filter);
     ImuStreamer(IDevice *owner, const std::shared_ptr<IDataStreamPort> &backend, std::vector<std::shared_ptr<IFilter>> filters);
@@ -45,10 +49,20 @@ public:
 
     IDevice *getOwner() const override;
 
+    // OB_PROP_SDK_IMU_BATCH_SIZE_INT
+    void setPropertyValue(uint32_t propertyId, const OBPropertyValue &value) override;
+    void getPropertyValue(uint32_t propertyId, OBPropertyValue *value) override;
+    void getPropertyRange(uint32_t propertyId, OBPropertyRange *range) override;
+
 private:
     virtual void parseIMUData(std::shared_ptr<Frame> frame);
     virtual void outputFrame(std::shared_ptr<Frame> frame);
 
+    void appendBatchSample(const OBImuOriginData *imuData, uint64_t timestamp, uint64_t sysTspUs, uint64_t frameIndex,
+                           const std::shared_ptr<const AccelStreamProfile> &accelStreamProfile,
+                           const std::shared_ptr<const GyroStreamProfile>  &gyroStreamProfile);
+    void resetBatch();
+
 private:
     IDevice                         *owner_;
     std::shared_ptr<IDataStreamPort> backend_;
@@ -60,5 +74,12 @@ private:
     std::atomic_bool running_;
 
     uint64_t frameIndex_;
+
+    // Batched output mode: the samples are accumulated into one accel and one gyro frame until the batch size is reached
+    std::atomic<uint32_t>  batchSize_;        // set by the user, applied when the streaming starts
+    uint32_t               activeBatchSize_;  // the following are only accessed by the backend callback while streaming
+    uint32_t               batchSampleCount_;
+    std::shared_ptr<Frame> batchAccelFrame_;
+    std::shared_ptr<Frame> batchGyroFrame_;
 };
 }  // namespace libobsensor
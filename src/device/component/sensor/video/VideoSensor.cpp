@@ -6,6 +6,7 @@
 #include "logger/LoggerInterval.hpp"
 #include "logger/LoggerHelper.hpp"
 #include "utils/Utils.hpp"
+#include "environment/EnvConfig.hpp"
 #include "stream/StreamProfile.hpp"
 #include "frame/Frame.hpp"
 #include "FilterDecorator.hpp"
@@ -77,6 +78,14 @@ void VideoSensor::start(std::shared_ptr<const StreamProfile> sp, FrameCallback c
         if(formatConverter) {
             formatConverter->setConversion(currentFormatFilterConfig_->srcFormat, currentFormatFilterConfig_->dstFormat);
         }
+        if(currentFormatFilterConfig_->srcFormat == OB_FORMAT_MJPG) {
+            int threadCount = 1;
+            EnvConfig::getInstance()->getIntValue("Misc.MjpegDecodeThreadCount", threadCount);
+            if(threadCount == 0) {
+                threadCount = static_cast<int>(std::thread::hardware_concurrency());
+            }
+            filter->setProcessThreadCount(static_cast<uint32_t>(threadCount > 1 ? threadCount : 1));
+        }
         currentFormatFilterConfig_->converter->setCallback([this](std::shared_ptr<Frame> frame) { outputFrame(frame); });
     }
 
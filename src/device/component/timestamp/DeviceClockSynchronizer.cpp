@@ -4,10 +4,17 @@
 #include "DeviceClockSynchronizer.hpp"
 #include "InternalTypes.hpp"
 
+#include <cstdlib>
+#include <thread>
+
 namespace libobsensor {
 
 DeviceClockSynchronizer::DeviceClockSynchronizer(IDevice *owner, uint64_t deviceClockFreqIn, uint64_t deviceClockFreqOut)
-    : DeviceComponentBase(owner), deviceClockFreqIn_(deviceClockFreqIn), deviceClockFreqOut_(deviceClockFreqOut), isTimestampResetConfigInit_(false) {}
+    : DeviceComponentBase(owner),
+      deviceClockFreqIn_(deviceClockFreqIn),
+      deviceClockFreqOut_(deviceClockFreqOut),
+      isTimestampResetConfigInit_(false),
+      syncStatus_() {}
 
 void DeviceClockSynchronizer::setTimestampResetConfig(const OBDeviceTimestampResetConfig &timestampResetConfig) {
     if(isTimestampResetConfigInit_ && 0 == memcmp(&currentTimestampResetConfig_, &timestampResetConfig, sizeof(OBDeviceTimestampResetConfig))) {
@@ -73,6 +80,17 @@ void DeviceClockSynchronizer::timerSyncWithHost() {
     const uint32_t MAX_REPEAT_TIME            = 10;
     uint8_t        repeated                   = 0;
     uint64_t       rtt                        = 0;
+    int64_t        offset                     = 0;
+    uint64_t       uncertainty                = 0;
+
+    std::lock_guard<std::mutex> lock(syncMutex_);
+
+    // Measure the round-trip time before the first sync, so that the latency of the command is compensated by the device from the first sync on
+    BEGIN_TRY_EXECUTE({
+        measureTimerOffset(uncertainty);
+        rtt = uncertainty * 2;
+    })
+    CATCH_EXCEPTION_AND_EXECUTE({ rtt = 0; })
 
     while(repeated < MAX_REPEAT_TIME) {
         {
@@ -85,36 +103,72 @@ void DeviceClockSynchronizer::timerSyncWithHost() {
             devTsp.rtt  = static_cast<uint64_t>(static_cast<double>(rtt) / 1000000 * deviceClockFreqOut_);
             propertyServer->setStructureDataT<OBDeviceTime>(OB_STRUCT_DEVICE_TIME, devTsp);
             uint64_t after = utils::getNowTimesUs();
-            rtt            = after - now;
+
+            // The shortest round-trip time is the closest to the actual latency, longer ones are delayed by the host or the bus
+            rtt = (rtt == 0 || after - now < rtt) ? after - now : rtt;
         }
         if(repeated == 0){
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
             repeated++;
             continue;
         }
-        {
-            auto     owner          = getOwner();
-            auto     propertyServer = owner->getPropertyServer();
-            uint64_t now            = utils::getNowTimesUs();
-            auto     devTsp         = propertyServer->getStructureDataT<OBDeviceTime>(OB_STRUCT_DEVICE_TIME);
-            uint64_t after          = utils::getNowTimesUs();
-            uint64_t nowDev         = static_cast<uint64_t>(static_cast<double>(devTsp.time) / deviceClockFreqIn_ * 1000000);
-            double   diff           = std::fabs(static_cast<double>(nowDev) - (after + now) / 2);
-            if(diff > 0xFFFFFFFF) {
-                diff = std::fabs(static_cast<double>(nowDev & 0xFFFFFFFF) - ((after & 0xFFFFFFFF) + (now & 0xFFFFFFFF)) / 2);
-            }
-            if(diff <= static_cast<double>(MINI_HOST_DEVICE_TIME_DIFF)) {
-                break;
-            }
-            LOG_DEBUG("Device/Host time diff: {} us, rtt: {} us, repeated: {}", diff, rtt, repeated);
+
+        offset = measureTimerOffset(uncertainty);
+        if(static_cast<uint64_t>(std::llabs(offset)) <= MINI_HOST_DEVICE_TIME_DIFF) {
+            break;
         }
+        LOG_DEBUG("Device/Host time diff: {} us, rtt: {} us, repeated: {}", offset, rtt, repeated);
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
         repeated++;
     }
 
+    {
+        std::lock_guard<std::mutex> statusLock(syncStatusMutex_);
+        syncStatus_.offset_us      = offset;
+        syncStatus_.uncertainty_us = uncertainty;
+        syncStatus_.rtt_us         = rtt;
+        syncStatus_.sync_time_us   = utils::getNowTimesUs();
+        syncStatus_.success        = repeated < MAX_REPEAT_TIME;
+    }
+
     if(repeated >= MAX_REPEAT_TIME) {
         throw io_exception(utils::string::to_string() << "syncDeviceTime failed after retry " << repeated << " times, rtt=" << rtt);
     }
+    LOG_DEBUG("Device timer synced with host, offset: {} us, uncertainty: {} us, rtt: {} us", offset, uncertainty, rtt);
+}
+
+OBDeviceClockSyncStatus DeviceClockSynchronizer::getClockSyncStatus() {
+    std::lock_guard<std::mutex> lock(syncStatusMutex_);
+    return syncStatus_;
+}
+
+int64_t DeviceClockSynchronizer::measureTimerOffset(uint64_t &uncertainty) {
+    const uint32_t MEASURE_SAMPLE_COUNT = 3;  // The sample with the shortest round-trip time is used, which is the least affected by the latency jitter
+    int64_t        offset               = 0;
+    uint64_t       minRtt               = 0;
+
+    for(uint32_t i = 0; i < MEASURE_SAMPLE_COUNT; i++) {
+        auto     owner          = getOwner();
+        auto     propertyServer = owner->getPropertyServer();
+        uint64_t now            = utils::getNowTimesUs();
+        auto     devTsp         = propertyServer->getStructureDataT<OBDeviceTime>(OB_STRUCT_DEVICE_TIME);
+        uint64_t after          = utils::getNowTimesUs();
+        uint64_t nowDev         = static_cast<uint64_t>(static_cast<double>(devTsp.time) / deviceClockFreqIn_ * 1000000);
+        if(i > 0 && after - now >= minRtt) {
+            continue;
+        }
+
+        // The device time is compared with the host time in the middle of the round-trip
+        auto hostTime = now + (after - now) / 2;
+        offset        = static_cast<int64_t>(nowDev - hostTime);
+        if(offset > 0xFFFFFFFFLL || offset < -0xFFFFFFFFLL) {
+            // The timer of some devices only has 32 bits
+            offset = static_cast<int32_t>(static_cast<uint32_t>(nowDev) - static_cast<uint32_t>(hostTime));
+        }
+        minRtt = after - now;
+    }
+    uncertainty = minRtt / 2;
+    return offset;
 }
 
 }  // namespace libobsensor
@@ -6,6 +6,8 @@
 #include "IDeviceClockSynchronizer.hpp"
 #include "DeviceComponentBase.hpp"
 
+#include <mutex>
+
 namespace libobsensor {
 class DeviceClockSynchronizer : public IDeviceClockSynchronizer, public DeviceComponentBase {
 public:
@@ -16,6 +18,11 @@ public:
     OBDeviceTimestampResetConfig getTimestampResetConfig() override;
     void                         timestampReset() override;
     void                         timerSyncWithHost() override;
+    OBDeviceClockSyncStatus      getClockSyncStatus() override;
+
+private:
+    // Measure the offset of the device timer to the host timer, uncertainty is set to half of the round-trip time of the measurement
+    int64_t measureTimerOffset(uint64_t &uncertainty);
 
 private:
     uint64_t deviceClockFreqIn_;
@@ -23,6 +30,10 @@ private:
 
     std::atomic<bool>            isTimestampResetConfigInit_;
     OBDeviceTimestampResetConfig currentTimestampResetConfig_;
+
+    std::mutex              syncMutex_;  // serialize the timer syncs requested by the user and the multi-device clock sync
+    std::mutex              syncStatusMutex_;
+    OBDeviceClockSyncStatus syncStatus_;
 };
 
 }  // namespace libobsensor
@@ -216,22 +216,48 @@ void DeviceManager::enableDeviceClockSync(uint64_t repeatInterval) {
     multiDeviceSyncIntervalMs_ = repeatInterval;
     multiDeviceSyncThread_     = std::thread([this]() {
         do {
-            std::unique_lock<std::mutex> lock(createdDevicesMutex_);
-            if(!destroy_) {
+            std::vector<std::shared_ptr<IDevice>> devices;
+            {
+                std::unique_lock<std::mutex> lock(createdDevicesMutex_);
                 for(auto &item: createdDevices_) {
                     auto dev = item.second.lock();
-                    if(!dev || !dev->isComponentExists(OB_DEV_COMPONENT_DEVICE_CLOCK_SYNCHRONIZER)) {
-                        continue;
+                    if(dev && dev->isComponentExists(OB_DEV_COMPONENT_DEVICE_CLOCK_SYNCHRONIZER)) {
+                        devices.push_back(dev);
                     }
-                    auto synchronizer = dev->getComponentT<IDeviceClockSynchronizer>(OB_DEV_COMPONENT_DEVICE_CLOCK_SYNCHRONIZER);
-                    TRY_EXECUTE(synchronizer->timerSyncWithHost());
                 }
             }
+            if(!destroy_) {
+                syncDevicesClock(devices);
+            }
+            devices.clear();  // release the devices before waiting, so that they can be destroyed in the meantime
+
+            std::unique_lock<std::mutex> lock(createdDevicesMutex_);
             multiDeviceSyncCv_.wait_for(lock, std::chrono::milliseconds(multiDeviceSyncIntervalMs_));
         } while(multiDeviceSyncIntervalMs_ > 0 && !destroy_);
     });
 }
 
+void DeviceManager::syncDevicesClock(const std::vector<std::shared_ptr<IDevice>> &devices) {
+    // Each device is synced by its own thread without holding the device list lock, so all devices are synced at almost the same time and the
+    // device creation is not blocked by the sync
+    auto sync = [&devices](size_t index) {
+        TRY_EXECUTE({
+            auto synchronizer = devices[index]->getComponentT<IDeviceClockSynchronizer>(OB_DEV_COMPONENT_DEVICE_CLOCK_SYNCHRONIZER);
+            synchronizer->timerSyncWithHost();
+        });
+    };
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < devices.size(); i++) {
+        threads.emplace_back(sync, i);
+    }
+    if(!devices.empty()) {
+        sync(0);
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+}
+
 void DeviceManager::enableNetDeviceEnumeration(bool enable) {
 #if defined(BUILD_NET_PAL)
     LOG_INFO("Enable net device enumeration: {0}", enable);
@@ -37,6 +37,7 @@ public:
 
 private:
     void onDeviceChanged(const DeviceEnumInfoList &removed, const DeviceEnumInfoList &added);
+    void syncDevicesClock(const std::vector<std::shared_ptr<IDevice>> &devices);
 
 private:
     bool destroy_;
@@ -400,6 +400,8 @@ void FemtoMegaUsbDevice::initProperties() {
                 auto filterStateProperty = std::make_shared<FilterStatePropertyAccessor>(imuCorrectorFilter);
                 propertyServer->registerProperty(OB_PROP_SDK_ACCEL_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
             }
+            auto imuStreamerPropertyAccessor = std::make_shared<DeviceComponentPropertyAccessor>(this, OB_DEV_COMPONENT_IMU_STREAMER);
+            propertyServer->registerProperty(OB_PROP_SDK_IMU_BATCH_SIZE_INT, "rw", "rw", imuStreamerPropertyAccessor);
         }
         else if(sensor == OB_SENSOR_GYRO) {
             auto imuCorrectorFilter = getSensorFrameFilter("IMUCorrector", sensor);
@@ -803,6 +805,10 @@ void FemtoMegaNetDevice::initProperties() {
         propertyServer->registerProperty(OB_PROP_SDK_ACCEL_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
         propertyServer->registerProperty(OB_PROP_SDK_GYRO_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
     }
+    if(isComponentExists(OB_DEV_COMPONENT_IMU_STREAMER)) {
+        auto imuStreamerPropertyAccessor = std::make_shared<DeviceComponentPropertyAccessor>(this, OB_DEV_COMPONENT_IMU_STREAMER);
+        propertyServer->registerProperty(OB_PROP_SDK_IMU_BATCH_SIZE_INT, "rw", "rw", imuStreamerPropertyAccessor);
+    }
 
     auto femtoMegaTempPropertyAccessor = std::make_shared<FemtoMegaTempPropertyAccessor>(this);
     propertyServer->registerProperty(OB_STRUCT_DEVICE_TEMPERATURE, "r", "r", femtoMegaTempPropertyAccessor);
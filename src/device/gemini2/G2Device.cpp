@@ -597,6 +597,8 @@ void G2Device::initProperties() {
                 auto filterStateProperty = std::make_shared<FilterStatePropertyAccessor>(imuCorrectorFilter);
                 propertyServer->registerProperty(OB_PROP_SDK_ACCEL_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
             }
+            auto imuStreamerPropertyAccessor = std::make_shared<DeviceComponentPropertyAccessor>(this, OB_DEV_COMPONENT_IMU_STREAMER);
+            propertyServer->registerProperty(OB_PROP_SDK_IMU_BATCH_SIZE_INT, "rw", "rw", imuStreamerPropertyAccessor);
         }
         else if(sensor == OB_SENSOR_GYRO) {
             auto imuCorrectorFilter = getSensorFrameFilter("IMUCorrector", sensor);
@@ -583,6 +583,8 @@ void G2XLUSBDevice::initProperties() {
                 auto filterStateProperty = std::make_shared<FilterStatePropertyAccessor>(imuCorrectorFilter);
                 propertyServer->registerProperty(OB_PROP_SDK_ACCEL_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
             }
+            auto imuStreamerPropertyAccessor = std::make_shared<DeviceComponentPropertyAccessor>(this, OB_DEV_COMPONENT_IMU_STREAMER);
+            propertyServer->registerProperty(OB_PROP_SDK_IMU_BATCH_SIZE_INT, "rw", "rw", imuStreamerPropertyAccessor);
         }
         else if(sensor == OB_SENSOR_GYRO) {
             auto imuCorrectorFilter = getSensorFrameFilter("IMUCorrector", sensor);
@@ -978,6 +980,10 @@ void G2XLNetDevice::initProperties() {
         propertyServer->registerProperty(OB_PROP_SDK_ACCEL_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
         propertyServer->registerProperty(OB_PROP_SDK_GYRO_FRAME_TRANSFORMED_BOOL, "rw", "rw", filterStateProperty);
     }
+    if(isComponentExists(OB_DEV_COMPONENT_IMU_STREAMER)) {
+        auto imuStreamerPropertyAccessor = std::make_shared<DeviceComponentPropertyAccessor>(this, OB_DEV_COMPONENT_IMU_STREAMER);
+        propertyServer->registerProperty(OB_PROP_SDK_IMU_BATCH_SIZE_INT, "rw", "rw", imuStreamerPropertyAccessor);
+    }
     propertyServer->aliasProperty(OB_PROP_DEPTH_AUTO_EXPOSURE_BOOL, OB_PROP_IR_AUTO_EXPOSURE_BOOL);
     propertyServer->aliasProperty(OB_PROP_DEPTH_GAIN_INT, OB_PROP_IR_GAIN_INT);
     propertyServer->aliasProperty(OB_PROP_DEPTH_EXPOSURE_INT, OB_PROP_IR_EXPOSURE_INT);
@@ -9,6 +9,7 @@
 #include "DevicePids.hpp"
 #include "exception/ObException.hpp"
 #include "publicfilters/IMUCorrector.hpp"
+#include "param/ParamDiskCache.hpp"
 
 #include <vector>
 #include <sstream>
@@ -64,6 +65,8 @@ G330AlgParamManager::G330AlgParamManager(IDevice *owner) : DisparityAlgParamMana
 }
 
 void G330AlgParamManager::fetchParamFromDevice() {
+    // The depth calibration params depend on the depth work mode, so only the params fixed for the device and firmware are cached on the disk
+    ParamDiskCache paramCache(getOwner());
 
     try {
         auto owner           = getOwner();
@@ -88,9 +91,10 @@ void G330AlgParamManager::fetchParamFromDevice() {
     }
 
     try {
-        auto owner           = getOwner();
-        auto propServer      = owner->getPropertyServer();
-        auto cameraParamList = propServer->getStructureDataListProtoV1_1_T<OBCameraParam_Internal_V0, 0>(OB_RAW_DATA_ALIGN_CALIB_PARAM);
+        auto cameraParamList = paramCache.getOrFetchList<OBCameraParam_Internal_V0>(OB_RAW_DATA_ALIGN_CALIB_PARAM, [this]() {
+            auto propServer = getOwner()->getPropertyServer();
+            return propServer->getStructureDataListProtoV1_1(OB_RAW_DATA_ALIGN_CALIB_PARAM, 0, PROP_ACCESS_INTERNAL);
+        });
         for(auto &cameraParam: cameraParamList) {
             OBCameraParam param;
             param.depthIntrinsic = cameraParam.depthIntrinsic;
@@ -113,9 +117,10 @@ void G330AlgParamManager::fetchParamFromDevice() {
     }
 
     try {
-        auto owner            = getOwner();
-        auto propServer       = owner->getPropertyServer();
-        originD2cProfileList_ = propServer->getStructureDataListProtoV1_1_T<OBD2CProfile, 0>(OB_RAW_DATA_D2C_ALIGN_SUPPORT_PROFILE_LIST);
+        originD2cProfileList_ = paramCache.getOrFetchList<OBD2CProfile>(OB_RAW_DATA_D2C_ALIGN_SUPPORT_PROFILE_LIST, [this]() {
+            auto propServer = getOwner()->getPropertyServer();
+            return propServer->getStructureDataListProtoV1_1(OB_RAW_DATA_D2C_ALIGN_SUPPORT_PROFILE_LIST, 0, PROP_ACCESS_INTERNAL);
+        });
     }
     catch(const std::exception &e) {
         LOG_ERROR("Get depth to color profile list failed! {}", e.what());
@@ -124,16 +129,19 @@ void G330AlgParamManager::fetchParamFromDevice() {
     // imu param
     std::vector<uint8_t> data;
     BEGIN_TRY_EXECUTE({
-        auto owner      = getOwner();
-        auto propServer = owner->getPropertyServer();
-        propServer->getRawData(
-            OB_RAW_DATA_IMU_CALIB_PARAM,
-            [&](OBDataTranState state, OBDataChunk *dataChunk) {
-                if(state == DATA_TRAN_STAT_TRANSFERRING) {
-                    data.insert(data.end(), dataChunk->data, dataChunk->data + dataChunk->size);
-                }
-            },
-            PROP_ACCESS_INTERNAL);
+        data = paramCache.getOrFetch(OB_RAW_DATA_IMU_CALIB_PARAM, 1, [this]() {
+            std::vector<uint8_t> rawData;
+            auto                 propServer = getOwner()->getPropertyServer();
+            propServer->getRawData(
+                OB_RAW_DATA_IMU_CALIB_PARAM,
+                [&](OBDataTranState state, OBDataChunk *dataChunk) {
+                    if(state == DATA_TRAN_STAT_TRANSFERRING) {
+                        rawData.insert(rawData.end(), dataChunk->data, dataChunk->data + dataChunk->size);
+                    }
+                },
+                PROP_ACCESS_INTERNAL);
+            return rawData;
+        });
     })
     CATCH_EXCEPTION_AND_EXECUTE({
         LOG_ERROR("Get imu calibration params failed!");
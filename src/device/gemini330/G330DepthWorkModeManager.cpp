@@ -4,6 +4,7 @@
 #include "G330DepthWorkModeManager.hpp"
 #include "property/InternalProperty.hpp"
 #include "logger/Logger.hpp"
+#include "param/ParamDiskCache.hpp"
 
 namespace libobsensor {
 
@@ -11,7 +12,11 @@ G330DepthWorkModeManager::G330DepthWorkModeManager(IDevice *owner) : DeviceCompo
 
     auto propServer = owner->getPropertyServer();
 
-    depthWorkModeList_ = propServer->getStructureDataListProtoV1_1_T<OBDepthWorkMode_Internal, 0>(OB_RAW_DATA_DEPTH_ALG_MODE_LIST);
+    // The work mode list is fixed for the firmware, so it can be loaded from the disk cache
+    ParamDiskCache paramCache(owner);
+    depthWorkModeList_ = paramCache.getOrFetchList<OBDepthWorkMode_Internal>(OB_RAW_DATA_DEPTH_ALG_MODE_LIST, [&propServer]() {
+        return propServer->getStructureDataListProtoV1_1(OB_RAW_DATA_DEPTH_ALG_MODE_LIST, 0, PROP_ACCESS_INTERNAL);
+    });
     currentWorkMode_   = propServer->getStructureDataProtoV1_1_T<OBDepthWorkMode_Internal, 0>(OB_STRUCT_CURRENT_DEPTH_ALG_MODE);
 }
 
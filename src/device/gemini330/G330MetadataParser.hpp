@@ -38,6 +38,10 @@ public:
         return dataSize >= sizeof(T);
     }
 
+    bool isPureMetadataParser() const override {
+        return true;
+    }
+
 private:
     Field T::            *field_;
     FrameMetadataModifier modifier_;
@@ -66,6 +70,10 @@ public:
         (void)metadata;
         return dataSize >= sizeof(T);
     }
+
+    bool isPureMetadataParser() const override {
+        return true;
+    }
 };
 
 // for depth and ir sensor
@@ -90,6 +98,10 @@ public:
         return dataSize >= sizeof(G330CommonUvcMetadata);
     }
 
+    bool isPureMetadataParser() const override {
+        return true;
+    }
+
 private:
     FrameMetadataModifier exp_to_usec_ = nullptr;
 };
@@ -115,6 +127,10 @@ public:
         return dataSize >= sizeof(G330CommonUvcMetadata);
     }
 
+    bool isPureMetadataParser() const override {
+        return true;
+    }
+
 private:
     FrameMetadataModifier exp_to_usec_ = nullptr;
 };
@@ -128,6 +144,10 @@ public:
         utils::unusedVar(metadata);
         return dataSize >= sizeof(StandardUvcFramePayloadHeader::scrSourceClock);
     }
+
+    bool isPureMetadataParser() const override {
+        return true;
+    }
 };
 
 class G330PayloadHeadMetadataTimestampParser : public G330ScrMetadataParserBase {
@@ -151,6 +171,10 @@ public:
         return calculatedTimestamp;
     }
 
+    bool isPureMetadataParser() const override {  // calculated with the device clock, which is updated per frame
+        return false;
+    }
+
 private:
     IDevice *device_;
 
@@ -217,6 +241,10 @@ public:
         return static_cast<int64_t>((std::min)(fps, colorCurrentStreamProfileFps));
     }
 
+    bool isPureMetadataParser() const override {  // limited by the fps of the active stream profile
+        return false;
+    }
+
 private:
     IDevice *device_;
 };
@@ -338,6 +366,10 @@ public:
         return static_cast<int64_t>((std::min)(fps, activatedStreamProfileFps));
     }
 
+    bool isPureMetadataParser() const override {  // limited by the fps of the active stream profile
+        return false;
+    }
+
 private:
     IDevice *device_;
 };
@@ -57,7 +57,10 @@ G330PresetManager::G330PresetManager(IDevice *owner) : DeviceComponentBase(owner
                 currentPreset_ = "Custom";
             }
         });
-    storeCurrentParamsAsCustomPreset("Custom");
+
+    // The current params are stored as the "Custom" preset on the first preset operation instead of here, since reading them takes a large part of
+    // the device opening. Until then the params are only changed by the property writes, which switch the current preset to "Custom".
+    availablePresets_.emplace_back("Custom");
 }
 
 void G330PresetManager::loadPreset(const std::string &presetName) {
@@ -66,7 +69,7 @@ void G330PresetManager::loadPreset(const std::string &presetName) {
     }
 
     // store current parameters to  "Custom"
-    if(currentPreset_ == "Custom") {
+    if(currentPreset_ == "Custom" || customPresets_.find("Custom") == customPresets_.end()) {
         storeCurrentParamsAsCustomPreset("Custom");
     }
 
@@ -99,7 +102,7 @@ void G330PresetManager::loadPresetFromJsonData(const std::string &presetName, co
         throw std::invalid_argument("Invalid JSON data");
     }
     // store current parameters to  "Custom"
-    if(currentPreset_ == "Custom") {
+    if(currentPreset_ == "Custom" || customPresets_.find("Custom") == customPresets_.end()) {
         storeCurrentParamsAsCustomPreset("Custom");
     }
     loadPresetFromJsonValue(presetName, root);
@@ -110,7 +113,7 @@ void G330PresetManager::loadPresetFromJsonFile(const std::string &filePath) {
     std::ifstream ifs(filePath);
     ifs >> root;
     // store current parameters to  "Custom"
-    if(currentPreset_ == "Custom") {
+    if(currentPreset_ == "Custom" || customPresets_.find("Custom") == customPresets_.end()) {
         storeCurrentParamsAsCustomPreset("Custom");
     }
     loadPresetFromJsonValue(filePath, root);
@@ -282,7 +285,7 @@ void G330PresetManager::storeCurrentParamsAsCustomPreset(const std::string &pres
         preset.depthWorkMode      = depthWorkModeManager->getCurrentDepthWorkMode().name;
     }
 
-    if(customPresets_.find(presetName) == customPresets_.end()) {
+    if(std::find(availablePresets_.begin(), availablePresets_.end(), presetName) == availablePresets_.end()) {
         availablePresets_.emplace_back(presetName);
     }
     customPresets_[presetName] = preset;
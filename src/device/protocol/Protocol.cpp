@@ -5,6 +5,8 @@
 #include "logger/Logger.hpp"
 #include "exception/ObException.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
 
 namespace libobsensor {
@@ -135,6 +137,7 @@ HpStatus execute(const std::shared_ptr<IVendorDataPort> &dataPort, uint8_t *reqD
     uint16_t opcode       = ((ReqHeader *)(reqData))->opcode;
     uint16_t nRetriesLeft = HP_NOT_READY_RETRIES;
     uint32_t exceptRecLen = getExpectedRespSize(static_cast<HpOpCodes>(opcode));
+    uint32_t retryDelayMs = HP_RETRY_INITIAL_DELAY_MS;
 
     while(nRetriesLeft-- > 0)  // loop until device is ready
     {
@@ -160,16 +163,18 @@ HpStatus execute(const std::shared_ptr<IVendorDataPort> &dataPort, uint8_t *reqD
             break;
         }
 
-        // Retry after delay
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        // Retry after delay, a busy device is usually ready again within a few milliseconds
+        if(nRetriesLeft > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(retryDelayMs));
+            retryDelayMs = std::min<uint32_t>(retryDelayMs * 2, HP_RETRY_MAX_DELAY_MS);
+        }
     }
     return hpStatus;
 }
 
 uint16_t generateRequestId() {
-    static uint16_t requestId = 0;
-    requestId++;
-    return requestId;
+    static std::atomic<uint16_t> requestId(0);  // requests are sent to several devices concurrently
+    return ++requestId;
 }
 
 GetPropertyReq *initGetPropertyReq(uint8_t *dataBuf, uint32_t propertyId) {
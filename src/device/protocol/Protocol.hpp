@@ -17,7 +17,9 @@ namespace protocol {
 #define HP_REQ_HEADER_SIZE sizeof(ReqHeader)
 #define HP_RESP_HEADER_SIZE sizeof(RespHeader)
 
-#define HP_NOT_READY_RETRIES 2
+#define HP_NOT_READY_RETRIES 7       // Attempts of a request while the device is busy or responds to an earlier request
+#define HP_RETRY_INITIAL_DELAY_MS 2  // Delay before the first retry, doubled for each following retry
+#define HP_RETRY_MAX_DELAY_MS 64     // Maximum delay between two attempts (2+4+...+64 = 126ms waited at most)
 
 enum HpOpCodes {
     OPCODE_GET_PROPERTY        = 1,
@@ -10,13 +10,31 @@ namespace libobsensor {
 
 const size_t DEFAULT_FRAME_QUEUE_CAPACITY = 10;
 
-FilterExtension::FilterExtension(const std::string &name) : name_(name), enabled_(true), configChanged_(false) {
+FilterExtension::FilterExtension(const std::string &name)
+    : name_(name),
+      enabled_(true),
+      configVersion_(0),
+      appliedConfigVersion_(0),
+      configApplying_(false),
+      appliedConfigSnapshot_(0),
+      processedFrameCount_(0),
+      copiedDataBytes_(0),
+      copiedMetadataBytes_(0),
+      processThreadCount_(1),
+      inFlightCount_(0),
+      nextInputSequence_(0),
+      nextOutputSequence_(0) {
     srcFrameQueue_ = std::make_shared<FrameQueue<const Frame>>(DEFAULT_FRAME_QUEUE_CAPACITY);  // todo： read from config file to set the size of frame queue
+    srcFrameQueue_->setExecutor(TaskExecutor::getSharedInstance());
     LOG_DEBUG("Filter {} created with frame queue capacity {}", name_, srcFrameQueue_->capacity());
 }
 
 FilterExtension::~FilterExtension() noexcept {
     reset();
+    if(processedFrameCount_ > 0) {
+        LOG_DEBUG("Filter {}: {} frames processed, {} bytes of data and {} bytes of metadata copied", name_, processedFrameCount_.load(),
+                  copiedDataBytes_.load(), copiedMetadataBytes_.load());
+    }
 }
 
 const std::string &FilterExtension::getName() const {
@@ -26,29 +44,92 @@ const std::string &FilterExtension::getName() const {
 void FilterExtension::pushFrame(std::shared_ptr<const Frame> frame) {
     if(!srcFrameQueue_->isStarted()) {
         srcFrameQueue_->start([&](std::shared_ptr<const Frame> frameToProcess) {
-            std::shared_ptr<Frame> rstFrame;
-            if(enabled_) {
-                checkAndUpdateConfig();
-                BEGIN_TRY_EXECUTE({ rstFrame = process(frameToProcess); })
-                CATCH_EXCEPTION_AND_EXECUTE({  // catch all exceptions to avoid crashing on the inner thread
-                    LOG_WARN("Filter {}: exception caught while processing frame {}#{}, this frame will be dropped", name_, frameToProcess->getType(),
-                             frameToProcess->getNumber());
-                    return;
-                })
-            }
-            else {
-                rstFrame = FrameFactory::createFrameFromOtherFrame(frameToProcess, true);
-            }
-            std::unique_lock<std::mutex> lock(callbackMutex_);
-            if(callback_ && rstFrame) {
-                callback_(rstFrame);
+            if(processExecutor_ && isConcurrentProcessSupported()) {
+                processFrameInOrder(frameToProcess);
+                return;
             }
+            outputFrame(processFrame(frameToProcess));
         });
         LOG_DEBUG("Filter {}: start frame queue", name_);
     }
     srcFrameQueue_->enqueue(frame);
 }
 
+std::shared_ptr<Frame> FilterExtension::processFrame(std::shared_ptr<const Frame> frame) {
+    auto &copyStatistics = getThreadFrameCopyStatistics();
+    auto  copiedBefore   = copyStatistics;
+
+    std::shared_ptr<Frame> rstFrame;
+    if(!enabled_) {
+        rstFrame = FrameFactory::cloneFrame(frame);  // pass through without copying the data
+    }
+    else {
+        checkAndUpdateConfig();
+        BEGIN_TRY_EXECUTE({ rstFrame = process(frame); })
+        CATCH_EXCEPTION_AND_EXECUTE({  // catch all exceptions to avoid crashing on the inner thread
+            LOG_WARN("Filter {}: exception caught while processing frame {}#{}, this frame will be dropped", name_, frame->getType(), frame->getNumber());
+            rstFrame = nullptr;
+        })
+    }
+
+    processedFrameCount_.fetch_add(1, std::memory_order_relaxed);
+    copiedDataBytes_.fetch_add(copyStatistics.dataBytes - copiedBefore.dataBytes, std::memory_order_relaxed);
+    copiedMetadataBytes_.fetch_add(copyStatistics.metadataBytes - copiedBefore.metadataBytes, std::memory_order_relaxed);
+    return rstFrame;
+}
+
+void FilterExtension::processFrameInOrder(std::shared_ptr<const Frame> frame) {
+    uint64_t sequence;
+    {
+        // wait for a free worker, which also holds back the frame queue to drop the frames on it if the processing is too slow
+        std::unique_lock<std::mutex> lock(orderMutex_);
+        orderCv_.wait(lock, [this]() { return inFlightCount_ < processThreadCount_; });
+        inFlightCount_++;
+        sequence = nextInputSequence_++;
+    }
+
+    processExecutor_->post([this, frame, sequence]() {
+        auto rstFrame = processFrame(frame);
+
+        // the result is output by the worker which finishes the oldest frame in flight, together with the newer results already done
+        std::unique_lock<std::mutex>        outputLock(outputMutex_);
+        std::vector<std::shared_ptr<Frame>> readyFrames;
+        {
+            std::unique_lock<std::mutex> lock(orderMutex_);
+            pendingResults_[sequence] = rstFrame;
+            while(!pendingResults_.empty() && pendingResults_.begin()->first == nextOutputSequence_) {
+                readyFrames.push_back(pendingResults_.begin()->second);  // null if the frame is dropped
+                pendingResults_.erase(pendingResults_.begin());
+                nextOutputSequence_++;
+            }
+        }
+        for(auto &readyFrame: readyFrames) {
+            BEGIN_TRY_EXECUTE({ outputFrame(readyFrame); })
+            CATCH_EXCEPTION
+        }
+        {
+            std::unique_lock<std::mutex> lock(orderMutex_);
+            inFlightCount_ -= static_cast<uint32_t>(readyFrames.size());
+        }
+        orderCv_.notify_all();
+    });
+}
+
+FilterCopyStatistics FilterExtension::getCopyStatistics() const {
+    FilterCopyStatistics statistics;
+    statistics.frameCount    = processedFrameCount_.load(std::memory_order_relaxed);
+    statistics.dataBytes     = copiedDataBytes_.load(std::memory_order_relaxed);
+    statistics.metadataBytes = copiedMetadataBytes_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void FilterExtension::outputFrame(std::shared_ptr<Frame> frame) {
+    std::unique_lock<std::mutex> lock(callbackMutex_);
+    if(callback_ && frame) {
+        callback_(frame);
+    }
+}
+
 void FilterExtension::setCallback(FilterCallback cb) {
     std::unique_lock<std::mutex> lock(callbackMutex_);
     callback_ = cb;
@@ -58,9 +139,30 @@ void FilterExtension::resizeFrameQueue(size_t size) {
     srcFrameQueue_->resize(size);
 }
 
+void FilterExtension::setTaskExecutor(std::shared_ptr<TaskExecutor> executor) {
+    srcFrameQueue_->setExecutor(executor);
+}
+
+void FilterExtension::setProcessThreadCount(uint32_t threadCount) {
+    std::unique_lock<std::mutex> lock(orderMutex_);
+    if(threadCount == 0) {
+        threadCount = 1;
+    }
+    if(threadCount == processThreadCount_) {
+        return;
+    }
+    processThreadCount_ = threadCount;
+    processExecutor_    = threadCount > 1 ? std::make_shared<TaskExecutor>(threadCount, false) : nullptr;
+    LOG_DEBUG("Filter {}: process thread count set to {}", name_, threadCount);
+}
+
 void FilterExtension::reset() {
     srcFrameQueue_->flush();
     srcFrameQueue_->reset();
+
+    // wait for the frames still being processed on the workers
+    std::unique_lock<std::mutex> lock(orderMutex_);
+    orderCv_.wait(lock, [this]() { return inFlightCount_ == 0; });
 }
 
 void FilterExtension::enable(bool en) {
@@ -118,10 +220,11 @@ double parseFilterConfigValue(const std::string &valueStr, OBFilterConfigValueTy
 }
 
 const std::vector<OBFilterConfigSchemaItem> &FilterExtension::getConfigSchemaVec() {
-    if(!configSchemaVec_.empty()) {
-        return configSchemaVec_;
-    }
+    std::call_once(configSchemaOnceFlag_, [this]() { compileConfigSchema(); });
+    return configSchemaVec_;
+}
 
+void FilterExtension::compileConfigSchema() {
     // csv format: name，type， min，max，step，default，description
     auto              schemaCSV = getConfigSchema();
     std::stringstream ss(schemaCSV);
@@ -151,65 +254,69 @@ const std::vector<OBFilterConfigSchemaItem> &FilterExtension::getConfigSchemaVec
         configSchemaVec_.push_back(item);
     }
 
-    return configSchemaVec_;
+    // compile the schema items into the indexed value array, initialized with the default values
+    configValues_.reset(new std::atomic<double>[configSchemaVec_.size()]);
+    for(size_t i = 0; i < configSchemaVec_.size(); i++) {
+        configIndexMap_.insert({ configSchemaVec_[i].name, i });
+        configValues_[i].store(configSchemaVec_[i].def, std::memory_order_relaxed);
+    }
+    for(auto &snapshot: configSnapshots_) {
+        snapshot.reserve(configSchemaVec_.size());
+    }
 }
 
-void FilterExtension::setConfigValue(const std::string &configName, double value) {
-    auto schemaVec = getConfigSchemaVec();
+size_t FilterExtension::getConfigIndex(const std::string &configName) {
+    auto &schemaVec = getConfigSchemaVec();
     if(schemaVec.empty()) {
         throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config schema is empty, doesn't have any config value");
     }
 
-    if(configMap_.empty()) {
-        for(auto &item: schemaVec) {
-            configMap_[item.name] = item.def;
-        }
-    }
-
-    auto it =
-        std::find_if(configSchemaVec_.begin(), configSchemaVec_.end(), [&configName](const OBFilterConfigSchemaItem &item) { return item.name == configName; });
-    if(it == configSchemaVec_.end()) {
+    auto it = configIndexMap_.find(configName);
+    if(it == configIndexMap_.end()) {
         throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config item " << configName << " doesn't exist");
     }
-    if(value < it->min || value > it->max) {
+    return it->second;
+}
+
+void FilterExtension::setConfigValue(const std::string &configName, double value) {
+    auto  index = getConfigIndex(configName);
+    auto &item  = configSchemaVec_[index];
+    if(value < item.min || value > item.max) {
         throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config item " << configName << " value " << value
-                                                                 << " out of range [" << it->min << ", " << it->max << "]");
+                                                                 << " out of range [" << item.min << ", " << item.max << "]");
     }
 
     std::unique_lock<std::mutex> lock(configMutex_);
-    if(configMap_[configName] != value) {
-        configChanged_         = true;
-        configMap_[configName] = value;  // store the value in the map, will be applied in the next process() call
+    if(configValues_[index].load(std::memory_order_relaxed) != value) {
+        // store the value in the array, will be applied in the next process() call
+        configVersion_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        configValues_[index].store(value, std::memory_order_relaxed);
+        configVersion_.fetch_add(1, std::memory_order_release);
         LOG_DEBUG("Filter {}: config item {} value set to {}", name_, configName, value);
     }
 }
 
 void FilterExtension::setConfigValueSync(const std::string &name, double value) {
     setConfigValue(name, value);
-    checkAndUpdateConfig();
-}
 
-double FilterExtension::getConfigValue(const std::string &configName) {
-    auto schemaVec = getConfigSchemaVec();
-    if(schemaVec.empty()) {
-        throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config schema is empty, doesn't have any config value");
-    }
-
-    if(configMap_.empty()) {
-        for(auto &item: schemaVec) {
-            configMap_[item.name] = item.def;
+    // the config may be being applied by a processing thread, wait for it and apply the rest
+    auto version = configVersion_.load(std::memory_order_acquire);
+    while(appliedConfigVersion_.load(std::memory_order_acquire) < version) {
+        checkAndUpdateConfig();
+        if(appliedConfigVersion_.load(std::memory_order_acquire) < version) {
+            std::this_thread::yield();
         }
     }
+}
 
-    auto it = configMap_.find(configName);
-    if(it == configMap_.end()) {
-        throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config item " << configName << " doesn't exist");
-    }
-    return it->second;
+double FilterExtension::getConfigValue(const std::string &configName) {
+    auto index = getConfigIndex(configName);
+    return configValues_[index].load(std::memory_order_relaxed);
 }
 
 OBFilterConfigSchemaItem FilterExtension::getConfigSchemaItem(const std::string &name) {
-    auto                     schemaVec  = getConfigSchemaVec();
+    auto                    &schemaVec  = getConfigSchemaVec();
     OBFilterConfigSchemaItem resultItem = {};
     if(schemaVec.empty()) {
         return resultItem;
@@ -242,37 +349,90 @@ std::string filterConfigValueToString(double value, OBFilterConfigValueType valu
     return "";
 }
 
+uint64_t FilterExtension::loadConfigSnapshot(FilterConfigValues &values) const {
+    values.resize(configSchemaVec_.size());
+    while(true) {
+        auto version = configVersion_.load(std::memory_order_acquire);
+        if(version & 1) {
+            std::this_thread::yield();  // a setter is writing
+            continue;
+        }
+        for(size_t i = 0; i < values.size(); i++) {
+            values[i] = configValues_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(configVersion_.load(std::memory_order_relaxed) == version) {
+            return version;
+        }
+    }
+}
+
+void FilterExtension::applyConfigSnapshot(const FilterConfigValues &values) {
+    if(updateTypedConfig(values)) {
+        return;
+    }
+
+    std::vector<std::string> configVec;
+    for(size_t i = 0; i < values.size(); i++) {
+        configVec.push_back(filterConfigValueToString(values[i], configSchemaVec_[i].type));
+    }
+    updateConfig(configVec);
+}
+
 void FilterExtension::checkAndUpdateConfig() {
-    if(configChanged_) {
-        std::unique_lock<std::mutex> lock(configMutex_);
+    if(configVersion_.load(std::memory_order_acquire) == appliedConfigVersion_.load(std::memory_order_acquire)) {
+        return;
+    }
 
-        std::vector<std::string> configVec;
-        for(auto &item: configSchemaVec_) {
-            auto it = configMap_.find(item.name);
-            if(it == configMap_.end()) {
-                throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config item " << item.name << " doesn't exist");
-            }
-            auto valueStr = filterConfigValueToString(it->second, item.type);
-            configVec.push_back(valueStr);
-        }
-        updateConfig(configVec);
+    // only one processing thread applies the config, the others go on with the current config
+    bool applying = false;
+    if(!configApplying_.compare_exchange_strong(applying, true, std::memory_order_acquire)) {
+        return;
+    }
 
-        configChanged_ = false;
+    auto &appliedSnapshot = configSnapshots_[appliedConfigSnapshot_];
+    auto &backSnapshot    = configSnapshots_[appliedConfigSnapshot_ ^ 1];
+    auto  version         = loadConfigSnapshot(backSnapshot);
+    try {
+        if(backSnapshot != appliedSnapshot) {
+            applyConfigSnapshot(backSnapshot);
+            appliedConfigSnapshot_ ^= 1;
+        }
+    }
+    catch(...) {
+        appliedSnapshot.clear();  // the filter state is unknown, apply the next change in full
+        appliedConfigVersion_.store(version, std::memory_order_release);
+        configApplying_.store(false, std::memory_order_release);
+        throw;
     }
+    appliedConfigVersion_.store(version, std::memory_order_release);
+    configApplying_.store(false, std::memory_order_release);
 }
 
 void FilterExtension::updateConfigCache(std::vector<std::string> &params) {
-    auto schemaVec = getConfigSchemaVec();
+    auto &schemaVec = getConfigSchemaVec();
     if(schemaVec.empty()) {
         throw invalid_value_exception(utils::string::to_string() << "Filter@" << name_ << ": config schema is empty, doesn't have any config value");
     }
 
     if(schemaVec.size() == params.size()) {
+        FilterConfigValues values;
         for(size_t i = 0; i < schemaVec.size(); i++) {
-            auto name        = schemaVec[i].name;
-            auto type        = schemaVec[i].type;
-            auto value       = parseFilterConfigValue(params[i], type);
-            configMap_[name] = value;
+            values.push_back(parseFilterConfigValue(params[i], schemaVec[i].type));
+        }
+
+        std::unique_lock<std::mutex> lock(configMutex_);
+        bool                         changed = false;
+        for(size_t i = 0; i < values.size() && !changed; i++) {
+            changed = configValues_[i].load(std::memory_order_relaxed) != values[i];
+        }
+        if(changed) {
+            configVersion_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for(size_t i = 0; i < values.size(); i++) {
+                configValues_[i].store(values[i], std::memory_order_relaxed);
+            }
+            configVersion_.fetch_add(1, std::memory_order_release);
         }
     }
 }
@@ -289,6 +449,10 @@ void FilterDecorator::updateConfig(std::vector<std::string> &params) {
     updateConfigCache(params);
 }
 
+bool FilterDecorator::updateTypedConfig(const FilterConfigValues &values) {
+    return baseFilter_->updateTypedConfig(values);
+}
+
 const std::string &FilterDecorator::getConfigSchema() const {
     return baseFilter_->getConfigSchema();
 }
@@ -307,10 +471,17 @@ std::shared_ptr<Frame> FilterDecorator::process(std::shared_ptr<const Frame> fra
 
     checkAndUpdateConfig();
 
+    if(baseFilter_->isConcurrentProcessSupported()) {
+        return baseFilter_->process(frame);
+    }
     std::unique_lock<std::mutex> lock(processMutex_);
     return baseFilter_->process(frame);
 }
 
+bool FilterDecorator::isConcurrentProcessSupported() const {
+    return baseFilter_->isConcurrentProcessSupported();
+}
+
 std::shared_ptr<IFilterBase> FilterDecorator::getBaseFilter() const {
     return baseFilter_;
 }
@@ -6,6 +6,7 @@
 #include "frame/FrameQueue.hpp"
 #include "stream/StreamProfile.hpp"
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -14,6 +15,12 @@
 
 namespace libobsensor {
 
+struct FilterCopyStatistics {
+    uint64_t frameCount;     // frames processed
+    uint64_t dataBytes;      // frame data bytes copied while processing the frames
+    uint64_t metadataBytes;  // frame metadata bytes copied while processing the frames
+};
+
 class FilterExtension : public IFilter {
 public:
     FilterExtension(const std::string &name);
@@ -36,10 +43,34 @@ public:
     void         setCallback(FilterCallback cb) override;
     virtual void resizeFrameQueue(size_t size) override;
 
+    // Process the frames on the task executor instead of a dedicated thread, default is the shared executor configured by
+    // Misc.SharedTaskExecutorEnable. Should be called before the first frame is pushed.
+    void setTaskExecutor(std::shared_ptr<TaskExecutor> executor);
+
+    // Process up to threadCount consecutive frames at the same time on an own worker pool, the results are still output in the input order. Only
+    // takes effect if isConcurrentProcessSupported() returns true; 1 (default) processes the frames one by one. Should be called before the first
+    // frame is pushed.
+    void setProcessThreadCount(uint32_t threadCount);
+
+    // Bytes copied by this filter for the frames pushed by pushFrame(), including the pass-through frames output while the filter is disabled
+    FilterCopyStatistics getCopyStatistics() const;
+
 protected:
     void updateConfigCache(std::vector<std::string> &params);
+
+    // Apply the config values changed since the last call, called before processing each frame. Costs a single atomic load if nothing changed.
     void checkAndUpdateConfig();
 
+private:
+    void     compileConfigSchema();
+    size_t   getConfigIndex(const std::string &name);
+    uint64_t loadConfigSnapshot(FilterConfigValues &values) const;
+    void     applyConfigSnapshot(const FilterConfigValues &values);
+
+    std::shared_ptr<Frame> processFrame(std::shared_ptr<const Frame> frame);
+    void                   processFrameInOrder(std::shared_ptr<const Frame> frame);
+    void                   outputFrame(std::shared_ptr<Frame> frame);
+
 private:
     const std::string name_;
     std::atomic<bool> enabled_;
@@ -49,11 +80,35 @@ private:
 
     std::shared_ptr<FrameQueue<const Frame>> srcFrameQueue_;
 
-    std::mutex                            configMutex_;
-    std::atomic<bool>                     configChanged_;
-    std::map<std::string, double>         configMap_;
+    std::once_flag                        configSchemaOnceFlag_;
     std::vector<OBFilterConfigSchemaItem> configSchemaVec_;
     std::vector<std::vector<std::string>> configSchemaStrSplittedVec_;
+    std::map<std::string, size_t>         configIndexMap_;
+
+    // The config values indexed in the schema order. They are written by the setters under configMutex_, with configVersion_ as a sequence lock (odd
+    // while writing), and copied without lock into the back snapshot by the processing thread, which swaps it in once applied to the filter.
+    std::mutex                             configMutex_;
+    std::unique_ptr<std::atomic<double>[]> configValues_;
+    std::atomic<uint64_t>                  configVersion_;
+    std::atomic<uint64_t>                  appliedConfigVersion_;
+    std::atomic<bool>                      configApplying_;  // held by the processing thread applying the config
+    FilterConfigValues                     configSnapshots_[2];
+    uint32_t                               appliedConfigSnapshot_;
+
+    std::atomic<uint64_t> processedFrameCount_;
+    std::atomic<uint64_t> copiedDataBytes_;
+    std::atomic<uint64_t> copiedMetadataBytes_;
+
+    // ordered concurrent processing, see setProcessThreadCount
+    std::mutex                                 orderMutex_;
+    std::condition_variable                    orderCv_;
+    std::mutex                                 outputMutex_;
+    uint32_t                                   processThreadCount_;
+    uint32_t                                   inFlightCount_;
+    uint64_t                                   nextInputSequence_;
+    uint64_t                                   nextOutputSequence_;
+    std::map<uint64_t, std::shared_ptr<Frame>> pendingResults_;
+    std::shared_ptr<TaskExecutor>              processExecutor_;  // declared last to be joined before the other members are destroyed
 };
 
 class FilterDecorator : public FilterExtension {
@@ -63,8 +118,10 @@ public:
 
     virtual void                   reset() override;
     virtual void                   updateConfig(std::vector<std::string> &params) override;
+    virtual bool                   updateTypedConfig(const FilterConfigValues &values) override;
     virtual const std::string     &getConfigSchema() const override;
     virtual std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    virtual bool                   isConcurrentProcessSupported() const override;
 
     std::shared_ptr<IFilterBase> getBaseFilter() const;
 
@@ -15,6 +15,9 @@ namespace libobsensor {
 
 typedef std::function<void(std::shared_ptr<Frame>)> FilterCallback;
 
+// Config values in the order of the config schema items, the int and boolean values are stored as double too
+typedef std::vector<double> FilterConfigValues;
+
 class IFilterBase {
 public:
     virtual ~IFilterBase() noexcept = default;
@@ -23,10 +26,22 @@ public:
     virtual void               updateConfig(std::vector<std::string> &params) = 0;
     virtual const std::string &getConfigSchema() const                        = 0;
 
+    // Typed config path used by FilterExtension to apply the changed config values without formatting and parsing strings.
+    // Returns false if not supported, then the values are formatted as strings and passed to updateConfig().
+    virtual bool updateTypedConfig(const FilterConfigValues &values) {
+        (void)values;
+        return false;
+    }
+
     virtual void reset() = 0;  // Stop thread, clean memory, reset status
 
     // Synchronize
     virtual std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) = 0;
+
+    // Whether process() can be called on several frames at the same time (see FilterExtension::setProcessThreadCount)
+    virtual bool isConcurrentProcessSupported() const {
+        return false;
+    }
 };
 
 class IFilterExtension {
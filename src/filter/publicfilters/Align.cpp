@@ -37,21 +37,33 @@ Align::~Align() noexcept {
 
 void Align::updateConfig(std::vector<std::string> &params) {
     // AlignType, TargetDistortion, GapFillCopy
-    std::lock_guard<std::recursive_mutex> lock(alignMutex_);
     if(params.size() != 3) {
         throw invalid_value_exception("Align config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        int align_to_stream = std::stoi(params[0]);
-        if(align_to_stream >= OB_STREAM_IR && align_to_stream <= OB_STREAM_IR_RIGHT) {
-            align_to_stream_ = (OBStreamType)align_to_stream;
+        for(auto &param: params) {
+            values.push_back(std::stoi(param));
         }
-        add_target_distortion_ = bool(std::stoi(params[1]));
-        gap_fill_copy_         = bool(std::stoi(params[2]));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("Align config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool Align::updateTypedConfig(const FilterConfigValues &values) {
+    std::lock_guard<std::recursive_mutex> lock(alignMutex_);
+    if(values.size() != 3) {
+        throw invalid_value_exception("Align config error: params size not match");
+    }
+    int align_to_stream = static_cast<int>(values[0]);
+    if(align_to_stream >= OB_STREAM_IR && align_to_stream <= OB_STREAM_IR_RIGHT) {
+        align_to_stream_ = (OBStreamType)align_to_stream;
+    }
+    add_target_distortion_ = static_cast<int>(values[1]) != 0;
+    gap_fill_copy_         = static_cast<int>(values[2]) != 0;
+    return true;
 }
 
 const std::string &Align::getConfigSchema() const {
@@ -69,7 +81,7 @@ std::shared_ptr<Frame> Align::process(std::shared_ptr<const Frame> frame) {
     std::lock_guard<std::recursive_mutex> lock(alignMutex_);
     if(!frame->is<FrameSet>()) {
         LOG_WARN("Invalid frame!");
-        return FrameFactory::createFrameFromOtherFrame(frame, true);
+        return FrameFactory::cloneFrame(frame);
     }
 
     auto newFrame = FrameFactory::createFrameFromOtherFrame(frame);
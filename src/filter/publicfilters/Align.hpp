@@ -21,6 +21,7 @@ public:
     }
 
     void               updateConfig(std::vector<std::string> &params) override;
+    bool               updateTypedConfig(const FilterConfigValues &values) override;
     const std::string &getConfigSchema() const override;
 
     void reset() override;
@@ -4,13 +4,20 @@
 #include "AlignImpl.hpp"
 #include "logger/Logger.hpp"
 #include "exception/ObException.hpp"
+#include "environment/EnvConfig.hpp"
+#include "utils/TaskExecutor.hpp"
 #include <fstream>
 #include <iostream>
 #include <chrono>
 #include <complex>
+#include <climits>
+#include <thread>
 
 namespace libobsensor {
 
+#define D2C_MIN_BAND_ROWS 32  // do not split the small frames, the merge costs more than the transform
+#define D2C_MAX_BAND_COUNT 16
+
 static inline void addDistortion(const OBCameraDistortion &distort_param, const float pt_ud[2], float pt_d[2]) {
     float k1 = distort_param.k1, k2 = distort_param.k2, k3 = distort_param.k3;
     float k4 = distort_param.k4, k5 = distort_param.k5, k6 = distort_param.k6;
@@ -78,9 +85,12 @@ const __m128  AlignImpl::TWO        = _mm_set_ps1(2);
 const __m128i AlignImpl::ZERO       = _mm_setzero_si128();
 const __m128  AlignImpl::ZERO_F     = _mm_set_ps1(0.0);
 
-AlignImpl::AlignImpl() : initialized_(false) {
+AlignImpl::AlignImpl() : initialized_(false), thread_count_(1), avx2_enabled_(true) {
     depth_unit_mm_ = 1.0;
     r2_max_loc_    = 0.0;
+    int thread_count = 1;
+    EnvConfig::getInstance()->getIntValue("Misc.AlignThreadCount", thread_count);
+    setThreadCount(thread_count < 0 ? 1 : static_cast<uint32_t>(thread_count));
     memset(&depth_intric_, 0, sizeof(OBCameraIntrinsic));
     memset(&depth_disto_, 0, sizeof(OBCameraDistortion));
     memset(&rgb_intric_, 0, sizeof(OBCameraIntrinsic));
@@ -138,9 +148,39 @@ void AlignImpl::initialize(OBCameraIntrinsic depth_intrin, OBCameraDistortion de
 
 void AlignImpl::reset() {
     clearMatrixCache();
+    d2c_bands_.clear();
     initialized_ = false;
 }
 
+void AlignImpl::setThreadCount(uint32_t thread_count) {
+    if(thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+    if(thread_count == 0) {
+        thread_count = 1;
+    }
+    if(thread_count > D2C_MAX_BAND_COUNT) {
+        thread_count = D2C_MAX_BAND_COUNT;
+    }
+    if(thread_count == thread_count_ && (thread_count == 1 || executor_)) {
+        return;
+    }
+    thread_count_ = thread_count;
+    executor_.reset();
+    if(thread_count_ > 1) {
+        // the calling thread processes a band as well
+        executor_ = std::make_shared<TaskExecutor>(thread_count_ - 1, false);
+    }
+}
+
+void AlignImpl::enableAVX2(bool enable) {
+    avx2_enabled_ = enable;
+}
+
+bool AlignImpl::isAVX2Supported() {
+    return utils::isAVX2Supported();
+}
+
 float polynomial(float x, float a, float b, float c, float d) {
     return (a * x * x * x + b * x * x + c * x + d);
 }
@@ -276,13 +316,17 @@ void AlignImpl::clearMatrixCache() {
     rot_coeff_ht_z.clear();
 }
 
-template <typename T> void fillPixelGap(const int *u, const int *v, const int width, const int height, const T val, T *buffer, bool copy = true) {
+template <typename T>
+void fillPixelGap(const int *u, const int *v, const int width, const int height, const T val, T *buffer, bool copy = true, uint8_t *overwritten = nullptr) {
     // point index and output depth buffer should be checked outside
 
     if(copy) {
         if((u[0] >= 0) && (u[0] < width) && (v[0] >= 0) && (v[0] < height)) {
             int pos          = v[0] * width + u[0];
             buffer[pos]      = val;
+            if(overwritten) {
+                overwritten[pos] = 1;
+            }
             bool right_valid = (u[0] + 1) < width, bottom_valid = (v[0] + 1) < height;
             if(right_valid) {
                 if(buffer[pos + 1] > val)
@@ -313,7 +357,8 @@ template <typename T> void fillPixelGap(const int *u, const int *v, const int wi
     }
 }
 
-void AlignImpl::transferDepth(const float *x, const float *y, const float *z, const int npts, const int point_index, uint16_t *out_depth, int *map) {
+void AlignImpl::transferDepth(const float *x, const float *y, const float *z, const int npts, const int point_index, uint16_t *out_depth, int *map,
+                              D2CBand *band) {
     int nchannels = gap_fill_copy_ ? 1 : 2;
 
     for(int i = 0; i < npts; i++) {
@@ -341,13 +386,24 @@ void AlignImpl::transferDepth(const float *x, const float *y, const float *z, co
 
         if(map) {  // coordinates mapping for C2D
             if((u_rgb[0] >= 0) && (u_rgb[0] < rgb_intric_.width) && (v_rgb[0] >= 0) && (v_rgb[0] < rgb_intric_.height)) {
-                map[2 * (point_index + i)]     = u_rgb[0];
-                map[2 * (point_index + i) + 1] = v_rgb[0];
+                map[point_index + i] = v_rgb[0] * rgb_intric_.width + u_rgb[0];
             }
         }
 
         if(out_depth) {
-            fillPixelGap<uint16_t>(u_rgb, v_rgb, rgb_intric_.width, rgb_intric_.height, cur_depth, out_depth, gap_fill_copy_);
+            if(band) {
+                // rows may be out of the frame, they are clamped on merging
+                int top    = gap_fill_copy_ ? v_rgb[0] : (v_rgb[0] < v_rgb[1] ? v_rgb[0] : v_rgb[1]);
+                int bottom = gap_fill_copy_ ? v_rgb[0] + 1 : (v_rgb[0] < v_rgb[1] ? v_rgb[1] : v_rgb[0]);
+                if(top < band->min_row)
+                    band->min_row = top;
+                if(bottom + 1 > band->max_row)
+                    band->max_row = bottom + 1;
+                fillPixelGap<uint16_t>(u_rgb, v_rgb, rgb_intric_.width, rgb_intric_.height, cur_depth, out_depth, gap_fill_copy_, band->overwritten.data());
+            }
+            else {
+                fillPixelGap<uint16_t>(u_rgb, v_rgb, rgb_intric_.width, rgb_intric_.height, cur_depth, out_depth, gap_fill_copy_);
+            }
         }
     }
 }
@@ -437,66 +493,61 @@ void AlignImpl::distortedWithSSE(__m128 &tx, __m128 &ty, const __m128 x2, const
 }
 
 void AlignImpl::D2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x, const float *coeff_mat_y, const float *coeff_mat_z,
-                              int *map) {
-
-    int       channel     = (gap_fill_copy_ ? 1 : 2);
-    float    *ptr_coeff_x = (float *)coeff_mat_x;
-    float    *ptr_coeff_y = (float *)coeff_mat_y;
-    float    *ptr_coeff_z = (float *)coeff_mat_z;
-    uint16_t *ptr_depth   = (uint16_t *)depth_buffer;
-
-    for(int v = 0; v < depth_intric_.height; v += 1) {
-        int depth_idx = v * depth_intric_.width;
-        for(int u = 0; u < depth_intric_.width; u += 1) {
-            uint16_t depth = *ptr_depth++;
-            depth_idx++;
-            if(depth < EPSILON) {
-                ptr_coeff_x += channel;
-                ptr_coeff_y += channel;
-                ptr_coeff_z += channel;
-                continue;
-            }
-            // int   u_rgb[] = { -1, -1 };
-            // int   v_rgb[] = { -1, -1 };
-            float pixelx_f[2], pixely_f[2], dst[2];
-
-            bool skip_this_pixel = true;
-            for(int k = 0; k < channel; k++) {
-                float dst_x = depth * (*ptr_coeff_x++) + scaled_trans_[0];
-                float dst_y = depth * (*ptr_coeff_y++) + scaled_trans_[1];
-                dst[k]      = depth * (*ptr_coeff_z++) + scaled_trans_[2];
-
-                float tx = float(dst_x / dst[k]);
-                float ty = float(dst_y / dst[k]);
-
-                if(add_target_distortion_) {
-                    float pt_ud[2] = { tx, ty };
-                    float pt_d[2]  = { 0 };
-                    float r2_cur   = pt_ud[0] * pt_ud[0] + pt_ud[1] * pt_ud[1];
-                    if((OB_DISTORTION_BROWN_CONRADY_K6 == rgb_disto_.model) && (r2_max_loc_ != 0) && (r2_cur > r2_max_loc_)) {
-                        continue;  // break;
-                    }
-                    addDistortion(rgb_disto_, pt_ud, pt_d);
-                    tx = pt_d[0];
-                    ty = pt_d[1];
+                              int *map, int begin, int end, D2CBand *band) {
+
+    int          channel     = (gap_fill_copy_ ? 1 : 2);
+    const float *ptr_coeff_x = coeff_mat_x + begin * channel;
+    const float *ptr_coeff_y = coeff_mat_y + begin * channel;
+    const float *ptr_coeff_z = coeff_mat_z + begin * channel;
+
+    for(int depth_idx = begin; depth_idx < end; depth_idx++) {
+        uint16_t depth = depth_buffer[depth_idx];
+        if(depth < EPSILON) {
+            ptr_coeff_x += channel;
+            ptr_coeff_y += channel;
+            ptr_coeff_z += channel;
+            continue;
+        }
+        // int   u_rgb[] = { -1, -1 };
+        // int   v_rgb[] = { -1, -1 };
+        float pixelx_f[2], pixely_f[2], dst[2];
+
+        bool skip_this_pixel = true;
+        for(int k = 0; k < channel; k++) {
+            float dst_x = depth * (*ptr_coeff_x++) + scaled_trans_[0];
+            float dst_y = depth * (*ptr_coeff_y++) + scaled_trans_[1];
+            dst[k]      = depth * (*ptr_coeff_z++) + scaled_trans_[2];
+
+            float tx = float(dst_x / dst[k]);
+            float ty = float(dst_y / dst[k]);
+
+            if(add_target_distortion_) {
+                float pt_ud[2] = { tx, ty };
+                float pt_d[2]  = { 0 };
+                float r2_cur   = pt_ud[0] * pt_ud[0] + pt_ud[1] * pt_ud[1];
+                if((OB_DISTORTION_BROWN_CONRADY_K6 == rgb_disto_.model) && (r2_max_loc_ != 0) && (r2_cur > r2_max_loc_)) {
+                    continue;  // break;
                 }
-
-                pixelx_f[k]     = tx * rgb_intric_.fx + rgb_intric_.cx;
-                pixely_f[k]     = ty * rgb_intric_.fy + rgb_intric_.cy;
-                skip_this_pixel = false;
+                addDistortion(rgb_disto_, pt_ud, pt_d);
+                tx = pt_d[0];
+                ty = pt_d[1];
             }
 
-            if(!skip_this_pixel)
-                transferDepth(pixelx_f, pixely_f, dst, 1, depth_idx - 1, out_depth, map);
+            pixelx_f[k]     = tx * rgb_intric_.fx + rgb_intric_.cx;
+            pixely_f[k]     = ty * rgb_intric_.fy + rgb_intric_.cy;
+            skip_this_pixel = false;
         }
+
+        if(!skip_this_pixel)
+            transferDepth(pixelx_f, pixely_f, dst, 1, depth_idx, out_depth, map, band);
     }
 }
 
 void AlignImpl::D2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x, const float *coeff_mat_y, const float *coeff_mat_z,
-                           int *map) {
+                           int *map, int begin, int end, D2CBand *band) {
 
     int channel = (gap_fill_copy_ ? 1 : 2);
-    for(int i = 0; i < depth_intric_.width * depth_intric_.height; i += 8) {
+    for(int i = begin; i < end; i += 8) {
         __m128i depth_i16 = _mm_loadu_si128((__m128i *)(depth_buffer + i));
         __m128i depth_i[] = { _mm_unpacklo_epi16(depth_i16, ZERO), _mm_unpackhi_epi16(depth_i16, ZERO) };
 
@@ -566,7 +617,287 @@ void AlignImpl::D2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, co
                 _mm_storeu_ps(z + fold * 4, depth_o);
             }
 
-            transferDepth(x, y, z, 4, i + k * 4, out_depth, map);
+            transferDepth(x, y, z, 4, i + k * 4, out_depth, map, band);
+        }
+    }
+}
+
+#if defined(OB_AVX2_AVAILABLE)
+// Parameters of the AVX2 transform, the operations are the same as the SSE path (no FMA) so that the results are bit-exact
+struct AVX2TransformParam {
+    float                   fx, fy, cx, cy;
+    float                   k1, k2, k3, k4, k5, k6, p1, p2;
+    float                   trans[3];
+    float                   r2_max_loc;
+    bool                    add_target_distortion;
+    OBCameraDistortionModel model;
+    int                     channel;
+};
+
+// Transform the 8 depth pixels from depth_buffer[idx] to the pixel coordinates of the target frame, x/y/z are stored as [fold * 8 + i]
+// return false if the distortion model is not supported
+OB_AVX2_TARGET static bool transformWithAVX2(const AVX2TransformParam &param, const uint16_t *depth_buffer, const float *coeff_mat_x,
+                                                const float *coeff_mat_y, const float *coeff_mat_z, int idx, float *x, float *y, float *z) {
+    const __m256 two   = _mm256_set1_ps(2);
+    const __m256 one   = _mm256_set1_ps(1);
+    const int    chl   = param.channel;
+    bool         valid = true;
+
+    __m256i depth_i32 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(depth_buffer + idx)));
+    __m256  depth_avx = _mm256_cvtepi32_ps(depth_i32);
+
+    for(int fold = 0; fold < chl; fold++) {
+        __m256 coeff_avx1, coeff_avx2, coeff_avx3;
+        if(chl == 1) {
+            coeff_avx1 = _mm256_loadu_ps(coeff_mat_x + idx);
+            coeff_avx2 = _mm256_loadu_ps(coeff_mat_y + idx);
+            coeff_avx3 = _mm256_loadu_ps(coeff_mat_z + idx);
+        }
+        else {
+            const __m256i offset = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+            int           base   = idx * chl + fold;
+            coeff_avx1           = _mm256_i32gather_ps(coeff_mat_x + base, offset, 4);
+            coeff_avx2           = _mm256_i32gather_ps(coeff_mat_y + base, offset, 4);
+            coeff_avx3           = _mm256_i32gather_ps(coeff_mat_z + base, offset, 4);
+        }
+
+        __m256 X       = _mm256_add_ps(_mm256_mul_ps(depth_avx, coeff_avx1), _mm256_set1_ps(param.trans[0]));
+        __m256 Y       = _mm256_add_ps(_mm256_mul_ps(depth_avx, coeff_avx2), _mm256_set1_ps(param.trans[1]));
+        __m256 depth_o = _mm256_add_ps(_mm256_mul_ps(depth_avx, coeff_avx3), _mm256_set1_ps(param.trans[2]));
+
+        __m256 nx = _mm256_div_ps(X, depth_o);
+        __m256 ny = _mm256_div_ps(Y, depth_o);
+
+        if(param.add_target_distortion) {
+            __m256 x2 = _mm256_mul_ps(nx, nx);
+            __m256 y2 = _mm256_mul_ps(ny, ny);
+            __m256 r2 = _mm256_add_ps(x2, y2);
+
+            switch(param.model) {
+            case OB_DISTORTION_BROWN_CONRADY: {
+                __m256 xy   = _mm256_mul_ps(nx, ny);
+                __m256 r4   = _mm256_mul_ps(r2, r2);
+                __m256 r6   = _mm256_mul_ps(r4, r2);
+                __m256 k_jx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.k1), r2), _mm256_mul_ps(_mm256_set1_ps(param.k2), r4)),
+                                            _mm256_mul_ps(_mm256_set1_ps(param.k3), r6));
+                __m256 x_qx = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.p2), _mm256_add_ps(_mm256_mul_ps(x2, two), r2)),
+                                            _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(param.p1), xy), two));
+                __m256 y_qx = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.p1), _mm256_add_ps(_mm256_mul_ps(y2, two), r2)),
+                                            _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(param.p2), xy), two));
+                __m256 distx = _mm256_add_ps(_mm256_mul_ps(nx, k_jx), x_qx);
+                __m256 disty = _mm256_add_ps(_mm256_mul_ps(ny, k_jx), y_qx);
+                nx           = _mm256_add_ps(nx, distx);
+                ny           = _mm256_add_ps(ny, disty);
+            } break;
+            case OB_DISTORTION_BROWN_CONRADY_K6: {
+                __m256 r2_max_loc = _mm256_set1_ps(param.r2_max_loc);
+                __m256 flag = _mm256_or_ps(_mm256_cmp_ps(_mm256_setzero_ps(), r2_max_loc, _CMP_GE_OS), _mm256_cmp_ps(r2, r2_max_loc, _CMP_LT_OS));
+                depth_o     = _mm256_and_ps(depth_o, flag);
+
+                __m256 xy = _mm256_mul_ps(nx, ny);
+                __m256 r4 = _mm256_mul_ps(r2, r2);
+                __m256 r6 = _mm256_mul_ps(r4, r2);
+                __m256 k_jx =
+                    _mm256_div_ps(_mm256_add_ps(one, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.k1), r2),
+                                                                                 _mm256_mul_ps(_mm256_set1_ps(param.k2), r4)),
+                                                                   _mm256_mul_ps(_mm256_set1_ps(param.k3), r6))),
+                                  _mm256_add_ps(one, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.k4), r2),
+                                                                                 _mm256_mul_ps(_mm256_set1_ps(param.k5), r4)),
+                                                                   _mm256_mul_ps(_mm256_set1_ps(param.k6), r6))));
+                __m256 x_qx = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.p2), _mm256_add_ps(_mm256_mul_ps(x2, two), r2)),
+                                            _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(param.p1), xy), two));
+                __m256 y_qx = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(param.p1), _mm256_add_ps(_mm256_mul_ps(y2, two), r2)),
+                                            _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(param.p2), xy), two));
+                nx = _mm256_add_ps(_mm256_mul_ps(nx, k_jx), x_qx);
+                ny = _mm256_add_ps(_mm256_mul_ps(ny, k_jx), y_qx);
+            } break;
+            case OB_DISTORTION_KANNALA_BRANDT4: {
+                __m256 r = _mm256_sqrt_ps(r2);
+
+                // float theta=atan(r)
+                float r_[8]     = { 0 };
+                float theta_[8] = { 0 };
+                _mm256_storeu_ps(r_, r);
+                for(int i = 0; i < 8; i++) {
+                    theta_[i] = atan(r_[i]);
+                }
+
+                __m256 theta  = _mm256_loadu_ps(theta_);
+                __m256 theta2 = _mm256_mul_ps(theta, theta);
+                __m256 theta3 = _mm256_mul_ps(theta, theta2);
+                __m256 theta5 = _mm256_mul_ps(theta2, theta3);
+                __m256 theta7 = _mm256_mul_ps(theta2, theta5);
+                __m256 theta9 = _mm256_mul_ps(theta2, theta7);
+
+                __m256 theta_jx = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(theta, _mm256_mul_ps(_mm256_set1_ps(param.k1), theta3)), _mm256_mul_ps(_mm256_set1_ps(param.k2), theta5)),
+                                  _mm256_mul_ps(_mm256_set1_ps(param.k3), theta7)),
+                    _mm256_mul_ps(_mm256_set1_ps(param.k4), theta9));
+
+                nx = _mm256_mul_ps(_mm256_div_ps(theta_jx, r), nx);
+                ny = _mm256_mul_ps(_mm256_div_ps(theta_jx, r), ny);
+            } break;
+            default:
+                valid = false;
+                break;
+            }
+        }
+
+        __m256 pixelx = _mm256_add_ps(_mm256_mul_ps(nx, _mm256_set1_ps(param.fx)), _mm256_set1_ps(param.cx));
+        __m256 pixely = _mm256_add_ps(_mm256_mul_ps(ny, _mm256_set1_ps(param.fy)), _mm256_set1_ps(param.cy));
+        _mm256_storeu_ps(x + fold * 8, pixelx);
+        _mm256_storeu_ps(y + fold * 8, pixely);
+        _mm256_storeu_ps(z + fold * 8, depth_o);
+    }
+    return valid;
+}
+#endif
+
+void AlignImpl::D2CWithAVX2(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x, const float *coeff_mat_y, const float *coeff_mat_z,
+                            int *map, int begin, int end, D2CBand *band) {
+#if defined(OB_AVX2_AVAILABLE)
+    AVX2TransformParam param    = {};
+    param.fx                    = rgb_intric_.fx;
+    param.fy                    = rgb_intric_.fy;
+    param.cx                    = rgb_intric_.cx;
+    param.cy                    = rgb_intric_.cy;
+    param.k1                    = rgb_disto_.k1;
+    param.k2                    = rgb_disto_.k2;
+    param.k3                    = rgb_disto_.k3;
+    param.k4                    = rgb_disto_.k4;
+    param.k5                    = rgb_disto_.k5;
+    param.k6                    = rgb_disto_.k6;
+    param.p1                    = rgb_disto_.p1;
+    param.p2                    = rgb_disto_.p2;
+    param.trans[0]              = scaled_trans_[0];
+    param.trans[1]              = scaled_trans_[1];
+    param.trans[2]              = scaled_trans_[2];
+    param.r2_max_loc            = r2_max_loc_;
+    param.add_target_distortion = add_target_distortion_;
+    param.model                 = rgb_disto_.model;
+    param.channel               = (gap_fill_copy_ ? 1 : 2);
+
+    for(int i = begin; i < end; i += 8) {
+        float x[16] = { 0 };
+        float y[16] = { 0 };
+        float z[16] = { 0 };
+        if(!transformWithAVX2(param, depth_buffer, coeff_mat_x, coeff_mat_y, coeff_mat_z, i, x, y, z)) {
+            LOG_ERROR("Distortion model not supported yet");
+        }
+        transferDepth(x, y, z, 8, i, out_depth, map, band);
+    }
+#else
+    D2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, band);
+#endif
+}
+
+void AlignImpl::D2CRange(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x, const float *coeff_mat_y, const float *coeff_mat_z,
+                         int *map, int begin, int end, D2CBand *band, bool withSSE) {
+    if(!withSSE) {
+        D2CWithoutSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, band);
+    }
+    else if(avx2_enabled_ && isAVX2Supported()) {
+        D2CWithAVX2(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, band);
+    }
+    else {
+        D2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, band);
+    }
+}
+
+void AlignImpl::D2CParallel(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_mat_x, const float *coeff_mat_y, const float *coeff_mat_z,
+                            int *map, uint32_t band_count, bool withSSE) {
+    const int pixnum = rgb_intric_.width * rgb_intric_.height;
+    if(out_depth) {
+        // the first band is transferred to the output directly, the others to their own z-buffer
+        if(d2c_bands_.size() != band_count - 1 || d2c_bands_.front().depth.size() != static_cast<size_t>(pixnum)
+           || d2c_bands_.front().overwritten.empty() == gap_fill_copy_) {
+            d2c_bands_.clear();
+            d2c_bands_.resize(band_count - 1);
+            for(auto &band: d2c_bands_) {
+                band.depth.assign(pixnum, 65535);
+                if(gap_fill_copy_) {
+                    band.overwritten.assign(pixnum, 0);
+                }
+                band.min_row = INT_MAX;
+                band.max_row = INT_MIN;
+            }
+        }
+    }
+
+    // split on row boundaries rounded to 8 pixels, which are transformed as a group by the SIMD paths
+    const int depth_width  = depth_intric_.width;
+    const int depth_height = depth_intric_.height;
+    executor_->parallelFor(band_count, [&](uint32_t index) {
+        int begin = static_cast<int>(static_cast<int64_t>(depth_height) * index / band_count) * depth_width / 8 * 8;
+        int end   = static_cast<int>(static_cast<int64_t>(depth_height) * (index + 1) / band_count) * depth_width / 8 * 8;
+        if(index == band_count - 1) {
+            end = depth_width * depth_height;
+        }
+        if(map) {
+            // the coordinate map is indexed by depth pixel, the bands never overlap
+            memset(map + begin, -1, (end - begin) * sizeof(int));
+        }
+        if(!out_depth) {
+            D2CRange(depth_buffer, nullptr, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, nullptr, withSSE);
+        }
+        else if(index == 0) {
+            D2CRange(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, nullptr, withSSE);
+        }
+        else {
+            auto &band = d2c_bands_[index - 1];
+            D2CRange(depth_buffer, band.depth.data(), coeff_mat_x, coeff_mat_y, coeff_mat_z, map, begin, end, &band, withSSE);
+        }
+    });
+
+    if(out_depth) {
+        const int color_height = rgb_intric_.height;
+        executor_->parallelFor(band_count, [&](uint32_t index) {
+            int row_begin = static_cast<int>(static_cast<int64_t>(color_height) * index / band_count);
+            int row_end   = static_cast<int>(static_cast<int64_t>(color_height) * (index + 1) / band_count);
+            mergeD2CBands(out_depth, band_count, row_begin, row_end);
+        });
+        for(auto &band: d2c_bands_) {
+            band.min_row = INT_MAX;
+            band.max_row = INT_MIN;
+        }
+    }
+}
+
+void AlignImpl::mergeD2CBands(uint16_t *out_depth, uint32_t band_count, int row_begin, int row_end) {
+    const int width = rgb_intric_.width;
+    for(uint32_t i = 0; i < band_count - 1; i++) {
+        auto &band  = d2c_bands_[i];
+        int   begin = (band.min_row > row_begin ? band.min_row : row_begin) * width;
+        int   end   = (band.max_row < row_end ? band.max_row : row_end) * width;
+
+        uint16_t *depth = band.depth.data();
+        if(gap_fill_copy_) {
+            // same as transferring the bands in order on one thread: a pixel overwritten by the band drops the values of the previous bands
+            uint8_t *overwritten = band.overwritten.data();
+            for(int pos = begin; pos < end; pos++) {
+                if(overwritten[pos]) {
+                    out_depth[pos]   = depth[pos];
+                    overwritten[pos] = 0;
+                }
+                else if(depth[pos] < out_depth[pos]) {
+                    out_depth[pos] = depth[pos];
+                }
+                depth[pos] = 65535;
+            }
+        }
+        else {
+            for(int pos = begin; pos < end; pos++) {
+                if(depth[pos] < out_depth[pos]) {
+                    out_depth[pos] = depth[pos];
+                }
+                depth[pos] = 65535;
+            }
+        }
+    }
+
+    for(int pos = row_begin * width; pos < row_end * width; pos++) {
+        if(65535 == out_depth[pos]) {
+            out_depth[pos] = 0;
         }
     }
 }
@@ -603,13 +934,20 @@ int AlignImpl::D2C(const uint16_t *depth_buffer, int depth_width, int depth_heig
     const float *coeff_mat_y = finder_y->second;
     const float *coeff_mat_z = finder_z->second;
 
-    if(withSSE) {
-        D2CWithSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
+    uint32_t band_count = static_cast<uint32_t>(depth_height / D2C_MIN_BAND_ROWS);
+    if(band_count > thread_count_) {
+        band_count = thread_count_;
     }
-    else {
-        D2CWithoutSSE(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map);
+    if(band_count > 1) {
+        D2CParallel(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, band_count, withSSE);
+        return ret;
     }
 
+    if(map) {
+        memset(map, -1, depth_width * depth_height * sizeof(int));
+    }
+    D2CRange(depth_buffer, out_depth, coeff_mat_x, coeff_mat_y, coeff_mat_z, map, 0, depth_width * depth_height, nullptr, withSSE);
+
     if(out_depth) {
         for(int idx = 0; idx < pixnum; idx++) {
             if(65535 == out_depth[idx]) {
@@ -625,63 +963,86 @@ typedef struct {
     unsigned char byte[3];
 } uint24_t;
 
+template <typename T> static void gatherPixel(const int *map, const T *src_buffer, T *dst_buffer, int begin, int end) {
+    for(int id = begin; id < end; id++) {
+        int is         = map[id];
+        dst_buffer[id] = is < 0 ? T{} : src_buffer[is];
+    }
+}
+
+// Each target pixel takes the luma and the chroma of its own position in the macro pixel (U for even pixels and V for odd ones) from the source
+// pixel, the source width is always even for YUYV.
+static void gatherYUYV(const int *map, const uint8_t *src_buffer, uint8_t *dst_buffer, int begin, int end) {
+    for(int id = begin; id < end; id++) {
+        int is = map[id];
+        if(is < 0) {
+            dst_buffer[2 * id]     = 0;
+            dst_buffer[2 * id + 1] = 128;
+            continue;
+        }
+        dst_buffer[2 * id]     = src_buffer[2 * is];
+        dst_buffer[2 * id + 1] = src_buffer[(is & ~1) * 2 + ((id & 1) ? 3 : 1)];
+    }
+}
+
 int AlignImpl::C2D(const uint16_t *depth_buffer, int depth_width, int depth_height, const void *rgb_buffer, void *out_rgb, int color_width, int color_height,
                    OBFormat format, bool withSSE) {
+    if(!mapPixel(nullptr, nullptr, nullptr, format, 0, 0)) {
+        LOG_ERROR("Unsupported format for C2D conversion yet!");
+        return -1;
+    }
 
-    // rgb x-y coordinates for each depth pixel
-    unsigned long long size     = static_cast<unsigned long long>(depth_width) * depth_height * 2;
-    int               *depth_xy = new int[size];
-    memset(depth_xy, -1, size * sizeof(int));
-
-    int ret = -1;
-    if(!D2C(depth_buffer, depth_width, depth_height, nullptr, color_width, color_height, depth_xy, withSSE)) {
-
-        switch(format) {
-        case OB_FORMAT_Y8:
-            memset(out_rgb, 0, depth_width * depth_height * sizeof(uint8_t));
-            mapPixel<uint8_t>(depth_xy, static_cast<const uint8_t *>(rgb_buffer), color_width, color_height, (uint8_t *)out_rgb, depth_width, depth_height);
-            break;
-        case OB_FORMAT_Y16:
-            memset(out_rgb, 0, depth_width * depth_height * sizeof(uint16_t));
-            mapPixel<uint16_t>(depth_xy, static_cast<const uint16_t *>(rgb_buffer), color_width, color_height, (uint16_t *)out_rgb, depth_width, depth_height);
-            break;
-        case OB_FORMAT_RGB:
-        case OB_FORMAT_BGR:
-            memset(out_rgb, 0, depth_width * depth_height * sizeof(uint24_t));
-            mapPixel<uint24_t>(depth_xy, static_cast<const uint24_t *>(rgb_buffer), color_width, color_height, (uint24_t *)out_rgb, depth_width, depth_height);
-            break;
-        case OB_FORMAT_BGRA:
-        case OB_FORMAT_RGBA:
-            memset(out_rgb, 0, depth_width * depth_height * sizeof(uint24_t));
-            mapPixel<uint32_t>(depth_xy, static_cast<const uint32_t *>(rgb_buffer), color_width, color_height, (uint32_t *)out_rgb, depth_width, depth_height);
-            break;
-        case OB_FORMAT_MJPG:
-        case OB_FORMAT_YUYV:
-        default:
-            LOG_ERROR("Unsupported format for C2D conversion yet!");
-            break;
-        }
+    // color pixel index for each depth pixel, kept between frames and only reallocated on resolution change
+    size_t map_size = static_cast<size_t>(depth_width) * depth_height;
+    if(c2d_map_.size() != map_size) {
+        c2d_map_.resize(map_size);
+    }
 
-        ret = 0;
+    if(D2C(depth_buffer, depth_width, depth_height, nullptr, color_width, color_height, c2d_map_.data(), withSSE)) {
+        return -1;
     }
-    delete[] depth_xy;
-    depth_xy = nullptr;
 
-    return ret;
+    uint32_t band_count = static_cast<uint32_t>(depth_height / D2C_MIN_BAND_ROWS);
+    if(band_count > thread_count_) {
+        band_count = thread_count_;
+    }
+    if(band_count > 1) {
+        executor_->parallelFor(band_count, [&](uint32_t index) {
+            int begin = static_cast<int>(static_cast<int64_t>(depth_height) * index / band_count) * depth_width;
+            int end   = static_cast<int>(static_cast<int64_t>(depth_height) * (index + 1) / band_count) * depth_width;
+            mapPixel(c2d_map_.data(), rgb_buffer, out_rgb, format, begin, end);
+        });
+    }
+    else {
+        mapPixel(c2d_map_.data(), rgb_buffer, out_rgb, format, 0, depth_width * depth_height);
+    }
+    return 0;
 }
 
-template <typename T>
-void AlignImpl::mapPixel(const int *map, const T *src_buffer, int src_width, int src_height, T *dst_buffer, int dst_width, int dst_height) {
-    for(int v = 0; v < dst_height; v++) {
-        for(int u = 0; u < dst_width; u++) {
-            int id = v * dst_width + u;
-            int us = map[2 * id], vs = map[2 * id + 1];
-            if((us < 0) || (us > src_width - 1) || (vs < 0) || (vs > src_height - 1))
-                continue;
-            int is         = vs * src_width + us;
-            dst_buffer[id] = src_buffer[is];
-        }
+bool AlignImpl::mapPixel(const int *map, const void *src_buffer, void *dst_buffer, OBFormat format, int begin, int end) {
+    switch(format) {
+    case OB_FORMAT_Y8:
+        gatherPixel<uint8_t>(map, static_cast<const uint8_t *>(src_buffer), static_cast<uint8_t *>(dst_buffer), begin, end);
+        break;
+    case OB_FORMAT_Y16:
+        gatherPixel<uint16_t>(map, static_cast<const uint16_t *>(src_buffer), static_cast<uint16_t *>(dst_buffer), begin, end);
+        break;
+    case OB_FORMAT_RGB:
+    case OB_FORMAT_BGR:
+        gatherPixel<uint24_t>(map, static_cast<const uint24_t *>(src_buffer), static_cast<uint24_t *>(dst_buffer), begin, end);
+        break;
+    case OB_FORMAT_BGRA:
+    case OB_FORMAT_RGBA:
+        gatherPixel<uint32_t>(map, static_cast<const uint32_t *>(src_buffer), static_cast<uint32_t *>(dst_buffer), begin, end);
+        break;
+    case OB_FORMAT_YUYV:
+        gatherYUYV(map, static_cast<const uint8_t *>(src_buffer), static_cast<uint8_t *>(dst_buffer), begin, end);
+        break;
+    case OB_FORMAT_MJPG:
+    default:
+        return false;
     }
+    return true;
 }
 
 }  // namespace libobsensor
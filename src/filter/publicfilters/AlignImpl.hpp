@@ -8,19 +8,17 @@
 #include <utility>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 #include "libobsensor/h/ObTypes.h"
 
-#if(defined(__ARM_NEON__) || defined(__aarch64__) || defined(__arm__))
-#include "SSE2NEON.h"
-#else
-#include <xmmintrin.h>
-#include <smmintrin.h>
-#endif
+#include "utils/CpuFeatures.hpp"
 
 namespace libobsensor {
 
 #define EPSILON (1e-6)
 
+class TaskExecutor;
+
 struct ResHashFunc {
     size_t operator()(const std::pair<int, int> &p) const {
         return (((uint32_t)p.first & 0xFFFF) << 16) | ((uint32_t)p.second & 0xFFFF);
@@ -84,8 +82,8 @@ public:
      * @param[out]  out_depth     aligned data buffer in row-major order
      * @param[in]       color_width   width of the color frame
      * @param[in]       color_height  height of the color frame
-     * @param[in]       map    coordinate mapping for C2D
-     * @param[in]       withSSE switch to speed up with SSE
+     * @param[in]       map    coordinate mapping for C2D, the pixel index of the color frame for each depth pixel, -1 if not mapped
+     * @param[in]       withSSE switch to speed up with SSE (AVX2 if enabled and supported by the CPU)
      * @retval  -1  fail
      * @retval  0   succeed
      */
@@ -101,36 +99,70 @@ public:
      * @param[out] out_rgb      aligned data buffer of the color frame
      * @param[in] color_width  width of the to-align color frame
      * @param[in] color_height height of the to-align color frame
-     * @param[in] format       pixel format of the color fraem
+     * @param[in] format       pixel format of the color fraem, Y8, Y16, RGB, BGR, RGBA, BGRA or YUYV (MJPG should be decoded before)
      * @retval -1 fail
      * @retval 0 succeed
      */
     int C2D(const uint16_t *depth_buffer, int depth_width, int depth_height, const void *rgb_buffer, void *out_rgb, int color_width, int color_height,
             OBFormat format, bool withSSE = true);
 
+    /**
+     * @brief Set the number of threads of the alignment, the depth frame is split into row bands which are transformed in parallel
+     * @param[in] thread_count number of threads, 0 for the number of CPU cores
+     */
+    void setThreadCount(uint32_t thread_count);
+
+    /**
+     * @brief Switch to use AVX2 instead of SSE on the CPUs supporting it, enabled by default
+     */
+    void enableAVX2(bool enable);
+
+    /**
+     * @brief Check whether the AVX2 path is compiled in and supported by the CPU
+     */
+    static bool isAVX2Supported();
+
 private:
+    /** Scratch of a row band of the parallel alignment, the bands except the first one are transferred to their own z-buffer and merged after */
+    struct D2CBand {
+        std::vector<uint16_t> depth;        // z-buffer of the target frame, kept 65535 out of [min_row, max_row) between frames
+        std::vector<uint8_t>  overwritten;  // pixels overwritten (rather than min-ed) by the band, only used when filling gaps with copy
+        int                   min_row;      // target rows touched by the band
+        int                   max_row;
+    };
+
     void clearMatrixCache();
 
-    void D2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map = nullptr);
-    void D2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map = nullptr);
+    void D2CWithoutSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map,
+                       int begin, int end, D2CBand *band);
+    void D2CWithSSE(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map, int begin,
+                    int end, D2CBand *band);
+    void D2CWithAVX2(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map, int begin,
+                     int end, D2CBand *band);
+    /** transform the depth pixels in [begin, end) with the best instruction set, begin and end should be multiples of 8 except the end of frame */
+    void D2CRange(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map, int begin,
+                  int end, D2CBand *band, bool withSSE);
+    void D2CParallel(const uint16_t *depth_buffer, uint16_t *out_depth, const float *coeff_x, const float *coeff_y, const float *coeff_z, int *map,
+                     uint32_t band_count, bool withSSE);
+    /** merge the z-buffers of the bands into the target rows [row_begin, row_end) in band order */
+    void mergeD2CBands(uint16_t *out_depth, uint32_t band_count, int row_begin, int row_end);
     /** SSE speed-ed depth to color alignment with different distortion model */
     void distortedWithSSE(__m128 &nx, __m128 &ny, const __m128 x2, const __m128 y2, const __m128 r2);
     void KBDistortedWithSSE(__m128 &nx, __m128 &ny, const __m128 r2);
     void BMDistortedWithSSE(__m128 &nx, __m128 &ny, const __m128 x2, const __m128 y2, const __m128 r2);
 
-    void transferDepth(const float *pixelx, const float *pixely, const float *depth, const int npts, const int point_index, uint16_t *out_depth, int *map);
+    void transferDepth(const float *pixelx, const float *pixely, const float *depth, const int npts, const int point_index, uint16_t *out_depth, int *map,
+                       D2CBand *band = nullptr);
 
     /**
-     * @brief               Transfer pixels of the source image buffer to the target
-     * @tparam T            pixel type, like uint8_t, uint16_t, etc.
-     * @param map           coordinate map of the same dimensions as the target
+     * @brief               Gather pixels of the source image buffer to the target pixels [begin, end), the unmapped pixels are set to black
+     * @param map           source pixel index for each target pixel, -1 if not mapped
      * @param src_buffer    the source image buffer
-     * @param src_width     columns of the source image
-     * @param src_height    rows of the source image
      * @param dst_buffer    the target image buffer
-     * @param dst_width
+     * @param format        pixel format of both images
+     * @retval false        the format is not supported
      */
-    template <typename T> void mapPixel(const int *map, const T *src_buffer, int src_width, int src_height, T *dst_buffer, int dst_width, int dst_height);
+    static bool mapPixel(const int *map, const void *src_buffer, void *dst_buffer, OBFormat format, int begin, int end);
 
 private:
     bool initialized_;
@@ -154,6 +186,13 @@ private:
     // possible inflection point of the calibrated K6 distortion curve
     float r2_max_loc_;
 
+    // members for the parallel alignment
+    uint32_t                      thread_count_;
+    bool                          avx2_enabled_;
+    std::shared_ptr<TaskExecutor> executor_;
+    std::vector<D2CBand>          d2c_bands_;
+    std::vector<int>              c2d_map_;  // reused by C2D, sized to the depth frame
+
     // members for SSE
     __m128 color_cx_;
     __m128 color_cy_;
@@ -219,21 +219,31 @@ void DecimationFilter::updateConfig(std::vector<std::string> &params) {
     if(params.size() != 1) {
         throw invalid_value_exception("DecimationFilter config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        uint8_t value = static_cast<uint8_t>(std::stoul(params[0]));
-        if(value >= 1 && value <= 8) {
-            if(value != control_val_) {
-                control_val_       = value;
-                patch_size_        = control_val_;
-                decimation_factor_ = control_val_;
-                kernel_size_       = patch_size_ * patch_size_;
-                options_changed_   = true;
-            }
-        }
+        values.push_back(static_cast<uint8_t>(std::stoul(params[0])));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("DecimationFilter config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool DecimationFilter::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 1) {
+        throw invalid_value_exception("DecimationFilter config error: params size not match");
+    }
+    if(values[0] >= 1 && values[0] <= 8) {
+        uint8_t value = static_cast<uint8_t>(values[0]);
+        if(value != control_val_) {
+            control_val_       = value;
+            patch_size_        = control_val_;
+            decimation_factor_ = control_val_;
+            kernel_size_       = patch_size_ * patch_size_;
+            options_changed_   = true;
+        }
+    }
+    return true;
 }
 
 const std::string &DecimationFilter::getConfigSchema() const {
@@ -256,13 +266,13 @@ std::shared_ptr<Frame> DecimationFilter::process(std::shared_ptr<const Frame> fr
 
     if(frame->is<FrameSet>()) {
         LOG_WARN_INTVL("The Frame processed by DecimationFilter cannot be FrameSet!");
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::cloneFrame(frame);
         return outFrame;
     }
 
     if(!isFrameFormatTypeSupported(frame->getFormat())) {
         LOG_WARN_INTVL("Unsupported decimation filter processing frame format @{}.", frame->getFormat());
-        auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto outFrame = FrameFactory::cloneFrame(frame);
         return outFrame;
     }
 
@@ -7,35 +7,74 @@
 #include "frame/FrameFactory.hpp"
 #include "frame/FrameMemoryPool.hpp"
 #include "stream/StreamProfile.hpp"
+#include "stream/StreamIntrinsicsManager.hpp"
 #include "libobsensor/h/ObTypes.h"
+#include "utils/TaskExecutor.hpp"
+#include "environment/EnvConfig.hpp"
 #include <libyuv.h>
 #include <turbojpeg.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace libobsensor {
 
-FormatConverter::FormatConverter() : convertType_(FORMAT_YUYV_TO_RGB) {}
-FormatConverter::~FormatConverter() noexcept {}
+FormatConverter::FormatConverter() : convertType_(FORMAT_YUYV_TO_RGB), decodeScale_(1) {
+    int threadCount = 1;
+    EnvConfig::getInstance()->getIntValue("Misc.FormatConvertThreadCount", threadCount);
+    setThreadCount(threadCount < 0 ? 1 : static_cast<uint32_t>(threadCount));
+}
+FormatConverter::~FormatConverter() noexcept {
+    for(auto handle: decompressors_) {
+        tjDestroy(handle);
+    }
+}
 
 void FormatConverter::updateConfig(std::vector<std::string> &params) {
-    if(params.size() != 1) {
+    // The decode scale is optional, so the callers setting only the conversion type keep working
+    if(params.size() != 1 && params.size() != 2) {
         throw invalid_value_exception("FormatConverter config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        int convertType = std::stoi(params[0]);
-        convertType_    = (OBConvertFormat)convertType;
+        for(auto &param: params) {
+            values.push_back(std::stoi(param));
+        }
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("FormatConverter config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool FormatConverter::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 1 && values.size() != 2) {
+        throw invalid_value_exception("FormatConverter config error: params size not match");
+    }
+    int decodeScale = values.size() > 1 ? static_cast<int>(values[1]) : 0;
+    if(decodeScale > 0) {
+        setDecodeScale(static_cast<uint32_t>(decodeScale));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        convertType = (OBConvertFormat) static_cast<int>(values[0]);
+    if(convertType_ != convertType) {
+        // the cached target profile has the format (and the decode scale) of the previous conversion
+        convertType_ = convertType;
+        currentStreamProfile_.reset();
+        tarStreamProfile_.reset();
+    }
+    return true;
 }
 
 const std::string &FormatConverter::getConfigSchema() const {
     // csv format: name，type， min，max，step，default，description
-    static const std::string schema = "convertType, int, 0, 17, 1, 0, frame data converter type";
+    static const std::string schema = "convertType, int, 0, 17, 1, 0, frame data converter type\n"
+                                      "decodeScale, int, 1, 8, 1, 1, mjpeg to rgb/bgr/bgra decode scale: 1 is full resolution; 2, 4 and 8 are 1/2, 1/4 and 1/8";
     return schema;
 }
 
 void FormatConverter::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
     currentStreamProfile_.reset();
     tarStreamProfile_.reset();
 }
@@ -52,7 +91,13 @@ const std::map<OBConvertFormat, std::pair<OBFormat, OBFormat>> FORMAT_CONVERT_MA
     { FORMAT_YUYV_TO_Y16, { OB_FORMAT_YUYV, OB_FORMAT_Y16 } },   { FORMAT_YUYV_TO_Y8, { OB_FORMAT_YUYV, OB_FORMAT_Y8 } },
 };
 
+// The MJPEG conversions decoded with TurboJPEG, which can scale the decoded image
+static bool isScaledDecodeSupported(OBConvertFormat convertType) {
+    return convertType == FORMAT_MJPG_TO_RGB || convertType == FORMAT_MJPG_TO_BGR || convertType == FORMAT_MJPG_TO_BGRA;
+}
+
 void FormatConverter::setConversion(OBFormat srcFormat, OBFormat dstFormat) {
+    std::lock_guard<std::mutex> lock(mutex_);
     for(auto &item: FORMAT_CONVERT_MAP) {
         if(item.second.first == srcFormat && item.second.second == dstFormat) {
             convertType_ = item.first;
@@ -73,45 +118,63 @@ std::shared_ptr<Frame> FormatConverter::process(std::shared_ptr<const Frame> fra
     int  w          = videoFrame->getWidth();
     int  h          = videoFrame->getHeight();
 
-    auto streamprofile = frame->getStreamProfile();
-    if(!currentStreamProfile_ || currentStreamProfile_.get() != streamprofile.get()) {
-        currentStreamProfile_ = streamprofile;
-        tarStreamProfile_     = streamprofile->clone();
-        if(FORMAT_CONVERT_MAP.find(convertType_) == FORMAT_CONVERT_MAP.end()) {
-            auto srcFormat = streamprofile->getFormat();
-            auto dstFormat = OB_FORMAT_RGB;
-            for(auto &item: FORMAT_CONVERT_MAP) {
-                if(item.second.first == srcFormat) {
-                    dstFormat = item.second.second;
-                    tarStreamProfile_->setFormat(dstFormat);
-                    break;
+    OBConvertFormat                convertType;
+    std::shared_ptr<StreamProfile> tarStreamProfile;
+    std::shared_ptr<TaskExecutor>  executor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto                        streamprofile = frame->getStreamProfile();
+        if(!currentStreamProfile_ || currentStreamProfile_.get() != streamprofile.get()) {
+            currentStreamProfile_ = streamprofile;
+            tarStreamProfile_     = streamprofile->clone();
+            if(FORMAT_CONVERT_MAP.find(convertType_) == FORMAT_CONVERT_MAP.end()) {
+                auto srcFormat = streamprofile->getFormat();
+                auto dstFormat = OB_FORMAT_RGB;
+                for(auto &item: FORMAT_CONVERT_MAP) {
+                    if(item.second.first == srcFormat) {
+                        dstFormat = item.second.second;
+                        tarStreamProfile_->setFormat(dstFormat);
+                        break;
+                    }
                 }
             }
+            else {
+                tarStreamProfile_->setFormat(FORMAT_CONVERT_MAP.at(convertType_).second);
+            }
+            if(decodeScale_ > 1 && isScaledDecodeSupported(convertType_)) {
+                scaleVideoStreamProfile(tarStreamProfile_->as<VideoStreamProfile>(), decodeScale_);
+            }
         }
-        else {
-            tarStreamProfile_->setFormat(FORMAT_CONVERT_MAP.at(convertType_).second);
-        }
+        convertType      = convertType_;
+        tarStreamProfile = tarStreamProfile_;
+        executor         = executor_;
     }
 
-    auto tarFrame = FrameFactory::createFrameFromStreamProfile(tarStreamProfile_);
+    auto tarFrame = FrameFactory::createFrameFromStreamProfile(tarStreamProfile);
     if(tarFrame == nullptr) {
         LOG_ERROR_INTVL("Create frame by frame factory failed!");
         return nullptr;
     }
 
     tarFrame->copyInfoFromOther(frame);
-    switch(convertType_) {
+    if(isScaledDecodeSupported(convertType)) {
+        // TurboJPEG decodes at the largest scaling factor fitting in the size of the target frame
+        auto tarVideoFrame = tarFrame->as<VideoFrame>();
+        w                  = tarVideoFrame->getWidth();
+        h                  = tarVideoFrame->getHeight();
+    }
+    switch(convertType) {
     case FORMAT_YUYV_TO_RGB:
-        yuyvToRgb((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        yuyvToRgb(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_YUYV_TO_RGBA:
-        yuyvToRgba((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        yuyvToRgba(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_YUYV_TO_BGR:
-        yuyvToBgr((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        yuyvToBgr(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_YUYV_TO_BGRA:
-        yuyvToBgra((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        yuyvToBgra(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_YUYV_TO_Y16:
         yuyvToy16((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
@@ -120,16 +183,16 @@ std::shared_ptr<Frame> FormatConverter::process(std::shared_ptr<const Frame> fra
         yuyvToy8((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_UYVY_TO_RGB:
-        uyvyToRgb((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        uyvyToRgb(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_I420_TO_RGB:
-        i420ToRgb((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        i420ToRgb(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_NV21_TO_RGB:
-        nv21ToRgb((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        nv21ToRgb(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_NV12_TO_RGB:
-        nv12ToRgb((uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
+        nv12ToRgb(executor, (uint8_t *)frame->getData(), (uint8_t *)tarFrame->getData(), w, h);
         break;
     case FORMAT_MJPG_TO_I420:
         mjpgToI420((uint8_t *)frame->getData(), (uint32_t)frame->getDataSize(), (uint8_t *)tarFrame->getData(), w, h);
@@ -158,74 +221,155 @@ std::shared_ptr<Frame> FormatConverter::process(std::shared_ptr<const Frame> fra
         break;
     default:
         LOG_WARN_INTVL("Unsupported data format conversion.");
-        return FrameFactory::createFrameFromOtherFrame(frame, true);
+        return FrameFactory::cloneFrame(frame);
         break;
     }
     return tarFrame;
 }
 
-void FormatConverter::yuyvToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const auto preferSize = width * height * 3 / 2;
-    if(tempDataBuf_ == nullptr || preferSize != tempDataBufSize_) {
-        if(nullptr != tempDataBuf_) {
-            delete[] tempDataBuf_;
-        }
-        tempDataBuf_     = new uint8_t[preferSize];
-        tempDataBufSize_ = preferSize;
+bool FormatConverter::isConcurrentProcessSupported() const {
+    // no conversion keeps any state across the frames, so several frames can be converted at the same time
+    return true;
+}
+
+void FormatConverter::setDecodeScale(uint32_t scale) {
+    if(scale != 1 && scale != 2 && scale != 4 && scale != 8) {
+        throw invalid_value_exception("FormatConverter config error: decode scale must be 1, 2, 4 or 8");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(decodeScale_ != scale) {
+        decodeScale_ = scale;
+        currentStreamProfile_.reset();
+        tarStreamProfile_.reset();
     }
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToRAW(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
 }
 
-void FormatConverter::yuyvToRgba(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const auto preferSize = width * height * 4;
-    if(tempDataBuf_ == nullptr || preferSize != tempDataBufSize_) {
-        if(nullptr != tempDataBuf_) {
-            delete[] tempDataBuf_;
-        }
-        tempDataBuf_     = new uint8_t[preferSize];
-        tempDataBufSize_ = preferSize;
+void FormatConverter::scaleVideoStreamProfile(const std::shared_ptr<VideoStreamProfile> &profile, uint32_t scale) {
+    // Same rounding as the scaled size of TurboJPEG (TJSCALED)
+    auto width  = (profile->getWidth() + scale - 1) / scale;
+    auto height = (profile->getHeight() + scale - 1) / scale;
+    profile->setWidth(width);
+    profile->setHeight(height);
+
+    // The clone has the intrinsics of the source profile if there are any, the distortion and the extrinsics remain unchanged.
+    // A decoded pixel is the average of scale x scale source pixels, so the pixel centers are shifted by (scale - 1) / 2 source pixels.
+    if(StreamIntrinsicsManager::getInstance()->containsVideoStreamIntrinsics(profile)) {
+        auto intrinsic   = profile->getIntrinsic();
+        intrinsic.width  = static_cast<int16_t>(width);
+        intrinsic.height = static_cast<int16_t>(height);
+        intrinsic.fx     = intrinsic.fx / scale;
+        intrinsic.fy     = intrinsic.fy / scale;
+        intrinsic.cx     = (intrinsic.cx + 0.5f) / scale - 0.5f;
+        intrinsic.cy     = (intrinsic.cy + 0.5f) / scale - 0.5f;
+        profile->bindIntrinsic(intrinsic);
+    }
+}
+
+void FormatConverter::setThreadCount(uint32_t threadCount) {
+    if(threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    executor_.reset();
+    if(threadCount > 1) {
+        // the calling thread converts a stripe as well
+        executor_ = std::make_shared<TaskExecutor>(threadCount - 1, false);
     }
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToABGR(yData, width, uData, width / 2, vData, width / 2, target, width * 4, width, height);
 }
 
-void FormatConverter::yuyvToBgr(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const auto preferSize = width * height * 3 / 2;
-    if(tempDataBuf_ == nullptr || preferSize != tempDataBufSize_) {
-        if(nullptr != tempDataBuf_) {
-            delete[] tempDataBuf_;
+void *FormatConverter::acquireDecompressor() {
+    {
+        std::lock_guard<std::mutex> lock(decompressorMutex_);
+        if(!decompressors_.empty()) {
+            auto handle = decompressors_.back();
+            decompressors_.pop_back();
+            return handle;
         }
-        tempDataBuf_     = new uint8_t[preferSize];
-        tempDataBufSize_ = preferSize;
     }
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToRGB24(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
+    return tjInitDecompress();
 }
 
-void FormatConverter::yuyvToBgra(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const auto preferSize = width * height * 4;
-    if(tempDataBuf_ == nullptr || preferSize != tempDataBufSize_) {
-        if(nullptr != tempDataBuf_) {
-            delete[] tempDataBuf_;
+void FormatConverter::releaseDecompressor(void *handle) {
+    if(!handle) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(decompressorMutex_);
+    decompressors_.push_back(handle);
+}
+
+namespace {
+typedef int (*PackedYuvToArgbFunc)(const uint8_t *src, int srcStride, uint8_t *dst, int dstStride, int width, int height);
+typedef int (*ArgbToPackedFunc)(const uint8_t *src, int srcStride, uint8_t *dst, int dstStride, int width, int height);
+
+const uint32_t MIN_STRIPE_ROWS = 32;  // smaller stripes are not worth the scheduling cost
+
+// Convert the rows of packed 4:2:2 data (YUYV/UYVY) to the packed target in a single pass: each row is converted to ARGB in a row buffer which stays
+// in the cache and then to the target pixel layout, or directly to the target if it is ARGB (BGRA).
+void packedYuvRowsToPacked(const uint8_t *src, uint8_t *target, uint32_t width, uint32_t rowBegin, uint32_t rowEnd, uint32_t dstPixelSize,
+                           PackedYuvToArgbFunc toArgb, ArgbToPackedFunc fromArgb) {
+    const int srcStride = static_cast<int>(width * 2);
+    const int dstStride = static_cast<int>(width * dstPixelSize);
+    if(!fromArgb) {
+        toArgb(src + rowBegin * srcStride, srcStride, target + rowBegin * dstStride, dstStride, static_cast<int>(width), static_cast<int>(rowEnd - rowBegin));
+        return;
+    }
+
+    if(dstPixelSize == 4) {
+        // The 4 bytes layouts are converted in place, the row is still in the cache when it is shuffled
+        for(uint32_t row = rowBegin; row < rowEnd; row++) {
+            toArgb(src + row * srcStride, srcStride, target + row * dstStride, dstStride, static_cast<int>(width), 1);
+            fromArgb(target + row * dstStride, dstStride, target + row * dstStride, dstStride, static_cast<int>(width), 1);
         }
-        tempDataBuf_     = new uint8_t[preferSize];
-        tempDataBufSize_ = preferSize;
+        return;
+    }
+
+    std::vector<uint8_t> rowBuf(width * 4);
+    for(uint32_t row = rowBegin; row < rowEnd; row++) {
+        toArgb(src + row * srcStride, srcStride, rowBuf.data(), static_cast<int>(width * 4), static_cast<int>(width), 1);
+        fromArgb(rowBuf.data(), static_cast<int>(width * 4), target + row * dstStride, dstStride, static_cast<int>(width), 1);
     }
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::YUY2ToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToARGB(yData, width, uData, width / 2, vData, width / 2, target, width * 4, width, height);
+}
+}  // namespace
+
+void FormatConverter::convertRowStripes(const std::shared_ptr<TaskExecutor> &executor, uint32_t height,
+                                        const std::function<void(uint32_t, uint32_t)> &convertRows) {
+    uint32_t stripeCount = executor ? executor->getThreadCount() + 1 : 1;
+    stripeCount          = (std::min)(stripeCount, (std::max)(height / MIN_STRIPE_ROWS, 1u));
+    if(stripeCount <= 1) {
+        convertRows(0, height);
+        return;
+    }
+
+    // The stripes start on even rows, so that the two rows sharing the chroma of the 4:2:0 formats are converted by the same stripe
+    executor->parallelFor(stripeCount, [&](uint32_t index) {
+        uint32_t rowBegin = static_cast<uint32_t>(static_cast<uint64_t>(height) * index / stripeCount) & ~1u;
+        uint32_t rowEnd   = index == stripeCount - 1 ? height : static_cast<uint32_t>(static_cast<uint64_t>(height) * (index + 1) / stripeCount) & ~1u;
+        convertRows(rowBegin, rowEnd);
+    });
+}
+
+void FormatConverter::yuyvToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {  //
+        packedYuvRowsToPacked(src, target, width, rowBegin, rowEnd, 3, libyuv::YUY2ToARGB, libyuv::ARGBToRAW);
+    });
+}
+
+void FormatConverter::yuyvToRgba(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {  //
+        packedYuvRowsToPacked(src, target, width, rowBegin, rowEnd, 4, libyuv::YUY2ToARGB, libyuv::ARGBToABGR);
+    });
+}
+
+void FormatConverter::yuyvToBgr(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {  //
+        packedYuvRowsToPacked(src, target, width, rowBegin, rowEnd, 3, libyuv::YUY2ToARGB, libyuv::ARGBToRGB24);
+    });
+}
+
+void FormatConverter::yuyvToBgra(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {  //
+        packedYuvRowsToPacked(src, target, width, rowBegin, rowEnd, 4, libyuv::YUY2ToARGB, nullptr);
+    });
 }
 
 void FormatConverter::yuyvToy16(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
@@ -262,39 +406,38 @@ void FormatConverter::yuyvToy8(uint8_t *src, uint8_t *target, uint32_t width, ui
     }
 }
 
-void FormatConverter::uyvyToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
-    const auto preferSize = width * height * 3 / 2;
-    if(tempDataBuf_ == nullptr || preferSize != tempDataBufSize_) {
-        if(nullptr != tempDataBuf_) {
-            delete[] tempDataBuf_;
-        }
-        tempDataBuf_     = new uint8_t[preferSize];
-        tempDataBufSize_ = preferSize;
-    }
-    uint8_t *yData = tempDataBuf_;
-    uint8_t *uData = tempDataBuf_ + width * height;
-    uint8_t *vData = tempDataBuf_ + width * height * 5 / 4;
-    libyuv::UYVYToI420(src, width * 2, yData, width, uData, width / 2, vData, width / 2, width, height);
-    libyuv::I420ToRAW(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
+void FormatConverter::uyvyToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {  //
+        packedYuvRowsToPacked(src, target, width, rowBegin, rowEnd, 3, libyuv::UYVYToARGB, libyuv::ARGBToRAW);
+    });
 }
 
-void FormatConverter::i420ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+void FormatConverter::i420ToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
     uint8_t *yData = src;
     uint8_t *uData = src + width * height;
     uint8_t *vData = src + width * height * 5 / 4;
-    libyuv::I420ToRAW(yData, width, uData, width / 2, vData, width / 2, target, width * 3, width, height);
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        libyuv::I420ToRAW(yData + rowBegin * width, width, uData + rowBegin / 2 * width / 2, width / 2, vData + rowBegin / 2 * width / 2, width / 2,
+                          target + rowBegin * width * 3, width * 3, width, rowEnd - rowBegin);
+    });
 }
 
-void FormatConverter::nv21ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+void FormatConverter::nv21ToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
     uint8_t *yData  = src;
     uint8_t *vuData = src + width * height;
-    libyuv::NV21ToRAW(yData, width, vuData, width, target, width * 3, width, height);
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        libyuv::NV21ToRAW(yData + rowBegin * width, width, vuData + rowBegin / 2 * width, width, target + rowBegin * width * 3, width * 3, width,
+                          rowEnd - rowBegin);
+    });
 }
 
-void FormatConverter::nv12ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
+void FormatConverter::nv12ToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height) {
     uint8_t *yData  = src;
-    uint8_t *vuData = src + width * height;
-    libyuv::NV12ToRAW(yData, width, vuData, width, target, width * 3, width, height);
+    uint8_t *uvData = src + width * height;
+    convertRowStripes(executor, height, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        libyuv::NV12ToRAW(yData + rowBegin * width, width, uvData + rowBegin / 2 * width, width, target + rowBegin * width * 3, width * 3, width,
+                          rowEnd - rowBegin);
+    });
 }
 
 void FormatConverter::mjpgToI420(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height) {
@@ -338,32 +481,30 @@ void FormatConverter::mjpgToNv12(uint8_t *src, uint32_t src_len, uint8_t *target
 }
 
 bool FormatConverter::mjpgToRgb(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height) {
-    tjhandle tjHandle;
-    tjHandle = tjInitDecompress();
+    tjhandle tjHandle = acquireDecompressor();
     if(tjDecompress2(tjHandle, src, src_len, target, width,
                      0,  // pitch
                      height, TJPF_RGB, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE)
        != 0) {
         LOG_WARN_INTVL("Failed to decode mjpeg frame to rgb! {}", tjGetErrorStr2(tjHandle));
-        tjDestroy(tjHandle);
+        releaseDecompressor(tjHandle);
         return false;
     }
-    tjDestroy(tjHandle);
+    releaseDecompressor(tjHandle);
     return true;
 }
 
 bool FormatConverter::mjpgToBgr(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height) {
-    tjhandle tjHandle;
-    tjHandle = tjInitDecompress();
+    tjhandle tjHandle = acquireDecompressor();
     if(tjDecompress2(tjHandle, src, src_len, target, width,
                      0,  // pitch
                      height, TJPF_BGR, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE)
        != 0) {
         LOG_WARN_INTVL("Failed to decode mjpeg frame to bgr! {}", tjGetErrorStr2(tjHandle));
-        tjDestroy(tjHandle);
+        releaseDecompressor(tjHandle);
         return false;
     }
-    tjDestroy(tjHandle);
+    releaseDecompressor(tjHandle);
     return true;
 }
 
@@ -382,15 +523,14 @@ void FormatConverter::exchangeRAndB(uint8_t *pucRgb, uint8_t *target, uint32_t w
 }
 
 void FormatConverter::mjpegToBgra(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height) {
-    tjhandle tjHandle;
-    tjHandle = tjInitDecompress();
+    tjhandle tjHandle = acquireDecompressor();
     if(tjDecompress2(tjHandle, src, src_len, target, width,
                      0,  // pitch
                      height, TJPF_BGRA, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE)
        != 0) {
         LOG_WARN_INTVL("Failed to decompress color frame");
     }
-    tjDestroy(tjHandle);
+    releaseDecompressor(tjHandle);
 }
 
 }  // namespace libobsensor
@@ -3,33 +3,55 @@
 
 #pragma once
 #include "IFilter.hpp"
+#include <functional>
 #include <mutex>
+#include <vector>
 
 namespace libobsensor {
 
+class TaskExecutor;
+class VideoStreamProfile;
+
 class FormatConverter : public IFilterBase {
 public:
     FormatConverter();
     virtual ~FormatConverter() noexcept;
 
     void                   updateConfig(std::vector<std::string> &params) override;
+    bool                   updateTypedConfig(const FilterConfigValues &values) override;
     const std::string     &getConfigSchema() const override;
     void                   reset() override;
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
+    bool                   isConcurrentProcessSupported() const override;
 
     void setConversion(OBFormat srcFormat, OBFormat dstFormat);
 
+    // Split the YUV to RGB conversions of each frame into row stripes converted by threadCount threads, including the calling thread.
+    // 0: the number of CPU cores, 1: no split (default, configured by Misc.FormatConvertThreadCount)
+    void setThreadCount(uint32_t threadCount);
+
+    // Decode the MJPEG frames converted to RGB/BGR/BGRA at 1/scale of the resolution with the DCT scaling of TurboJPEG, which is several times cheaper
+    // than decoding at full resolution and downscaling. The output stream profile has the scaled resolution and intrinsics.
+    // 1: full resolution (default), 2, 4 or 8
+    void setDecodeScale(uint32_t scale);
+
 private:
-    void yuyvToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void yuyvToRgba(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void yuyvToBgr(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void yuyvToBgra(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    // Run convertRows(rowBegin, rowEnd) on the row stripes of the frame in parallel on the executor, or on the whole frame if executor is null
+    static void convertRowStripes(const std::shared_ptr<TaskExecutor> &executor, uint32_t height, const std::function<void(uint32_t, uint32_t)> &convertRows);
+
+    // Set the resolution of the profile to the size of the MJPEG frames decoded at 1/scale, and bind the intrinsics scaled accordingly
+    static void scaleVideoStreamProfile(const std::shared_ptr<VideoStreamProfile> &profile, uint32_t scale);
+
+    void yuyvToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void yuyvToRgba(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void yuyvToBgr(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void yuyvToBgra(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
     void yuyvToy16(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
     void yuyvToy8(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void uyvyToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void i420ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void nv21ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
-    void nv12ToRgb(uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void uyvyToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void i420ToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void nv21ToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
+    void nv12ToRgb(const std::shared_ptr<TaskExecutor> &executor, uint8_t *src, uint8_t *target, uint32_t width, uint32_t height);
     void mjpgToI420(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
     void mjpgToNv21(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
     bool mjpgToRgb(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
@@ -38,12 +60,20 @@ private:
     void mjpegToBgra(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
     void mjpgToNv12(uint8_t *src, uint32_t src_len, uint8_t *target, uint32_t width, uint32_t height);
 
+    // The TurboJPEG decompressor handles are reused across the frames, one handle for each frame being decoded at the same time
+    void *acquireDecompressor();
+    void  releaseDecompressor(void *handle);
+
 protected:
+    mutable std::mutex                   mutex_;  // guards the conversion type and the stream profiles, process() may run concurrently
     std::shared_ptr<const StreamProfile> currentStreamProfile_;
     std::shared_ptr<StreamProfile>       tarStreamProfile_;
     OBConvertFormat                      convertType_;
-    uint8_t                             *tempDataBuf_     = nullptr;
-    uint32_t                             tempDataBufSize_ = 0;
+    uint32_t                             decodeScale_;
+    std::shared_ptr<TaskExecutor>        executor_;  // converts the row stripes of a frame in parallel, null if the conversions are not split
+
+    std::mutex          decompressorMutex_;
+    std::vector<void *> decompressors_;
 };
 
 }  // namespace libobsensor
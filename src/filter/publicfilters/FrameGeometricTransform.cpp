@@ -479,17 +479,27 @@ void FrameRotate::updateConfig(std::vector<std::string> &params) {
     if(params.size() != 1) {
         throw invalid_value_exception("Frame rotate config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        int rotateDegree = static_cast<int>(std::stoi(params[0]));
-        if(rotateDegree == 0 || rotateDegree == 90 || rotateDegree == 180 || rotateDegree == 270) {
-            std::lock_guard<std::mutex> rotateLock(mtx_);
-            rotateDegree_        = rotateDegree;
-            rotateDegreeUpdated_ = true;
-        }
+        values.push_back(std::stoi(params[0]));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("Frame rotate config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool FrameRotate::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 1) {
+        throw invalid_value_exception("Frame rotate config error: params size not match");
+    }
+    int rotateDegree = static_cast<int>(values[0]);
+    if(rotateDegree == 0 || rotateDegree == 90 || rotateDegree == 180 || rotateDegree == 270) {
+        std::lock_guard<std::mutex> rotateLock(mtx_);
+        rotateDegree_        = rotateDegree;
+        rotateDegreeUpdated_ = true;
+    }
+    return true;
 }
 
 const std::string &FrameRotate::getConfigSchema() const {
@@ -56,6 +56,7 @@ public:
     virtual ~FrameRotate() noexcept;
 
     void               updateConfig(std::vector<std::string> &params) override;
+    bool               updateTypedConfig(const FilterConfigValues &values) override;
     const std::string &getConfigSchema() const override;
     void               reset() override;
 
@@ -75,13 +75,23 @@ void PixelValueScaler::updateConfig(std::vector<std::string> &params) {
     if(params.size() != 1) {
         throw invalid_value_exception("PixelValueScaler config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        std::lock_guard<std::mutex> scaleLock(mtx_);
-        scale_ = std::stof(params[0]);
+        values.push_back(std::stof(params[0]));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("PixelValueScaler config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool PixelValueScaler::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 1) {
+        throw invalid_value_exception("PixelValueScaler config error: params size not match");
+    }
+    std::lock_guard<std::mutex> scaleLock(mtx_);
+    scale_ = static_cast<float>(values[0]);
+    return true;
 }
 
 const std::string &PixelValueScaler::getConfigSchema() const {
@@ -93,7 +103,7 @@ const std::string &PixelValueScaler::getConfigSchema() const {
 std::shared_ptr<Frame> PixelValueScaler::process(std::shared_ptr<const Frame> frame) {
     if(frame->getType() != OB_FRAME_DEPTH) {
         LOG_WARN_INTVL("PixelValueScaler unsupported to process this frame type: {}", frame->getType());
-        return FrameFactory::createFrameFromOtherFrame(frame);
+        return FrameFactory::cloneFrame(frame);
     }
 
     std::lock_guard<std::mutex> scaleLock(mtx_);
@@ -122,21 +132,32 @@ void ThresholdFilter::updateConfig(std::vector<std::string> &params) {
     if(params.size() != 2) {
         throw invalid_value_exception("ThresholdFilter config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        std::lock_guard<std::mutex> cutOffLock(mtx_);
-        int                         min = std::stoi(params[0]);
-        if(min >= 0 && min <= 16000) {
-            min_ = min;
-        }
-
-        int max = std::stoi(params[1]);
-        if(max >= 0 && max <= 16000) {
-            max_ = max;
-        }
+        values.push_back(std::stoi(params[0]));
+        values.push_back(std::stoi(params[1]));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("ThresholdFilter config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool ThresholdFilter::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 2) {
+        throw invalid_value_exception("ThresholdFilter config error: params size not match");
+    }
+    std::lock_guard<std::mutex> cutOffLock(mtx_);
+    int                         min = static_cast<int>(values[0]);
+    if(min >= 0 && min <= 16000) {
+        min_ = min;
+    }
+
+    int max = static_cast<int>(values[1]);
+    if(max >= 0 && max <= 16000) {
+        max_ = max;
+    }
+    return true;
 }
 
 const std::string &ThresholdFilter::getConfigSchema() const {
@@ -185,13 +206,23 @@ void PixelValueOffset::updateConfig(std::vector<std::string> &params) {
     if(params.size() != 1) {
         throw invalid_value_exception("PixelValueOffset config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        std::lock_guard<std::mutex> offsetLock(mtx_);
-        offset_ = static_cast<int8_t>(std::stoi(params[0]));
+        values.push_back(std::stoi(params[0]));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("PixelValueOffset config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool PixelValueOffset::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 1) {
+        throw invalid_value_exception("PixelValueOffset config error: params size not match");
+    }
+    std::lock_guard<std::mutex> offsetLock(mtx_);
+    offset_ = static_cast<int8_t>(static_cast<int>(values[0]));
+    return true;
 }
 
 const std::string &PixelValueOffset::getConfigSchema() const {
@@ -206,24 +237,26 @@ std::shared_ptr<Frame> PixelValueOffset::process(std::shared_ptr<const Frame> fr
     }
 
     std::lock_guard<std::mutex> offsetLock(mtx_);
-    auto                        videoFrame = frame->as<VideoFrame>();
-    auto                        outFrame   = FrameFactory::createFrameFromOtherFrame(frame);
-    if(offset_ != 0) {
-        switch(frame->getFormat()) {
-        case OB_FORMAT_Y16:
-            imagePixelValueOffset((uint16_t *)frame->getData(), (uint16_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
-            break;
-        case OB_FORMAT_Y8:
-            imagePixelValueOffset((uint8_t *)frame->getData(), (uint8_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
-            break;
-        default:
-            LOG_ERROR_INTVL("PixelValueOffset: unsupported format: {}", frame->getFormat());
-            break;
-        }
+    if(offset_ == 0) {
+        return FrameFactory::cloneFrame(frame);
+    }
 
-        uint8_t bitSize = frame->as<VideoFrame>()->getPixelAvailableBitSize();
-        outFrame->as<VideoFrame>()->setPixelAvailableBitSize(bitSize - offset_);
+    auto videoFrame = frame->as<VideoFrame>();
+    auto outFrame   = FrameFactory::createFrameFromOtherFrame(frame);
+    switch(frame->getFormat()) {
+    case OB_FORMAT_Y16:
+        imagePixelValueOffset((uint16_t *)frame->getData(), (uint16_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
+        break;
+    case OB_FORMAT_Y8:
+        imagePixelValueOffset((uint8_t *)frame->getData(), (uint8_t *)outFrame->getData(), videoFrame->getWidth(), videoFrame->getHeight(), offset_);
+        break;
+    default:
+        LOG_ERROR_INTVL("PixelValueOffset: unsupported format: {}", frame->getFormat());
+        break;
     }
+
+    uint8_t bitSize = frame->as<VideoFrame>()->getPixelAvailableBitSize();
+    outFrame->as<VideoFrame>()->setPixelAvailableBitSize(bitSize - offset_);
     return outFrame;
 }
 
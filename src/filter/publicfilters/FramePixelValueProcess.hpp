@@ -13,6 +13,7 @@ public:
     ~PixelValueScaler() noexcept override;
 
     void               updateConfig(std::vector<std::string> &params) override;
+    bool               updateTypedConfig(const FilterConfigValues &values) override;
     const std::string &getConfigSchema() const override;
     void               reset() override {}
 
@@ -30,6 +31,7 @@ public:
     virtual ~ThresholdFilter() noexcept;
 
     void               updateConfig(std::vector<std::string> &params) override;
+    bool               updateTypedConfig(const FilterConfigValues &values) override;
     const std::string &getConfigSchema() const override;
     void               reset() override {}
 
@@ -48,6 +50,7 @@ public:
     virtual ~PixelValueOffset() noexcept;
 
     void               updateConfig(std::vector<std::string> &params) override;
+    bool               updateTypedConfig(const FilterConfigValues &values) override;
     const std::string &getConfigSchema() const override;
     void               reset() override {}
 
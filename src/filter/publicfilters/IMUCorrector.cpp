@@ -119,7 +119,7 @@ std::shared_ptr<Frame> IMUCorrector::process(std::shared_ptr<const Frame> frame)
         return nullptr;
     }
 
-    auto newFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+    auto newFrame = FrameFactory::cloneFrame(frame);
     if(!frame->is<FrameSet>()) {
         return newFrame;
     }
@@ -131,8 +131,15 @@ std::shared_ptr<Frame> IMUCorrector::process(std::shared_ptr<const Frame> frame)
         auto accelSp   = sp->as<AccelStreamProfile>();
         auto intrinsic = accelSp->getIntrinsic();
 
-        auto frameData   = (AccelFrame::Data *)accelFrame->getData();
-        frameData->value = correctAccel(frameData->value, &intrinsic);
+        auto frameData = (AccelFrame::Data *)accelFrame->getDataMutable();
+        auto batch     = ImuSampleBatch::get(accelFrame.get());
+        if(batch.count > 0) {
+            correctSamples(batch, intrinsic.scaleMisalignment, intrinsic.bias);
+            frameData->value = { batch.x[batch.count - 1], batch.y[batch.count - 1], batch.z[batch.count - 1] };
+        }
+        else {
+            frameData->value = correctAccel(frameData->value, &intrinsic);
+        }
     }
 
     auto gyroFrame = frameSet->getFrame(OB_FRAME_GYRO);
@@ -141,13 +148,43 @@ std::shared_ptr<Frame> IMUCorrector::process(std::shared_ptr<const Frame> frame)
         auto gyroSp    = sp->as<GyroStreamProfile>();
         auto intrinsic = gyroSp->getIntrinsic();
 
-        auto frameData   = (GyroFrame::Data *)gyroFrame->getData();
-        frameData->value = correctGyro(frameData->value, &intrinsic);
+        auto frameData = (GyroFrame::Data *)gyroFrame->getDataMutable();
+        auto batch     = ImuSampleBatch::get(gyroFrame.get());
+        if(batch.count > 0) {
+            correctSamples(batch, intrinsic.scaleMisalignment, intrinsic.bias);
+            frameData->value = { batch.x[batch.count - 1], batch.y[batch.count - 1], batch.z[batch.count - 1] };
+        }
+        else {
+            frameData->value = correctGyro(frameData->value, &intrinsic);
+        }
     }
 
     return newFrame;
 }
 
+void IMUCorrector::correctSamples(const ImuSampleBatch &batch, const double scaleMisalignment[9], const double bias[3]) {
+    // Same as correctAccel/correctGyro, in single precision over the SoA arrays so that the loop is vectorized
+    float m[9];
+    for(int i = 0; i < 9; i++) {
+        m[i] = static_cast<float>(scaleMisalignment[i]);
+    }
+    const float bx = static_cast<float>(bias[0]);
+    const float by = static_cast<float>(bias[1]);
+    const float bz = static_cast<float>(bias[2]);
+
+    float *x = batch.x;
+    float *y = batch.y;
+    float *z = batch.z;
+    for(uint32_t i = 0; i < batch.count; i++) {
+        const float dx = x[i] - bx;
+        const float dy = y[i] - by;
+        const float dz = z[i] - bz;
+        x[i]           = m[0] * dx + m[1] * dy + m[2] * dz;
+        y[i]           = m[3] * dx + m[4] * dy + m[5] * dz;
+        z[i]           = m[6] * dx + m[7] * dy + m[8] * dz;
+    }
+}
+
 OBAccelValue IMUCorrector::correctAccel(const OBAccelValue &accelValue, OBAccelIntrinsic *intrinsic) {
     double M_acc[3][3];
     double bias_acc[3];
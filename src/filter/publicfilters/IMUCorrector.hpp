@@ -6,6 +6,7 @@
 #include "libobsensor/h/ObTypes.h"
 // #include "IProperty.hpp"
 #include "InternalTypes.hpp"
+#include "frame/Frame.hpp"
 
 namespace libobsensor {
 
@@ -16,6 +17,8 @@ public:
     static float                calculateAccelGravity(int16_t accelValue, uint8_t accelFSR);
     static float                calculateGyroDPS(int16_t gyroValue, uint8_t gyroFSR);
     static float                calculateRegisterTemperature(int16_t tempValue);
+    // Correct the samples of a batched accel/gyro frame in place
+    static void correctSamples(const ImuSampleBatch &batch, const double scaleMisalignment[9], const double bias[3]);
 
 public:
     IMUCorrector();
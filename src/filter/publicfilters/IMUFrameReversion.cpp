@@ -30,7 +30,7 @@ std::shared_ptr<Frame> IMUFrameReversion::process(std::shared_ptr<const Frame> f
         return nullptr;
     }
 
-    auto newFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+    auto newFrame = FrameFactory::cloneFrame(frame);
     if(!frame->is<FrameSet>()) {
         return newFrame;
     }
@@ -38,22 +38,47 @@ std::shared_ptr<Frame> IMUFrameReversion::process(std::shared_ptr<const Frame> f
     auto frameSet   = newFrame->as<FrameSet>();
     auto accelFrame = frameSet->getFrame(OB_FRAME_ACCEL);
     if(accelFrame) {
-        AccelFrame::Data *frameData = (AccelFrame::Data *)accelFrame->getData();
-        frameData->value.x *= -1;
-        frameData->value.y *= -1;
-        frameData->value.z *= -1;
+        AccelFrame::Data *frameData = (AccelFrame::Data *)accelFrame->getDataMutable();
+        auto              batch     = ImuSampleBatch::get(accelFrame.get());
+        if(batch.count > 0) {
+            reverseSamples(batch);
+            frameData->value = { batch.x[batch.count - 1], batch.y[batch.count - 1], batch.z[batch.count - 1] };
+        }
+        else {
+            frameData->value.x *= -1;
+            frameData->value.y *= -1;
+            frameData->value.z *= -1;
+        }
     }
 
     auto gyroFrame = frameSet->getFrame(OB_FRAME_GYRO);
     if(gyroFrame) {
-        GyroFrame::Data *gyroFrameData = (GyroFrame::Data *)gyroFrame->getData();
-        gyroFrameData->value.x *= -1;
-        gyroFrameData->value.y *= -1;
-        gyroFrameData->value.z *= -1;
+        GyroFrame::Data *gyroFrameData = (GyroFrame::Data *)gyroFrame->getDataMutable();
+        auto             batch         = ImuSampleBatch::get(gyroFrame.get());
+        if(batch.count > 0) {
+            reverseSamples(batch);
+            gyroFrameData->value = { batch.x[batch.count - 1], batch.y[batch.count - 1], batch.z[batch.count - 1] };
+        }
+        else {
+            gyroFrameData->value.x *= -1;
+            gyroFrameData->value.y *= -1;
+            gyroFrameData->value.z *= -1;
+        }
     }
 
     return newFrame;
 }
 
+void IMUFrameReversion::reverseSamples(const ImuSampleBatch &batch) {
+    float *x = batch.x;
+    float *y = batch.y;
+    float *z = batch.z;
+    for(uint32_t i = 0; i < batch.count; i++) {
+        x[i] = -x[i];
+        y[i] = -y[i];
+        z[i] = -z[i];
+    }
+}
+
 }  // namespace libobsensor
 
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "IFilter.hpp"
+#include "frame/Frame.hpp"
 #include <mutex>
 
 namespace libobsensor {
@@ -16,6 +17,9 @@ public:
     const std::string &getConfigSchema() const override;
     void               reset() override {}
 
+    // Reverse the samples of a batched accel/gyro frame in place
+    static void reverseSamples(const ImuSampleBatch &batch);
+
 private:
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
 };
@@ -9,6 +9,8 @@
 #include "libobsensor/h/ObTypes.h"
 #include "utils/CoordinateUtil.hpp"
 #include "utils/Utils.hpp"
+#include "utils/TaskExecutor.hpp"
+#include "environment/EnvConfig.hpp"
 
 namespace libobsensor {
 
@@ -17,8 +19,19 @@ PointCloudFilter::PointCloudFilter()
       positionDataScale_(1.0f),
       coordinateSystemType_(OB_RIGHT_HAND_COORDINATE_SYSTEM),
       isColorDataNormalization_(false),
+      outputMode_(OBPointCloudOutputMode::OB_POINT_CLOUD_ORGANIZED_OUTPUT),
       tablesDataSize_(0),
-      tablesData_(nullptr) {}
+      tablesData_(nullptr) {
+    int threadCount = 1;
+    EnvConfig::getInstance()->getIntValue("Misc.PointCloudThreadCount", threadCount);
+    if(threadCount == 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if(threadCount > 1) {
+        // the calling thread processes a band as well
+        executor_ = std::make_shared<TaskExecutor>(static_cast<uint32_t>(threadCount - 1), false);
+    }
+}
 
 PointCloudFilter::~PointCloudFilter() noexcept {
     reset();
@@ -28,6 +41,8 @@ void PointCloudFilter::reset() {
     if(formatConverter_) {
         formatConverter_.reset();
     }
+    decodedColorFrame_.reset();
+    decodedRgbFrame_.reset();
     if(tablesData_) {
         tablesData_.reset();
         tablesDataSize_ = 0;
@@ -35,32 +50,56 @@ void PointCloudFilter::reset() {
 }
 
 void PointCloudFilter::updateConfig(std::vector<std::string> &params) {
-    if(params.size() != 4) {
+    // compactOutputMode is optional for compatibility
+    if(params.size() != 4 && params.size() != 5) {
         throw invalid_value_exception("PointCloudFilter config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-        OBFormat type = (OBFormat)std::stoi(params[0]);
-        if(type != OB_FORMAT_POINT && type != OB_FORMAT_RGB_POINT) {
-            LOG_ERROR("Invalid type, the pointType must be OB_FORMAT_POINT or OB_FORMAT_RGB_POINT");
-        }
-        else {
-            pointFormat_ = type;
-        }
-
-        float scale = std::stof(params[1]);
-        if(scale >= 0.000009 && scale <= 100) {
-            positionDataScale_ = scale;
+        values.push_back(std::stoi(params[0]));
+        values.push_back(std::stof(params[1]));
+        values.push_back(std::stoi(params[2]));
+        values.push_back(std::stoi(params[3]));
+        if(params.size() == 5) {
+            values.push_back(std::stoi(params[4]));
         }
-
-        int colorDataNormalizationState = std::stoi(params[2]);
-        isColorDataNormalization_       = colorDataNormalizationState == 0 ? false : true;
-
-        int csType            = std::stoi(params[3]);
-        coordinateSystemType_ = static_cast<OBCoordinateSystemType>(csType);
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("PointCloudFilter config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool PointCloudFilter::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 4 && values.size() != 5) {
+        throw invalid_value_exception("PointCloudFilter config error: params size not match");
+    }
+    OBFormat type = (OBFormat) static_cast<int>(values[0]);
+    if(type != OB_FORMAT_POINT && type != OB_FORMAT_RGB_POINT) {
+        LOG_ERROR("Invalid type, the pointType must be OB_FORMAT_POINT or OB_FORMAT_RGB_POINT");
+    }
+    else {
+        pointFormat_ = type;
+    }
+
+    float scale = static_cast<float>(values[1]);
+    if(scale >= 0.000009 && scale <= 100) {
+        positionDataScale_ = scale;
+    }
+
+    isColorDataNormalization_ = static_cast<int>(values[2]) == 0 ? false : true;
+    coordinateSystemType_     = static_cast<OBCoordinateSystemType>(static_cast<int>(values[3]));
+
+    if(values.size() == 5) {
+        int outputMode = static_cast<int>(values[4]);
+        if(outputMode < 0 || outputMode > static_cast<int>(OBPointCloudOutputMode::OB_POINT_CLOUD_COMPACT_WITH_INDEX_OUTPUT)) {
+            LOG_ERROR("Invalid compactOutputMode: {}, the compactOutputMode must be 0, 1 or 2", outputMode);
+        }
+        else {
+            outputMode_ = static_cast<OBPointCloudOutputMode>(outputMode);
+        }
+    }
+    return true;
 }
 
 const std::string &PointCloudFilter::getConfigSchema() const {
@@ -68,7 +107,9 @@ const std::string &PointCloudFilter::getConfigSchema() const {
     static const std::string schema = "pointFormat, integer, 19, 20, 1, 19, create point type: 19 is OB_FORMAT_POINT; 20 is OB_FORMAT_RGB_POINT\n"
                                       "coordinateDataScale, float, 0.00000001, 100, 0.00001, 1.0, coordinate data scale\n"
                                       "colorDataNormalization, integer, 0, 1, 1, 0, color data normal state\n"
-                                      "coordinateSystemType, integer, 0, 1, 1, 1, Coordinate system representation type: 0 is left hand; 1 is right hand\n";
+                                      "coordinateSystemType, integer, 0, 1, 1, 1, Coordinate system representation type: 0 is left hand; 1 is right hand\n"
+                                      "compactOutputMode, integer, 0, 2, 1, 0, output mode: 0 is all the points (organized); 1 is the valid points only; 2 is the "
+                                      "valid points only with the pixel index of each point\n";
     return schema;
 }
 
@@ -92,8 +133,11 @@ std::shared_ptr<Frame> PointCloudFilter::createDepthPointCloud(std::shared_ptr<c
     auto depthWidth              = depthVideoFrame->getWidth();
     auto depthHeight             = depthVideoFrame->getHeight();
     auto pointDataSize           = depthWidth * depthHeight * sizeof(OBPoint);
+    auto withPointIndex          = outputMode_ == OBPointCloudOutputMode::OB_POINT_CLOUD_COMPACT_WITH_INDEX_OUTPUT;
 
-    auto pointFrame = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_POINT, pointDataSize);
+    // the point index is stored after the space of the points, so that the points and the indexes are written in one pass
+    auto pointIndexSize = withPointIndex ? depthWidth * depthHeight * sizeof(uint32_t) : 0;
+    auto pointFrame     = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_POINT, pointDataSize + pointIndexSize);
     if(pointFrame == nullptr) {
         LOG_ERROR_INTVL("Acquire point cloud frame failed!");
         return nullptr;
@@ -118,8 +162,20 @@ std::shared_ptr<Frame> PointCloudFilter::createDepthPointCloud(std::shared_ptr<c
         }
     }
 
-    CoordinateUtil::transformationDepthToPointCloud(&xyTables_, depthFrame->getData(), (void *)pointFrame->getData(), positionDataScale_,
-                                                    coordinateSystemType_);
+    if(outputMode_ == OBPointCloudOutputMode::OB_POINT_CLOUD_ORGANIZED_OUTPUT) {
+        CoordinateUtil::transformationDepthToPointCloud(&xyTables_, depthFrame->getData(), (void *)pointFrame->getData(), positionDataScale_,
+                                                        coordinateSystemType_, executor_.get());
+    }
+    else {
+        auto pointIndexData = withPointIndex ? reinterpret_cast<uint32_t *>(pointFrame->getDataMutable() + pointDataSize) : nullptr;
+        auto pointCount     = CoordinateUtil::transformationDepthToCompactPointCloud(&xyTables_, depthFrame->getData(), (void *)pointFrame->getData(),
+                                                                                     pointIndexData, positionDataScale_, coordinateSystemType_,
+                                                                                     executor_.get());
+        pointFrame->setDataSize(pointCount * sizeof(OBPoint));
+        if(withPointIndex) {
+            pointFrame->as<PointsFrame>()->setPointIndexOffset(pointDataSize);
+        }
+    }
 
     float depthValueScale = depthFrame->as<DepthFrame>()->getValueScale();
     pointFrame->copyInfoFromOther(depthFrame);
@@ -157,68 +213,35 @@ std::shared_ptr<Frame> PointCloudFilter::createRGBDPointCloud(std::shared_ptr<co
     OBCameraIntrinsic  dstIntrinsic          = dstVideoStreamProfile->getIntrinsic();
     OBCameraDistortion dstDistortion         = dstVideoStreamProfile->getDistortion();
 
-    // Create an RGBD point cloud frame
-    auto pointFrame = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_RGB_POINT, dstWidth * dstHeight * sizeof(OBColorPoint));
+    // Create an RGBD point cloud frame, the point index is stored after the space of the points
+    auto pointDataSize  = dstWidth * dstHeight * sizeof(OBColorPoint);
+    auto withPointIndex = outputMode_ == OBPointCloudOutputMode::OB_POINT_CLOUD_COMPACT_WITH_INDEX_OUTPUT;
+    auto pointIndexSize = withPointIndex ? dstWidth * dstHeight * sizeof(uint32_t) : 0;
+    auto pointFrame     = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_RGB_POINT, pointDataSize + pointIndexSize);
     if(pointFrame == nullptr) {
         LOG_WARN_INTVL("Acquire point cloud frame failed!");
         return nullptr;
     }
 
-    // decode rgb frame
-    if(formatConverter_ == nullptr) {
-        formatConverter_ = std::make_shared<FormatConverter>();
+    // The YUV color frames are sampled by the point cloud functions without converting the whole frame to RGB
+    RGBDColorImage colorImage = { colorFrame->getFormat(), colorFrame->getData(), static_cast<int>(colorVideoFrame->getWidth()),
+                                  static_cast<int>(colorVideoFrame->getHeight()) };
+    if(colorImage.format == OB_FORMAT_MJPG) {
+        auto rgbFrame = decodeColorFrame(colorFrame);
+        if(!rgbFrame) {
+            LOG_ERROR_INTVL("get rgb data failed!");
+            return nullptr;
+        }
+        colorImage.format = OB_FORMAT_RGB;
+        colorImage.data   = rgbFrame->getData();
     }
-
-    std::shared_ptr<const Frame> tarFrame;
-    std::vector<std::string>     params;
-    switch(colorFrame->getFormat()) {
-    case OB_FORMAT_YUYV:
-        // FORMAT_YUYV_TO_RGB
-        params.push_back("0");
-        formatConverter_->updateConfig(params);
-        break;
-    case OB_FORMAT_UYVY:
-        // FORMAT_UYVY_TO_RGB888
-        params.push_back("10");
-        formatConverter_->updateConfig(params);
-        break;
-    case OB_FORMAT_I420:
-        // FORMAT_I420_TO_RGB888
-        params.push_back("1");
-        formatConverter_->updateConfig(params);
-        break;
-    case OB_FORMAT_MJPG:
-        // FORMAT_MJPG_TO_RGB888
-        params.push_back("7");
-        formatConverter_->updateConfig(params);
-        break;
-    case OB_FORMAT_NV21:
-        // FORMAT_NV21_TO_RGB888
-        params.push_back("2");
-        formatConverter_->updateConfig(params);
-        break;
-    case OB_FORMAT_NV12:
-        // FORMAT_NV12_TO_RGB888
-        params.push_back("3");
-        formatConverter_->updateConfig(params);
-        break;
-    case OB_FORMAT_RGB:
-        tarFrame = colorFrame;
-        break;
-    default:
+    else if(!CoordinateUtil::isRGBDColorFormatSupported(colorImage.format)) {
         throw unsupported_operation_exception("unsupported color format for RgbDepth pointCloud convert!");
     }
 
-    uint8_t *colorData = nullptr;
-    if(colorFrame->getFormat() != OB_FORMAT_RGB) {
-        tarFrame = formatConverter_->process(colorFrame);
-    }
-
-    if(tarFrame) {
-        colorData = (uint8_t *)tarFrame->getData();
-    }
-    else {
-        LOG_ERROR_INTVL("get rgb data failed!");
+    // The color is sampled at the pixel index of the depth frame, the color frame is expected to be aligned to the depth frame
+    if(static_cast<uint32_t>(colorImage.width * colorImage.height) < dstWidth * dstHeight) {
+        LOG_ERROR_INTVL("The color frame ({}x{}) is smaller than the depth frame ({}x{})!", colorImage.width, colorImage.height, dstWidth, dstHeight);
         return nullptr;
     }
 
@@ -251,13 +274,34 @@ std::shared_ptr<Frame> PointCloudFilter::createRGBDPointCloud(std::shared_ptr<co
         }
     }
 
-    if(distortionType == OBPointCloudDistortionType::OB_POINT_CLOUD_ADD_DISTORTION_TYPE) {
-        CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(dstIntrinsic, &xyTables_, depthFrame->getData(), colorData, (void *)pointFrame->getData(),
-                                                                      positionDataScale_, coordinateSystemType_, isColorDataNormalization_);
+    if(outputMode_ == OBPointCloudOutputMode::OB_POINT_CLOUD_ORGANIZED_OUTPUT) {
+        if(distortionType == OBPointCloudDistortionType::OB_POINT_CLOUD_ADD_DISTORTION_TYPE) {
+            CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(dstIntrinsic, &xyTables_, depthFrame->getData(), colorImage,
+                                                                          (void *)pointFrame->getData(), positionDataScale_, coordinateSystemType_,
+                                                                          isColorDataNormalization_);
+        }
+        else {
+            CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables_, depthFrame->getData(), colorImage, (void *)pointFrame->getData(), positionDataScale_,
+                                                                coordinateSystemType_, isColorDataNormalization_, executor_.get());
+        }
     }
     else {
-        CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables_, depthFrame->getData(), colorData, (void *)pointFrame->getData(), positionDataScale_,
-                                                            coordinateSystemType_, isColorDataNormalization_);
+        auto     pointIndexData = withPointIndex ? reinterpret_cast<uint32_t *>(pointFrame->getDataMutable() + pointDataSize) : nullptr;
+        uint32_t pointCount     = 0;
+        if(distortionType == OBPointCloudDistortionType::OB_POINT_CLOUD_ADD_DISTORTION_TYPE) {
+            pointCount = CoordinateUtil::transformationDepthToCompactRGBDPointCloudByUVTables(dstIntrinsic, &xyTables_, depthFrame->getData(), colorImage,
+                                                                                              (void *)pointFrame->getData(), pointIndexData, positionDataScale_,
+                                                                                              coordinateSystemType_, isColorDataNormalization_);
+        }
+        else {
+            pointCount = CoordinateUtil::transformationDepthToCompactRGBDPointCloud(&xyTables_, depthFrame->getData(), colorImage, (void *)pointFrame->getData(),
+                                                                                    pointIndexData, positionDataScale_, coordinateSystemType_,
+                                                                                    isColorDataNormalization_, executor_.get());
+        }
+        pointFrame->setDataSize(pointCount * sizeof(OBColorPoint));
+        if(withPointIndex) {
+            pointFrame->as<PointsFrame>()->setPointIndexOffset(pointDataSize);
+        }
     }
 
     float depthValueScale = depthVideoFrame->as<DepthFrame>()->getValueScale();
@@ -267,6 +311,20 @@ std::shared_ptr<Frame> PointCloudFilter::createRGBDPointCloud(std::shared_ptr<co
     return pointFrame;
 }
 
+std::shared_ptr<const Frame> PointCloudFilter::decodeColorFrame(const std::shared_ptr<const Frame> &colorFrame) {
+    // The same color frame is received again when the depth frame rate is higher than the color frame rate
+    if(colorFrame == decodedColorFrame_) {
+        return decodedRgbFrame_;
+    }
+    if(formatConverter_ == nullptr) {
+        formatConverter_ = std::make_shared<FormatConverter>();
+        formatConverter_->setConversion(OB_FORMAT_MJPG, OB_FORMAT_RGB);
+    }
+    decodedRgbFrame_   = formatConverter_->process(colorFrame);
+    decodedColorFrame_ = decodedRgbFrame_ ? colorFrame : nullptr;
+    return decodedRgbFrame_;
+}
+
 std::shared_ptr<Frame> PointCloudFilter::process(std::shared_ptr<const Frame> frame) {
     if(!frame) {
         return nullptr;
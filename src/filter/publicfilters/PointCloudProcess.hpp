@@ -8,6 +8,8 @@
 
 namespace libobsensor {
 
+class TaskExecutor;
+
 class PointCloudFilter : public IFilterBase {
     enum class OBPointCloudDistortionType {
         // The depth camera already includes the distortion from the color camera.
@@ -24,6 +26,17 @@ class PointCloudFilter : public IFilterBase {
         OB_POINT_CLOUD_ZERO_DISTORTION_TYPE,
     };
 
+    enum class OBPointCloudOutputMode {
+        // Organized point cloud: width * height points, the invalid points are zero.
+        OB_POINT_CLOUD_ORGANIZED_OUTPUT = 0,
+
+        // Compact point cloud: only the valid points (the depth is not 0 and can be projected), in pixel order.
+        OB_POINT_CLOUD_COMPACT_OUTPUT,
+
+        // Compact point cloud with the pixel index of each point, see PointsFrame::getPointIndexData.
+        OB_POINT_CLOUD_COMPACT_WITH_INDEX_OUTPUT,
+    };
+
 public:
     PointCloudFilter();
     virtual ~PointCloudFilter() noexcept;
@@ -31,12 +44,16 @@ public:
     void reset() override;
 
     void               updateConfig(std::vector<std::string> &params) override;
+    bool               updateTypedConfig(const FilterConfigValues &values) override;
     const std::string &getConfigSchema() const override;
 
 private:
     std::shared_ptr<Frame> createDepthPointCloud(std::shared_ptr<const Frame> frame);
     std::shared_ptr<Frame> createRGBDPointCloud(std::shared_ptr<const Frame> frame);
 
+    // Decode the MJPEG color frame to RGB, the decoded frame is reused while the same color frame is received
+    std::shared_ptr<const Frame> decodeColorFrame(const std::shared_ptr<const Frame> &colorFrame);
+
     std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override;
 
     PointCloudFilter::OBPointCloudDistortionType getDistortionType(OBCameraDistortion colorDistortion, OBCameraDistortion depthDistortion);
@@ -46,12 +63,17 @@ protected:
     float                  positionDataScale_;
     OBCoordinateSystemType coordinateSystemType_;
     bool                   isColorDataNormalization_;
+    OBPointCloudOutputMode outputMode_;
 
     std::shared_ptr<FormatConverter> formatConverter_;
+    std::shared_ptr<const Frame>     decodedColorFrame_;  // the last MJPEG color frame decoded
+    std::shared_ptr<const Frame>     decodedRgbFrame_;    // and its RGB frame
 
     uint32_t               tablesDataSize_;
     std::shared_ptr<float> tablesData_;
     OBXYTables             xyTables_;
+
+    std::shared_ptr<TaskExecutor> executor_;  // split the frame into row bands if Misc.PointCloudThreadCount > 1
 };
 
 }  // namespace libobsensor
@@ -16,19 +16,28 @@ void SequenceIdFilter::updateConfig(std::vector<std::string> &params) {
     if(params.size() != 1) {
         throw invalid_value_exception("SequenceIdFilter config error: params size not match");
     }
+    FilterConfigValues values;
     try {
-
-        int select_sequence_id = std::stoi(params[0]);
-        if(select_sequence_id >= -1 && select_sequence_id <= 1) {
-            if(select_sequence_id != selectedID_) {
-                std::lock_guard<std::recursive_mutex> lk(valueUpdateMutex_);
-                selectedID_ = select_sequence_id;
-            }
-        }
+        values.push_back(std::stoi(params[0]));
     }
     catch(const std::exception &e) {
         throw invalid_value_exception("SequenceIdFilter config error: " + std::string(e.what()));
     }
+    updateTypedConfig(values);
+}
+
+bool SequenceIdFilter::updateTypedConfig(const FilterConfigValues &values) {
+    if(values.size() != 1) {
+        throw invalid_value_exception("SequenceIdFilter config error: params size not match");
+    }
+    int select_sequence_id = static_cast<int>(values[0]);
+    if(select_sequence_id >= -1 && select_sequence_id <= 1) {
+        if(select_sequence_id != selectedID_) {
+            std::lock_guard<std::recursive_mutex> lk(valueUpdateMutex_);
+            selectedID_ = select_sequence_id;
+        }
+    }
+    return true;
 }
 
 const std::string &SequenceIdFilter::getConfigSchema() const {
@@ -47,7 +56,7 @@ std::shared_ptr<Frame> SequenceIdFilter::process(std::shared_ptr<const Frame> fr
         return nullptr;
     }
 
-    auto outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+    auto outFrame = FrameFactory::cloneFrame(frame);
     if(outFrame->is<FrameSet>()) {
         LOG_WARN_INTVL("The Frame processed by SequenceIdFilter cannot be FrameSet!");
         return outFrame;
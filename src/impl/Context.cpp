@@ -88,6 +88,13 @@ void ob_free_idle_memory(ob_context *context, ob_error **error) BEGIN_API_CALL {
 }
 HANDLE_EXCEPTIONS_NO_RETURN(context)
 
+ob_frame_memory_pool_statistics ob_get_frame_memory_pool_statistics(ob_context *context, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(context);
+    auto frameMemPool = context->context->getFrameMemoryPool();
+    return frameMemPool->getStatistics();
+}
+HANDLE_EXCEPTIONS_AND_RETURN({}, context)
+
 void ob_set_logger_severity(ob_log_severity severity, ob_error **error) BEGIN_API_CALL {
     libobsensor::Logger::setLogSeverity(severity);
 }
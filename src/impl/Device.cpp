@@ -13,6 +13,8 @@
 #include "IAlgParamManager.hpp"
 #include "component/timestamp/GlobalTimestampFitter.hpp"
 
+#include <thread>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -143,6 +145,49 @@ ob_device *ob_device_list_get_device_by_uid(const ob_device_list *list, const ch
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, list, uid)
 
+uint32_t ob_device_list_get_devices(const ob_device_list *list, ob_device **devices, uint32_t count, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(list);
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_LE(count, list->list.size());
+
+    // Each device is created by its own thread, so the time to open all devices is close to the time to open the slowest one. The shared
+    // TaskExecutor is not used: it is disabled by default, and the device creations block on the control transfers for up to seconds, which would
+    // hold its workers away from the frame processing of the devices already streaming.
+    auto create = [&](uint32_t index) {
+        devices[index] = nullptr;
+        try {
+            auto &info      = list->list[index];
+            auto  deviceMgr = info->getDeviceManager();
+            auto  device    = deviceMgr->createDevice(info);
+            auto  impl      = new ob_device();
+            impl->device    = device;
+            devices[index]  = impl;
+        }
+        catch(const std::exception &e) {
+            LOG_WARN("Create device {} failed: {}", index, e.what());
+        }
+    };
+    std::vector<std::thread> threads;
+    for(uint32_t i = 1; i < count; i++) {
+        threads.emplace_back(create, i);
+    }
+    if(count > 0) {
+        create(0);
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+
+    uint32_t createdCount = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        if(devices[i]) {
+            createdCount++;
+        }
+    }
+    return createdCount;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, list, devices, count)
+
 void ob_delete_device(ob_device *device, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(device);
     delete device;
@@ -301,6 +346,58 @@ bool ob_device_is_property_supported(const ob_device *device, ob_property_id pro
 }
 HANDLE_EXCEPTIONS_AND_RETURN(false, device, property_id, permission)
 
+uint32_t ob_device_execute_property_operations(ob_device *device, ob_property_operation *operations, uint32_t count, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(operations);
+    auto propServer = device->device->getPropertyServer();
+    return propServer->executePropertyOperations(operations, count, libobsensor::PROP_ACCESS_USER);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device, operations, count)
+
+uint32_t ob_devices_execute_property_operations(ob_device **devices, uint32_t device_count, ob_property_operation *operations, uint32_t count,
+                                                ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_NOT_NULL(operations);
+    for(uint32_t i = 0; i < device_count; i++) {
+        VALIDATE_NOT_NULL(devices[i]);
+    }
+
+    // Each device is accessed by its own thread, so the round-trips to the devices overlap instead of adding up
+    std::vector<uint32_t> failedCounts(device_count, 0);
+
+    auto execute = [&](uint32_t index) {
+        auto deviceOperations = operations + static_cast<size_t>(index) * count;
+        try {
+            auto propServer     = devices[index]->device->getPropertyServer();
+            failedCounts[index] = propServer->executePropertyOperations(deviceOperations, count, libobsensor::PROP_ACCESS_USER);
+        }
+        catch(const std::exception &e) {
+            LOG_WARN("Execute property operations on device {} failed: {}", index, e.what());
+            for(uint32_t i = 0; i < count; i++) {
+                deviceOperations[i].status = OB_STATUS_ERROR;
+            }
+            failedCounts[index] = count;
+        }
+    };
+    std::vector<std::thread> threads;
+    for(uint32_t i = 1; i < device_count; i++) {
+        threads.emplace_back(execute, i);
+    }
+    if(device_count > 0) {
+        execute(0);
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+
+    uint32_t failedCount = 0;
+    for(auto &deviceFailedCount: failedCounts) {
+        failedCount += deviceFailedCount;
+    }
+    return failedCount;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, devices, device_count, operations, count)
+
 bool ob_device_is_global_timestamp_supported(const ob_device *device, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(device);
     return device->device->isComponentExists(libobsensor::OB_DEV_COMPONENT_GLOBAL_TIMESTAMP_FILTER);
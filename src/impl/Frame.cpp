@@ -216,9 +216,17 @@ float ob_points_frame_get_coordinate_value_scale(const ob_frame *frame, ob_error
 }
 HANDLE_EXCEPTIONS_AND_RETURN(-1.0f, frame)
 
+const uint32_t *ob_points_frame_get_point_index_data(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(frame);
+    auto pointsFrame = frame->frame->as<libobsensor::PointsFrame>();
+    return pointsFrame->getPointIndexData();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame)
+
 uint8_t *ob_frame_get_data(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
-    return const_cast<uint8_t *>(frame->frame->getData());
+    // the returned buffer may be written by the user, so the data shared with the other frames is copied first
+    return frame->frame->getDataMutable();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, frame)
 
@@ -268,6 +276,13 @@ int64_t ob_frame_get_metadata_value(const ob_frame *frame, ob_frame_metadata_typ
 }
 HANDLE_EXCEPTIONS_AND_RETURN(-1, frame)
 
+void ob_frame_get_metadata_values(const ob_frame *frame, ob_frame_metadata_values *values, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    *values = frame->frame->getMetadataValues();
+}
+HANDLE_EXCEPTIONS_NO_RETURN(frame, values)
+
 ob_stream_profile *ob_frame_get_stream_profile(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frame);
     auto innerProfile = frame->frame->getStreamProfile();
@@ -418,6 +433,18 @@ float ob_gyro_frame_get_temperature(const ob_frame *frame, ob_error **error) BEG
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0.0f, frame)
 
+ob_imu_samples ob_imu_frame_get_samples(const ob_frame *frame, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(frame);
+    if(frame->frame->is<libobsensor::AccelFrame>()) {
+        return frame->frame->as<libobsensor::AccelFrame>()->getSamples();
+    }
+    if(frame->frame->is<libobsensor::GyroFrame>()) {
+        return frame->frame->as<libobsensor::GyroFrame>()->getSamples();
+    }
+    throw libobsensor::unsupported_operation_exception("It's not an accel or gyro frame!");
+}
+HANDLE_EXCEPTIONS_AND_RETURN(ob_imu_samples(), frame)
+
 uint32_t ob_frameset_get_count(const ob_frame *frameset, ob_error **error) BEGIN_API_CALL {
     VALIDATE_NOT_NULL(frameset);
     if(!frameset->frame->is<libobsensor::FrameSet>()) {
@@ -78,6 +78,14 @@ void ob_device_timer_sync_with_host(ob_device *device, ob_error **error) BEGIN_A
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+ob_device_clock_sync_status ob_device_get_clock_sync_status(ob_device *device, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(device);
+
+    auto configurator = device->device->getComponentT<libobsensor::IDeviceClockSynchronizer>(libobsensor::OB_DEV_COMPONENT_DEVICE_CLOCK_SYNCHRONIZER);
+    return configurator->getClockSyncStatus();
+}
+HANDLE_EXCEPTIONS_AND_RETURN({}, device)
+
 #ifdef __cplusplus
 }
 #endif
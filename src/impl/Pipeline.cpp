@@ -7,6 +7,7 @@
 #include "exception/ObException.hpp"
 #include "utils/Utils.hpp"
 #include "pipeline/Pipeline.hpp"
+#include "pipeline/MultiDevicePipeline.hpp"
 #include "pipeline/Config.hpp"
 #include "context/Context.hpp"
 
@@ -264,6 +265,107 @@ void ob_config_set_frame_aggregate_output_mode(ob_config *config, ob_frame_aggre
 }
 HANDLE_EXCEPTIONS_NO_RETURN(config, mode)
 
+ob_multi_device_pipeline *ob_create_multi_device_pipeline(ob_device **devices, uint32_t device_count, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_NOT_EQUAL(device_count, 0);
+    std::vector<std::shared_ptr<libobsensor::IDevice>> deviceList;
+    for(uint32_t i = 0; i < device_count; i++) {
+        VALIDATE_NOT_NULL(devices[i]);
+        deviceList.push_back(devices[i]->device);
+    }
+    auto impl      = new ob_multi_device_pipeline();
+    impl->pipeline = std::make_shared<libobsensor::MultiDevicePipeline>(deviceList);
+    return impl;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, devices, device_count)
+
+void ob_delete_multi_device_pipeline(ob_multi_device_pipeline *pipeline, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    delete pipeline;
+}
+HANDLE_EXCEPTIONS_NO_RETURN(pipeline)
+
+void ob_multi_device_pipeline_set_frame_sync_config(ob_multi_device_pipeline *pipeline, const ob_multi_device_frame_sync_config *config,
+                                                    ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    VALIDATE_NOT_NULL(config);
+    pipeline->pipeline->setFrameSyncConfig(*config);
+}
+HANDLE_EXCEPTIONS_NO_RETURN(pipeline, config)
+
+ob_multi_device_frame_sync_config ob_multi_device_pipeline_get_frame_sync_config(ob_multi_device_pipeline *pipeline, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    return pipeline->pipeline->getFrameSyncConfig();
+}
+HANDLE_EXCEPTIONS_AND_RETURN({}, pipeline)
+
+static std::vector<std::shared_ptr<const libobsensor::Config>> getMultiDeviceConfigs(ob_config **configs, uint32_t config_count) {
+    std::vector<std::shared_ptr<const libobsensor::Config>> configList;
+    if(configs) {
+        for(uint32_t i = 0; i < config_count; i++) {
+            configList.push_back(configs[i] ? configs[i]->config : nullptr);
+        }
+    }
+    return configList;
+}
+
+void ob_multi_device_pipeline_start(ob_multi_device_pipeline *pipeline, ob_config **configs, uint32_t config_count, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    pipeline->pipeline->start(getMultiDeviceConfigs(configs, config_count));
+}
+HANDLE_EXCEPTIONS_NO_RETURN(pipeline, configs, config_count)
+
+void ob_multi_device_pipeline_start_with_callback(ob_multi_device_pipeline *pipeline, ob_config **configs, uint32_t config_count,
+                                                  ob_frameset_callback callback, void *user_data, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    VALIDATE_NOT_NULL(callback);
+    pipeline->pipeline->start(getMultiDeviceConfigs(configs, config_count), [callback, user_data](std::shared_ptr<const libobsensor::Frame> frame) {
+        auto impl   = new ob_frame();
+        impl->frame = std::const_pointer_cast<libobsensor::Frame>(frame);  // todo: it's not safe to cast const to non-const, fix it
+        callback(impl, user_data);
+    });
+}
+HANDLE_EXCEPTIONS_NO_RETURN(pipeline, configs, config_count)
+
+void ob_multi_device_pipeline_stop(ob_multi_device_pipeline *pipeline, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    pipeline->pipeline->stop();
+}
+HANDLE_EXCEPTIONS_NO_RETURN(pipeline)
+
+ob_frame *ob_multi_device_pipeline_wait_for_frameset(ob_multi_device_pipeline *pipeline, uint32_t timeout_ms, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    auto frame = pipeline->pipeline->waitForFrameset(timeout_ms);
+    if(!frame) {
+        return nullptr;
+    }
+    auto impl   = new ob_frame();
+    impl->frame = std::const_pointer_cast<libobsensor::Frame>(frame);  // todo: it's not safe to cast const to non-const, fix it
+    return impl;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, pipeline, timeout_ms)
+
+uint32_t ob_multi_device_pipeline_get_device_count(const ob_multi_device_pipeline *pipeline, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    return pipeline->pipeline->getDeviceCount();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, pipeline)
+
+ob_device *ob_multi_device_pipeline_get_device(const ob_multi_device_pipeline *pipeline, uint32_t index, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    VALIDATE_UNSIGNED_INDEX(index, pipeline->pipeline->getDeviceCount());
+    auto impl    = new ob_device();
+    impl->device = pipeline->pipeline->getDevice(index);
+    return impl;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, pipeline, index)
+
+ob_multi_device_frame_sync_statistics ob_multi_device_pipeline_get_statistics(ob_multi_device_pipeline *pipeline, ob_error **error) BEGIN_API_CALL {
+    VALIDATE_NOT_NULL(pipeline);
+    return pipeline->pipeline->getStatistics();
+}
+HANDLE_EXCEPTIONS_AND_RETURN({}, pipeline)
+
 #ifdef __cplusplus
 }
 #endif
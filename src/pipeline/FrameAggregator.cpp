@@ -4,297 +4,488 @@
 // #pragma once
 #include "FrameAggregator.hpp"
 #include "frame/FrameFactory.hpp"
-#include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
 #include "utils/PublicTypeHelper.hpp"
 
-#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
 
 namespace libobsensor {
 
 #define MAX_FRAME_DELAY 0.5f  // 0.3s max delay diff + 0.1s max frame gap
 #define MAX_NORMAL_MODE_QUEUE_SIZE 3
 
-typedef std::map<OBFrameType, SourceFrameQueue>::iterator FrameQueuePair;
-
 const std::map<OBStreamType, OBFrameType> STREAM_FRAME_TYPE_MAP = {
     { OB_STREAM_COLOR, OB_FRAME_COLOR },     { OB_STREAM_DEPTH, OB_FRAME_DEPTH },        { OB_STREAM_IR, OB_FRAME_IR },
     { OB_STREAM_IR_LEFT, OB_FRAME_IR_LEFT }, { OB_STREAM_IR_RIGHT, OB_FRAME_IR_RIGHT },  { OB_STREAM_ACCEL, OB_FRAME_ACCEL },
     { OB_STREAM_GYRO, OB_FRAME_GYRO },       { OB_STREAM_RAW_PHASE, OB_FRAME_RAW_PHASE }
 };
 
-uint64_t getFrameTimestampMsec(const std::shared_ptr<const Frame> &frame, FrameSyncMode syncMode) {
-    if(syncMode == FrameSyncModeSyncAccordingSystemTimestamp) {
-        return frame->getSystemTimeStampUsec() / 1000;
+static uint64_t steadyClockUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FrameRingBuffer::resize(size_t capacity) {
+    slots_.clear();
+    slots_.resize(capacity);
+    head_ = 0;
+    size_ = 0;
+}
+
+void FrameRingBuffer::clear() {
+    while(size_ > 0) {
+        pop();
     }
-    return frame->getTimeStampUsec() / 1000;
+    head_ = 0;
+}
+
+bool FrameRingBuffer::empty() const {
+    return size_ == 0;
+}
+
+size_t FrameRingBuffer::size() const {
+    return size_;
+}
+
+size_t FrameRingBuffer::capacity() const {
+    return slots_.size();
+}
+
+bool FrameRingBuffer::push(std::shared_ptr<const Frame> frame, uint64_t timestampUs, uint64_t arrivalTimeUs) {
+    if(size_ >= slots_.size()) {
+        return false;
+    }
+    auto &slot         = slots_[(head_ + size_) % slots_.size()];
+    slot.frame         = std::move(frame);
+    slot.timestampUs   = timestampUs;
+    slot.arrivalTimeUs = arrivalTimeUs;
+    size_++;
+    return true;
+}
+
+void FrameRingBuffer::pop() {
+    slots_[head_].frame.reset();  // release the frame to the memory pool
+    head_ = (head_ + 1) % slots_.size();
+    size_--;
+}
+
+const std::shared_ptr<const Frame> &FrameRingBuffer::front() const {
+    return slots_[head_].frame;
+}
+
+uint64_t FrameRingBuffer::frontTimestampUs() const {
+    return slots_[head_].timestampUs;
+}
+
+uint64_t FrameRingBuffer::frontArrivalTimeUs() const {
+    return slots_[head_].arrivalTimeUs;
 }
 
 FrameAggregator::FrameAggregator()
     : frameSyncMode_(FrameSyncModeDisable),
-      miniTimeStamp_(0),
+      nonEmptyQueueCount_(0),
+      overflowQueueCount_(0),
       frameAggregateOutputMode_(OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION),
-      frameCnt_(0),
-      withColorFrame_(false),
-      matchingRateFirst_(true) {}
+      matchingRateFirst_(true),
+      clock_(steadyClockUs),
+      statistics_({}) {}
 
 FrameAggregator::~FrameAggregator() noexcept {
+    std::unique_lock<std::mutex> lk(queueMutex_);
     reset();
 }
 
+float FrameAggregator::getProfileFps(std::shared_ptr<const StreamProfile> profile) {
+    float fps = 0;
+    if(profile->is<const VideoStreamProfile>()) {
+        auto videoProfile = profile->as<const VideoStreamProfile>();
+        fps               = (float)videoProfile->getFps();
+    }
+    else if(profile->is<const AccelStreamProfile>()) {
+        auto accelStreamProfile = profile->as<const AccelStreamProfile>();
+        fps                     = utils::mapIMUSampleRateToValue(accelStreamProfile->getSampleRate());
+    }
+    else if(profile->is<const GyroStreamProfile>()) {
+        auto gyroStreamProfile = profile->as<const GyroStreamProfile>();
+        fps                    = utils::mapIMUSampleRateToValue(gyroStreamProfile->getSampleRate());
+    }
+    return fps;
+}
+
+uint32_t FrameAggregator::calcMaxSyncQueueSize(std::shared_ptr<const StreamProfile> profile) {
+    float maxSyncQueueSize = getProfileFps(profile) * MAX_FRAME_DELAY + 1;
+    maxSyncQueueSize += ((maxSyncQueueSize - (int)maxSyncQueueSize) > 0 ? 1 : 0);
+    return (uint32_t)maxSyncQueueSize;
+}
+
 void FrameAggregator::updateConfig(std::shared_ptr<const Config> config, const bool matchingRateFirst) {
-    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
+    std::unique_lock<std::mutex> lk(queueMutex_);
     frameAggregateOutputMode_ = config->getFrameAggregateOutputMode();
     matchingRateFirst_        = matchingRateFirst;
     reset();
     auto profiles = config->getEnabledStreamProfileList();
     for(auto &profile: profiles) {
-        float fps = 0;
-        if(profile->is<const VideoStreamProfile>()) {
-            auto videoProfile = profile->as<const VideoStreamProfile>();
-            fps               = (float)videoProfile->getFps();
-        }
-        else if(profile->is<const AccelStreamProfile>()) {
-            auto accelStreamProfile = profile->as<const AccelStreamProfile>();
-            fps                     = utils::mapIMUSampleRateToValue(accelStreamProfile->getSampleRate());
+        auto fps = getProfileFps(profile);
+
+        SourceFrameQueue srcQueue;
+        srcQueue.frameType        = STREAM_FRAME_TYPE_MAP.find(profile->getType())->second;
+        srcQueue.maxSyncQueueSize = calcMaxSyncQueueSize(profile);
+        srcQueue.halfTspGapUs     = fps > 0 ? static_cast<uint64_t>(500000.0f / fps + 0.5) : 0;  // +0.5 to complete rounding
+        srcQueue.queue.resize(std::max<uint32_t>(srcQueue.maxSyncQueueSize, MAX_NORMAL_MODE_QUEUE_SIZE));
+        srcFrameQueues_.push_back(std::move(srcQueue));
+    }
+    frontHeap_.reserve(srcFrameQueues_.size());
+    matchedQueues_.reserve(srcFrameQueues_.size());
+}
+
+uint64_t FrameAggregator::getFrameTimestampUs(const std::shared_ptr<const Frame> &frame) const {
+    if(frameSyncMode_ == FrameSyncModeSyncAccordingSystemTimestamp) {
+        return frame->getSystemTimeStampUsec();
+    }
+    return frame->getTimeStampUsec();
+}
+
+uint32_t FrameAggregator::getMaxQueueSize(const SourceFrameQueue &queue) const {
+    return frameSyncMode_ == FrameSyncModeDisable ? MAX_NORMAL_MODE_QUEUE_SIZE : queue.maxSyncQueueSize;
+}
+
+void FrameAggregator::pushFrame(std::shared_ptr<const Frame> frame) {
+    std::vector<MatchResult> results;
+    {
+        std::unique_lock<std::mutex> lk(queueMutex_);
+        auto                         frameType = frame->getType();
+        auto                         iter      = std::find_if(srcFrameQueues_.begin(), srcFrameQueues_.end(),
+                                                              [frameType](const SourceFrameQueue &queue) { return queue.frameType == frameType; });
+        if(iter == srcFrameQueues_.end()) {
+            return;
         }
-        else if(profile->is<const GyroStreamProfile>()) {
-            auto gyroStreamProfile = profile->as<const GyroStreamProfile>();
-            fps                    = utils::mapIMUSampleRateToValue(gyroStreamProfile->getSampleRate());
+        statistics_.inputFrameCount++;
+        pushToQueue(static_cast<uint32_t>(iter - srcFrameQueues_.begin()), std::move(frame), clock_());
+        tryAggregator(results);
+        if(results.empty()) {
+            return;
         }
 
-        float maxSyncQueueSize = fps * MAX_FRAME_DELAY + 1;
-        maxSyncQueueSize += ((maxSyncQueueSize - (int)maxSyncQueueSize) > 0 ? 1 : 0);
-        auto halfTspGap = static_cast<uint32_t>(500.0f / fps + 0.5);  // +0.5 to complete rounding
-        srcFrameQueueMap_.insert(
-            { STREAM_FRAME_TYPE_MAP.find(profile->getType())->second, { std::queue<std::shared_ptr<const Frame>>(), (uint32_t)maxSyncQueueSize, halfTspGap } });
+        // take the output lock before releasing the queues, so that the framesets are output in the matching order
+        outputMutex_.lock();
+    }
+
+    std::unique_lock<std::mutex> outputLock(outputMutex_, std::adopt_lock);
+    auto                         nowUs = clock_();
+    for(auto &result: results) {
+        outputFrameset(result, nowUs);
     }
 }
 
-void FrameAggregator::pushFrame(std::shared_ptr<const Frame> frame) {
-    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
-    withEmptyQueue_ = false;
-    // auto tmp = frame->getSystemTimeStamp();
-    // LOG_INFO("Type: {}, AggFrameTimeStamp: {}", frame->getType(), frame->getSystemTimeStamp());
-    auto frameType = frame->getType();
-    for(auto &item: srcFrameQueueMap_) {
-        if(item.first == frameType) {
-            item.second.queue.push(frame);
-            uint32_t maxQueueSize_ = frameSyncMode_ == FrameSyncModeDisable ? MAX_NORMAL_MODE_QUEUE_SIZE : item.second.maxSyncQueueSize_;
-            // auto size = item.second.queue.size();
-            // LOG_INFO("Type: {}, queueSize: {}", frame->getType(), size);
-            if(item.second.queue.size() >= maxQueueSize_) {
-                withOverflowQueue_          = true;
-                withOverflowQueueFrameType_ = frameType;
-            }
+void FrameAggregator::pushToQueue(uint32_t queueIndex, std::shared_ptr<const Frame> frame, uint64_t arrivalTimeUs) {
+    auto &srcQueue = srcFrameQueues_[queueIndex];
+    if(srcQueue.queue.size() >= srcQueue.queue.capacity()) {
+        // not expected, the overflowed queue is drained on each push
+        LOG_WARN_INTVL("Frame aggregator queue of frame type {} is full, drop the oldest frame!", srcQueue.frameType);
+        popFromQueue(queueIndex);
+        rebuildHeap();
+        statistics_.droppedFrameCount++;
+    }
+    auto timestamp = getFrameTimestampUs(frame);
+    srcQueue.queue.push(std::move(frame), timestamp, arrivalTimeUs);
 
-            auto timestamp = getFrameTimestampMsec(frame, frameSyncMode_);
-            if(srcFrameQueueMap_.size() > 1 && frameSyncMode_ && (srcFrameQueueMap_.size() == 2 || !matchingRateFirst_)
-               && (miniTimeStamp_ == 0 || timestamp < miniTimeStamp_)) {
-                miniTimeStamp_          = timestamp;
-                miniTimeStampFrameType_ = frameType;
-            }
-        }
-        else if(item.second.queue.empty()) {
-            withEmptyQueue_ = true;
+    auto size = srcQueue.queue.size();
+    if(size == 1) {
+        nonEmptyQueueCount_++;
+        heapPush(queueIndex);
+    }
+    if(size == getMaxQueueSize(srcQueue)) {
+        overflowQueueCount_++;
+    }
+}
+
+void FrameAggregator::popFromQueue(uint32_t queueIndex) {
+    auto &srcQueue = srcFrameQueues_[queueIndex];
+    if(srcQueue.queue.size() == getMaxQueueSize(srcQueue)) {
+        overflowQueueCount_--;
+    }
+    srcQueue.queue.pop();
+    if(srcQueue.queue.empty()) {
+        nonEmptyQueueCount_--;
+    }
+}
+
+void FrameAggregator::heapPush(uint32_t queueIndex) {
+    frontHeap_.push_back({ srcFrameQueues_[queueIndex].queue.frontTimestampUs(), queueIndex });
+    std::push_heap(frontHeap_.begin(), frontHeap_.end(), std::greater<HeapItem>());
+}
+
+void FrameAggregator::heapPop() {
+    std::pop_heap(frontHeap_.begin(), frontHeap_.end(), std::greater<HeapItem>());
+    frontHeap_.pop_back();
+}
+
+void FrameAggregator::rebuildHeap() {
+    frontHeap_.clear();
+    for(uint32_t i = 0; i < srcFrameQueues_.size(); i++) {
+        if(!srcFrameQueues_[i].queue.empty()) {
+            frontHeap_.push_back({ srcFrameQueues_[i].queue.frontTimestampUs(), i });
         }
     }
-    tryAggregator();
+    std::make_heap(frontHeap_.begin(), frontHeap_.end(), std::greater<HeapItem>());
+}
+
+bool FrameAggregator::isMatchRequired() const {
+    // match when every stream has a frame, or a stream has cached too many frames
+    return !srcFrameQueues_.empty() && (nonEmptyQueueCount_ == srcFrameQueues_.size() || overflowQueueCount_ > 0);
 }
 
-void sortFrameMap(std::map<OBFrameType, SourceFrameQueue> &frameMap, std::vector<FrameQueuePair> &frameVec, FrameSyncMode frameSyncMode) {
-    // Sort srcFrameQueueMap_ so that the pair with the queue having the smallest timestamp at the front is placed first.
-    auto iter = frameMap.begin();
-    while(iter != frameMap.end()) {
-        if(!iter->second.queue.empty()) {
-            frameVec.push_back(iter);
+void FrameAggregator::tryAggregator(std::vector<MatchResult> &results) {
+    bool syncEnabled = srcFrameQueues_.size() > 1 && frameSyncMode_ != FrameSyncModeDisable;
+    while(isMatchRequired()) {
+        MatchResult result    = {};
+        result.minTimestampUs = UINT64_MAX;
+        try {
+            result.frameSet = FrameFactory::createFrameSet();
         }
-        iter++;
-    }
-    std::sort(frameVec.begin(), frameVec.end(), [frameSyncMode](const FrameQueuePair &x, const FrameQueuePair &y) {
-        auto xTsp = getFrameTimestampMsec(x->second.queue.front(), frameSyncMode);
-        auto yTsp = getFrameTimestampMsec(y->second.queue.front(), frameSyncMode);
-        return xTsp < yTsp;
-    });
-}
-
-void FrameAggregator::tryAggregator() {
-    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
-    while(!withEmptyQueue_ || withOverflowQueue_) {
-        frameCnt_       = 0;
-        withColorFrame_ = false;
-        auto frameSet   = FrameFactory::createFrameSet();
-        if(!frameSet) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Wait for 100ms and then try again to see if the request can succeed.
+        catch(const std::exception &e) {
+            // never wait for the memory under the lock, drop the oldest frame instead
+            LOG_WARN_INTVL("Frame aggregator failed to create frameset, drop the oldest frame! {}", e.what());
+            dropOldestFrame();
             continue;
         }
-        if(srcFrameQueueMap_.size() > 1 && frameSyncMode_) {
-            if(matchingRateFirst_ && srcFrameQueueMap_.size() != 2) {  // Match rate priority
-                std::vector<FrameQueuePair> frameVector;
-                sortFrameMap(srcFrameQueueMap_, frameVector, frameSyncMode_);  // Sort srcFrameQueueMap_
-                auto refIter       = frameVector.begin();
-                auto refTsp        = getFrameTimestampMsec((*refIter)->second.queue.front(), frameSyncMode_);
-                auto refHalfTspGap = (*refIter)->second.halfTspGap;
-                for(auto &item: frameVector) {
-                    auto    &tarFrame      = item->second.queue.front();
-                    auto     tarHalfTspGap = item->second.halfTspGap;
-                    uint32_t tspHalfGap    = tarHalfTspGap < refHalfTspGap ? tarHalfTspGap : refHalfTspGap;
-
-                    auto tarTsp = getFrameTimestampMsec(tarFrame, frameSyncMode_);
-                    if(tarTsp - refTsp > tspHalfGap) {
-                        break;
-                    }
-                    refTsp        = tarTsp;  // After dequeuing, save the current reference timestamp to use as a reference for the next loop.
-                    refHalfTspGap = tarHalfTspGap;
-                    frameSet->pushFrame(std::move(tarFrame));
-                    frameCnt_++;
-                    if(item->first == OB_FRAME_COLOR) {
-                        withColorFrame_ = true;
-                    }
-                    item->second.queue.pop();
-                    if(withOverflowQueue_ && item->first == withOverflowQueueFrameType_) {
-                        withOverflowQueue_ = false;
-                    }
-                    if(!withEmptyQueue_ && item->second.queue.empty()) {
-                        withEmptyQueue_ = true;
-                    }
-                }
-            }
-            else {  // Match precision priority
-                uint64_t    newMiniTimeStamp_          = 0;
-                OBFrameType newMiniTimeStampFrameType_ = miniTimeStampFrameType_;
-                // Synchronous matching
-                auto refIter       = srcFrameQueueMap_.find(miniTimeStampFrameType_);
-                auto refTsp        = getFrameTimestampMsec(refIter->second.queue.front(), frameSyncMode_);
-                auto refHalfTspGap = refIter->second.halfTspGap;
-                for(auto &item: srcFrameQueueMap_) {
-                    if(!item.second.queue.empty()) {
-                        auto    &tarFrame      = item.second.queue.front();
-                        auto     tarHalfTspGap = item.second.halfTspGap;
-                        uint32_t tspHalfGap    = tarHalfTspGap < refHalfTspGap ? tarHalfTspGap : refHalfTspGap;
-                        auto     tarTsp        = getFrameTimestampMsec(tarFrame, frameSyncMode_);
-                        if(tarTsp - refTsp <= tspHalfGap) {
-                            frameSet->pushFrame(std::move(tarFrame));
-                            frameCnt_++;
-                            if(item.first == OB_FRAME_COLOR) {
-                                withColorFrame_ = true;
-                            }
-                            item.second.queue.pop();
-                            if(withOverflowQueue_ && item.first == withOverflowQueueFrameType_) {
-                                withOverflowQueue_ = false;
-                            }
-                        }
-                    }
-
-                    if(item.second.queue.empty()) {
-                        withEmptyQueue_ = true;
-                        continue;
-                    }
-
-                    auto tsp = getFrameTimestampMsec(item.second.queue.front(), frameSyncMode_);
-                    if(newMiniTimeStamp_ == 0 || newMiniTimeStamp_ > tsp) {
-                        newMiniTimeStamp_          = tsp;
-                        newMiniTimeStampFrameType_ = item.second.queue.front()->getType();
-                    }
-                }
-                miniTimeStamp_          = newMiniTimeStamp_;
-                miniTimeStampFrameType_ = newMiniTimeStampFrameType_;
-            }
+
+        if(!syncEnabled) {
+            matchAsync(result);
+            addMatchResult(results, result);
+            break;  // at most one frameset for each pushed frame
+        }
+
+        if(matchingRateFirst_ && srcFrameQueues_.size() != 2) {
+            matchRateFirst(result);
         }
         else {
-            // Asynchronous matching
-            for(auto &item: srcFrameQueueMap_) {
-                if(!withEmptyQueue_ || item.second.queue.size() >= MAX_NORMAL_MODE_QUEUE_SIZE - 1) {
-                    auto &srcFrame = item.second.queue.front();
-                    frameSet->pushFrame(std::move(srcFrame));
-                    item.second.queue.pop();
-                    frameCnt_++;
-                    if(item.first == OB_FRAME_COLOR) {
-                        withColorFrame_ = true;
-                    }
-                }
+            matchPrecisionFirst(result);
+        }
+        addMatchResult(results, result);
+    }
+}
+
+// Match rate priority: walk the queue fronts in timestamp order, each frame is matched if it is within half a frame interval of the previous one
+void FrameAggregator::matchRateFirst(MatchResult &result) {
+    matchedQueues_.clear();
+    uint64_t refTsp        = 0;
+    uint64_t refHalfTspGap = 0;
+    while(!frontHeap_.empty()) {
+        auto  item     = frontHeap_.front();
+        auto &srcQueue = srcFrameQueues_[item.queueIndex];
+        if(!matchedQueues_.empty()) {
+            auto tspHalfGap = std::min(srcQueue.halfTspGapUs, refHalfTspGap);
+            if(item.timestampUs - refTsp > tspHalfGap) {
+                break;
             }
-            withEmptyQueue_    = true;
-            withOverflowQueue_ = false;
         }
-        // test code:
-        // auto        depthFrame = frameSet->getFrame(OB_FRAME_DEPTH);
-        // auto        colorFrame = frameSet->getFrame(OB_FRAME_COLOR);
-        // auto        irFrame    = frameSet->getFrame(OB_FRAME_IR);
-        // std::string msg;
-        // if(depthFrame) {
-        //     msg = msg + " | depthFrame tsp=" + std::to_string(depthFrame->getTimeStamp());
-        // }
-        // if(irFrame) {
-        //     msg = msg + " | irFrame tsp=" + std::to_string(irFrame->getTimeStamp());
-        // }
-        // if(colorFrame) {
-        //     msg = msg + " | colorFrame tsp=" + std::to_string(colorFrame->getTimeStamp());
-        // }
-        // if(depthFrame && irFrame) {
-        //     msg = msg + " | depth-ir diff=" + std::to_string((int64_t)depthFrame->getTimeStamp() - (int64_t)irFrame->getTimeStamp());
-        // }
-        // if(depthFrame && colorFrame) {
-        //     msg = msg + " | depth-color diff=" + std::to_string((int64_t)depthFrame->getTimeStamp() - (int64_t)colorFrame->getTimeStamp());
-        // }
-        // if(frameSyncMode_){
-        //     LOG_WARN(msg;
-        // }
-        outputFrameset(frameSet);
-    }
-}
-
-void FrameAggregator::outputFrameset(std::shared_ptr<const FrameSet> frameSet) {
-    if(frameSet != nullptr) {
-        if(srcFrameQueueMap_.size() == 1 || frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION) {
-            FrameSetCallbackFunc_(frameSet);
+        heapPop();
+        refTsp        = item.timestampUs;  // save the current timestamp as the reference of the next frame
+        refHalfTspGap = srcQueue.halfTspGapUs;
+        popToFrameSet(item.queueIndex, result);
+        matchedQueues_.push_back(item.queueIndex);
+    }
+
+    // the next frames enter the heap after the round, so that a frameset has at most one frame of each stream
+    for(auto queueIndex: matchedQueues_) {
+        if(!srcFrameQueues_[queueIndex].queue.empty()) {
+            heapPush(queueIndex);
         }
-        else if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_COLOR_FRAME_REQUIRE && withColorFrame_) {
-            FrameSetCallbackFunc_(frameSet);
+    }
+}
+
+// Match precision priority: each frame is matched if it is within half a frame interval of the oldest frame
+void FrameAggregator::matchPrecisionFirst(MatchResult &result) {
+    matchedQueues_.clear();
+    auto refItem       = frontHeap_.front();
+    auto refHalfTspGap = srcFrameQueues_[refItem.queueIndex].halfTspGapUs;
+    heapPop();
+    popToFrameSet(refItem.queueIndex, result);
+    matchedQueues_.push_back(refItem.queueIndex);
+
+    // the gap is the smaller one of the two streams, so the candidates are all within the gap of the reference stream
+    std::vector<HeapItem> unmatched;
+    while(!frontHeap_.empty() && frontHeap_.front().timestampUs - refItem.timestampUs <= refHalfTspGap) {
+        auto item = frontHeap_.front();
+        heapPop();
+        if(item.timestampUs - refItem.timestampUs <= srcFrameQueues_[item.queueIndex].halfTspGapUs) {
+            popToFrameSet(item.queueIndex, result);
+            matchedQueues_.push_back(item.queueIndex);
+        }
+        else {
+            unmatched.push_back(item);
+        }
+    }
+
+    for(auto &item: unmatched) {
+        frontHeap_.push_back(item);
+        std::push_heap(frontHeap_.begin(), frontHeap_.end(), std::greater<HeapItem>());
+    }
+    for(auto queueIndex: matchedQueues_) {
+        if(!srcFrameQueues_[queueIndex].queue.empty()) {
+            heapPush(queueIndex);
         }
-        else if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_ALL_TYPE_FRAME_REQUIRE && frameCnt_ == srcFrameQueueMap_.size()) {
-            FrameSetCallbackFunc_(frameSet);
+    }
+}
+
+// Asynchronous matching: output the oldest frame of each stream once all streams have a frame, or a stream has cached too many frames
+void FrameAggregator::matchAsync(MatchResult &result) {
+    bool withEmptyQueue = nonEmptyQueueCount_ != srcFrameQueues_.size();
+    for(uint32_t i = 0; i < srcFrameQueues_.size(); i++) {
+        auto &srcQueue = srcFrameQueues_[i].queue;
+        if(!srcQueue.empty() && (!withEmptyQueue || srcQueue.size() >= MAX_NORMAL_MODE_QUEUE_SIZE - 1)) {
+            popToFrameSet(i, result);
         }
     }
+    rebuildHeap();
+}
+
+void FrameAggregator::popToFrameSet(uint32_t queueIndex, MatchResult &result) {
+    auto &srcQueue  = srcFrameQueues_[queueIndex];
+    auto  timestamp = srcQueue.queue.frontTimestampUs();
+    auto  arrival   = srcQueue.queue.frontArrivalTimeUs();
+    auto  frame     = srcQueue.queue.front();
+    result.frameSet->pushFrame(std::move(frame));
+    result.frameCount++;
+    if(srcQueue.frameType == OB_FRAME_COLOR) {
+        result.withColorFrame = true;
+    }
+    if(result.frameCount == 1 || arrival < result.oldestArrivalTimeUs) {
+        result.oldestArrivalTimeUs = arrival;
+    }
+    result.minTimestampUs = std::min(result.minTimestampUs, timestamp);
+    result.maxTimestampUs = std::max(result.maxTimestampUs, timestamp);
+    popFromQueue(queueIndex);
+}
+
+void FrameAggregator::dropOldestFrame() {
+    if(frontHeap_.empty()) {
+        return;
+    }
+    auto queueIndex = frontHeap_.front().queueIndex;
+    heapPop();
+    popFromQueue(queueIndex);
+    if(!srcFrameQueues_[queueIndex].queue.empty()) {
+        heapPush(queueIndex);
+    }
+    statistics_.droppedFrameCount++;
+}
+
+bool FrameAggregator::isOutputRequired(const MatchResult &result) const {
+    if(result.frameCount == 0) {
+        return false;
+    }
+    if(srcFrameQueues_.size() == 1 || frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION) {
+        return true;
+    }
+    if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_COLOR_FRAME_REQUIRE) {
+        return result.withColorFrame;
+    }
+    if(frameAggregateOutputMode_ == OB_FRAME_AGGREGATE_OUTPUT_ALL_TYPE_FRAME_REQUIRE) {
+        return result.frameCount == srcFrameQueues_.size();
+    }
+    return false;
+}
+
+// Called with queueMutex_ locked, the framesets not required by the frame aggregate output mode are discarded here
+void FrameAggregator::addMatchResult(std::vector<MatchResult> &results, MatchResult &result) {
+    if(!isOutputRequired(result)) {
+        statistics_.discardedFramesetCount++;
+        statistics_.droppedFrameCount += result.frameCount;
+        return;
+    }
+    results.push_back(std::move(result));
+}
+
+// Called with outputMutex_ locked
+void FrameAggregator::outputFrameset(MatchResult &result, uint64_t nowUs) {
+    auto latency = nowUs > result.oldestArrivalTimeUs ? nowUs - result.oldestArrivalTimeUs : 0;
+    auto spread  = result.maxTimestampUs - result.minTimestampUs;
+    statistics_.outputFramesetCount++;
+    statistics_.totalMatchLatencyUs += latency;
+    statistics_.maxMatchLatencyUs = std::max(statistics_.maxMatchLatencyUs, latency);
+    statistics_.totalTimestampSpreadUs += spread;
+    statistics_.maxTimestampSpreadUs = std::max(statistics_.maxTimestampSpreadUs, spread);
+
+    if(FrameSetCallbackFunc_) {
+        FrameSetCallbackFunc_(std::move(result.frameSet));
+    }
 }
 
 void FrameAggregator::enableFrameSync(FrameSyncMode mode) {
+    std::unique_lock<std::mutex> lk(queueMutex_);
     if(frameSyncMode_ != mode) {
-        std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
         frameSyncMode_ = mode;
-        clearAllFrameQueue();
+        clearQueues();
     }
 }
 
 void FrameAggregator::setCallback(FrameCallback callback) {
+    std::unique_lock<std::mutex> lk(outputMutex_);
     FrameSetCallbackFunc_ = callback;
 }
 
+void FrameAggregator::setClock(std::function<uint64_t()> clock) {
+    std::unique_lock<std::mutex> lk(queueMutex_);
+    clock_ = clock;
+}
+
+FrameAggregatorStatistics FrameAggregator::getStatistics() {
+    std::unique_lock<std::mutex> lk(queueMutex_);
+    std::unique_lock<std::mutex> outputLock(outputMutex_);
+    return statistics_;
+}
+
+void FrameAggregator::resetStatistics() {
+    std::unique_lock<std::mutex> lk(queueMutex_);
+    std::unique_lock<std::mutex> outputLock(outputMutex_);
+    statistics_ = {};
+}
+
 void FrameAggregator::clearAllFrameQueue() {
-    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
-    for(auto &item: srcFrameQueueMap_) {
-        auto &queue = item.second.queue;
-        while(!queue.empty()) {
-            queue.pop();
+    std::unique_lock<std::mutex> lk(queueMutex_);
+    clearQueues();
+    {
+        std::unique_lock<std::mutex> outputLock(outputMutex_);
+        if(statistics_.outputFramesetCount > 0) {
+            LOG_DEBUG("Frame aggregator statistics: input frames {}, output framesets {}, discarded framesets {}, dropped frames {}, "
+                      "match latency avg {}us max {}us, timestamp spread avg {}us max {}us",
+                      statistics_.inputFrameCount, statistics_.outputFramesetCount, statistics_.discardedFramesetCount, statistics_.droppedFrameCount,
+                      statistics_.totalMatchLatencyUs / statistics_.outputFramesetCount, statistics_.maxMatchLatencyUs,
+                      statistics_.totalTimestampSpreadUs / statistics_.outputFramesetCount, statistics_.maxTimestampSpreadUs);
         }
     }
-    miniTimeStamp_     = 0;
-    withOverflowQueue_ = false;
 }
 
+// Called with queueMutex_ locked
+void FrameAggregator::clearQueues() {
+    for(auto &item: srcFrameQueues_) {
+        item.queue.clear();
+    }
+    frontHeap_.clear();
+    nonEmptyQueueCount_ = 0;
+    overflowQueueCount_ = 0;
+}
+
+// Called with queueMutex_ locked
 void FrameAggregator::reset() {
-    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
-    clearAllFrameQueue();
-    srcFrameQueueMap_.clear();
+    clearQueues();
+    srcFrameQueues_.clear();
 }
 
 void FrameAggregator::clearFrameQueue(OBFrameType frameType) {
-    std::unique_lock<std::recursive_mutex> lk(srcFrameQueueMutex_);
-    for(auto &item: srcFrameQueueMap_) {
-        if(frameType == item.first) {
-            auto &queue = item.second.queue;
-            while(!queue.empty()) {
-                queue.pop();
+    std::unique_lock<std::mutex> lk(queueMutex_);
+    for(uint32_t i = 0; i < srcFrameQueues_.size(); i++) {
+        auto &srcQueue = srcFrameQueues_[i];
+        if(frameType == srcQueue.frameType) {
+            while(!srcQueue.queue.empty()) {
+                popFromQueue(i);
             }
+            rebuildHeap();
             break;
         }
     }
@@ -2,23 +2,52 @@
 // Licensed under the MIT License.
 
 #pragma once
-// #include "core/frame/process/FrameProcessingBlock.hpp"
 #include "libobsensor/h/ObTypes.h"
 #include "frame/Frame.hpp"
 #include "Config.hpp"
 
-#include <map>
-#include <queue>
+#include <functional>
 #include <mutex>
 #include <memory>
-#include <algorithm>
+#include <vector>
 
 namespace libobsensor {
 
+// Fixed capacity FIFO of the frames of a stream, with the timestamp (us) used for matching cached beside each frame
+class FrameRingBuffer {
+public:
+    FrameRingBuffer() : head_(0), size_(0) {}
+
+    void resize(size_t capacity);
+    void clear();
+
+    bool   empty() const;
+    size_t size() const;
+    size_t capacity() const;
+
+    // returns false if the buffer is full
+    bool                                push(std::shared_ptr<const Frame> frame, uint64_t timestampUs, uint64_t arrivalTimeUs);
+    void                                pop();
+    const std::shared_ptr<const Frame> &front() const;
+    uint64_t                            frontTimestampUs() const;
+    uint64_t                            frontArrivalTimeUs() const;
+
+private:
+    struct Slot {
+        std::shared_ptr<const Frame> frame;
+        uint64_t                     timestampUs;
+        uint64_t                     arrivalTimeUs;
+    };
+    std::vector<Slot> slots_;
+    size_t            head_;
+    size_t            size_;
+};
+
 struct SourceFrameQueue {
-    std::queue<std::shared_ptr<const Frame>> queue;
-    uint32_t                                 maxSyncQueueSize_;
-    uint32_t                                 halfTspGap;
+    OBFrameType     frameType;
+    FrameRingBuffer queue;
+    uint32_t        maxSyncQueueSize;
+    uint64_t        halfTspGapUs;  // half of the frame interval, the max timestamp difference to be matched with the other streams
 };
 
 enum FrameSyncMode {
@@ -26,8 +55,19 @@ enum FrameSyncMode {
     FrameSyncModeSyncAccordingFrameTimestamp,
     FrameSyncModeSyncAccordingSystemTimestamp,
 };
+
+struct FrameAggregatorStatistics {
+    uint64_t inputFrameCount;
+    uint64_t outputFramesetCount;
+    uint64_t discardedFramesetCount;  // not output because of the frame aggregate output mode
+    uint64_t droppedFrameCount;       // frames of the discarded framesets and the frames dropped on frameset allocation failures
+    uint64_t totalMatchLatencyUs;     // time from the arrival of the oldest frame of a frameset to the output of the frameset
+    uint64_t maxMatchLatencyUs;
+    uint64_t totalTimestampSpreadUs;  // difference between the max and min timestamps of the frames in a frameset
+    uint64_t maxTimestampSpreadUs;
+};
+
 class FrameAggregator {
-public:
 public:
     FrameAggregator();
     ~FrameAggregator() noexcept;
@@ -40,24 +80,74 @@ public:
     void clearFrameQueue(OBFrameType frameType);
     void clearAllFrameQueue();
 
+    FrameAggregatorStatistics getStatistics();
+    void                      resetStatistics();
+
+    // Clock used for the match latency statistics, default is the steady clock in us. Used to replay recorded streams deterministically.
+    void setClock(std::function<uint64_t()> clock);
+
+    // The max number of frames of the stream that can be cached in the sync queue
+    static uint32_t calcMaxSyncQueueSize(std::shared_ptr<const StreamProfile> profile);
+
 private:
-    void outputFrameset(std::shared_ptr<const FrameSet> frameSet);
+    static float getProfileFps(std::shared_ptr<const StreamProfile> profile);
+
+private:
+    struct HeapItem {
+        uint64_t timestampUs;
+        uint32_t queueIndex;
+
+        bool operator>(const HeapItem &other) const {
+            return timestampUs > other.timestampUs || (timestampUs == other.timestampUs && queueIndex > other.queueIndex);
+        }
+    };
+
+    struct MatchResult {
+        std::shared_ptr<FrameSet> frameSet;
+        uint32_t                  frameCount;
+        bool                      withColorFrame;
+        uint64_t                  oldestArrivalTimeUs;
+        uint64_t                  minTimestampUs;
+        uint64_t                  maxTimestampUs;
+    };
+
     void reset();
-    void tryAggregator();
+    void clearQueues();
+    bool isMatchRequired() const;
+    void tryAggregator(std::vector<MatchResult> &results);
+    void matchRateFirst(MatchResult &result);
+    void matchPrecisionFirst(MatchResult &result);
+    void matchAsync(MatchResult &result);
+    void popToFrameSet(uint32_t queueIndex, MatchResult &result);
+    void dropOldestFrame();
+    bool isOutputRequired(const MatchResult &result) const;
+    void addMatchResult(std::vector<MatchResult> &results, MatchResult &result);
+    void outputFrameset(MatchResult &result, uint64_t nowUs);
+
+    // min-heap of the front timestamps of the non-empty queues, O(log k) for each frame entering or leaving the front of a queue
+    void heapPush(uint32_t queueIndex);
+    void heapPop();
+    void rebuildHeap();
+
+    void pushToQueue(uint32_t queueIndex, std::shared_ptr<const Frame> frame, uint64_t arrivalTimeUs);
+    void popFromQueue(uint32_t queueIndex);
+
+    uint64_t getFrameTimestampUs(const std::shared_ptr<const Frame> &frame) const;
+    uint32_t getMaxQueueSize(const SourceFrameQueue &queue) const;
 
 private:
-    FrameSyncMode                           frameSyncMode_;
-    std::map<OBFrameType, SourceFrameQueue> srcFrameQueueMap_;
-    std::recursive_mutex                    srcFrameQueueMutex_;
-    FrameCallback                           FrameSetCallbackFunc_;
-    uint64_t                                miniTimeStamp_;
-    OBFrameType                             miniTimeStampFrameType_;
-    bool                                    withOverflowQueue_;
-    OBFrameType                             withOverflowQueueFrameType_;
-    bool                                    withEmptyQueue_;
-    OBFrameAggregateOutputMode              frameAggregateOutputMode_;
-    uint32_t                                frameCnt_;
-    bool                                    withColorFrame_;
-    bool                                    matchingRateFirst_;
+    std::mutex                    queueMutex_;   // guards the queues, held by the producers only for the matching
+    std::mutex                    outputMutex_;  // keeps the framesets matched by different producers in order while being output
+    FrameSyncMode                 frameSyncMode_;
+    std::vector<SourceFrameQueue> srcFrameQueues_;
+    std::vector<HeapItem>         frontHeap_;
+    std::vector<uint32_t>         matchedQueues_;  // scratch of the queues popped in a matching round
+    uint32_t                      nonEmptyQueueCount_;
+    uint32_t                      overflowQueueCount_;
+    FrameCallback                 FrameSetCallbackFunc_;
+    OBFrameAggregateOutputMode    frameAggregateOutputMode_;
+    bool                          matchingRateFirst_;
+    std::function<uint64_t()>     clock_;
+    FrameAggregatorStatistics     statistics_;  // the frame counters are guarded by queueMutex_, the output ones by outputMutex_
 };
 }  // namespace libobsensor
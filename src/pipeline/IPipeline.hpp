@@ -7,6 +7,7 @@
 
 namespace libobsensor {
 class Pipeline;
+class MultiDevicePipeline;
 class Config;
 }  // namespace libobsensor
 
@@ -17,6 +18,10 @@ struct ob_pipeline_t {
     std::shared_ptr<libobsensor::Pipeline> pipeline;
 };
 
+struct ob_multi_device_pipeline_t {
+    std::shared_ptr<libobsensor::MultiDevicePipeline> pipeline;
+};
+
 struct ob_config_t {
     std::shared_ptr<libobsensor::Config> config;
 };
@@ -0,0 +1,232 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "MultiDeviceFrameAggregator.hpp"
+#include "frame/FrameFactory.hpp"
+#include "exception/ObException.hpp"
+#include "logger/LoggerInterval.hpp"
+
+namespace libobsensor {
+
+#define DEFAULT_MULTI_DEVICE_FRAME_SYNC_TOLERANCE_US 8000
+#define DEFAULT_MULTI_DEVICE_FRAME_SYNC_MAX_LATENCY_US 200000
+
+MultiDeviceFrameAggregator::MultiDeviceFrameAggregator(uint32_t sourceCount)
+    : config_(getDefaultConfig()), sourceQueues_(sourceCount), nonEmptyQueueCount_(0), newestTimestampUs_(0), groupNumber_(0), statistics_({}) {
+    if(sourceCount == 0) {
+        throw invalid_value_exception("MultiDeviceFrameAggregator: source count should be greater than 0");
+    }
+}
+
+MultiDeviceFrameAggregator::~MultiDeviceFrameAggregator() noexcept {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    clearQueues();
+}
+
+OBMultiDeviceFrameSyncConfig MultiDeviceFrameAggregator::getDefaultConfig() {
+    OBMultiDeviceFrameSyncConfig config;
+    config.timestampType = OB_MULTI_DEVICE_FRAME_SYNC_GLOBAL_TIMESTAMP;
+    config.toleranceUs   = DEFAULT_MULTI_DEVICE_FRAME_SYNC_TOLERANCE_US;
+    config.maxLatencyUs  = DEFAULT_MULTI_DEVICE_FRAME_SYNC_MAX_LATENCY_US;
+    return config;
+}
+
+void MultiDeviceFrameAggregator::setConfig(const OBMultiDeviceFrameSyncConfig &config) {
+    if(config.maxLatencyUs < config.toleranceUs) {
+        throw invalid_value_exception("MultiDeviceFrameAggregator: max latency should not be less than the tolerance");
+    }
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    if(config.timestampType != config_.timestampType) {
+        clearQueues();  // the queued timestamps are not comparable with the new ones
+    }
+    config_ = config;
+}
+
+OBMultiDeviceFrameSyncConfig MultiDeviceFrameAggregator::getConfig() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    return config_;
+}
+
+void MultiDeviceFrameAggregator::setCallback(FrameCallback callback) {
+    std::unique_lock<std::mutex> lock(outputMutex_);
+    callback_ = callback;
+}
+
+OBMultiDeviceFrameSyncStatistics MultiDeviceFrameAggregator::getStatistics() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    return statistics_;
+}
+
+void MultiDeviceFrameAggregator::clear() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    clearQueues();
+}
+
+// Called with queueMutex_ locked
+void MultiDeviceFrameAggregator::clearQueues() {
+    for(auto &queue: sourceQueues_) {
+        queue.clear();
+    }
+    nonEmptyQueueCount_ = 0;
+    newestTimestampUs_  = 0;
+}
+
+uint64_t MultiDeviceFrameAggregator::getFramesetTimestampUs(const std::shared_ptr<const Frame> &frameset) const {
+    auto getTimestamp = [this](const std::shared_ptr<const Frame> &frame) -> uint64_t {
+        switch(config_.timestampType) {
+        case OB_MULTI_DEVICE_FRAME_SYNC_SYSTEM_TIMESTAMP:
+            return frame->getSystemTimeStampUsec();
+        case OB_MULTI_DEVICE_FRAME_SYNC_DEVICE_TIMESTAMP:
+            return frame->getTimeStampUsec();
+        default:
+            // the global timestamp is 0 if the device doesn't support it
+            return frame->getGlobalTimeStampUsec() != 0 ? frame->getGlobalTimeStampUsec() : frame->getTimeStampUsec();
+        }
+    };
+
+    if(!frameset->is<FrameSet>()) {
+        return getTimestamp(frameset);
+    }
+
+    // the oldest frame of the frameset, the frames of a device are captured at the same time
+    uint64_t timestamp = 0;
+    frameset->as<FrameSet>()->foreachFrame([&](void *item) {
+        auto &frame = *(std::shared_ptr<const Frame> *)item;
+        if(frame) {
+            auto frameTimestamp = getTimestamp(frame);
+            if(timestamp == 0 || (frameTimestamp != 0 && frameTimestamp < timestamp)) {
+                timestamp = frameTimestamp;
+            }
+        }
+        return false;
+    });
+    return timestamp;
+}
+
+void MultiDeviceFrameAggregator::pushFrameset(uint32_t sourceIndex, std::shared_ptr<const Frame> frameset) {
+    std::vector<std::shared_ptr<FrameSet>> composites;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        if(sourceIndex >= sourceQueues_.size()) {
+            throw invalid_value_exception("MultiDeviceFrameAggregator: source index out of range");
+        }
+        statistics_.inputFramesetCount++;
+
+        auto  timestamp = getFramesetTimestampUs(frameset);
+        auto &queue     = sourceQueues_[sourceIndex];
+        if(!queue.empty() && timestamp < queue.back().timestampUs) {
+            // the timer of the device has been reset, restart the grouping with the new timestamps
+            LOG_WARN_INTVL("Multi-device frameset of source {} goes back in time, clear the cached framesets of all sources", sourceIndex);
+            for(auto &sourceQueue: sourceQueues_) {
+                statistics_.droppedFramesetCount += sourceQueue.size();
+            }
+            clearQueues();
+        }
+        if(queue.empty()) {
+            nonEmptyQueueCount_++;
+        }
+        queue.push_back({ timestamp, std::move(frameset) });
+        if(timestamp > newestTimestampUs_) {
+            newestTimestampUs_ = timestamp;
+        }
+
+        // dropping the stale framesets may expose newer framesets which can be grouped
+        do {
+            while(auto composite = tryMatch()) {
+                composites.push_back(composite);
+            }
+        } while(dropStaleFramesets());
+
+        if(composites.empty()) {
+            return;
+        }
+        // take the output lock before releasing the queues, so that the composite framesets are output in the matching order
+        outputMutex_.lock();
+    }
+
+    std::unique_lock<std::mutex> outputLock(outputMutex_, std::adopt_lock);
+    if(callback_) {
+        for(auto &composite: composites) {
+            callback_(std::move(composite));
+        }
+    }
+}
+
+// Called with queueMutex_ locked
+void MultiDeviceFrameAggregator::dropFront(uint32_t sourceIndex) {
+    auto &queue = sourceQueues_[sourceIndex];
+    queue.pop_front();
+    if(queue.empty()) {
+        nonEmptyQueueCount_--;
+    }
+    statistics_.droppedFramesetCount++;
+}
+
+// Called with queueMutex_ locked. Drop the framesets which have waited for the other sources longer than the max latency.
+bool MultiDeviceFrameAggregator::dropStaleFramesets() {
+    bool dropped = false;
+    for(uint32_t i = 0; i < sourceQueues_.size(); i++) {
+        auto &queue = sourceQueues_[i];
+        while(!queue.empty() && queue.front().timestampUs + config_.maxLatencyUs < newestTimestampUs_) {
+            LOG_DEBUG_INTVL("Multi-device frameset of source {} is not grouped within the max latency, drop it", i);
+            dropFront(i);
+            dropped = true;
+        }
+    }
+    return dropped;
+}
+
+// Called with queueMutex_ locked
+std::shared_ptr<FrameSet> MultiDeviceFrameAggregator::tryMatch() {
+    auto sourceCount = static_cast<uint32_t>(sourceQueues_.size());
+    while(nonEmptyQueueCount_ == sourceCount) {
+        uint64_t minTimestamp = UINT64_MAX;
+        uint64_t maxTimestamp = 0;
+        for(auto &queue: sourceQueues_) {
+            minTimestamp = std::min(minTimestamp, queue.front().timestampUs);
+            maxTimestamp = std::max(maxTimestamp, queue.front().timestampUs);
+        }
+
+        if(maxTimestamp - minTimestamp > config_.toleranceUs) {
+            // the source of the newest front has no frameset close to the older fronts, they can never be grouped
+            for(uint32_t i = 0; i < sourceCount; i++) {
+                while(!sourceQueues_[i].empty() && sourceQueues_[i].front().timestampUs + config_.toleranceUs < maxTimestamp) {
+                    dropFront(i);
+                }
+            }
+            continue;
+        }
+
+        std::shared_ptr<FrameSet> composite;
+        try {
+            composite = FrameFactory::createFrameSet(sourceCount);
+        }
+        catch(const std::exception &e) {
+            LOG_WARN_INTVL("Failed to create multi-device frameset, drop the group! {}", e.what());
+        }
+        for(uint32_t i = 0; i < sourceCount; i++) {
+            if(composite) {
+                composite->appendFrame(std::move(sourceQueues_[i].front().frameset));
+                sourceQueues_[i].pop_front();
+                if(sourceQueues_[i].empty()) {
+                    nonEmptyQueueCount_--;
+                }
+            }
+            else {
+                dropFront(i);
+            }
+        }
+        if(!composite) {
+            continue;
+        }
+
+        composite->setNumber(groupNumber_++);
+        composite->setTimeStampUsec(minTimestamp);
+        statistics_.outputFramesetCount++;
+        statistics_.maxTimestampSpreadUs = std::max(statistics_.maxTimestampSpreadUs, maxTimestamp - minTimestamp);
+        return composite;
+    }
+    return nullptr;
+}
+
+}  // namespace libobsensor
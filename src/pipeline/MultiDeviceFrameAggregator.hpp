@@ -0,0 +1,63 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "libobsensor/h/ObTypes.h"
+#include "frame/Frame.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Group the framesets of several devices by timestamp into composite framesets.
+ *
+ * The composite frameset holds one frameset of each source, the frameset of source i is at index i. A group is output once every source has a
+ * frameset within the tolerance of each other; a frameset which can not be completed within maxLatencyUs (measured by the timestamps of the newer
+ * framesets) is dropped. The framesets are pushed on the threads of the sources, no thread is created.
+ */
+class MultiDeviceFrameAggregator {
+public:
+    explicit MultiDeviceFrameAggregator(uint32_t sourceCount);
+    ~MultiDeviceFrameAggregator() noexcept;
+
+    void                         setConfig(const OBMultiDeviceFrameSyncConfig &config);
+    OBMultiDeviceFrameSyncConfig getConfig();
+    void                         setCallback(FrameCallback callback);
+
+    void pushFrameset(uint32_t sourceIndex, std::shared_ptr<const Frame> frameset);
+    void clear();
+
+    OBMultiDeviceFrameSyncStatistics getStatistics();
+
+    static OBMultiDeviceFrameSyncConfig getDefaultConfig();
+
+private:
+    struct SourceItem {
+        uint64_t                     timestampUs;
+        std::shared_ptr<const Frame> frameset;
+    };
+
+    uint64_t                  getFramesetTimestampUs(const std::shared_ptr<const Frame> &frameset) const;
+    bool                      dropStaleFramesets();
+    void                      dropFront(uint32_t sourceIndex);
+    void                      clearQueues();
+    std::shared_ptr<FrameSet> tryMatch();
+
+private:
+    std::mutex                          queueMutex_;
+    std::mutex                          outputMutex_;  // keeps the composite framesets matched by different sources in order while being output
+    OBMultiDeviceFrameSyncConfig        config_;
+    std::vector<std::deque<SourceItem>> sourceQueues_;
+    uint32_t                            nonEmptyQueueCount_;
+    uint64_t                            newestTimestampUs_;
+    uint64_t                            groupNumber_;
+    FrameCallback                       callback_;
+    OBMultiDeviceFrameSyncStatistics    statistics_;
+};
+
+}  // namespace libobsensor
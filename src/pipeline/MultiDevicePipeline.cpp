@@ -0,0 +1,168 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "MultiDevicePipeline.hpp"
+
+#include "exception/ObException.hpp"
+#include "logger/LoggerInterval.hpp"
+#include "environment/EnvConfig.hpp"
+#include "component/timestamp/GlobalTimestampFitter.hpp"
+
+namespace libobsensor {
+
+MultiDevicePipeline::MultiDevicePipeline(const std::vector<std::shared_ptr<IDevice>> &devices) : devices_(devices), streaming_(false), callback_(nullptr) {
+    if(devices_.empty()) {
+        throw invalid_value_exception("MultiDevicePipeline: no device is specified!");
+    }
+    for(auto &device: devices_) {
+        if(!device) {
+            throw invalid_value_exception("MultiDevicePipeline: the device is null!");
+        }
+        pipelines_.push_back(std::make_shared<Pipeline>(device));
+    }
+
+    int maxFrameQueueSize = 10;
+    EnvConfig::getInstance()->getIntValue("Memory.PipelineFrameQueueSize", maxFrameQueueSize);
+    if(maxFrameQueueSize <= 0) {
+        maxFrameQueueSize = 10;
+    }
+    outputFrameQueue_ = std::make_shared<FrameQueue<const Frame>>(maxFrameQueueSize);
+
+    frameAggregator_ = std::make_shared<MultiDeviceFrameAggregator>(static_cast<uint32_t>(devices_.size()));
+    frameAggregator_->setCallback([this](std::shared_ptr<const Frame> frameset) { outputFrameset(frameset); });
+    LOG_INFO("MultiDevicePipeline created with {} devices, @0x{:X}", devices_.size(), (uint64_t)this);
+}
+
+MultiDevicePipeline::~MultiDevicePipeline() noexcept {
+    TRY_EXECUTE(stop());
+    outputFrameQueue_->reset();
+    LOG_INFO("MultiDevicePipeline destroyed! @0x{:X}", (uint64_t)this);
+}
+
+void MultiDevicePipeline::start(const std::vector<std::shared_ptr<const Config>> &configs, FrameCallback callback) {
+    if(!configs.empty() && configs.size() != pipelines_.size()) {
+        throw invalid_value_exception("MultiDevicePipeline: the count of the configs does not match the count of the devices!");
+    }
+
+    std::unique_lock<std::mutex> lock(streamMutex_);
+    if(streaming_) {
+        throw wrong_api_call_sequence_exception("MultiDevicePipeline: the pipeline is already started!");
+    }
+    if(frameAggregator_->getConfig().timestampType == OB_MULTI_DEVICE_FRAME_SYNC_GLOBAL_TIMESTAMP) {
+        enableGlobalTimestamp();
+    }
+    frameAggregator_->clear();
+    outputFrameQueue_->reset();
+    callback_  = callback;
+    streaming_ = true;
+    lock.unlock();
+
+    try {
+        for(uint32_t i = 0; i < pipelines_.size(); i++) {
+            auto config = configs.empty() ? nullptr : configs[i];
+            pipelines_[i]->start(config, [this, i](std::shared_ptr<const Frame> frameset) { frameAggregator_->pushFrameset(i, frameset); });
+        }
+    }
+    catch(...) {
+        TRY_EXECUTE(stop());
+        throw;
+    }
+    LOG_INFO("MultiDevicePipeline started!");
+}
+
+void MultiDevicePipeline::stop() {
+    {
+        std::unique_lock<std::mutex> lock(streamMutex_);
+        if(!streaming_) {
+            return;
+        }
+        streaming_ = false;
+    }
+
+    for(auto &pipeline: pipelines_) {
+        BEGIN_TRY_EXECUTE({ pipeline->stop(); })
+        CATCH_EXCEPTION_AND_EXECUTE({ LOG_WARN("MultiDevicePipeline: failed to stop the pipeline of device {}", pipeline->getDevice()->getInfo()->name_); })
+    }
+    frameAggregator_->clear();
+
+    std::unique_lock<std::mutex> lock(streamMutex_);
+    callback_ = nullptr;
+    LOG_INFO("MultiDevicePipeline stopped!");
+}
+
+void MultiDevicePipeline::enableGlobalTimestamp() {
+    for(auto &device: devices_) {
+        if(!device->isComponentExists(OB_DEV_COMPONENT_GLOBAL_TIMESTAMP_FILTER)) {
+            LOG_WARN("MultiDevicePipeline: device {} does not support global timestamp, the device timestamp is used to group the framesets",
+                     device->getInfo()->name_);
+            continue;
+        }
+        auto globalTimestampFilter = device->getComponentT<GlobalTimestampFitter>(OB_DEV_COMPONENT_GLOBAL_TIMESTAMP_FILTER);
+        globalTimestampFilter->enable(true);
+    }
+}
+
+void MultiDevicePipeline::outputFrameset(std::shared_ptr<const Frame> frameset) {
+    FrameCallback callback;
+    {
+        std::unique_lock<std::mutex> lock(streamMutex_);
+        if(!streaming_) {
+            return;
+        }
+        callback = callback_;
+    }
+    if(callback) {
+        callback(frameset);
+        return;
+    }
+
+    if(outputFrameQueue_->fulled()) {
+        LOG_WARN_INTVL("Output multi-device frameset queue is full, drop oldest frameset!");
+        outputFrameQueue_->dequeue();
+    }
+    outputFrameQueue_->enqueue(std::move(frameset));
+}
+
+std::shared_ptr<const Frame> MultiDevicePipeline::waitForFrameset(uint32_t timeoutMs) {
+    auto frameset = outputFrameQueue_->dequeue(timeoutMs);
+    if(!frameset) {
+        LOG_WARN_INTVL("Wait for multi-device frameset timeout, you can try to increase the wait time! current timeout={}", timeoutMs);
+    }
+    return frameset;
+}
+
+uint32_t MultiDevicePipeline::getDeviceCount() const {
+    return static_cast<uint32_t>(devices_.size());
+}
+
+std::shared_ptr<IDevice> MultiDevicePipeline::getDevice(uint32_t index) const {
+    if(index >= devices_.size()) {
+        throw invalid_value_exception("MultiDevicePipeline: device index out of range!");
+    }
+    return devices_[index];
+}
+
+std::shared_ptr<Pipeline> MultiDevicePipeline::getPipeline(uint32_t index) const {
+    if(index >= pipelines_.size()) {
+        throw invalid_value_exception("MultiDevicePipeline: device index out of range!");
+    }
+    return pipelines_[index];
+}
+
+void MultiDevicePipeline::setFrameSyncConfig(const OBMultiDeviceFrameSyncConfig &config) {
+    frameAggregator_->setConfig(config);
+    std::unique_lock<std::mutex> lock(streamMutex_);
+    if(streaming_ && config.timestampType == OB_MULTI_DEVICE_FRAME_SYNC_GLOBAL_TIMESTAMP) {
+        enableGlobalTimestamp();
+    }
+}
+
+OBMultiDeviceFrameSyncConfig MultiDevicePipeline::getFrameSyncConfig() {
+    return frameAggregator_->getConfig();
+}
+
+OBMultiDeviceFrameSyncStatistics MultiDevicePipeline::getStatistics() {
+    return frameAggregator_->getStatistics();
+}
+
+}  // namespace libobsensor
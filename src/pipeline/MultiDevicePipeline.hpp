@@ -0,0 +1,51 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "Pipeline.hpp"
+#include "MultiDeviceFrameAggregator.hpp"
+
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Stream several devices at once and output the framesets of all devices captured at the same time as one composite frameset.
+ *
+ * Each device is streamed with its own Pipeline, the frameset of device i is at index i of the composite frameset. The framesets are grouped on the
+ * threads delivering them, so the pipeline does not add a thread per device.
+ */
+class MultiDevicePipeline {
+public:
+    MultiDevicePipeline(const std::vector<std::shared_ptr<IDevice>> &devices);
+    ~MultiDevicePipeline() noexcept;
+
+    // configs may be empty to start all the devices with the default config, otherwise one config (may be null) per device
+    void                         start(const std::vector<std::shared_ptr<const Config>> &configs, FrameCallback callback = nullptr);
+    void                         stop();
+    std::shared_ptr<const Frame> waitForFrameset(uint32_t timeoutMs = 1000);
+
+    uint32_t                  getDeviceCount() const;
+    std::shared_ptr<IDevice>  getDevice(uint32_t index) const;
+    std::shared_ptr<Pipeline> getPipeline(uint32_t index) const;
+
+    void                             setFrameSyncConfig(const OBMultiDeviceFrameSyncConfig &config);
+    OBMultiDeviceFrameSyncConfig     getFrameSyncConfig();
+    OBMultiDeviceFrameSyncStatistics getStatistics();
+
+private:
+    void enableGlobalTimestamp();
+    void outputFrameset(std::shared_ptr<const Frame> frameset);
+
+private:
+    std::vector<std::shared_ptr<IDevice>>  devices_;
+    std::vector<std::shared_ptr<Pipeline>> pipelines_;
+
+    std::mutex                                  streamMutex_;
+    bool                                        streaming_;
+    FrameCallback                               callback_;
+    std::shared_ptr<FrameQueue<const Frame>>    outputFrameQueue_;
+    std::shared_ptr<MultiDeviceFrameAggregator> frameAggregator_;
+};
+
+}  // namespace libobsensor
@@ -11,6 +11,7 @@
 #include "utils/Utils.hpp"
 #include "IAlgParamManager.hpp"
 #include "frameprocessor/FrameProcessor.hpp"
+#include "frame/FrameMemoryPool.hpp"
 
 #include <cmath>
 #include <algorithm>
@@ -129,9 +130,31 @@ void Pipeline::loadFrameQueueSizeConfig() {
         maxFrameQueueSize_ = 10;
     }
 
+    envConfig->getIntValue("Memory.FrameProcessingBlockQueueSize", processingBlockQueueSize_);
+    if(processingBlockQueueSize_ <= 0) {
+        processingBlockQueueSize_ = 10;
+    }
+    envConfig->getBooleanValue("Memory.PreallocateFrameBuffers", preallocateFrameBuffersEn_);
+
     LOG_DEBUG("loadFrameQueueSizeConfig() config queue size: {}", maxFrameQueueSize_);
 }
 
+void Pipeline::preallocateFrameBuffers() {
+    // The worst case of the in-flight frames of a stream: the frames cached in the sync queue of frame aggregator, in the framesets of the output
+    // queue and in the queue of the processing block, plus one frame being filled by the device and one being processed by the user callback.
+    auto memoryPool = FrameMemoryPool::getInstance();
+    auto spList     = config_->getEnabledStreamProfileList();
+    for(const auto &sp: spList) {
+        auto frameType = utils::mapStreamTypeToFrameType(sp->getType());
+        auto count     = FrameAggregator::calcMaxSyncQueueSize(sp) + maxFrameQueueSize_ + processingBlockQueueSize_ + 2;
+        memoryPool->reserveFrameBuffers(frameType, sp, count);
+    }
+    memoryPool->reserveFrameSetBuffers(maxFrameQueueSize_ + 2);
+
+    auto stats = memoryPool->getStatistics();
+    LOG_DEBUG("Frame buffers preallocated for {} streams, total allocated size: {:.3f}MB", spList.size(), byteToMB(stats.allocatedSize));
+}
+
 StreamProfileList Pipeline::getEnabledStreamProfileList() {
     if(!config_) {
         return {};
@@ -192,6 +215,10 @@ void Pipeline::start(std::shared_ptr<const Config> cfg) {
 
     frameAggregator_->updateConfig(config_, true);
 
+    if(preallocateFrameBuffersEn_) {
+        preallocateFrameBuffers();
+    }
+
     streamState_ = STREAM_STATE_STARTING;
     BEGIN_TRY_EXECUTE({ startStream(); })
     CATCH_EXCEPTION_AND_EXECUTE({
@@ -243,7 +270,7 @@ void Pipeline::onFrameCallback(std::shared_ptr<const Frame> frame) {
         frameAggregator_->pushFrame(frame);
     }
     auto frameType = frame->getType();
-    LOG_INTVL(LOG_INTVL_OBJECT_TAG + std::to_string(frameType), DEF_MIN_LOG_INTVL, spdlog::level::debug, "Frame received on pipeline! type={}", frameType);
+    LOG_INTVL(LOG_INTVL_OBJECT_TAG + frameType, DEF_MIN_LOG_INTVL, spdlog::level::debug, "Frame received on pipeline! type={}", frameType);
 }
 
 void Pipeline::outputFrame(std::shared_ptr<const Frame> frame) {
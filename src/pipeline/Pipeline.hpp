@@ -43,6 +43,7 @@ private:
 
     void loadDefaultConfig();
     void loadFrameQueueSizeConfig();
+    void preallocateFrameBuffers();
 
     void configAlignMode();
     void resetAlignMode();
@@ -66,7 +67,9 @@ private:
 
     std::shared_ptr<FrameAggregator> frameAggregator_;
 
-    int maxFrameQueueSize_ = 10;
+    int  maxFrameQueueSize_         = 10;
+    int  processingBlockQueueSize_  = 10;
+    bool preallocateFrameBuffersEn_ = false;
 };
 
 }  // namespace libobsensor
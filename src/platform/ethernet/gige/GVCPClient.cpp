@@ -75,7 +75,7 @@ std::vector<GVCPDeviceInfo> GVCPClient::queryNetDeviceList() {
     LOG_TRACE("queryNetDevice completed ({}):", devInfoList_.size());
     for(auto &&info: devInfoList_) {
         // LOG_INFO("\t-mac:{}, ip:{}, sn:{}, pid:0x{:04x}", info.mac, info.ip, info.sn, info.pid);
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "queryNetDevice", DEF_MIN_LOG_INTVL, spdlog::level::debug, "\t- mac:{}, ip:{}, sn:{}, pid:0x{:04x}", info.mac, info.ip,
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::debug, "\t- mac:{}, ip:{}, sn:{}, pid:0x{:04x}", info.mac, info.ip,
                   info.sn, info.pid);
     }
     return devInfoList_;
@@ -223,7 +223,7 @@ SOCKET GVCPClient::openClientSocket(SOCKADDR_IN addr) {
 #if(defined(__linux__) || defined(OS_IOS) || defined(OS_MACOS) || defined(__ANDROID__))
     addr.sin_addr.s_addr = inet_addr("0.0.0.0");
 #endif
-    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP bind", MAX_LOG_INTERVAL, spdlog::level::debug, "bind {}:{}", inet_ntoa(addr.sin_addr), ntohs(addr.sin_port));
+    LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "bind {}:{}", inet_ntoa(addr.sin_addr), ntohs(addr.sin_port));
     err = bind(sock, (SOCKADDR *)&addr, sizeof(SOCKADDR));
     if(err == SOCKET_ERROR) {
         return 0;
@@ -264,7 +264,7 @@ void GVCPClient::sendGVCPDiscovery(SOCKET sock) {
     // send data
     int err = sendto(sock, (const char *)&discoverCmd, sizeof(discoverCmd), 0, (SOCKADDR *)&destAddr, sizeof(destAddr));
     if(err == SOCKET_ERROR) {
-        LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP sendto", MAX_LOG_INTERVAL, spdlog::level::debug, "sendto failed with error:{}", GET_LAST_ERROR());
+        LOG_INTVL(LOG_INTVL_OBJECT_TAG, MAX_LOG_INTERVAL, spdlog::level::debug, "sendto failed with error:{}", GET_LAST_ERROR());
     }
     // LOG_INFO("sendto get info with error:{}", GET_LAST_ERROR());
     char recvBuf[1024];
@@ -292,7 +292,7 @@ void GVCPClient::sendGVCPDiscovery(SOCKET sock) {
 
                 err = recvfrom(sock, recvBuf, sizeof(recvBuf), 0, (SOCKADDR *)&srcAddr, &srcAddrLen);
                 if(err == SOCKET_ERROR) {
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP recvfrom", DEF_MIN_LOG_INTVL, spdlog::level::err, "recvfrom failed with error: {}",
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::err, "recvfrom failed with error: {}",
                               GET_LAST_ERROR());
 
                     if(failedCount-- < 0) {
@@ -310,7 +310,7 @@ void GVCPClient::sendGVCPDiscovery(SOCKET sock) {
                 uint16_t len    = ntohs(ackHeader.wLen);
                 uint16_t reqID  = ntohs(ackHeader.wReqID);
 
-                LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP get info", DEF_MIN_LOG_INTVL, spdlog::level::info, "{}, {}, {}, {}", status, ack, len, reqID);
+                LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::info, "{}, {}, {}, {}", status, ack, len, reqID);
 
                 discoverAck.header = ackHeader;
 
@@ -348,7 +348,7 @@ void GVCPClient::sendGVCPDiscovery(SOCKET sock) {
                     //          subMaskStr, gatewayStr, ackPayload.szFacName, ackPayload.szModelName, ackPayload.szDevVer, ackPayload.szFacInfo,
                     //          ackPayload.szSerial, ackPayload.szUserName);
 
-                    LOG_INTVL(LOG_INTVL_OBJECT_TAG + "GVCP get ack info", DEF_MIN_LOG_INTVL, spdlog::level::info,
+                    LOG_INTVL(LOG_INTVL_OBJECT_TAG, DEF_MIN_LOG_INTVL, spdlog::level::info,
                               "{},{}, {},{}, {},{}, {}, {}, {}, {}, {}, {}, {}, {}, {}", specVer, devMode, std::string(macStr), supIpSet, curIpSet, curPID,
                               std::string(curIPStr), std::string(subMaskStr), std::string(gatewayStr), std::string(ackPayload.szFacName),
                               std::string(ackPayload.szModelName), std::string(ackPayload.szDevVer), std::string(ackPayload.szFacInfo),
@@ -10,8 +10,15 @@
 #include "usb/enumerator/UsbEnumeratorLibusb.hpp"
 
 namespace libobsensor {
+
+// Number of interrupt transfers kept in flight, so that the endpoint is polled again while the completed packets are being handed over
+const uint32_t HID_TRANSFER_COUNT = 4;
+
+// Interval to resubmit the transfers failed to be resubmitted on their completion, such as on a transient error or a frame allocation failure
+const uint32_t HID_TRANSFER_RETRY_INTERVAL_MS = 10;
+
 HidDevicePort::HidDevicePort(const std::shared_ptr<IUsbDevice> &usbDevice, std::shared_ptr<const USBSourcePortInfo> portInfo)
-    : portInfo_(portInfo), usbDevice_(usbDevice), isStreaming_(false), frameQueue_(10) {
+    : portInfo_(portInfo), usbDevice_(usbDevice), isStreaming_(false), frameQueue_(10), pendingTransferCount_(0) {
 
     auto libusbDevice = std::dynamic_pointer_cast<UsbDeviceLibusb>(usbDevice_);
     auto epDesc       = libusbDevice->getEndpointDesc(portInfo->infIndex, LIBUSB_ENDPOINT_TRANSFER_TYPE_INTERRUPT, LIBUSB_ENDPOINT_IN);
@@ -33,7 +40,7 @@ HidDevicePort::HidDevicePort(const std::shared_ptr<IUsbDevice> &usbDevice, std::
 }
 
 HidDevicePort::~HidDevicePort() noexcept {
-    if(isStreaming_) {
+    if(!transfers_.empty()) {
         frameQueue_.stop();
         stopStream();
     }
@@ -55,44 +62,173 @@ HidDevicePort::~HidDevicePort() noexcept {
 }
 
 void HidDevicePort::startStream(MutableFrameCallback callback) {
-    if(isStreaming_) {
+    if(isStreaming_ || !transfers_.empty()) {
         throw wrong_api_call_sequence_exception("HidDevicePort::startStream() called while streaming");
     }
-    isStreaming_ = true;
     frameQueue_.start(callback);
 
-    streamThread_ = std::thread([this]() {
-        auto libusbDevice    = std::dynamic_pointer_cast<UsbDeviceLibusb>(usbDevice_);
-        auto libusbDevHandle = libusbDevice->getLibusbDeviceHandle();
-        while(isStreaming_) {
-            auto frame = FrameFactory::createFrame(OB_FRAME_UNKNOWN, OB_FORMAT_UNKNOWN, maxPacketSize_);
-            int  transferred;
-            auto res = libusb_interrupt_transfer(libusbDevHandle, endpointAddress_, frame->getDataMutable(), static_cast<int>(frame->getDataSize()),
-                                                 &transferred, 1000);
-            if(res != LIBUSB_SUCCESS && isStreaming_) {
-                LOG_WARN_INTVL(utils::string::to_string() << "interrupt transfer failed, error: " << libusb_strerror(res));
-                continue;
-            }
-            auto realtime = utils::getNowTimesUs();
-            frame->setSystemTimeStampUsec(realtime);
-            frameQueue_.enqueue(frame);
+    std::unique_lock<std::mutex> lock(transferMutex_);
+    isStreaming_ = true;
+    for(uint32_t i = 0; i < HID_TRANSFER_COUNT; i++) {
+        auto transfer = libusb_alloc_transfer(0);
+        if(transfer == nullptr) {
+            LOG_WARN("HidDevicePort: alloc transfer failed");
+            break;
         }
-    });
-    LOG_DEBUG("HidDevicePort::startStream done");
+        std::unique_ptr<HidTransfer> hidTransfer(new HidTransfer{ this, transfer, nullptr });
+        if(submitTransfer(hidTransfer.get()) == LIBUSB_SUCCESS) {
+            pendingTransferCount_++;
+        }
+        transfers_.push_back(std::move(hidTransfer));
+    }
+    if(pendingTransferCount_ == 0) {
+        isStreaming_ = false;
+        for(auto &hidTransfer: transfers_) {
+            libusb_free_transfer(hidTransfer->transfer);
+        }
+        transfers_.clear();
+        lock.unlock();
+        frameQueue_.flush();
+        throw io_exception("HidDevicePort::startStream() failed, no interrupt transfer can be submitted");
+    }
+    retryThread_ = std::thread(&HidDevicePort::retryTransfers, this);
+    LOG_DEBUG("HidDevicePort::startStream done, {} transfers in flight", pendingTransferCount_);
 }
 
 void HidDevicePort::stopStream() {
-    if(!isStreaming_) {
-        throw wrong_api_call_sequence_exception("HidDevicePort::stopStream() called while not streaming");
-    }
-    isStreaming_ = false;
+    {
+        // isStreaming_ is also cleared once all the transfers have failed, the transfers are kept to be freed here
+        std::unique_lock<std::mutex> lock(transferMutex_);
+        if(transfers_.empty()) {
+            throw wrong_api_call_sequence_exception("HidDevicePort::stopStream() called while not streaming");
+        }
+        isStreaming_ = false;
+        for(auto &hidTransfer: transfers_) {
+            libusb_cancel_transfer(hidTransfer->transfer);  // fails harmlessly for the transfers already retired or waiting for a retry
+        }
+        for(auto hidTransfer: retryTransfers_) {
+            hidTransfer->frame.reset();
+            pendingTransferCount_--;
+        }
+        retryTransfers_.clear();
+        transferCv_.notify_all();  // wake up the retry thread
 
-    streamThread_.join();
+        // The cancelled transfers are retired by their completion callbacks on the libusb event thread
+        transferCv_.wait(lock, [this]() { return pendingTransferCount_ == 0; });
+        for(auto &hidTransfer: transfers_) {
+            libusb_free_transfer(hidTransfer->transfer);
+        }
+        transfers_.clear();
+    }
+    if(retryThread_.joinable()) {
+        retryThread_.join();
+    }
     frameQueue_.flush();
 
     LOG_DEBUG("HidDevicePort::stopStream done");
 }
 
+// Called with transferMutex_ held, returns the libusb error code
+int HidDevicePort::submitTransfer(HidTransfer *hidTransfer) {
+    try {
+        if(!hidTransfer->frame) {
+            hidTransfer->frame = FrameFactory::createFrame(OB_FRAME_UNKNOWN, OB_FORMAT_UNKNOWN, maxPacketSize_);
+        }
+    }
+    catch(const std::exception &e) {
+        LOG_WARN_INTVL("HidDevicePort: create frame failed, error: {}", e.what());
+        return LIBUSB_ERROR_NO_MEM;
+    }
+
+    auto libusbDevice = std::dynamic_pointer_cast<UsbDeviceLibusb>(usbDevice_);
+    auto callback     = [](libusb_transfer *transfer) {
+        auto completedTransfer = static_cast<HidTransfer *>(transfer->user_data);
+        completedTransfer->port->onTransferCompleted(completedTransfer);
+    };
+    libusb_fill_interrupt_transfer(hidTransfer->transfer, libusbDevice->getLibusbDeviceHandle(), endpointAddress_, hidTransfer->frame->getDataMutable(),
+                                   maxPacketSize_, callback, hidTransfer, 0);
+    auto res = libusb_submit_transfer(hidTransfer->transfer);
+    if(res != LIBUSB_SUCCESS) {
+        LOG_WARN_INTVL("HidDevicePort: submit interrupt transfer failed, error: {}", libusb_strerror(res));
+    }
+    return res;
+}
+
+// Called on the libusb event thread, the transfer is resubmitted right away so that the endpoint is always polled
+void HidDevicePort::onTransferCompleted(HidTransfer *hidTransfer) {
+    auto transfer = hidTransfer->transfer;
+    if(transfer->status == LIBUSB_TRANSFER_COMPLETED && isStreaming_) {
+        // The packet is handed over only if there is a frame for the next one, otherwise it is dropped and its frame is reused
+        std::shared_ptr<Frame> nextFrame;
+        try {
+            nextFrame = FrameFactory::createFrame(OB_FRAME_UNKNOWN, OB_FORMAT_UNKNOWN, maxPacketSize_);
+        }
+        catch(const std::exception &e) {
+            LOG_WARN_INTVL("HidDevicePort: create frame failed, drop the packet! error: {}", e.what());
+        }
+        if(nextFrame) {
+            auto frame         = std::move(hidTransfer->frame);
+            hidTransfer->frame = std::move(nextFrame);
+            frame->setDataSize(static_cast<size_t>(transfer->actual_length));
+            frame->setSystemTimeStampUsec(utils::getNowTimesUs());
+            frameQueue_.enqueue(frame);
+        }
+    }
+    else if(transfer->status != LIBUSB_TRANSFER_CANCELLED && isStreaming_) {
+        LOG_WARN_INTVL("interrupt transfer failed, status: {}", static_cast<int>(transfer->status));
+    }
+
+    std::unique_lock<std::mutex> lock(transferMutex_);
+    if(isStreaming_ && transfer->status != LIBUSB_TRANSFER_NO_DEVICE && transfer->status != LIBUSB_TRANSFER_CANCELLED) {
+        auto res = submitTransfer(hidTransfer);
+        if(res == LIBUSB_SUCCESS) {
+            return;
+        }
+        if(res != LIBUSB_ERROR_NO_DEVICE) {
+            retryTransfers_.push_back(hidTransfer);  // still pending, resubmitted by the retry thread
+            lock.unlock();
+            transferCv_.notify_all();
+            return;
+        }
+    }
+    retireTransfer(hidTransfer);
+    lock.unlock();
+    transferCv_.notify_all();
+}
+
+// Called with transferMutex_ held
+void HidDevicePort::retireTransfer(HidTransfer *hidTransfer) {
+    hidTransfer->frame.reset();
+    pendingTransferCount_--;
+    if(pendingTransferCount_ == 0 && isStreaming_) {
+        // Not stopped by stopStream, such as on the disconnection of the device
+        LOG_ERROR("HidDevicePort: all the interrupt transfers have failed, the IMU stream is stopped!");
+        isStreaming_ = false;
+    }
+}
+
+void HidDevicePort::retryTransfers() {
+    std::unique_lock<std::mutex> lock(transferMutex_);
+    while(isStreaming_) {
+        transferCv_.wait(lock, [this]() { return !isStreaming_ || !retryTransfers_.empty(); });
+        if(transferCv_.wait_for(lock, std::chrono::milliseconds(HID_TRANSFER_RETRY_INTERVAL_MS), [this]() { return !isStreaming_; })) {
+            break;
+        }
+
+        std::vector<HidTransfer *> failedTransfers;
+        for(auto hidTransfer: retryTransfers_) {
+            auto res = submitTransfer(hidTransfer);
+            if(res == LIBUSB_ERROR_NO_DEVICE) {
+                retireTransfer(hidTransfer);
+            }
+            else if(res != LIBUSB_SUCCESS) {
+                failedTransfers.push_back(hidTransfer);
+            }
+        }
+        retryTransfers_.swap(failedTransfers);
+    }
+}
+
 std::shared_ptr<const SourcePortInfo> HidDevicePort::getSourcePortInfo() const {
     return portInfo_;
 }
@@ -6,6 +6,13 @@
 #include "frame/FrameQueue.hpp"
 #include "usb/enumerator/IUsbEnumerator.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct libusb_transfer;
+
 namespace libobsensor {
 
 class HidDevicePort : public IDataStreamPort {
@@ -18,6 +25,19 @@ public:
 
     std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override;
 
+private:
+    // An asynchronous interrupt transfer kept in flight while streaming, and the frame it receives the packet into
+    struct HidTransfer {
+        HidDevicePort         *port;
+        libusb_transfer       *transfer;
+        std::shared_ptr<Frame> frame;
+    };
+
+    int  submitTransfer(HidTransfer *hidTransfer);
+    void onTransferCompleted(HidTransfer *hidTransfer);
+    void retireTransfer(HidTransfer *hidTransfer);
+    void retryTransfers();
+
 private:
     std::shared_ptr<const USBSourcePortInfo> portInfo_;
     std::shared_ptr<IUsbDevice>              usbDevice_;
@@ -27,7 +47,12 @@ private:
     std::atomic_bool  isStreaming_;
     FrameQueue<Frame> frameQueue_;
 
-    std::thread streamThread_;
+    std::mutex                                transferMutex_;  // guards the submitting and cancelling of the transfers against stopStream
+    std::condition_variable                   transferCv_;
+    std::vector<std::unique_ptr<HidTransfer>> transfers_;             // kept until stopStream, also if they have all failed
+    uint32_t                                  pendingTransferCount_;  // transfers in flight or waiting for a retry, not yet retired
+    std::vector<HidTransfer *>                retryTransfers_;        // transfers failed to be resubmitted, retried by retryThread_
+    std::thread                               retryThread_;
 };
 
 }  // namespace libobsensor
@@ -175,7 +175,7 @@ std::shared_ptr<ISourcePort> LinuxUsbPal::getSourcePort(std::shared_ptr<const So
                 LOG_DEBUG("GMSL device have been create with V4L2 backend! dev: {}, inf: {}", usbPortInfo->url, usbPortInfo->infUrl);
             }
             else {
-                port = std::make_shared<ObV4lUvcDevicePort>(usbPortInfo);
+                port = std::make_shared<ObV4lUvcDevicePort>(usbPortInfo, v4lCaptureMemoryMode_);
                 LOG_DEBUG("UVC device have been create with V4L2 backend! dev: {}, inf: {}", usbPortInfo->url, usbPortInfo->infUrl);
             }
         }
@@ -287,6 +287,15 @@ void LinuxUsbPal::loadXmlConfig() {
         uvcBackendType_ = UVC_BACKEND_TYPE_AUTO;
     }
     LOG_DEBUG("Uvc backend have been set to {}", static_cast<int>(uvcBackendType_));
+
+    std::string memoryMode = "";
+    if(envConfig->getStringValue("Device.V4L2CaptureMemoryMode", memoryMode) && memoryMode == "USERPTR") {
+        v4lCaptureMemoryMode_ = V4L_CAPTURE_MEMORY_USERPTR;
+    }
+    else {
+        v4lCaptureMemoryMode_ = V4L_CAPTURE_MEMORY_MMAP;
+    }
+    LOG_DEBUG("V4L2 capture memory mode have been set to {}", static_cast<int>(v4lCaptureMemoryMode_));
 }
 
 }  // namespace libobsensor
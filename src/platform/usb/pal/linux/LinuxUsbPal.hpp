@@ -14,6 +14,7 @@
 #include <map>
 
 #include "usb/enumerator/IUsbEnumerator.hpp"
+#include "usb/uvc/V4lUserPtrBufferQueue.hpp"
 namespace libobsensor {
 
 class LinuxUsbPal : public IPal {
@@ -38,7 +39,8 @@ private:
         UVC_BACKEND_TYPE_V4L2,
     } UvcBackendType;
 
-    UvcBackendType uvcBackendType_ = UVC_BACKEND_TYPE_LIBUVC;
+    UvcBackendType       uvcBackendType_       = UVC_BACKEND_TYPE_LIBUVC;
+    V4lCaptureMemoryMode v4lCaptureMemoryMode_ = V4L_CAPTURE_MEMORY_MMAP;
 
 private:
     std::mutex                                                                  sourcePortMapMutex_;
@@ -324,7 +324,8 @@ std::string fourccToString(uint32_t id) {
     return fourcc_buff;
 }
 
-ObV4lUvcDevicePort::ObV4lUvcDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo) : portInfo_(portInfo) {
+ObV4lUvcDevicePort::ObV4lUvcDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo, V4lCaptureMemoryMode memoryMode)
+    : portInfo_(portInfo), memoryMode_(memoryMode) {
     auto devs = queryRelatedDevices(portInfo_);
     if(devs.empty()) {
         throw libobsensor::camera_disconnected_exception("No v4l device found for port: " + portInfo_->infUrl);
@@ -401,7 +402,10 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
             xioctl(devHandle->metadataFd, VIDIOC_QBUF, &buf);
         }
 
-        if(devHandle->fd >= 0) {
+        if(devHandle->userPtrQueue) {
+            devHandle->userPtrQueue->start();
+        }
+        else if(devHandle->fd >= 0) {
             v4l2_buffer buf = {};
             buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
             buf.memory      = V4L2_MEMORY_MMAP;
@@ -464,7 +468,37 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
                 }
             }
 
-            if(FD_ISSET(devHandle->fd, &fds)) {
+            if(FD_ISSET(devHandle->fd, &fds) && devHandle->userPtrQueue) {
+                FD_CLR(devHandle->fd, &fds);
+                v4l2_buffer buf = {};
+                if(!devHandle->userPtrQueue->dequeue(buf)) {
+                    continue;
+                }
+
+                bool delivered = false;
+                if(buf.bytesused) {
+                    TRY_EXECUTE({
+                        // zero-copy: the frame wraps the kernel-filled buffer and queue it back to driver on frame destruction. When the frames held
+                        // downstream leave too few buffers to the driver, the data is copied out and the buffer goes back to the driver at once.
+                        std::shared_ptr<Frame> frame;
+                        if(devHandle->userPtrQueue->getQueuedBufferCount() >= MIN_QUEUED_USERPTR_BUFFER_COUNT) {
+                            frame = devHandle->userPtrQueue->wrapFrame(buf, devHandle->profile);
+                        }
+                        else {
+                            frame = devHandle->userPtrQueue->copyFrame(buf, devHandle->profile);
+                        }
+                        auto videoFrame = frame->as<VideoFrame>();
+                        delivered       = true;
+                        fillFrameInfo(devHandle, metadataBufferIndex, buf, videoFrame);
+                        devHandle->frameCallback(videoFrame);
+                    })
+                }
+
+                if(!delivered) {
+                    devHandle->userPtrQueue->requeue(buf.index);
+                }
+            }
+            else if(FD_ISSET(devHandle->fd, &fds)) {
                 FD_CLR(devHandle->fd, &fds);
                 v4l2_buffer buf = {};
                 buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -482,19 +516,7 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
                         auto rawframe   = FrameFactory::createFrameFromStreamProfile(devHandle->profile);
                         auto videoFrame = rawframe->as<VideoFrame>();
                         videoFrame->updateData(static_cast<const uint8_t *>(devHandle->buffers[buf.index].ptr), buf.bytesused);
-                        if(metadataBufferIndex >= 0 && devHandle->metadataBuffers[metadataBufferIndex].sequence == buf.sequence) {
-                            auto uvc_payload_header     = devHandle->metadataBuffers[metadataBufferIndex].ptr + sizeof(V4L2UvcMetaHeader);
-                            auto uvc_payload_header_len = devHandle->metadataBuffers[metadataBufferIndex].actual_length - sizeof(V4L2UvcMetaHeader);
-                            if(uvc_payload_header_len >= sizeof(StandardUvcFramePayloadHeader)) {
-                                auto payloadHeader = (StandardUvcFramePayloadHeader *)uvc_payload_header;
-                                videoFrame->appendMetadata(static_cast<const uint8_t *>(uvc_payload_header), uvc_payload_header_len);
-                                videoFrame->setTimeStampUsec(payloadHeader->dwPresentationTime);
-                            }
-                        }
-
-                        auto realtime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                        videoFrame->setSystemTimeStampUsec(realtime);
-                        videoFrame->setNumber(buf.sequence);
+                        fillFrameInfo(devHandle, metadataBufferIndex, buf, videoFrame);
                         devHandle->frameCallback(videoFrame);
                     })
                 }
@@ -510,6 +532,23 @@ void ObV4lUvcDevicePort::captureLoop(std::shared_ptr<V4lDeviceHandle> devHandle)
     }
 }
 
+void ObV4lUvcDevicePort::fillFrameInfo(const std::shared_ptr<V4lDeviceHandle> &devHandle, int metadataBufferIndex, const v4l2_buffer &buf,
+                                       const std::shared_ptr<VideoFrame> &videoFrame) {
+    if(metadataBufferIndex >= 0 && devHandle->metadataBuffers[metadataBufferIndex].sequence == buf.sequence) {
+        auto uvc_payload_header     = devHandle->metadataBuffers[metadataBufferIndex].ptr + sizeof(V4L2UvcMetaHeader);
+        auto uvc_payload_header_len = devHandle->metadataBuffers[metadataBufferIndex].actual_length - sizeof(V4L2UvcMetaHeader);
+        if(uvc_payload_header_len >= sizeof(StandardUvcFramePayloadHeader)) {
+            auto payloadHeader = (StandardUvcFramePayloadHeader *)uvc_payload_header;
+            videoFrame->appendMetadata(static_cast<const uint8_t *>(uvc_payload_header), uvc_payload_header_len);
+            videoFrame->setTimeStampUsec(payloadHeader->dwPresentationTime);
+        }
+    }
+
+    auto realtime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    videoFrame->setSystemTimeStampUsec(realtime);
+    videoFrame->setNumber(buf.sequence);
+}
+
 StreamProfileList ObV4lUvcDevicePort::getStreamProfileList() {
     StreamProfileList profileList;
     foreachProfile(deviceHandles_, [&profileList](std::shared_ptr<V4lDeviceHandle> devHandle, std::shared_ptr<VideoStreamProfile> profile) {
@@ -632,11 +671,25 @@ void ObV4lUvcDevicePort::startStream(std::shared_ptr<const StreamProfile> profil
         throw libobsensor::io_exception("Failed to get streamparm!" + devHandle->info->name + ", " + strerror(errno));
     }
 
+    devHandle->memoryMode   = V4L_CAPTURE_MEMORY_MMAP;
+    devHandle->userPtrQueue = nullptr;
+    if(memoryMode_ == V4L_CAPTURE_MEMORY_USERPTR) {
+        auto userPtrQueue = std::make_shared<V4lUserPtrBufferQueue>(devHandle->fd, MAX_BUFFER_COUNT, fmt.fmt.pix.sizeimage, xioctl);
+        if(userPtrQueue->requestBuffers()) {
+            devHandle->memoryMode   = V4L_CAPTURE_MEMORY_USERPTR;
+            devHandle->userPtrQueue = userPtrQueue;
+            LOG_DEBUG("Video node {} is working on USERPTR memory mode", devHandle->info->name);
+        }
+        else {
+            LOG_WARN("USERPTR memory mode is not supported by {}, fallback to MMAP memory mode", devHandle->info->name);
+        }
+    }
+
     struct v4l2_requestbuffers req = {};
-    req.count                      = MAX_BUFFER_COUNT;
+    req.count                      = devHandle->userPtrQueue ? 0 : MAX_BUFFER_COUNT;
     req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     req.memory                     = V4L2_MEMORY_MMAP;
-    if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
+    if(!devHandle->userPtrQueue && xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
         throw libobsensor::io_exception("Failed to request buffers!" + devHandle->info->name + ", " + strerror(errno));
     }
     for(uint32_t i = 0; i < req.count && i < MAX_BUFFER_COUNT; i++) {
@@ -716,6 +769,13 @@ void ObV4lUvcDevicePort::stopStream(std::shared_ptr<const StreamProfile> profile
         }
         devHandle->captureThread.reset();
 
+        // frames released by user from now on will not queue their buffers back to driver
+        auto userPtrQueue = devHandle->userPtrQueue;
+        if(userPtrQueue) {
+            userPtrQueue->stop();
+        }
+        devHandle->userPtrQueue = nullptr;
+
         v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         if(xioctl(devHandle->fd, VIDIOC_STREAMOFF, &type) < 0) {
             clearUp(devHandle);
@@ -728,7 +788,11 @@ void ObV4lUvcDevicePort::stopStream(std::shared_ptr<const StreamProfile> profile
         req.count                      = 0;
         req.type                       = type;
         req.memory                     = V4L2_MEMORY_MMAP;
-        if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
+        if(userPtrQueue) {
+            // the buffers memory is kept alive until all the frames wrapping it are released
+            userPtrQueue->releaseBuffers();
+        }
+        else if(xioctl(devHandle->fd, VIDIOC_REQBUFS, &req) < 0) {
             throw libobsensor::io_exception("Failed to request buffers!" + devHandle->info->name + ", " + strerror(errno));
         }
 
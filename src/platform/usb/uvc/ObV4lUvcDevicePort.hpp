@@ -9,6 +9,7 @@
 #include <sys/mman.h>
 
 #include "UvcDevicePort.hpp"
+#include "V4lUserPtrBufferQueue.hpp"
 #include "stream/StreamProfile.hpp"
 
 #include <linux/uvcvideo.h>
@@ -33,9 +34,10 @@ constexpr bool metadata_node = false;
 
 namespace libobsensor {
 
-static const uint32_t MAX_META_DATA_SIZE       = 255;
-static const uint32_t MAX_BUFFER_COUNT         = 4;
-static const uint32_t LOCAL_V4L2_META_FMT_D4XX = v4l2_fourcc('D', '4', 'X', 'X');  // borrows from videodev2.h, using for getting extention metadata
+static const uint32_t MAX_META_DATA_SIZE              = 255;
+static const uint32_t MAX_BUFFER_COUNT                = 4;
+static const uint32_t MIN_QUEUED_USERPTR_BUFFER_COUNT = 2;  // below it the USERPTR frames are copied out, so that the driver always has buffers to fill
+static const uint32_t LOCAL_V4L2_META_FMT_D4XX        = v4l2_fourcc('D', '4', 'X', 'X');  // borrows from videodev2.h, using for getting extention metadata
 #define LOCAL_V4L2_BUF_TYPE_META_CAPTURE ((v4l2_buf_type)13)
 
 #pragma pack(push, 1)
@@ -76,6 +78,9 @@ struct V4lDeviceHandle {
     MutableFrameCallback                      frameCallback;
     std::shared_ptr<const VideoStreamProfile> profile = nullptr;
 
+    V4lCaptureMemoryMode                   memoryMode   = V4L_CAPTURE_MEMORY_MMAP;  // memory mode of current streaming
+    std::shared_ptr<V4lUserPtrBufferQueue> userPtrQueue = nullptr;                  // valid on V4L_CAPTURE_MEMORY_USERPTR mode
+
     int                          stopPipeFd[2] = { -1, -1 };  // pipe to signal the capture thread to stop
     std::shared_ptr<std::thread> captureThread = nullptr;
     std::atomic<bool>            isCapturing   = { false };
@@ -83,7 +88,7 @@ struct V4lDeviceHandle {
 
 class ObV4lUvcDevicePort : public UvcDevicePort {
 public:
-    explicit ObV4lUvcDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo);
+    explicit ObV4lUvcDevicePort(std::shared_ptr<const USBSourcePortInfo> portInfo, V4lCaptureMemoryMode memoryMode = V4L_CAPTURE_MEMORY_MMAP);
     ~ObV4lUvcDevicePort() noexcept override;
 
     virtual std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override;
@@ -104,6 +109,9 @@ public:
 
 private:
     static void     captureLoop(std::shared_ptr<V4lDeviceHandle> deviceHandle);
+    // Set the metadata, timestamps and number of a captured frame
+    static void     fillFrameInfo(const std::shared_ptr<V4lDeviceHandle> &devHandle, int metadataBufferIndex, const v4l2_buffer &buf,
+                                  const std::shared_ptr<VideoFrame> &videoFrame);
     bool            getXu(uint8_t ctrl, uint8_t *data, uint32_t *len);
     bool            setXu(uint8_t ctrl, const uint8_t *data, uint32_t len);
     UvcControlRange getXuRange(uint8_t control, int len);
@@ -113,6 +121,7 @@ private:
 
 private:
     std::shared_ptr<const USBSourcePortInfo>      portInfo_ = nullptr;
+    V4lCaptureMemoryMode                          memoryMode_;
     std::vector<std::shared_ptr<V4lDeviceHandle>> deviceHandles_;
     std::recursive_mutex                          ctrlMutex_;
 };
@@ -0,0 +1,189 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "V4lUserPtrBufferQueue.hpp"
+
+#include <unistd.h>
+#include <string.h>
+
+#include "frame/FrameBufferManager.hpp"
+#include "frame/FrameFactory.hpp"
+#include "logger/Logger.hpp"
+#include "exception/ObException.hpp"
+#include "utils/PublicTypeHelper.hpp"
+
+namespace libobsensor {
+
+V4lUserPtrBufferQueue::V4lUserPtrBufferQueue(int fd, uint32_t bufferCount, size_t bufferSize, V4lIoctlFunc ioctlFunc)
+    : fd_(fd),
+      bufferSize_(bufferSize),
+      allocSize_(0),
+      ioctlFunc_(ioctlFunc),
+      streaming_(false),
+      buffers_(bufferCount),
+      frameMemoryAllocator_(FrameMemoryAllocator::getInstance()) {
+    auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    // apply for one more page to align the buffer address to page size, which is required by some drivers on USERPTR mode
+    allocSize_ = bufferSize_ + pageSize;
+    for(auto &buffer: buffers_) {
+        buffer.allocPtr = frameMemoryAllocator_->allocate(allocSize_);
+        if(buffer.allocPtr == nullptr) {
+            throw memory_exception("Failed to allocate v4l2 userptr buffer! size=" + std::to_string(allocSize_));
+        }
+        auto addr  = reinterpret_cast<uintptr_t>(buffer.allocPtr);
+        buffer.ptr = reinterpret_cast<uint8_t *>((addr + pageSize - 1) & ~(static_cast<uintptr_t>(pageSize) - 1));
+    }
+    LOG_DEBUG("V4lUserPtrBufferQueue created! fd: {}, buffer count: {}, buffer size: {}", fd_, bufferCount, bufferSize_);
+}
+
+V4lUserPtrBufferQueue::~V4lUserPtrBufferQueue() noexcept {
+    for(auto &buffer: buffers_) {
+        if(buffer.allocPtr) {
+            frameMemoryAllocator_->deallocate(buffer.allocPtr, allocSize_);
+            buffer.allocPtr = nullptr;
+            buffer.ptr      = nullptr;
+        }
+    }
+    LOG_DEBUG("V4lUserPtrBufferQueue destroyed! fd: {}", fd_);
+}
+
+bool V4lUserPtrBufferQueue::requestBuffers() {
+    struct v4l2_requestbuffers req = {};
+    req.count                      = static_cast<uint32_t>(buffers_.size());
+    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory                     = V4L2_MEMORY_USERPTR;
+    if(ioctlFunc_(fd_, VIDIOC_REQBUFS, &req) < 0) {
+        LOG_DEBUG("VIDIOC_REQBUFS with V4L2_MEMORY_USERPTR failed, {}", strerror(errno));
+        return false;
+    }
+    if(req.count < buffers_.size()) {
+        LOG_DEBUG("Driver granted {} userptr buffers, less than requested {}", req.count, buffers_.size());
+        if(req.count == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for(size_t i = req.count; i < buffers_.size(); i++) {
+            frameMemoryAllocator_->deallocate(buffers_[i].allocPtr, allocSize_);
+        }
+        buffers_.resize(req.count);
+    }
+    return true;
+}
+
+void V4lUserPtrBufferQueue::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streaming_ = true;
+    for(uint32_t i = 0; i < buffers_.size(); i++) {
+        if(!buffers_[i].queued) {
+            queueBuffer(i);
+        }
+    }
+}
+
+void V4lUserPtrBufferQueue::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streaming_ = false;
+}
+
+void V4lUserPtrBufferQueue::releaseBuffers() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // VIDIOC_STREAMOFF has dequeued all buffers from driver
+    for(auto &buffer: buffers_) {
+        buffer.queued = false;
+    }
+    struct v4l2_requestbuffers req = {};
+    req.count                      = 0;
+    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory                     = V4L2_MEMORY_USERPTR;
+    if(ioctlFunc_(fd_, VIDIOC_REQBUFS, &req) < 0) {
+        throw io_exception(std::string("Failed to release userptr buffers! ") + strerror(errno));
+    }
+}
+
+bool V4lUserPtrBufferQueue::dequeue(v4l2_buffer &buf) {
+    buf        = {};
+    buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_USERPTR;
+    if(ioctlFunc_(fd_, VIDIOC_DQBUF, &buf) < 0) {
+        LOG_DEBUG("VIDIOC_DQBUF failed, {}", strerror(errno));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(buf.index >= buffers_.size()) {
+        LOG_WARN("Dequeued an invalid userptr buffer index: {}", buf.index);
+        return false;
+    }
+    buffers_[buf.index].queued = false;
+    return true;
+}
+
+std::shared_ptr<Frame> V4lUserPtrBufferQueue::wrapFrame(const v4l2_buffer &buf, std::shared_ptr<const VideoStreamProfile> profile) {
+    if(buf.index >= buffers_.size()) {
+        throw invalid_value_exception("Invalid userptr buffer index: " + std::to_string(buf.index));
+    }
+
+    // The frame holds the queue to keep the buffer memory alive, the buffer is queued back to the driver once the frame is released
+    auto index       = buf.index;
+    auto self        = shared_from_this();
+    auto reclaimFunc = [self, index]() { self->requeue(index); };
+
+    auto frameType = utils::mapStreamTypeToFrameType(profile->getType());
+    auto frame     = FrameFactory::createVideoFrameFromUserBuffer(frameType, profile->getFormat(), profile->getWidth(), profile->getHeight(), 0,
+                                                                  buffers_[index].ptr, bufferSize_, reclaimFunc);
+    frame->setStreamProfile(profile);
+    frame->setDataSize(buf.bytesused);
+    return frame;
+}
+
+std::shared_ptr<Frame> V4lUserPtrBufferQueue::copyFrame(const v4l2_buffer &buf, std::shared_ptr<const VideoStreamProfile> profile) {
+    if(buf.index >= buffers_.size()) {
+        throw invalid_value_exception("Invalid userptr buffer index: " + std::to_string(buf.index));
+    }
+
+    auto frame = FrameFactory::createFrameFromStreamProfile(profile);
+    frame->updateData(buffers_[buf.index].ptr, buf.bytesused);
+    requeue(buf.index);
+    return frame;
+}
+
+void V4lUserPtrBufferQueue::requeue(uint32_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(!streaming_ || index >= buffers_.size() || buffers_[index].queued) {
+        return;
+    }
+    queueBuffer(index);
+}
+
+void V4lUserPtrBufferQueue::queueBuffer(uint32_t index) {
+    v4l2_buffer buf = {};
+    buf.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory      = V4L2_MEMORY_USERPTR;
+    buf.index       = index;
+    buf.m.userptr   = reinterpret_cast<unsigned long>(buffers_[index].ptr);
+    buf.length      = static_cast<uint32_t>(bufferSize_);
+    if(ioctlFunc_(fd_, VIDIOC_QBUF, &buf) < 0) {
+        LOG_WARN("VIDIOC_QBUF for userptr buffer {} failed, {}", index, strerror(errno));
+        return;
+    }
+    buffers_[index].queued = true;
+}
+
+uint32_t V4lUserPtrBufferQueue::getBufferCount() const {
+    return static_cast<uint32_t>(buffers_.size());
+}
+
+size_t V4lUserPtrBufferQueue::getBufferSize() const {
+    return bufferSize_;
+}
+
+uint32_t V4lUserPtrBufferQueue::getQueuedBufferCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t                    count = 0;
+    for(const auto &buffer: buffers_) {
+        count += buffer.queued ? 1 : 0;
+    }
+    return count;
+}
+
+}  // namespace libobsensor
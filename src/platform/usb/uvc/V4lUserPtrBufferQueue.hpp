@@ -0,0 +1,87 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <linux/videodev2.h>
+
+#include "frame/Frame.hpp"
+#include "stream/StreamProfile.hpp"
+
+namespace libobsensor {
+
+// ioctl entry used by the buffer queue, can be replaced by a mock implementation for testing
+typedef std::function<int(int fd, unsigned long request, void *arg)> V4lIoctlFunc;
+
+typedef enum {
+    V4L_CAPTURE_MEMORY_MMAP,     // driver allocated buffers, frame data is copied out of the mapped buffer
+    V4L_CAPTURE_MEMORY_USERPTR,  // sdk allocated buffers, frame wraps the kernel-filled memory without copy
+} V4lCaptureMemoryMode;
+
+/**
+ * @brief V4L2 capture buffer queue working on V4L2_MEMORY_USERPTR mode.
+ *
+ * The buffers are allocated from FrameMemoryAllocator (so they are counted in Memory.MaxFrameBufferSize) and queued to the driver as user pointers.
+ * A dequeued buffer is wrapped into a Frame without copy, and is queued back to the driver when the frame's reclaim function runs. If the frame is
+ * released after the queue has been stopped, the buffer will not be queued again and the memory is released with the last frame.
+ */
+class V4lUserPtrBufferQueue : public std::enable_shared_from_this<V4lUserPtrBufferQueue> {
+public:
+    V4lUserPtrBufferQueue(int fd, uint32_t bufferCount, size_t bufferSize, V4lIoctlFunc ioctlFunc);
+    ~V4lUserPtrBufferQueue() noexcept;
+
+    // VIDIOC_REQBUFS with V4L2_MEMORY_USERPTR, return false if the driver does not support USERPTR mode
+    bool requestBuffers();
+
+    // queue all idle buffers to driver, should be called after requestBuffers() and before/after VIDIOC_STREAMON
+    void start();
+
+    // stop re-queuing buffers to the driver, should be called before VIDIOC_STREAMOFF
+    void stop();
+
+    // VIDIOC_REQBUFS with count 0, release the driver side buffer structures, memory still alive until all frames are released
+    void releaseBuffers();
+
+    // Dequeue a filled buffer from driver, return false if no buffer is available
+    bool dequeue(v4l2_buffer &buf);
+
+    // Wrap the dequeued buffer into a frame, the buffer will be re-queued to driver when the frame is destroyed
+    std::shared_ptr<Frame> wrapFrame(const v4l2_buffer &buf, std::shared_ptr<const VideoStreamProfile> profile);
+
+    // Copy the dequeued buffer into a frame of the frame memory pool and queue the buffer back to driver at once
+    std::shared_ptr<Frame> copyFrame(const v4l2_buffer &buf, std::shared_ptr<const VideoStreamProfile> profile);
+
+    // Queue the buffer back to driver directly (eg. the buffer is empty or failed to wrap it into a frame)
+    void requeue(uint32_t index);
+
+    uint32_t getBufferCount() const;
+    size_t   getBufferSize() const;
+    // Number of the buffers owned by the driver, the others are held by the wrapped frames or being processed
+    uint32_t getQueuedBufferCount() const;
+
+private:
+    void queueBuffer(uint32_t index);
+
+private:
+    struct UserPtrBuffer {
+        uint8_t *allocPtr = nullptr;  // pointer returned by FrameMemoryAllocator
+        uint8_t *ptr      = nullptr;  // page aligned pointer queued to driver
+        bool     queued   = false;
+    };
+
+    const int                             fd_;
+    const size_t                          bufferSize_;
+    size_t                                allocSize_;
+    V4lIoctlFunc                          ioctlFunc_;
+    mutable std::mutex                    mutex_;
+    bool                                  streaming_;
+    std::vector<UserPtrBuffer>            buffers_;
+    std::shared_ptr<FrameMemoryAllocator> frameMemoryAllocator_;
+};
+
+}  // namespace libobsensor
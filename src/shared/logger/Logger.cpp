@@ -21,10 +21,6 @@
 
 #include <map>
 
-std::map<std::string, std::shared_ptr<ObLogIntvlRecord>> logIntvlRecordMap;
-std::mutex                                               logIntvlRecordMapMtx;
-std::atomic<bool>                                        logIntvlRecordMapDestroyed(false);
-
 namespace libobsensor {
 
 const std::map<OBLogSeverity, spdlog::level::level_enum> OBLogSeverityToSpdlogLevel = {
@@ -51,11 +47,12 @@ const char *OB_DEFAULT_LOG_FILE_PATH = "/sdcard/Orbbec/Log/";
 const char *OB_DEFAULT_LOG_FILE_PATH = "Log/";
 #endif
 
-const OBLogSeverity OB_DEFAULT_LOG_SEVERITY  = OB_LOG_SEVERITY_INFO;
-const std::string   OB_DEFAULT_LOG_FMT       = "[%m/%d %H:%M:%S.%f][%l][%t][%s:%#] %v";
-const uint64_t      OB_DEFAULT_MAX_FILE_SIZE = 1024 * 1024 * 100;
-const uint16_t      OB_DEFAULT_MAX_FILE_NUM  = 3;
-const std::string   OB_DEFAULT_LOG_FILE_NAME = "OrbbecSDK.log.txt";
+const OBLogSeverity OB_DEFAULT_LOG_SEVERITY     = OB_LOG_SEVERITY_INFO;
+const std::string   OB_DEFAULT_LOG_FMT          = "[%m/%d %H:%M:%S.%f][%l][%t][%s:%#] %v";
+const uint64_t      OB_DEFAULT_MAX_FILE_SIZE    = 1024 * 1024 * 100;
+const uint16_t      OB_DEFAULT_MAX_FILE_NUM     = 3;
+const std::string   OB_DEFAULT_LOG_FILE_NAME    = "OrbbecSDK.log.txt";
+const uint32_t      OB_DEFAULT_ASYNC_QUEUE_SIZE = 8192;
 
 struct Logger::LoggerConfig {
     bool          loadFileLogSeverityFromEnvConfig = true;
@@ -74,7 +71,9 @@ struct Logger::LoggerConfig {
     OBLogSeverity callbackLogSeverity                  = OB_DEFAULT_LOG_SEVERITY;
     LogCallback   logCallback                          = nullptr;
 
-    bool async = false;
+    bool     async              = false;
+    uint32_t asyncQueueSize     = OB_DEFAULT_ASYNC_QUEUE_SIZE;
+    bool     asyncOverflowBlock = true;
 };
 
 Logger::LoggerConfig    Logger::config_;
@@ -93,27 +92,19 @@ std::shared_ptr<Logger> Logger::getInstance() {
 Logger::Logger() : spdlogRegistry_(spdlog::details::registry::instance_ptr()) {
     spdlog::set_pattern(OB_DEFAULT_LOG_FMT);
 
-    std::lock_guard<std::mutex> lock(logIntvlRecordMapMtx);
-    logIntvlRecordMapDestroyed = false;
     loadEnvConfig();
     createConsoleSink();
     createFileSink();
     createCallbackSink();
     updateDefaultSpdLogger();
+    log_intvl_start_flusher();
 }
 
 Logger::~Logger() noexcept {
-    {
-        std::lock_guard<std::mutex> lock(logIntvlRecordMapMtx);
-        logIntvlRecordMapDestroyed = true;
-        for(auto &it: logIntvlRecordMap) {
-            it.second->flush();
-            it.second.reset();
-        }
-        logIntvlRecordMap.clear();
-    }
+    log_intvl_stop_flusher();
 
     spdlog::set_default_logger(std::make_shared<spdlog::logger>("EmptySinksLogger"));
+    asyncThreadPool_.reset();  // Output the remaining logs in the queue
 
     if(consoleSink_) {
         consoleSink_->flush();
@@ -209,11 +200,14 @@ void Logger::updateDefaultSpdLogger() {
 
     std::shared_ptr<spdlog::logger> spdLogger;
     if(config_.async) {
-        spdlog::init_thread_pool(1024, 1);  // queue with 1k items and 1 threads, multiple threads will cause the log output order to be disordered
+        if(!asyncThreadPool_) {
+            // Bounded queue with 1 thread, multiple threads will cause the log output order to be disordered
+            asyncThreadPool_ = std::make_shared<spdlog::details::thread_pool>(config_.asyncQueueSize, 1);
+        }
 
-        // Asynchronous logger
-        spdLogger = std::make_shared<spdlog::async_logger>("OrbbecSDK", sinks.begin(), sinks.end(),  //
-                                                           spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+        // Asynchronous logger, the caller never blocks on a full queue unless the block policy is configured
+        auto overflowPolicy = config_.asyncOverflowBlock ? spdlog::async_overflow_policy::block : spdlog::async_overflow_policy::overrun_oldest;
+        spdLogger           = std::make_shared<spdlog::async_logger>("OrbbecSDK", sinks.begin(), sinks.end(), asyncThreadPool_, overflowPolicy);
 
         spdlog::flush_every(std::chrono::seconds(1));  // Set to flush the log every 1 second
     }
@@ -290,6 +284,14 @@ void Logger::loadEnvConfig() {
     if(envConfig->getBooleanValue("Log.Async", async)) {
         config_.async = async;
     }
+    int asyncQueueSize = 0;
+    if(envConfig->getIntValue("Log.AsyncQueueSize", asyncQueueSize) && asyncQueueSize > 0) {
+        config_.asyncQueueSize = static_cast<uint32_t>(asyncQueueSize);
+    }
+    bool asyncOverflowBlock = true;
+    if(envConfig->getBooleanValue("Log.AsyncOverflowBlock", asyncOverflowBlock)) {
+        config_.asyncOverflowBlock = asyncOverflowBlock;
+    }
 }
 
 void Logger::setLogSeverity(OBLogSeverity severity) {
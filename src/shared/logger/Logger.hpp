@@ -41,6 +41,12 @@
 #include <libobsensor/h/ObTypes.h>
 #include "utils/PublicTypeHelper.hpp"
 
+namespace spdlog {
+namespace details {
+class thread_pool;
+}
+}  // namespace spdlog
+
 namespace libobsensor {
 typedef std::function<void(OBLogSeverity severity, const std::string &logMsg)> LogCallback;
 
@@ -77,6 +83,8 @@ private:
     spdlog::sink_ptr fileSink_;
     spdlog::sink_ptr callbackSink_;
 
+    std::shared_ptr<spdlog::details::thread_pool> asyncThreadPool_;  // bounded queue and worker thread of the asynchronous logger
+
     std::shared_ptr<spdlog::details::registry> spdlogRegistry_;  // handle spdlog registry instance to control it's life cycle
 };
 }  // namespace libobsensor
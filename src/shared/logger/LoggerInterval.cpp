@@ -0,0 +1,173 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "LoggerInterval.hpp"
+
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+
+namespace {
+std::atomic<ObLogIntvlSite *> logIntvlSiteList(nullptr);  // Sites with suppressed logs, only grows since the sites are static variables
+std::mutex                    logIntvlFlusherMtx;
+std::condition_variable       logIntvlFlusherCv;
+std::thread                   logIntvlFlusherThread;
+bool                          logIntvlFlusherRunning = false;
+bool                          logIntvlFlusherWakeup  = false;
+
+const int64_t LOG_INTVL_SLOT_EXPIRE_TIME_MS = MAX_LOG_INTERVAL;  // Slots idle for this time can be claimed by other tags
+
+void outputSummary(ObLogIntvlSite &site, ObLogIntvlSlot &slot, const char *msg, uint32_t count, int64_t nowMs) {
+    // Convert the steady clock time of the last suppressed log to the system clock time
+    auto sinceLastUs = log_intvl_now_us() - slot.lastSuppressedTimeUs.load(std::memory_order_relaxed);
+    auto lastUs      = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - sinceLastUs;
+    auto duration    = nowMs - slot.lastLogTimeMs.load(std::memory_order_relaxed);
+
+    char   timestampStr[100];
+    time_t timestamp = static_cast<time_t>(lastUs / 1000000);
+    std::strftime(timestampStr, sizeof(timestampStr), "%H:%M:%S", std::localtime(&timestamp));
+
+    spdlog::default_logger_raw()->log(site.srcLoc, static_cast<spdlog::level::level_enum>(site.level), "{} [**{} logs in {}ms, last: {}.{:06d}**]", msg, count,
+                                      duration, timestampStr, lastUs % 1000000);
+}
+
+// Output the summary of the pending slots whose interval has expired (or all pending slots if force is true)
+// Returns the earliest steady clock time at which a pending slot expires, or INT64_MAX if there is none.
+int64_t flushPendingSlots(bool force) {
+    auto nowMs    = log_intvl_now_us() / 1000;
+    auto earliest = (std::numeric_limits<int64_t>::max)();
+    for(auto site = logIntvlSiteList.load(std::memory_order_acquire); site != nullptr; site = site->next) {
+        for(auto &slot: site->slots) {
+            if(slot.state.load(std::memory_order_acquire) != OB_LOG_INTVL_SLOT_PENDING) {
+                continue;
+            }
+            auto next = slot.nextLogTimeMs.load(std::memory_order_acquire);
+            if(next == (std::numeric_limits<int64_t>::max)()) {
+                continue;  // A log is being emitted, it will take over the pending summary
+            }
+            if(!force && nowMs < next) {
+                earliest = (std::min)(earliest, next);
+                continue;
+            }
+            if(!slot.nextLogTimeMs.compare_exchange_strong(next, (std::numeric_limits<int64_t>::max)(), std::memory_order_acq_rel)) {
+                continue;
+            }
+
+            // No writer can touch the message while the slot is pending
+            char msg[LOG_INTVL_MSG_SIZE];
+            memcpy(msg, slot.msg, sizeof(msg));
+            slot.state.store(OB_LOG_INTVL_SLOT_IDLE, std::memory_order_release);
+
+            auto count = slot.count.exchange(0, std::memory_order_relaxed);
+            if(count == 0) {
+                slot.nextLogTimeMs.store(next, std::memory_order_release);  // Already reported by an emitted log
+                continue;
+            }
+            outputSummary(*site, slot, msg, count, nowMs);
+            log_intvl_release_slot(slot, nowMs, count);
+        }
+    }
+    return earliest;
+}
+
+void flusherLoop() {
+    std::unique_lock<std::mutex> lock(logIntvlFlusherMtx);
+    while(logIntvlFlusherRunning) {
+        logIntvlFlusherWakeup = false;
+        lock.unlock();
+        auto earliest = flushPendingSlots(false);
+        lock.lock();
+
+        auto predicate = [] { return !logIntvlFlusherRunning || logIntvlFlusherWakeup; };
+        if(earliest == (std::numeric_limits<int64_t>::max)()) {
+            logIntvlFlusherCv.wait(lock, predicate);
+        }
+        else {
+            logIntvlFlusherCv.wait_for(lock, std::chrono::milliseconds((std::max)(earliest - log_intvl_now_us() / 1000, static_cast<int64_t>(1))), predicate);
+        }
+    }
+}
+}  // namespace
+
+ObLogIntvlSlot *log_intvl_claim_slot(ObLogIntvlSite &site, uint64_t tag, int64_t nowMs) {
+    for(auto &slot: site.slots) {
+        uint64_t slotTag = 0;
+        if(slot.tag.compare_exchange_strong(slotTag, tag, std::memory_order_acq_rel) || slotTag == tag) {
+            return &slot;
+        }
+    }
+
+    // All slots are in use, take over a slot whose object (or thread) has not logged for a long time
+    for(auto &slot: site.slots) {
+        auto slotTag = slot.tag.load(std::memory_order_acquire);
+        auto next    = slot.nextLogTimeMs.load(std::memory_order_acquire);
+        if(nowMs - next > LOG_INTVL_SLOT_EXPIRE_TIME_MS && slot.state.load(std::memory_order_acquire) == OB_LOG_INTVL_SLOT_IDLE
+           && slot.count.load(std::memory_order_relaxed) == 0 && slot.tag.compare_exchange_strong(slotTag, tag, std::memory_order_acq_rel)) {
+            slot.lastLogTimeMs.store(0, std::memory_order_relaxed);
+            slot.intervalMs.store(0, std::memory_order_relaxed);
+            return &slot;
+        }
+    }
+    return &site.slots[LOG_INTVL_SLOT_COUNT - 1];
+}
+
+void log_intvl_release_slot(ObLogIntvlSlot &slot, int64_t nowMs, uint32_t count) {
+    uint64_t minInterval = slot.minIntervalMs.load(std::memory_order_relaxed);
+    uint64_t interval    = slot.intervalMs.load(std::memory_order_relaxed);
+    auto     lastMs      = slot.lastLogTimeMs.load(std::memory_order_relaxed);
+    if(interval == 0 || lastMs == 0) {
+        interval = minInterval;
+    }
+    else if(static_cast<uint64_t>(nowMs - lastMs) / count < interval) {  // Reduce the log output frequency
+        interval = (std::min)(interval * 2, static_cast<uint64_t>(MAX_LOG_INTERVAL));
+    }
+    else {
+        interval = minInterval;  // Restore the log output frequency
+    }
+    slot.intervalMs.store(interval, std::memory_order_relaxed);
+    slot.lastLogTimeMs.store(nowMs, std::memory_order_relaxed);
+    slot.nextLogTimeMs.store(nowMs + static_cast<int64_t>(interval), std::memory_order_release);
+}
+
+void log_intvl_notify_pending(ObLogIntvlSite &site, const spdlog::source_loc &srcLoc, spdlog::level::level_enum level) {
+    bool registered = false;
+    if(site.registered.compare_exchange_strong(registered, true, std::memory_order_acq_rel)) {
+        site.srcLoc = srcLoc;
+        site.level  = level;
+        site.next   = logIntvlSiteList.load(std::memory_order_relaxed);
+        while(!logIntvlSiteList.compare_exchange_weak(site.next, &site, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    std::unique_lock<std::mutex> lock(logIntvlFlusherMtx);
+    if(!logIntvlFlusherRunning) {
+        return;  // The pending summary will be reported by the next emitted log or when the flusher is started
+    }
+    logIntvlFlusherWakeup = true;
+    lock.unlock();
+    logIntvlFlusherCv.notify_one();
+}
+
+void log_intvl_start_flusher() {
+    std::lock_guard<std::mutex> lock(logIntvlFlusherMtx);
+    if(logIntvlFlusherRunning) {
+        return;
+    }
+    logIntvlFlusherRunning = true;
+    logIntvlFlusherThread  = std::thread(flusherLoop);
+}
+
+void log_intvl_stop_flusher() {
+    {
+        std::lock_guard<std::mutex> lock(logIntvlFlusherMtx);
+        if(!logIntvlFlusherRunning) {
+            return;
+        }
+        logIntvlFlusherRunning = false;
+    }
+    logIntvlFlusherCv.notify_all();
+    if(logIntvlFlusherThread.joinable()) {
+        logIntvlFlusherThread.join();
+    }
+    flushPendingSlots(true);
+}
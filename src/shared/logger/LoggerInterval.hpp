@@ -6,169 +6,165 @@
 #include "Logger.hpp"
 #include <spdlog/common.h>
 #include <spdlog/fmt/fmt.h>
-#include <spdlog/fmt/chrono.h>
-#include <map>
-#include <sstream>
-#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <thread>
-#include <mutex>
-#include <ctime>
-
-#define LOG_RECORD_MAP_SIZE_LIMIT 500  // Maximum number of log entries
-#define MAX_LOG_INTERVAL 60 * 1000     // Maximum log output interval: 60000ms
-#define DEF_MIN_LOG_INTVL 3000         // Default minimum log output interval: 3000ms
-#define LOG_INTVL_OBJECT_TAG std::string(__FILE__) + std::to_string(__LINE__) + std::to_string((uint64_t)this)
-
-struct ObLogIntvlRecord {
-    uint32_t                              count;
-    uint64_t                              interval;
-    std::chrono::system_clock::time_point lastInvokeTime;
-    std::chrono::system_clock::time_point lastLogTime;
-    std::thread                           invokeThread;
-    std::mutex                            mtx;
-    std::condition_variable               cv;
-    void                                  flush() {
-        cv.notify_all();
-        if(invokeThread.joinable()) {
-            invokeThread.join();
-        }
-    }
-    ~ObLogIntvlRecord() {
-        flush();
-    }
+
+#define MAX_LOG_INTERVAL 60 * 1000  // Maximum log output interval: 60000ms
+#define DEF_MIN_LOG_INTVL 3000      // Default minimum log output interval: 3000ms
+#define LOG_INTVL_SLOT_COUNT 8      // Maximum number of objects (or threads) whose log output interval is controlled separately at one call site
+#define LOG_INTVL_MSG_SIZE 256      // Buffer size of the suppressed log message kept for the summary output (longer messages are truncated)
+#define LOG_INTVL_OBJECT_TAG static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this))
+#define LOG_INTVL_THREAD_TAG static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()))
+
+enum ObLogIntvlSlotState {
+    OB_LOG_INTVL_SLOT_IDLE    = 0,  // No suppressed log message is kept
+    OB_LOG_INTVL_SLOT_WRITING = 1,  // The first suppressed log message of the interval is being written to the slot
+    OB_LOG_INTVL_SLOT_PENDING = 2,  // The slot keeps a suppressed log message, the flusher will output the summary when the interval expires
 };
 
-extern std::atomic<bool>                                        logIntvlRecordMapDestroyed;
-extern std::map<std::string, std::shared_ptr<ObLogIntvlRecord>> logIntvlRecordMap;
-extern std::mutex                                               logIntvlRecordMapMtx;
+// Log output interval control state of one object (or thread) at one call site.
+// All members are accessed without lock, the emitting of a log is claimed by swapping nextLogTimeMs to INT64_MAX.
+struct ObLogIntvlSlot {
+    std::atomic<uint64_t> tag;                   // 0 means the slot is free
+    std::atomic<int64_t>  nextLogTimeMs;         // steady clock time when the next log is allowed to be emitted
+    std::atomic<int64_t>  lastLogTimeMs;         // steady clock time of the last emitted log, 0 means never
+    std::atomic<uint64_t> intervalMs;            // current log output interval, doubled when logs are invoked frequently
+    std::atomic<uint64_t> minIntervalMs;         // minimum log output interval requested by the call site
+    std::atomic<uint32_t> count;                 // number of logs suppressed since the last emitted log
+    std::atomic<int64_t>  lastSuppressedTimeUs;  // steady clock time of the last suppressed log
+    std::atomic<int>      state;                 // ObLogIntvlSlotState
+    char                  msg[LOG_INTVL_MSG_SIZE];
+};
 
-template <typename... Args>
-void log_intvl_invoke(std::shared_ptr<ObLogIntvlRecord> record, uint64_t minIntvlMsec, spdlog::source_loc src_loc, spdlog::level::level_enum level,
-                      std::string fmt, Args &&...args) {
-    std::unique_lock<std::mutex> lock(record->mtx);
-    record->cv.wait_for(lock, std::chrono::milliseconds(record->interval));
-    if(record->count > 0) {
-        auto     nowTime  = std::chrono::system_clock::now();
-        uint64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - record->lastInvokeTime).count();
-
-        char   timestampStr[100];
-        time_t timestamp = std::chrono::duration_cast<std::chrono::seconds>(record->lastLogTime.time_since_epoch()).count();
-        std::strftime(timestampStr, sizeof(timestampStr), "%H:%M:%S", std::localtime(&timestamp));
-
-        auto us    = std::chrono::duration_cast<std::chrono::microseconds>(record->lastLogTime.time_since_epoch()).count() % 1000000;
-        auto usStr = fmt::format("{:06d}", us);
-
-        fmt = fmt + " [**" + std::to_string(record->count) + " logs in " + std::to_string(duration) + "ms, last: " + timestampStr + "." + usStr.data() + "**]";
-        spdlog::default_logger_raw()->log(src_loc, level, fmt, std::forward<Args>(args)...);
-
-        uint64_t avgInterval = duration / record->count;
-        if(avgInterval < record->interval) {  // Reduce log output frequency
-            record->interval *= 2;
-            if(record->interval > MAX_LOG_INTERVAL) {
-                record->interval = MAX_LOG_INTERVAL;
-            }
+// Per call site state of LOG_INTVL, declared as a function local static variable by the macro.
+// The struct is trivially constructible and destructible, so it is zero-initialized without any initialization guard and remains valid during exit.
+struct ObLogIntvlSite {
+    ObLogIntvlSlot     slots[LOG_INTVL_SLOT_COUNT];
+    std::atomic<bool>  registered;  // registered to the site list of the flusher
+    ObLogIntvlSite    *next;
+    spdlog::source_loc srcLoc;
+    int                level;
+};
+
+// Claim a free (or expired) slot for the tag, return the last slot which is shared by the overflowed tags if all slots are in use
+ObLogIntvlSlot *log_intvl_claim_slot(ObLogIntvlSite &site, uint64_t tag, int64_t nowMs);
+
+// Register the site to the flusher and wake it up to output the summary of the suppressed logs when the interval expires
+void log_intvl_notify_pending(ObLogIntvlSite &site, const spdlog::source_loc &srcLoc, spdlog::level::level_enum level);
+
+// Update the log output interval after a log is emitted and allow the next log to be emitted after the interval
+// When logs are invoked frequently in succession, the interval is doubled until the maximum interval, MAX_LOG_INTERVAL, is reached
+void log_intvl_release_slot(ObLogIntvlSlot &slot, int64_t nowMs, uint32_t count);
+
+// Start/stop the background flusher, the pending summaries are output immediately when the flusher is stopped
+void log_intvl_start_flusher();
+void log_intvl_stop_flusher();
+
+inline int64_t log_intvl_now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline ObLogIntvlSlot *log_intvl_find_slot(ObLogIntvlSite &site, uint64_t tag, int64_t nowMs) {
+    for(auto &slot: site.slots) {
+        auto slotTag = slot.tag.load(std::memory_order_acquire);
+        if(slotTag == tag) {
+            return &slot;
         }
-        else {
-            avgInterval = minIntvlMsec;  // Restore log output frequency
+        if(slotTag == 0) {
+            break;  // Slots are claimed in order, the rest are free
         }
+    }
+    return log_intvl_claim_slot(site, tag, nowMs);
+}
 
-        record->lastInvokeTime = nowTime;
-        record->count          = 0;
+template <typename... Args>
+void log_intvl_format(spdlog::memory_buf_t &buf, spdlog::string_view_t fmtStr, Args &&...args) {
+    try {
+        fmt::vformat_to(std::back_inserter(buf), fmtStr, fmt::make_format_args(args...));
+    }
+    catch(...) {
+        buf.clear();
+        buf.append(fmtStr.data(), fmtStr.data() + fmtStr.size());
+    }
+}
+
+template <typename... Args>
+void log_intvl_format_to_slot(ObLogIntvlSlot &slot, spdlog::string_view_t fmtStr, Args &&...args) {
+    size_t size = 0;
+    try {
+        size = fmt::vformat_to_n(slot.msg, LOG_INTVL_MSG_SIZE - 1, fmtStr, fmt::make_format_args(args...)).size;
     }
+    catch(...) {
+        size = fmtStr.size();
+        std::copy(fmtStr.data(), fmtStr.data() + std::min<size_t>(size, LOG_INTVL_MSG_SIZE - 1), slot.msg);
+    }
+    slot.msg[std::min<size_t>(size, LOG_INTVL_MSG_SIZE - 1)] = '\0';
 }
 
-// Control log output at intervals; when log_intvl is called repeatedly within the interval time, only one log entry is output
-// When log_intvl is called frequently in succession, the log output frequency will decrease (intervals will lengthen) until the maximum interval, MAX_INTERVAL, is reached
+// Control log output at intervals; when log_intvl is called repeatedly within the interval time, only one log entry is output and the rest are counted.
+// The first suppressed log of the interval is kept in the slot, and the background flusher outputs it with the count when the interval expires.
+// The fast path (log suppressed) only loads the clock and updates a few atomics of the call site state, it never allocates or locks.
 template <typename... Args>
-void log_intvl(std::shared_ptr<ObLogIntvlRecord> record, uint64_t minIntvlMsec, spdlog::source_loc src_loc, spdlog::level::level_enum level, std::string fmt,
-               Args &&...args) {
+void log_intvl(ObLogIntvlSite &site, uint64_t tag, uint64_t minIntvlMsec, const spdlog::source_loc &srcLoc, spdlog::level::level_enum level,
+               spdlog::string_view_t fmtStr, Args &&...args) {
     if(minIntvlMsec == 0) {
-        spdlog::default_logger_raw()->log(src_loc, level, fmt, std::forward<Args>(args)...);
+        spdlog::memory_buf_t buf;
+        log_intvl_format(buf, fmtStr, args...);
+        spdlog::default_logger_raw()->log(srcLoc, level, spdlog::string_view_t(buf.data(), buf.size()));
+        return;
     }
-    else {
-        std::unique_lock<std::mutex> lock(record->mtx);
-        auto                         nowTime = std::chrono::system_clock::now();
-        record->lastLogTime                  = nowTime;
-        record->count++;
-        uint64_t duration           = std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - record->lastInvokeTime).count();
-        bool     zeroLastInvokeTime = record->lastInvokeTime.time_since_epoch() == std::chrono::system_clock::duration::zero();
-        if(duration > record->interval || zeroLastInvokeTime) {
-            if(!zeroLastInvokeTime) {
-                uint64_t avgInterval = duration / record->count;
-                if(avgInterval < record->interval) {  // Reduce the log output frequency
-                    record->interval *= 2;
-                    if(record->interval > MAX_LOG_INTERVAL) {
-                        record->interval = MAX_LOG_INTERVAL;
-                    }
-                }
-                else {
-                    record->interval = minIntvlMsec;  // Restore the log output frequency
-                }
-
-                if(record->count > 1) {
-                    fmt = fmt + " [**" + std::to_string(record->count) + " logs in " + std::to_string(duration) + "ms**]";
-                }
-            }
-
-            spdlog::default_logger_raw()->log(src_loc, level, fmt, std::forward<Args>(args)...);
-            record->count          = 0;
-            record->lastInvokeTime = nowTime;
-            lock.unlock();
-            if(record->invokeThread.joinable())  // Notify the thread to exit (resources will be automatically released after the thread exits)
-            {
-                record->cv.notify_all();
-                record->invokeThread.join();
-            }
-        }
-        else if(record->count == 1) {
-            lock.unlock();
-            if(record->invokeThread.joinable()) {
-                record->invokeThread.join();
-            }
-            auto func            = std::bind(std::move(log_intvl_invoke<Args &...>), record, minIntvlMsec, src_loc, level, fmt, std::forward<Args>(args)...);
-            record->invokeThread = std::thread(func);
+
+    auto nowUs = log_intvl_now_us();
+    auto nowMs = nowUs / 1000;
+    auto slot  = log_intvl_find_slot(site, tag == 0 ? 1 : tag, nowMs);
+    auto next  = slot->nextLogTimeMs.load(std::memory_order_acquire);
+    if(nowMs < next || !slot->nextLogTimeMs.compare_exchange_strong(next, (std::numeric_limits<int64_t>::max)(), std::memory_order_acq_rel)) {
+        auto count = slot->count.fetch_add(1, std::memory_order_relaxed);
+        slot->lastSuppressedTimeUs.store(nowUs, std::memory_order_relaxed);
+        int idle = OB_LOG_INTVL_SLOT_IDLE;
+        if(count == 0 && slot->state.compare_exchange_strong(idle, OB_LOG_INTVL_SLOT_WRITING, std::memory_order_acquire)) {
+            log_intvl_format_to_slot(*slot, fmtStr, args...);
+            slot->state.store(OB_LOG_INTVL_SLOT_PENDING, std::memory_order_release);
+            log_intvl_notify_pending(site, srcLoc, level);
         }
+        return;
+    }
+
+    // The log is emitted by this call, so the pending summary is no longer needed
+    int pending = OB_LOG_INTVL_SLOT_PENDING;
+    slot->state.compare_exchange_strong(pending, OB_LOG_INTVL_SLOT_IDLE, std::memory_order_acq_rel);
+    auto count  = slot->count.exchange(0, std::memory_order_relaxed) + 1;
+    auto lastMs = slot->lastLogTimeMs.load(std::memory_order_relaxed);
+    slot->minIntervalMs.store(minIntvlMsec, std::memory_order_relaxed);
+
+    spdlog::memory_buf_t buf;
+    log_intvl_format(buf, fmtStr, args...);
+    if(count > 1) {
+        fmt::format_to(std::back_inserter(buf), " [**{} logs in {}ms**]", count, lastMs != 0 ? nowMs - lastMs : 0);
+    }
+    spdlog::default_logger_raw()->log(srcLoc, level, spdlog::string_view_t(buf.data(), buf.size()));
+    log_intvl_release_slot(*slot, nowMs, count);
+    if(slot->state.load(std::memory_order_acquire) == OB_LOG_INTVL_SLOT_PENDING) {
+        // A log suppressed during the emitting became pending, the flusher skipped it as the slot was claimed by this call
+        log_intvl_notify_pending(site, srcLoc, level);
     }
 }
 
 // Control the log output interval in milliseconds; 0 means no control
-#define LOG_INTVL(tag, minIntvlMsec, level, ...)                                                                                                            \
-    do {                                                                                                                                                    \
-        std::unique_lock<std::mutex> logIntvlRecordMapLock(logIntvlRecordMapMtx);                                                                           \
-        if(logIntvlRecordMapDestroyed) {                                                                                                                    \
-            break;                                                                                                                                          \
-        }                                                                                                                                                   \
-        if(logIntvlRecordMap.size() > LOG_RECORD_MAP_SIZE_LIMIT) {                                                                                          \
-            LOG_WARN("logIntvlRecordMap size {} > {}, clear it!", logIntvlRecordMap.size(), LOG_RECORD_MAP_SIZE_LIMIT);                                     \
-            auto nowTime = std::chrono::system_clock::now();                                                                                                \
-            for(auto logIntvlRecordMapIter = logIntvlRecordMap.begin(); logIntvlRecordMapIter != logIntvlRecordMap.end();) {                                \
-                uint64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - logIntvlRecordMapIter->second->lastInvokeTime).count(); \
-                if(logIntvlRecordMapIter->second->count == 0 && duration > logIntvlRecordMapIter->second->interval) {                                       \
-                    logIntvlRecordMapIter = logIntvlRecordMap.erase(logIntvlRecordMapIter);                                                                 \
-                }                                                                                                                                           \
-                else {                                                                                                                                      \
-                    logIntvlRecordMapIter++;                                                                                                                \
-                }                                                                                                                                           \
-            }                                                                                                                                               \
-        }                                                                                                                                                   \
-        auto logIntvlRecordMapIter = logIntvlRecordMap.find(tag);                                                                                           \
-        if(logIntvlRecordMapIter == logIntvlRecordMap.end()) {                                                                                              \
-            auto record      = std::make_shared<ObLogIntvlRecord>();                                                                                        \
-            record->count    = 0;                                                                                                                           \
-            record->interval = minIntvlMsec;                                                                                                                \
-            logIntvlRecordMap.insert(std::make_pair(tag, record));                                                                                          \
-            logIntvlRecordMapIter = logIntvlRecordMap.find(tag);                                                                                            \
-        }                                                                                                                                                   \
-        log_intvl(logIntvlRecordMapIter->second, minIntvlMsec, spdlog::source_loc{ __FILE__, __LINE__, SPDLOG_FUNCTION }, level, __VA_ARGS__);              \
+// The state is kept per call site (and per tag), so the tag only needs to distinguish the objects (or threads) logging at the same call site
+#define LOG_INTVL(tag, minIntvlMsec, level, ...)                                                                                                              \
+    do {                                                                                                                                                      \
+        static ObLogIntvlSite logIntvlSite;                                                                                                                   \
+        log_intvl(logIntvlSite, static_cast<uint64_t>(tag), minIntvlMsec, spdlog::source_loc{ __FILE__, __LINE__, SPDLOG_FUNCTION }, level, __VA_ARGS__); \
     } while(0)
 
-#define LOG_INTVL_ON_THREAD(minIntvlMsec, level, ...)                                  \
-    do {                                                                               \
-        std::stringstream ss;                                                          \
-        ss << std::this_thread::get_id();                                              \
-        std::string tag = std::string(__FILE__) + std::to_string(__LINE__) + ss.str(); \
-        LOG_INTVL(tag, minIntvlMsec, level, __VA_ARGS__);                              \
-    } while(0)
+#define LOG_INTVL_ON_THREAD(minIntvlMsec, level, ...) LOG_INTVL(LOG_INTVL_THREAD_TAG, minIntvlMsec, level, __VA_ARGS__)
 
 // The LOG_XXX_INTVL macro can only be used within class member functions because it uses the `this` pointer as a tag (log output interval control is bound to a specific object)
 // The LOG_XXX_INTVL_THREAD macro uses the current thread ID as a tag and can be used in class member functions and regular functions (log output interval control is bound to a specific thread)
@@ -4,8 +4,12 @@
 #include "CoordinateUtil.hpp"
 #include "logger/Logger.hpp"
 #include "logger/LoggerInterval.hpp"
+#include "CpuFeatures.hpp"
+#include "TaskExecutor.hpp"
 
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 namespace libobsensor {
 static bool judgeTransformValid(OBD2CTransform cameraRotParam) {
@@ -572,135 +576,818 @@ bool CoordinateUtil::transformationInitAddDistortionUVTables(const OBCameraIntri
     return true;
 }
 
-void CoordinateUtil::transformationDepthToPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, float positionDataScale,
-                                                     OBCoordinateSystemType type) {
-    const uint16_t *imageData = (const uint16_t *)depthImageData;
-    float          *xyzData   = (float *)pointCloudData;
-    float           x, y, z;
-    int             coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
-
-    for(int i = 0; i < xyTables->width * xyTables->height; i++) {
-        float x_tab = xyTables->xTable[i];
-
-        uint16_t depthValue = imageData[i];
-        if(!std::isnan(x_tab) && depthValue != 65535) {
-            z = (float)depthValue;
-            x = x_tab * (float)z;
-            y = xyTables->yTable[i] * (float)z * coordinateSystemCoefficient;
-
-            z *= positionDataScale;
-            x *= positionDataScale;
-            y *= positionDataScale;
+#define POINT_CLOUD_MIN_BAND_ROWS 32  // minimum rows of a band processed by one thread
+
+struct DepthToPointParam {
+    const float    *xTable;
+    const float    *yTable;
+    const uint16_t *depth;
+    float           scale;
+    float           yCoeff;  // -1 for left hand coordinate system
+};
+
+// Split [0, width * height) into row bands (boundaries rounded to 8 pixels), run them on the executor and the calling thread
+static int getPointCloudBandCount(TaskExecutor *executor, int height) {
+    int bandCount = executor ? static_cast<int>(executor->getThreadCount()) + 1 : 1;
+    if(bandCount > height / POINT_CLOUD_MIN_BAND_ROWS) {
+        bandCount = height / POINT_CLOUD_MIN_BAND_ROWS;
+    }
+    return bandCount < 1 ? 1 : bandCount;
+}
+
+static void getPointCloudBandRange(int index, int bandCount, int width, int height, int &begin, int &end) {
+    begin = height * index / bandCount * width / 8 * 8;
+    end   = index == bandCount - 1 ? width * height : height * (index + 1) / bandCount * width / 8 * 8;
+}
+
+static void forEachPointCloudBand(TaskExecutor *executor, int width, int height, const std::function<void(int, int)> &func) {
+    int bandCount = getPointCloudBandCount(executor, height);
+    if(bandCount == 1) {
+        func(0, width * height);
+        return;
+    }
+
+    executor->parallelFor(static_cast<uint32_t>(bandCount), [&](uint32_t index) {
+        int begin, end;
+        getPointCloudBandRange(static_cast<int>(index), bandCount, width, height, begin, end);
+        func(begin, end);
+    });
+}
+
+static inline void depthToPoint(const DepthToPointParam &param, int i, float &x, float &y, float &z) {
+    float    xTab       = param.xTable[i];
+    uint16_t depthValue = param.depth[i];
+    if(!std::isnan(xTab) && depthValue != 65535) {
+        z = (float)depthValue;
+        x = xTab * z;
+        y = param.yTable[i] * z * param.yCoeff;
+
+        z *= param.scale;
+        x *= param.scale;
+        y *= param.scale;
+    }
+    else {
+        x = 0.0f;
+        y = 0.0f;
+        z = 0.0f;
+    }
+}
+
+// 4 points at once, the per pixel NaN check is replaced by a validity mask (x table is not NaN and depth is not 65535) that zeroes the invalid lanes
+static inline __m128 depthToPointSSE(const DepthToPointParam &param, int i, __m128 &x, __m128 &y, __m128 &z) {
+    __m128i depth32 = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(param.depth + i)), _mm_setzero_si128());
+    __m128  depth   = _mm_cvtepi32_ps(depth32);
+    __m128  xTab    = _mm_loadu_ps(param.xTable + i);
+    __m128  valid   = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(depth32, _mm_set1_epi32(65535))), _mm_cmpord_ps(xTab, xTab));
+    __m128  scale   = _mm_set1_ps(param.scale);
+
+    x = _mm_and_ps(_mm_mul_ps(_mm_mul_ps(xTab, depth), scale), valid);
+    y = _mm_and_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(param.yTable + i), depth), _mm_set1_ps(param.yCoeff)), scale), valid);
+    z = _mm_and_ps(_mm_mul_ps(depth, scale), valid);
+    return valid;
+}
+
+// Interleave 4 points into x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+static inline void storeXYZ(float *dst, __m128 x, __m128 y, __m128 z) {
+    __m128 xy0 = _mm_unpacklo_ps(x, y);  // x0 y0 x1 y1
+    __m128 xy1 = _mm_unpackhi_ps(x, y);  // x2 y2 x3 y3
+    __m128 a   = _mm_shuffle_ps(z, xy0, _MM_SHUFFLE(2, 2, 0, 0));
+    __m128 b   = _mm_shuffle_ps(xy0, z, _MM_SHUFFLE(1, 1, 3, 3));
+    __m128 c   = _mm_shuffle_ps(z, xy1, _MM_SHUFFLE(3, 2, 2, 3));
+    _mm_storeu_ps(dst, _mm_shuffle_ps(xy0, a, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(b, xy1, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 3, 2, 1)));
+}
+
+// IEEE 754 binary16, round to nearest even (same as F16C)
+static inline uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    uint32_t abs  = bits & 0x7fffffff;
+
+    if(abs > 0x7f800000) {
+        return sign | 0x7e00 | (uint16_t)((abs >> 13) & 0x3ff);  // quiet NaN
+    }
+    if(abs >= 0x477ff000) {
+        return sign | 0x7c00;  // infinity or overflow
+    }
+    if(abs < 0x38800000) {
+        // subnormal half
+        int shift = 126 - (int)(abs >> 23);
+        if(shift > 24) {
+            return sign;
         }
-        else {
-            x = 0.0;
-            y = 0.0;
-            z = 0.0;
+        uint32_t mantissa = (abs & 0x7fffff) | 0x800000;
+        uint32_t half     = mantissa >> shift;
+        uint32_t rest     = mantissa & ((1u << shift) - 1);
+        uint32_t halfway  = 1u << (shift - 1);
+        if(rest > halfway || (rest == halfway && (half & 1))) {
+            half++;
         }
+        return sign | (uint16_t)half;
+    }
 
-        xyzData[3 * i + 0] = x;
-        xyzData[3 * i + 1] = y;
-        xyzData[3 * i + 2] = z;
+    uint32_t half = (abs - 0x38000000) >> 13;
+    uint32_t rest = abs & 0x1fff;
+    if(rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+        half++;
     }
+    return sign | (uint16_t)half;
 }
 
-void CoordinateUtil::transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData, void *pointCloudData,
-                                                         float positionDataScale, OBCoordinateSystemType type, bool colorDataNormalization) {
-    const uint16_t *dImageData = (const uint16_t *)depthImageData;
-    const uint8_t  *cImageData = (const uint8_t *)colorImageData;
-    float          *xyzrgbData = (float *)pointCloudData;
-    float           x, y, z;
-    float           r, g, b;
-    int             coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
-    float           colorDivCoeff               = colorDataNormalization ? 255.0f : 1.0f;
-
-    for(int i = 0; i < xyTables->width * xyTables->height; i++) {
-        float x_tab = xyTables->xTable[i];
-
-        uint16_t depthValue = dImageData[i];
-        if(!std::isnan(x_tab) && depthValue != 65535) {
-            z = (float)depthValue;
-            x = x_tab * (float)z;
-            y = xyTables->yTable[i] * (float)z * coordinateSystemCoefficient;
-
-            z *= positionDataScale;
-            x *= positionDataScale;
-            y *= positionDataScale;
-
-            r = cImageData[3 * i + 0] / colorDivCoeff;
-            g = cImageData[3 * i + 1] / colorDivCoeff;
-            b = cImageData[3 * i + 2] / colorDivCoeff;
+static void depthToPointCloudBand(const DepthToPointParam &param, float *xyzData, int begin, int end) {
+    int i = begin;
+    for(; i + 4 <= end; i += 4) {
+        __m128 x, y, z;
+        depthToPointSSE(param, i, x, y, z);
+        storeXYZ(xyzData + 3 * i, x, y, z);
+    }
+    for(; i < end; i++) {
+        depthToPoint(param, i, xyzData[3 * i + 0], xyzData[3 * i + 1], xyzData[3 * i + 2]);
+    }
+}
+
+static void depthToPlanarPointCloudBand(const DepthToPointParam &param, float *xData, float *yData, float *zData, int begin, int end) {
+    int i = begin;
+    for(; i + 4 <= end; i += 4) {
+        __m128 x, y, z;
+        depthToPointSSE(param, i, x, y, z);
+        _mm_storeu_ps(xData + i, x);
+        _mm_storeu_ps(yData + i, y);
+        _mm_storeu_ps(zData + i, z);
+    }
+    for(; i < end; i++) {
+        depthToPoint(param, i, xData[i], yData[i], zData[i]);
+    }
+}
+
+static void depthToHalfPointCloudBand(const DepthToPointParam &param, uint16_t *xyzData, int begin, int end) {
+    for(int i = begin; i < end; i++) {
+        float x, y, z;
+        depthToPoint(param, i, x, y, z);
+        xyzData[3 * i + 0] = floatToHalf(x);
+        xyzData[3 * i + 1] = floatToHalf(y);
+        xyzData[3 * i + 2] = floatToHalf(z);
+    }
+}
+
+// r, g and b of 4 rgb pixels divided by the normalization coefficient
+static inline void loadColorSSE(const uint8_t *color, __m128 divCoeff, __m128 &r, __m128 &g, __m128 &b) {
+    r = _mm_div_ps(_mm_setr_ps(color[0], color[3], color[6], color[9]), divCoeff);
+    g = _mm_div_ps(_mm_setr_ps(color[1], color[4], color[7], color[10]), divCoeff);
+    b = _mm_div_ps(_mm_setr_ps(color[2], color[5], color[8], color[11]), divCoeff);
+}
+
+// Interleave 4 points into x y z r g b per point, 2 points per 3 stores
+static inline void storeXYZRGB(float *dst, __m128 x, __m128 y, __m128 z, __m128 r, __m128 g, __m128 b) {
+    __m128 xy = _mm_unpacklo_ps(x, y);
+    __m128 zr = _mm_unpacklo_ps(z, r);
+    __m128 gb = _mm_unpacklo_ps(g, b);
+    _mm_storeu_ps(dst, _mm_movelh_ps(xy, zr));
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(gb, xy, _MM_SHUFFLE(3, 2, 1, 0)));
+    _mm_storeu_ps(dst + 8, _mm_movehl_ps(gb, zr));
+    xy = _mm_unpackhi_ps(x, y);
+    zr = _mm_unpackhi_ps(z, r);
+    gb = _mm_unpackhi_ps(g, b);
+    _mm_storeu_ps(dst + 12, _mm_movelh_ps(xy, zr));
+    _mm_storeu_ps(dst + 16, _mm_shuffle_ps(gb, xy, _MM_SHUFFLE(3, 2, 1, 0)));
+    _mm_storeu_ps(dst + 20, _mm_movehl_ps(gb, zr));
+}
+
+static inline uint8_t clampColor(int value) {
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// BT.601 limited range, 8-bit fixed point
+static inline void yuvToRgb(int y, int u, int v, uint8_t *rgb) {
+    int c  = 298 * (y - 16) + 128;
+    int d  = u - 128;
+    int e  = v - 128;
+    rgb[0] = clampColor((c + 409 * e) >> 8);
+    rgb[1] = clampColor((c - 100 * d - 208 * e) >> 8);
+    rgb[2] = clampColor((c + 516 * d) >> 8);
+}
+
+// The fixed point value >> 8 clamped to [0, 255]. All the values are integers exactly represented by floats, so the result is the same as yuvToRgb.
+static inline __m128 fixedPointToColorSSE(__m128 value, __m128 divCoeff) {
+    __m128 color = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(value, _mm_set1_ps(1.0f / 256))));
+    return _mm_div_ps(_mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), _mm_set1_ps(255.0f)), divCoeff);
+}
+
+// r, g and b of 4 pixels divided by the normalization coefficient
+static inline void yuvToRgbSSE(__m128 y, __m128 u, __m128 v, __m128 divCoeff, __m128 &r, __m128 &g, __m128 &b) {
+    __m128 c = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(y, _mm_set1_ps(16.0f)), _mm_set1_ps(298.0f)), _mm_set1_ps(128.0f));
+    __m128 d = _mm_sub_ps(u, _mm_set1_ps(128.0f));
+    __m128 e = _mm_sub_ps(v, _mm_set1_ps(128.0f));
+    r        = fixedPointToColorSSE(_mm_add_ps(c, _mm_mul_ps(e, _mm_set1_ps(409.0f))), divCoeff);
+    g        = fixedPointToColorSSE(_mm_sub_ps(c, _mm_add_ps(_mm_mul_ps(d, _mm_set1_ps(100.0f)), _mm_mul_ps(e, _mm_set1_ps(208.0f)))), divCoeff);
+    b        = fixedPointToColorSSE(_mm_add_ps(c, _mm_mul_ps(d, _mm_set1_ps(516.0f))), divCoeff);
+}
+
+// The color samplers of the RGBD point cloud: sample(i, buf) returns the 3 bytes rgb of the i-th pixel, either in the image or written to buf, and
+// sample4(i, ...) returns r, g and b of the pixels i to i + 3 divided by the normalization coefficient. i is even for sample4.
+class RGBColorSampler {
+public:
+    explicit RGBColorSampler(const RGBDColorImage &image) : data_(image.data) {}
+
+    inline const uint8_t *sample(int i, uint8_t *) const {
+        return data_ + 3 * i;
+    }
+
+    inline void sample4(int i, __m128 divCoeff, __m128 &r, __m128 &g, __m128 &b) const {
+        loadColorSSE(data_ + 3 * i, divCoeff, r, g, b);
+    }
+
+private:
+    const uint8_t *data_;
+};
+
+// Y0 U Y1 V (YUYV) or U Y0 V Y1 (UYVY), the 2 pixels of a pair share the chroma
+template <bool UYVY> class Packed422ColorSampler {
+public:
+    explicit Packed422ColorSampler(const RGBDColorImage &image) : data_(image.data) {}
+
+    inline const uint8_t *sample(int i, uint8_t *buf) const {
+        auto pair = data_ + (i & ~1) * 2;
+        yuvToRgb(data_[2 * i + (UYVY ? 1 : 0)], pair[UYVY ? 0 : 1], pair[UYVY ? 2 : 3], buf);
+        return buf;
+    }
+
+    inline void sample4(int i, __m128 divCoeff, __m128 &r, __m128 &g, __m128 &b) const {
+        __m128i bytes = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(data_ + 2 * i)), _mm_setzero_si128());
+        __m128  lo    = _mm_cvtepi32_ps(_mm_unpacklo_epi16(bytes, _mm_setzero_si128()));
+        __m128  hi    = _mm_cvtepi32_ps(_mm_unpackhi_epi16(bytes, _mm_setzero_si128()));
+        __m128  y     = UYVY ? _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)) : _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128  uv    = UYVY ? _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)) : _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));  // U0 V0 U1 V1
+        yuvToRgbSSE(y, _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(2, 2, 0, 0)), _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 3, 1, 1)), divCoeff, r, g, b);
+    }
+
+private:
+    const uint8_t *data_;
+};
+
+// Y plane followed by the interleaved (NV12: U V, NV21: V U) or separated (I420) chroma planes subsampled by 2 in both directions
+template <OBFormat FORMAT> class Planar420ColorSampler {
+public:
+    explicit Planar420ColorSampler(const RGBDColorImage &image)
+        : data_(image.data),
+          width_(image.width),
+          rowDivMagic_(((1ull << 40) + image.width - 1) / image.width),
+          uOffset_(image.width * image.height + (FORMAT == OB_FORMAT_NV21 ? 1 : 0)),
+          vOffset_(FORMAT == OB_FORMAT_I420 ? image.width * image.height * 5 / 4 : image.width * image.height + (FORMAT == OB_FORMAT_NV12 ? 1 : 0)) {}
+
+    inline const uint8_t *sample(int i, uint8_t *buf) const {
+        auto chroma = chromaIndex(i / width_, i % width_);
+        yuvToRgb(data_[i], data_[uOffset_ + chroma], data_[vOffset_ + chroma], buf);
+        return buf;
+    }
+
+    inline void sample4(int i, __m128 divCoeff, __m128 &r, __m128 &g, __m128 &b) const {
+        int     row = static_cast<int>((static_cast<uint64_t>(i) * rowDivMagic_) >> 40);
+        int     col = i - row * width_;
+        int32_t luma;
+        memcpy(&luma, data_ + i, sizeof(luma));
+        __m128 y = bytesToFloatSSE(luma);
+        if(col + 4 <= width_) {  // 2 chroma samples shared by 2 pixels each
+            auto chroma = chromaIndex(row, col);
+            if(FORMAT == OB_FORMAT_I420) {
+                __m128 u = _mm_setr_ps(data_[uOffset_ + chroma], data_[uOffset_ + chroma], data_[uOffset_ + chroma + 1], data_[uOffset_ + chroma + 1]);
+                __m128 v = _mm_setr_ps(data_[vOffset_ + chroma], data_[vOffset_ + chroma], data_[vOffset_ + chroma + 1], data_[vOffset_ + chroma + 1]);
+                yuvToRgbSSE(y, u, v, divCoeff, r, g, b);
+                return;
+            }
+            int32_t chromaPairs;
+            memcpy(&chromaPairs, data_ + (FORMAT == OB_FORMAT_NV12 ? uOffset_ : vOffset_) + chroma, sizeof(chromaPairs));
+            __m128 uv = bytesToFloatSSE(chromaPairs);  // U0 V0 U1 V1 (NV12) or V0 U0 V1 U1 (NV21)
+            __m128 c0 = _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 c1 = _mm_shuffle_ps(uv, uv, _MM_SHUFFLE(3, 3, 1, 1));
+            yuvToRgbSSE(y, FORMAT == OB_FORMAT_NV12 ? c0 : c1, FORMAT == OB_FORMAT_NV12 ? c1 : c0, divCoeff, r, g, b);
+            return;
         }
-        else {
-            x = 0.0;
-            y = 0.0;
-            z = 0.0;
-            r = 0.0;
-            g = 0.0;
-            b = 0.0;
+
+        // the pixels span 2 rows
+        float u[4], v[4];
+        for(int k = 0; k < 4; k++, col++) {
+            if(col == width_) {
+                col = 0;
+                row++;
+            }
+            auto chroma = chromaIndex(row, col);
+            u[k]        = data_[uOffset_ + chroma];
+            v[k]        = data_[vOffset_ + chroma];
         }
+        yuvToRgbSSE(y, _mm_loadu_ps(u), _mm_loadu_ps(v), divCoeff, r, g, b);
+    }
+
+private:
+    static inline __m128 bytesToFloatSSE(int32_t bytes) {
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), _mm_setzero_si128()), _mm_setzero_si128()));
+    }
+
+    inline int chromaIndex(int row, int col) const {
+        return FORMAT == OB_FORMAT_I420 ? (row / 2) * (width_ / 2) + col / 2 : (row / 2) * width_ + (col & ~1);
+    }
+
+    const uint8_t *data_;
+    int            width_;
+    uint64_t       rowDivMagic_;  // i / width is (i * rowDivMagic_) >> 40 for the pixel indexes below 2^40 / width
+    int            uOffset_;      // offset of the first u
+    int            vOffset_;      // offset of the first v
+};
+
+// Call kernel(sampler) with the sampler of the color image format, the sampler is a template parameter of the kernel so the format is resolved once
+template <typename Result, typename Kernel> static Result withRGBDColorSampler(const RGBDColorImage &image, const Kernel &kernel) {
+    switch(image.format) {
+    case OB_FORMAT_YUYV:
+        return kernel(Packed422ColorSampler<false>(image));
+    case OB_FORMAT_UYVY:
+        return kernel(Packed422ColorSampler<true>(image));
+    case OB_FORMAT_NV12:
+        return kernel(Planar420ColorSampler<OB_FORMAT_NV12>(image));
+    case OB_FORMAT_NV21:
+        return kernel(Planar420ColorSampler<OB_FORMAT_NV21>(image));
+    case OB_FORMAT_I420:
+        return kernel(Planar420ColorSampler<OB_FORMAT_I420>(image));
+    default:
+        return kernel(RGBColorSampler(image));
+    }
+}
 
-        xyzrgbData[6 * i + 0] = x;
-        xyzrgbData[6 * i + 1] = y;
-        xyzrgbData[6 * i + 2] = z;
-        xyzrgbData[6 * i + 3] = r;
-        xyzrgbData[6 * i + 4] = g;
-        xyzrgbData[6 * i + 5] = b;
+template <typename ColorSampler>
+static void depthToRGBDPointCloudBand(const DepthToPointParam &param, const ColorSampler &color, float colorDivCoeff, float *xyzrgbData, int begin, int end) {
+    __m128  divCoeff = _mm_set1_ps(colorDivCoeff);
+    uint8_t buf[3];
+    int     i = begin;
+    for(; i + 4 <= end; i += 4) {
+        __m128 x, y, z, r, g, b;
+        __m128 valid = depthToPointSSE(param, i, x, y, z);
+        color.sample4(i, divCoeff, r, g, b);
+        storeXYZRGB(xyzrgbData + 6 * i, x, y, z, _mm_and_ps(r, valid), _mm_and_ps(g, valid), _mm_and_ps(b, valid));
+    }
+    for(; i < end; i++) {
+        float *dst = xyzrgbData + 6 * i;
+        depthToPoint(param, i, dst[0], dst[1], dst[2]);
+        bool valid = !std::isnan(param.xTable[i]) && param.depth[i] != 65535;
+        auto rgb   = color.sample(i, buf);
+        dst[3]     = valid ? rgb[0] / colorDivCoeff : 0.0f;
+        dst[4]     = valid ? rgb[1] / colorDivCoeff : 0.0f;
+        dst[5]     = valid ? rgb[2] / colorDivCoeff : 0.0f;
     }
 }
 
+// The compact layout only keeps the valid points: the x table is not NaN and the depth is not 0 or 65535
+static inline bool isCompactPointValid(const DepthToPointParam &param, int i) {
+    return !std::isnan(param.xTable[i]) && param.depth[i] != 0 && param.depth[i] != 65535;
+}
+
+// Bit k is set if the point i + k is valid
+static inline int compactPointValidMaskSSE(const DepthToPointParam &param, int i) {
+    __m128i depth32 = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(param.depth + i)), _mm_setzero_si128());
+    __m128i invalid = _mm_or_si128(_mm_cmpeq_epi32(depth32, _mm_setzero_si128()), _mm_cmpeq_epi32(depth32, _mm_set1_epi32(65535)));
+    __m128  xTab    = _mm_loadu_ps(param.xTable + i);
+    return _mm_movemask_ps(_mm_andnot_ps(_mm_castsi128_ps(invalid), _mm_cmpord_ps(xTab, xTab)));
+}
+
+static uint32_t countCompactPoints(const DepthToPointParam &param, int begin, int end) {
+    static const uint8_t bitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+    uint32_t count = 0;
+    int      i     = begin;
+    for(; i + 4 <= end; i += 4) {
+        count += bitCount[compactPointValidMaskSSE(param, i)];
+    }
+    for(; i < end; i++) {
+        count += isCompactPointValid(param, i) ? 1 : 0;
+    }
+    return count;
+}
+
+// Write the valid points of [begin, end) from the offset-th point of the output, return the number of points written
+static uint32_t depthToCompactPointCloudBand(const DepthToPointParam &param, float *xyzData, uint32_t *indexData, int begin, int end, uint32_t offset) {
+    float    *dst   = xyzData + 3 * offset;
+    uint32_t *index = indexData ? indexData + offset : nullptr;
+    int       i     = begin;
+    for(; i + 4 <= end; i += 4) {
+        int mask = compactPointValidMaskSSE(param, i);
+        if(mask == 0) {
+            continue;
+        }
+
+        __m128 x, y, z;
+        depthToPointSSE(param, i, x, y, z);
+        if(mask == 0xf) {
+            storeXYZ(dst, x, y, z);
+            dst += 12;
+            if(index) {
+                _mm_storeu_si128((__m128i *)index, _mm_add_epi32(_mm_set1_epi32(i), _mm_setr_epi32(0, 1, 2, 3)));
+                index += 4;
+            }
+            continue;
+        }
+
+        float xyz[12];
+        storeXYZ(xyz, x, y, z);
+        for(int k = 0; k < 4; k++) {
+            if(mask & (1 << k)) {
+                memcpy(dst, xyz + 3 * k, 3 * sizeof(float));
+                dst += 3;
+                if(index) {
+                    *index++ = static_cast<uint32_t>(i + k);
+                }
+            }
+        }
+    }
+    for(; i < end; i++) {
+        if(isCompactPointValid(param, i)) {
+            depthToPoint(param, i, dst[0], dst[1], dst[2]);
+            dst += 3;
+            if(index) {
+                *index++ = static_cast<uint32_t>(i);
+            }
+        }
+    }
+    return static_cast<uint32_t>((dst - xyzData) / 3) - offset;
+}
+
+template <typename ColorSampler>
+static uint32_t depthToCompactRGBDPointCloudBand(const DepthToPointParam &param, const ColorSampler &color, float colorDivCoeff, float *xyzrgbData,
+                                                 uint32_t *indexData, int begin, int end, uint32_t offset) {
+    __m128    divCoeff = _mm_set1_ps(colorDivCoeff);
+    float    *dst      = xyzrgbData + 6 * offset;
+    uint32_t *index    = indexData ? indexData + offset : nullptr;
+    uint8_t   buf[3];
+    int       i = begin;
+    for(; i + 4 <= end; i += 4) {
+        int mask = compactPointValidMaskSSE(param, i);
+        if(mask == 0) {
+            continue;
+        }
+
+        __m128 x, y, z, r, g, b;
+        depthToPointSSE(param, i, x, y, z);
+        color.sample4(i, divCoeff, r, g, b);
+        if(mask == 0xf) {
+            storeXYZRGB(dst, x, y, z, r, g, b);
+            dst += 24;
+            if(index) {
+                _mm_storeu_si128((__m128i *)index, _mm_add_epi32(_mm_set1_epi32(i), _mm_setr_epi32(0, 1, 2, 3)));
+                index += 4;
+            }
+            continue;
+        }
+
+        float xyzrgb[24];
+        storeXYZRGB(xyzrgb, x, y, z, r, g, b);
+        for(int k = 0; k < 4; k++) {
+            if(mask & (1 << k)) {
+                memcpy(dst, xyzrgb + 6 * k, 6 * sizeof(float));
+                dst += 6;
+                if(index) {
+                    *index++ = static_cast<uint32_t>(i + k);
+                }
+            }
+        }
+    }
+    for(; i < end; i++) {
+        if(isCompactPointValid(param, i)) {
+            depthToPoint(param, i, dst[0], dst[1], dst[2]);
+            auto rgb = color.sample(i, buf);
+            dst[3]   = rgb[0] / colorDivCoeff;
+            dst[4]   = rgb[1] / colorDivCoeff;
+            dst[5]   = rgb[2] / colorDivCoeff;
+            dst += 6;
+            if(index) {
+                *index++ = static_cast<uint32_t>(i);
+            }
+        }
+    }
+    return static_cast<uint32_t>((dst - xyzrgbData) / 6) - offset;
+}
+
+// The valid points of each band are counted first, so that each band writes its points from its own offset of the output and no compaction copy is
+// needed. func(begin, end, offset) returns the number of points written.
+static uint32_t forEachCompactPointCloudBand(TaskExecutor *executor, const DepthToPointParam &param, int width, int height,
+                                             const std::function<uint32_t(int, int, uint32_t)> &func) {
+    int bandCount = getPointCloudBandCount(executor, height);
+    if(bandCount == 1) {
+        return func(0, width * height, 0);
+    }
+
+    std::vector<uint32_t> offsets(bandCount + 1, 0);
+    executor->parallelFor(static_cast<uint32_t>(bandCount), [&](uint32_t index) {
+        int begin, end;
+        getPointCloudBandRange(static_cast<int>(index), bandCount, width, height, begin, end);
+        offsets[index + 1] = countCompactPoints(param, begin, end);
+    });
+    for(int i = 0; i < bandCount; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    executor->parallelFor(static_cast<uint32_t>(bandCount), [&](uint32_t index) {
+        int begin, end;
+        getPointCloudBandRange(static_cast<int>(index), bandCount, width, height, begin, end);
+        func(begin, end, offsets[index]);
+    });
+    return offsets[bandCount];
+}
+
+#if defined(OB_AVX2_AVAILABLE)
+// The AVX2 kernels compute 8 points at once, no FMA is used so that the results are the same as the SSE kernels
+static inline OB_AVX2_TARGET void depthToPointAVX2(const DepthToPointParam &param, int i, __m256 &x, __m256 &y, __m256 &z) {
+    __m256i depth32 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(param.depth + i)));
+    __m256  depth   = _mm256_cvtepi32_ps(depth32);
+    __m256  xTab    = _mm256_loadu_ps(param.xTable + i);
+    __m256  valid   = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(depth32, _mm256_set1_epi32(65535))), _mm256_cmp_ps(xTab, xTab, _CMP_ORD_Q));
+    __m256  scale   = _mm256_set1_ps(param.scale);
+
+    x = _mm256_and_ps(_mm256_mul_ps(_mm256_mul_ps(xTab, depth), scale), valid);
+    y = _mm256_and_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(param.yTable + i), depth), _mm256_set1_ps(param.yCoeff)), scale), valid);
+    z = _mm256_and_ps(_mm256_mul_ps(depth, scale), valid);
+}
+
+static OB_AVX2_TARGET void depthToPointCloudBandAVX2(const DepthToPointParam &param, float *xyzData, int begin, int end) {
+    int i = begin;
+    for(; i + 8 <= end; i += 8) {
+        __m256 x, y, z;
+        depthToPointAVX2(param, i, x, y, z);
+        storeXYZ(xyzData + 3 * i, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+        storeXYZ(xyzData + 3 * i + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+    }
+    depthToPointCloudBand(param, xyzData, i, end);
+}
+
+static OB_AVX2_TARGET void depthToPlanarPointCloudBandAVX2(const DepthToPointParam &param, float *xData, float *yData, float *zData, int begin, int end) {
+    int i = begin;
+    for(; i + 8 <= end; i += 8) {
+        __m256 x, y, z;
+        depthToPointAVX2(param, i, x, y, z);
+        _mm256_storeu_ps(xData + i, x);
+        _mm256_storeu_ps(yData + i, y);
+        _mm256_storeu_ps(zData + i, z);
+    }
+    depthToPlanarPointCloudBand(param, xData, yData, zData, i, end);
+}
+
+static OB_AVX2_F16C_TARGET void depthToHalfPointCloudBandF16C(const DepthToPointParam &param, uint16_t *xyzData, int begin, int end) {
+    int i = begin;
+    for(; i + 8 <= end; i += 8) {
+        __m256 x, y, z;
+        depthToPointAVX2(param, i, x, y, z);
+        uint16_t half[3][8];
+        _mm_storeu_si128((__m128i *)half[0], _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128((__m128i *)half[1], _mm256_cvtps_ph(y, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128((__m128i *)half[2], _mm256_cvtps_ph(z, _MM_FROUND_TO_NEAREST_INT));
+        uint16_t *dst = xyzData + 3 * i;
+        for(int k = 0; k < 8; k++) {
+            dst[3 * k + 0] = half[0][k];
+            dst[3 * k + 1] = half[1][k];
+            dst[3 * k + 2] = half[2][k];
+        }
+    }
+    depthToHalfPointCloudBand(param, xyzData, i, end);
+}
+#endif
+
+static DepthToPointParam makeDepthToPointParam(OBXYTables *xyTables, const void *depthImageData, float positionDataScale, OBCoordinateSystemType type) {
+    DepthToPointParam param;
+    param.xTable = xyTables->xTable;
+    param.yTable = xyTables->yTable;
+    param.depth  = (const uint16_t *)depthImageData;
+    param.scale  = positionDataScale;
+    param.yCoeff = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1.0f : 1.0f;
+    return param;
+}
+
+void CoordinateUtil::transformationDepthToPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, float positionDataScale,
+                                                     OBCoordinateSystemType type, TaskExecutor *executor) {
+    auto  param   = makeDepthToPointParam(xyTables, depthImageData, positionDataScale, type);
+    auto *xyzData = (float *)pointCloudData;
+#if defined(OB_AVX2_AVAILABLE)
+    if(utils::isAVX2Supported()) {
+        forEachPointCloudBand(executor, xyTables->width, xyTables->height,
+                              [&](int begin, int end) { depthToPointCloudBandAVX2(param, xyzData, begin, end); });
+        return;
+    }
+#endif
+    forEachPointCloudBand(executor, xyTables->width, xyTables->height, [&](int begin, int end) { depthToPointCloudBand(param, xyzData, begin, end); });
+}
+
+void CoordinateUtil::transformationDepthToPlanarPointCloud(OBXYTables *xyTables, const void *depthImageData, float *xData, float *yData, float *zData,
+                                                           float positionDataScale, OBCoordinateSystemType type, TaskExecutor *executor) {
+    auto param = makeDepthToPointParam(xyTables, depthImageData, positionDataScale, type);
+#if defined(OB_AVX2_AVAILABLE)
+    if(utils::isAVX2Supported()) {
+        forEachPointCloudBand(executor, xyTables->width, xyTables->height,
+                              [&](int begin, int end) { depthToPlanarPointCloudBandAVX2(param, xData, yData, zData, begin, end); });
+        return;
+    }
+#endif
+    forEachPointCloudBand(executor, xyTables->width, xyTables->height,
+                          [&](int begin, int end) { depthToPlanarPointCloudBand(param, xData, yData, zData, begin, end); });
+}
+
+void CoordinateUtil::transformationDepthToHalfPointCloud(OBXYTables *xyTables, const void *depthImageData, uint16_t *pointCloudData, float positionDataScale,
+                                                         OBCoordinateSystemType type, TaskExecutor *executor) {
+    auto param = makeDepthToPointParam(xyTables, depthImageData, positionDataScale, type);
+#if defined(OB_AVX2_AVAILABLE)
+    if(utils::isAVX2F16CSupported()) {
+        forEachPointCloudBand(executor, xyTables->width, xyTables->height,
+                              [&](int begin, int end) { depthToHalfPointCloudBandF16C(param, pointCloudData, begin, end); });
+        return;
+    }
+#endif
+    forEachPointCloudBand(executor, xyTables->width, xyTables->height,
+                          [&](int begin, int end) { depthToHalfPointCloudBand(param, pointCloudData, begin, end); });
+}
+
+void CoordinateUtil::transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData, void *pointCloudData,
+                                                         float positionDataScale, OBCoordinateSystemType type, bool colorDataNormalization,
+                                                         TaskExecutor *executor) {
+    RGBDColorImage colorImage = { OB_FORMAT_RGB, (const uint8_t *)colorImageData, xyTables->width, xyTables->height };
+    transformationDepthToRGBDPointCloud(xyTables, depthImageData, colorImage, pointCloudData, positionDataScale, type, colorDataNormalization, executor);
+}
+
+struct RGBDPointCloudKernel {
+    const DepthToPointParam &param;
+    float                    colorDivCoeff;
+    float                   *xyzrgbData;
+    OBXYTables              *xyTables;
+    TaskExecutor            *executor;
+
+    template <typename ColorSampler> void operator()(const ColorSampler &color) const {
+        forEachPointCloudBand(executor, xyTables->width, xyTables->height,
+                              [&](int begin, int end) { depthToRGBDPointCloudBand(param, color, colorDivCoeff, xyzrgbData, begin, end); });
+    }
+};
+
+void CoordinateUtil::transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const RGBDColorImage &colorImage,
+                                                         void *pointCloudData, float positionDataScale, OBCoordinateSystemType type, bool colorDataNormalization,
+                                                         TaskExecutor *executor) {
+    auto                 param  = makeDepthToPointParam(xyTables, depthImageData, positionDataScale, type);
+    RGBDPointCloudKernel kernel = { param, colorDataNormalization ? 255.0f : 1.0f, (float *)pointCloudData, xyTables, executor };
+    withRGBDColorSampler<void>(colorImage, kernel);
+}
+
+uint32_t CoordinateUtil::transformationDepthToCompactPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, uint32_t *pointIndexData,
+                                                               float positionDataScale, OBCoordinateSystemType type, TaskExecutor *executor) {
+    auto  param   = makeDepthToPointParam(xyTables, depthImageData, positionDataScale, type);
+    auto *xyzData = (float *)pointCloudData;
+    return forEachCompactPointCloudBand(executor, param, xyTables->width, xyTables->height, [&](int begin, int end, uint32_t offset) {
+        return depthToCompactPointCloudBand(param, xyzData, pointIndexData, begin, end, offset);
+    });
+}
+
+uint32_t CoordinateUtil::transformationDepthToCompactRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData,
+                                                                   void *pointCloudData, uint32_t *pointIndexData, float positionDataScale,
+                                                                   OBCoordinateSystemType type, bool colorDataNormalization, TaskExecutor *executor) {
+    RGBDColorImage colorImage = { OB_FORMAT_RGB, (const uint8_t *)colorImageData, xyTables->width, xyTables->height };
+    return transformationDepthToCompactRGBDPointCloud(xyTables, depthImageData, colorImage, pointCloudData, pointIndexData, positionDataScale, type,
+                                                      colorDataNormalization, executor);
+}
+
+struct CompactRGBDPointCloudKernel {
+    const DepthToPointParam &param;
+    float                    colorDivCoeff;
+    float                   *xyzrgbData;
+    uint32_t                *pointIndexData;
+    OBXYTables              *xyTables;
+    TaskExecutor            *executor;
+
+    template <typename ColorSampler> uint32_t operator()(const ColorSampler &color) const {
+        return forEachCompactPointCloudBand(executor, param, xyTables->width, xyTables->height, [&](int begin, int end, uint32_t offset) {
+            return depthToCompactRGBDPointCloudBand(param, color, colorDivCoeff, xyzrgbData, pointIndexData, begin, end, offset);
+        });
+    }
+};
+
+uint32_t CoordinateUtil::transformationDepthToCompactRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const RGBDColorImage &colorImage,
+                                                                   void *pointCloudData, uint32_t *pointIndexData, float positionDataScale,
+                                                                   OBCoordinateSystemType type, bool colorDataNormalization, TaskExecutor *executor) {
+    auto                        param  = makeDepthToPointParam(xyTables, depthImageData, positionDataScale, type);
+    CompactRGBDPointCloudKernel kernel = { param, colorDataNormalization ? 255.0f : 1.0f, (float *)pointCloudData, pointIndexData, xyTables, executor };
+    return withRGBDColorSampler<uint32_t>(colorImage, kernel);
+}
+
+// The x y z r g b of the i-th depth pixel, the color is sampled at the pixel given by the uv tables. Return false and write zeros if the point is invalid.
+template <typename ColorSampler>
+static inline bool depthToRGBDPointByUVTables(const OBCameraIntrinsic &rgbIntrinsic, const OBXYTables *uvTables, const uint16_t *dImageData,
+                                              const ColorSampler &color, int i, int coordinateSystemCoefficient, float positionDataScale, float colorDivCoeff,
+                                              float *xyzrgbData) {
+    int xValue = i % uvTables->width;
+    int yValue = i / uvTables->width;
+
+    uint16_t depthValue = dImageData[i];
+    if(std::isnan(uvTables->xTable[i]) || depthValue == 65535) {
+        memset(xyzrgbData, 0, 6 * sizeof(float));
+        return false;
+    }
+
+    float z = (float)depthValue;
+    float x = ((xValue - rgbIntrinsic.cx) / rgbIntrinsic.fx) * (float)z;
+    float y = ((yValue - rgbIntrinsic.cy) / rgbIntrinsic.fy) * (float)z * coordinateSystemCoefficient;
+
+    int u_rgb   = (int)round(uvTables->xTable[i]);
+    int v_rgb   = (int)round(uvTables->yTable[i]);
+    int idx_rgb = v_rgb * uvTables->width + u_rgb;
+
+    uint8_t buf[3];
+    auto    rgb = color.sample(idx_rgb, buf);
+
+    xyzrgbData[0] = x * positionDataScale;
+    xyzrgbData[1] = y * positionDataScale;
+    xyzrgbData[2] = z * positionDataScale;
+    xyzrgbData[3] = rgb[0] / colorDivCoeff;
+    xyzrgbData[4] = rgb[1] / colorDivCoeff;
+    xyzrgbData[5] = rgb[2] / colorDivCoeff;
+    return true;
+}
+
 void CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
                                                                    const void *colorImageData, void *pointCloudData, float positionDataScale,
                                                                    OBCoordinateSystemType type, bool colorDataNormalization) {
-    const uint16_t *dImageData = (const uint16_t *)depthImageData;
-    const uint8_t  *cImageData = (const uint8_t *)colorImageData;
-    float          *xyzrgbData = (float *)pointCloudData;
-    float           x, y, z;
-    float           r, g, b;
-    int             coordinateSystemCoefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
-    float           colorDivCoeff               = colorDataNormalization ? 255.0f : 1.0f;
-
-    for(int i = 0; i < uvTables->width * uvTables->height; i++) {
-        // int u_tab = (int)uvTables->xTable[i];
-        // int v_tab = (int)uvTables->yTable[i];
-
-        int xValue = i % uvTables->width;
-        int yValue = i / uvTables->width;
-
-        uint16_t depthValue = dImageData[i];
-        if(!std::isnan(uvTables->xTable[i]) && depthValue != 65535) {
-            z = (float)depthValue;
-            x = ((xValue - rgbIntrinsic.cx) / rgbIntrinsic.fx) * (float)z;
-            y = ((yValue - rgbIntrinsic.cy) / rgbIntrinsic.fy) * (float)z * coordinateSystemCoefficient;
-
-            z *= positionDataScale;
-            x *= positionDataScale;
-            y *= positionDataScale;
-
-            int u_rgb   = (int)round(uvTables->xTable[i]);
-            int v_rgb   = (int)round(uvTables->yTable[i]);
-            int idx_rgb = v_rgb * uvTables->width + u_rgb;
-
-            r = cImageData[3 * idx_rgb + 0] / colorDivCoeff;
-            g = cImageData[3 * idx_rgb + 1] / colorDivCoeff;
-            b = cImageData[3 * idx_rgb + 2] / colorDivCoeff;
-        }
-        else {
-            x = (int)0.0;
-            y = (int)0.0;
-            z = 0.0;
-            r = 0.0;
-            g = 0.0;
-            b = 0.0;
-        }
+    RGBDColorImage colorImage = { OB_FORMAT_RGB, (const uint8_t *)colorImageData, uvTables->width, uvTables->height };
+    transformationDepthToRGBDPointCloudByUVTables(rgbIntrinsic, uvTables, depthImageData, colorImage, pointCloudData, positionDataScale, type,
+                                                  colorDataNormalization);
+}
 
-        xyzrgbData[6 * i + 0] = (float)x;
-        xyzrgbData[6 * i + 1] = (float)y;
-        xyzrgbData[6 * i + 2] = z;
-        xyzrgbData[6 * i + 3] = r;
-        xyzrgbData[6 * i + 4] = g;
-        xyzrgbData[6 * i + 5] = b;
+// Organized point cloud if pointIndexData is null and compact is false
+struct RGBDPointCloudByUVTablesKernel {
+    const OBCameraIntrinsic &rgbIntrinsic;
+    const OBXYTables        *uvTables;
+    const uint16_t          *dImageData;
+    float                   *xyzrgbData;
+    uint32_t                *pointIndexData;
+    bool                     compact;
+    int                      coordinateSystemCoefficient;
+    float                    positionDataScale;
+    float                    colorDivCoeff;
+
+    template <typename ColorSampler> uint32_t operator()(const ColorSampler &color) const {
+        uint32_t count = 0;
+        for(int i = 0; i < uvTables->width * uvTables->height; i++) {
+            if(!compact) {
+                depthToRGBDPointByUVTables(rgbIntrinsic, uvTables, dImageData, color, i, coordinateSystemCoefficient, positionDataScale, colorDivCoeff,
+                                           xyzrgbData + 6 * i);
+                continue;
+            }
+            if(dImageData[i] == 0) {
+                continue;
+            }
+            if(depthToRGBDPointByUVTables(rgbIntrinsic, uvTables, dImageData, color, i, coordinateSystemCoefficient, positionDataScale, colorDivCoeff,
+                                          xyzrgbData + 6 * count)) {
+                if(pointIndexData) {
+                    pointIndexData[count] = static_cast<uint32_t>(i);
+                }
+                count++;
+            }
+        }
+        return count;
     }
+};
+
+void CoordinateUtil::transformationDepthToRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
+                                                                   const RGBDColorImage &colorImage, void *pointCloudData, float positionDataScale,
+                                                                   OBCoordinateSystemType type, bool colorDataNormalization) {
+    RGBDPointCloudByUVTablesKernel kernel = { rgbIntrinsic,
+                                              uvTables,
+                                              (const uint16_t *)depthImageData,
+                                              (float *)pointCloudData,
+                                              nullptr,
+                                              false,
+                                              type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1,
+                                              positionDataScale,
+                                              colorDataNormalization ? 255.0f : 1.0f };
+    withRGBDColorSampler<uint32_t>(colorImage, kernel);
+}
+
+uint32_t CoordinateUtil::transformationDepthToCompactRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables,
+                                                                             const void *depthImageData, const void *colorImageData, void *pointCloudData,
+                                                                             uint32_t *pointIndexData, float positionDataScale, OBCoordinateSystemType type,
+                                                                             bool colorDataNormalization) {
+    RGBDColorImage colorImage = { OB_FORMAT_RGB, (const uint8_t *)colorImageData, uvTables->width, uvTables->height };
+    return transformationDepthToCompactRGBDPointCloudByUVTables(rgbIntrinsic, uvTables, depthImageData, colorImage, pointCloudData, pointIndexData,
+                                                                positionDataScale, type, colorDataNormalization);
+}
+
+uint32_t CoordinateUtil::transformationDepthToCompactRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables,
+                                                                             const void *depthImageData, const RGBDColorImage &colorImage, void *pointCloudData,
+                                                                             uint32_t *pointIndexData, float positionDataScale, OBCoordinateSystemType type,
+                                                                             bool colorDataNormalization) {
+    RGBDPointCloudByUVTablesKernel kernel = { rgbIntrinsic,
+                                              uvTables,
+                                              (const uint16_t *)depthImageData,
+                                              (float *)pointCloudData,
+                                              pointIndexData,
+                                              true,
+                                              type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1,
+                                              positionDataScale,
+                                              colorDataNormalization ? 255.0f : 1.0f };
+    return withRGBDColorSampler<uint32_t>(colorImage, kernel);
+}
+
+bool CoordinateUtil::isRGBDColorFormatSupported(OBFormat format) {
+    return format == OB_FORMAT_RGB || format == OB_FORMAT_YUYV || format == OB_FORMAT_UYVY || format == OB_FORMAT_NV12 || format == OB_FORMAT_NV21
+           || format == OB_FORMAT_I420;
 }
 
 }  // namespace libobsensor
@@ -12,6 +12,18 @@ namespace libobsensor {
 #define EPS 1e-4
 #define FMAX 1e4
 
+class TaskExecutor;
+
+// Color image sampled by the RGBD point cloud functions. The color image has the resolution of the depth image (eg. aligned by D2C).
+// The YUV formats (YUYV, UYVY, NV12, NV21 and I420) are converted to rgb (BT.601 limited range) only at the sampled pixels, so the color image does not
+// need to be converted to RGB first.
+struct RGBDColorImage {
+    OBFormat       format;
+    const uint8_t *data;
+    int            width;
+    int            height;
+};
+
 class CoordinateUtil {
 public:
     static bool transformation3dTo3d(const OBPoint3f sourcePoint3f, OBD2CTransform transSourceToTarget, OBPoint3f *targetPoint3f);
@@ -46,16 +58,66 @@ public:
     static bool transformationInitAddDistortionUVTables(const OBCameraIntrinsic intrinsic, const OBCameraDistortion distortion, float *data, uint32_t *dataSize,
                                                         OBXYTables *uvTables);
 
+    // The point cloud functions are vectorized (SSE/NEON, AVX2 if supported by the CPU). If executor is not null, the frame is split into row bands
+    // processed on the executor and the calling thread.
     static void transformationDepthToPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, float positionDataScale = 1.0f,
-                                                OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM);
+                                                OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, TaskExecutor *executor = nullptr);
+
+    // Planar (SoA) layout: the x, y and z planes of width * height floats each
+    static void transformationDepthToPlanarPointCloud(OBXYTables *xyTables, const void *depthImageData, float *xData, float *yData, float *zData,
+                                                      float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                      TaskExecutor *executor = nullptr);
+
+    // Interleaved xyz as IEEE 754 half floats (6 bytes per point), the scale should keep the values in the half float range (eg. meter)
+    static void transformationDepthToHalfPointCloud(OBXYTables *xyTables, const void *depthImageData, uint16_t *pointCloudData, float positionDataScale = 1.0f,
+                                                    OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, TaskExecutor *executor = nullptr);
 
     static void transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData, void *pointCloudData,
                                                     float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM,
-                                                    bool colorDataNormalization = false);
+                                                    bool colorDataNormalization = false, TaskExecutor *executor = nullptr);
+
+    // Compact layout: only the valid points (the x table is not NaN and the depth is not 0 or 65535) are written, in pixel order. Return the number of
+    // points written. If pointIndexData is not null, the pixel index (v * width + u) of each point is written to it as well.
+    static uint32_t transformationDepthToCompactPointCloud(OBXYTables *xyTables, const void *depthImageData, void *pointCloudData, uint32_t *pointIndexData,
+                                                           float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                           TaskExecutor *executor = nullptr);
+
+    static uint32_t transformationDepthToCompactRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const void *colorImageData,
+                                                               void *pointCloudData, uint32_t *pointIndexData, float positionDataScale = 1.0f,
+                                                               OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool colorDataNormalization = false,
+                                                               TaskExecutor *executor = nullptr);
 
     static void transformationDepthToRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
                                                               const void *colorImageData, void *pointCloudData, float positionDataScale = 1.0f,
                                                               OBCoordinateSystemType type                   = OB_RIGHT_HAND_COORDINATE_SYSTEM,
                                                               bool                   colorDataNormalization = false);
+
+    static uint32_t transformationDepthToCompactRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
+                                                                         const void *colorImageData, void *pointCloudData, uint32_t *pointIndexData,
+                                                                         float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                                         bool colorDataNormalization = false);
+
+    // The RGBD point cloud functions above with the color sampled from a color image of any format supported by isRGBDColorFormatSupported().
+    // The functions taking colorImageData expect an RGB image.
+    static bool isRGBDColorFormatSupported(OBFormat format);
+
+    static void transformationDepthToRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const RGBDColorImage &colorImage, void *pointCloudData,
+                                                    float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                    bool colorDataNormalization = false, TaskExecutor *executor = nullptr);
+
+    static uint32_t transformationDepthToCompactRGBDPointCloud(OBXYTables *xyTables, const void *depthImageData, const RGBDColorImage &colorImage,
+                                                               void *pointCloudData, uint32_t *pointIndexData, float positionDataScale = 1.0f,
+                                                               OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM, bool colorDataNormalization = false,
+                                                               TaskExecutor *executor = nullptr);
+
+    static void transformationDepthToRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
+                                                              const RGBDColorImage &colorImage, void *pointCloudData, float positionDataScale = 1.0f,
+                                                              OBCoordinateSystemType type                   = OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                              bool                   colorDataNormalization = false);
+
+    static uint32_t transformationDepthToCompactRGBDPointCloudByUVTables(const OBCameraIntrinsic rgbIntrinsic, OBXYTables *uvTables, const void *depthImageData,
+                                                                         const RGBDColorImage &colorImage, void *pointCloudData, uint32_t *pointIndexData,
+                                                                         float positionDataScale = 1.0f, OBCoordinateSystemType type = OB_RIGHT_HAND_COORDINATE_SYSTEM,
+                                                                         bool colorDataNormalization = false);
 };
 }  // namespace libobsensor
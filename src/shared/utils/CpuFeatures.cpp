@@ -0,0 +1,91 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "CpuFeatures.hpp"
+
+#if defined(OB_AVX2_AVAILABLE)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace libobsensor {
+namespace utils {
+
+#if defined(OB_AVX2_AVAILABLE)
+static void cpuid(unsigned int leaf, unsigned int subLeaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+    for(int i = 0; i < 4; i++) {
+        regs[i] = static_cast<unsigned int>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+struct CpuFeatureFlags {
+    bool avx2;
+    bool f16c;
+};
+
+static CpuFeatureFlags detectCpuFeatures() {
+    CpuFeatureFlags flags = { false, false };
+    unsigned int    regs[4];
+    cpuid(0, 0, regs);
+    if(regs[0] < 7) {
+        return flags;
+    }
+
+    cpuid(1, 0, regs);
+    bool avx     = (regs[2] & (1u << 28)) != 0;
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool f16c    = (regs[2] & (1u << 29)) != 0;
+    // the OS saves the XMM and YMM registers on context switch
+    if(!avx || !osxsave || (xgetbv0() & 0x6) != 0x6) {
+        return flags;
+    }
+
+    cpuid(7, 0, regs);
+    flags.avx2 = (regs[1] & (1u << 5)) != 0;
+    flags.f16c = flags.avx2 && f16c;
+    return flags;
+}
+
+static const CpuFeatureFlags &getCpuFeatures() {
+    static const CpuFeatureFlags flags = detectCpuFeatures();
+    return flags;
+}
+#endif
+
+bool isAVX2Supported() {
+#if defined(OB_AVX2_AVAILABLE)
+    return getCpuFeatures().avx2;
+#else
+    return false;
+#endif
+}
+
+bool isAVX2F16CSupported() {
+#if defined(OB_AVX2_AVAILABLE)
+    return getCpuFeatures().f16c;
+#else
+    return false;
+#endif
+}
+
+}  // namespace utils
+}  // namespace libobsensor
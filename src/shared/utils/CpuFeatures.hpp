@@ -0,0 +1,38 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// SIMD headers: SSE on x86, SSE emulated by NEON on ARM
+#if(defined(__ARM_NEON__) || defined(__aarch64__) || defined(__arm__))
+#include "SSE2NEON.h"
+#else
+#include <xmmintrin.h>
+#include <smmintrin.h>
+#endif
+
+// The AVX2 paths are compiled into the functions marked with OB_AVX2_TARGET (the rest of the code is compiled for the baseline instruction set), and
+// should only be called after checking utils::isAVX2Supported() at runtime.
+#if !(defined(__ARM_NEON__) || defined(__aarch64__) || defined(__arm__)) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define OB_AVX2_AVAILABLE
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define OB_AVX2_TARGET
+#define OB_AVX2_F16C_TARGET
+#else
+#define OB_AVX2_TARGET __attribute__((target("avx2")))
+#define OB_AVX2_F16C_TARGET __attribute__((target("avx2,f16c")))
+#endif
+#endif
+
+namespace libobsensor {
+namespace utils {
+
+// The CPU supports AVX2 and the OS saves the YMM registers, always false if the AVX2 paths are not compiled in
+bool isAVX2Supported();
+
+// The CPU supports AVX2 and the F16C half float conversion instructions
+bool isAVX2F16CSupported();
+
+}  // namespace utils
+}  // namespace libobsensor
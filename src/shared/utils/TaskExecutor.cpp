@@ -0,0 +1,237 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#include "TaskExecutor.hpp"
+
+#include "environment/EnvConfig.hpp"
+#include "logger/Logger.hpp"
+
+#include <exception>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace libobsensor {
+
+#define MIN_TASK_EXECUTOR_THREAD_COUNT 2  // a task may wait for another task (eg. flush a downstream queue), so at least 2 threads are required
+
+// The worker the current thread belongs to, used to push the tasks posted from a worker to its own queue
+static thread_local const void *currentExecutorState_ = nullptr;
+static thread_local uint32_t    currentWorkerIndex_   = 0;
+
+std::mutex                  TaskExecutor::instanceMutex_;
+std::weak_ptr<TaskExecutor> TaskExecutor::instanceWeakPtr_;
+
+std::shared_ptr<TaskExecutor> TaskExecutor::getSharedInstance() {
+    std::lock_guard<std::mutex> lock(instanceMutex_);
+    auto                        instance = instanceWeakPtr_.lock();
+    if(instance) {
+        return instance;
+    }
+
+    auto envConfig = EnvConfig::getInstance();
+    bool enable    = false;
+    envConfig->getBooleanValue("Misc.SharedTaskExecutorEnable", enable);
+    if(!enable) {
+        return nullptr;
+    }
+
+    int  threadCount = 0;
+    bool pinThreads  = false;
+    envConfig->getIntValue("Misc.SharedTaskExecutorThreadCount", threadCount);
+    envConfig->getBooleanValue("Misc.SharedTaskExecutorCorePinning", pinThreads);
+    if(threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+
+    instance         = std::make_shared<TaskExecutor>(static_cast<uint32_t>(threadCount), pinThreads);
+    instanceWeakPtr_ = instance;
+    return instance;
+}
+
+TaskExecutor::TaskExecutor(uint32_t threadCount, bool pinThreads) : state_(std::make_shared<SharedState>()), nextQueue_(0) {
+    if(threadCount < MIN_TASK_EXECUTOR_THREAD_COUNT) {
+        threadCount = MIN_TASK_EXECUTOR_THREAD_COUNT;
+    }
+    for(uint32_t i = 0; i < threadCount; i++) {
+        state_->queues.emplace_back(new WorkerQueue());
+    }
+    uint32_t coreCount = std::thread::hardware_concurrency();
+    if(coreCount == 0) {
+        coreCount = 1;
+    }
+    for(uint32_t i = 0; i < threadCount; i++) {
+        threads_.emplace_back(&TaskExecutor::workerLoop, state_, i);
+        if(pinThreads) {
+            pinThreadToCore(threads_.back(), i % coreCount);
+        }
+    }
+    LOG_DEBUG("TaskExecutor created! thread count: {}, core pinning: {}", threadCount, pinThreads);
+}
+
+TaskExecutor::~TaskExecutor() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(state_->sleepMutex);
+        state_->stopping = true;
+    }
+    state_->sleepCv.notify_all();
+    for(auto &thread: threads_) {
+        if(thread.get_id() == std::this_thread::get_id()) {
+            // released on the worker itself, the worker exits by itself after the current task is done
+            thread.detach();
+            continue;
+        }
+        if(thread.joinable()) {
+            thread.join();
+        }
+    }
+    LOG_DEBUG("TaskExecutor destroyed!");
+}
+
+uint32_t TaskExecutor::getThreadCount() const {
+    return static_cast<uint32_t>(threads_.size());
+}
+
+void TaskExecutor::post(std::function<void()> task) {
+    uint32_t index;
+    if(currentExecutorState_ == state_.get()) {
+        index = currentWorkerIndex_;
+    }
+    else {
+        index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(state_->queues.size());
+    }
+
+    // count before pushing, so that the count never underflows when the task is taken by a worker immediately
+    state_->pendingTaskCount++;
+    {
+        auto                       &queue = *state_->queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // lock the sleep mutex to avoid losing the notification while a worker is going to sleep
+    { std::lock_guard<std::mutex> lock(state_->sleepMutex); }
+    state_->sleepCv.notify_one();
+}
+
+void TaskExecutor::parallelFor(uint32_t count, const std::function<void(uint32_t)> &func) {
+    if(count == 0) {
+        return;
+    }
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    uint32_t                remaining = count - 1;
+    for(uint32_t i = 1; i < count; i++) {
+        post([&, i]() {
+            try {
+                func(i);
+            }
+            catch(const std::exception &e) {
+                LOG_WARN("TaskExecutor: exception caught while running parallel task: {}", e.what());
+            }
+            catch(...) {
+                LOG_WARN("TaskExecutor: unknown exception caught while running parallel task");
+            }
+            // notify under the lock, the waiter may destroy the condition variable right after being woken up
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--remaining == 0) {
+                cv.notify_one();
+            }
+        });
+    }
+    // the posted tasks refer to the local variables, wait for them even if the first one throws
+    std::exception_ptr exception;
+    try {
+        func(0);
+    }
+    catch(...) {
+        exception = std::current_exception();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&remaining]() { return remaining == 0; });
+    }
+    if(exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+bool TaskExecutor::popTask(SharedState &state, uint32_t index, std::function<void()> &task) {
+    // 1. the oldest task of its own queue
+    {
+        auto                       &queue = *state.queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // 2. steal the newest task from the other queues
+    auto queueCount = static_cast<uint32_t>(state.queues.size());
+    for(uint32_t i = 1; i < queueCount; i++) {
+        auto                       &queue = *state.queues[(index + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskExecutor::workerLoop(std::shared_ptr<SharedState> state, uint32_t index) {
+    currentExecutorState_ = state.get();
+    currentWorkerIndex_   = index;
+    while(true) {
+        std::function<void()> task;
+        if(popTask(*state, index, task)) {
+            state->pendingTaskCount--;
+            try {
+                task();
+            }
+            catch(const std::exception &e) {
+                LOG_WARN("TaskExecutor: exception caught while running task: {}", e.what());
+            }
+            catch(...) {
+                LOG_WARN("TaskExecutor: unknown exception caught while running task");
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state->sleepMutex);
+        if(state->stopping && state->pendingTaskCount == 0) {
+            break;
+        }
+        state->sleepCv.wait(lock, [&state] { return state->pendingTaskCount > 0 || state->stopping; });
+    }
+    currentExecutorState_ = nullptr;
+}
+
+void TaskExecutor::pinThreadToCore(std::thread &thread, uint32_t core) {
+#if defined(_WIN32)
+    if(SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(1) << core) == 0) {
+        LOG_WARN("TaskExecutor: failed to pin thread to core {}", core);
+    }
+#elif defined(__linux__) && !defined(__ANDROID__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    if(pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) != 0) {
+        LOG_WARN("TaskExecutor: failed to pin thread to core {}", core);
+    }
+#else
+    (void)thread;
+    LOG_WARN("TaskExecutor: core pinning is not supported on this platform, core {} ignored", core);
+#endif
+}
+
+}  // namespace libobsensor
@@ -0,0 +1,69 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libobsensor {
+
+/**
+ * @brief Thread pool with per-thread task deques and work stealing.
+ *
+ * A task posted from a worker thread is pushed to the deque of that worker (so a chain of processing units tends to stay on the same core), a task
+ * posted from other threads is distributed round-robin. An idle worker steals tasks from the other workers before going to sleep.
+ *
+ * The tasks are not ordered between each other, the user should keep at most one task of an in-order stream scheduled at a time (see FrameQueue).
+ */
+class TaskExecutor {
+public:
+    TaskExecutor(uint32_t threadCount, bool pinThreads);
+    ~TaskExecutor() noexcept;
+
+    // The SDK-wide executor configured by Misc.SharedTaskExecutor*, return nullptr if the shared executor is disabled
+    static std::shared_ptr<TaskExecutor> getSharedInstance();
+
+    void     post(std::function<void()> task);
+    uint32_t getThreadCount() const;
+
+    // Run func(0) on the calling thread and func(1) ~ func(count - 1) on the workers, return after all of them are done. Used to split a frame into
+    // bands; should not be called from a task of the same executor, which may wait for itself.
+    void parallelFor(uint32_t count, const std::function<void(uint32_t)> &func);
+
+private:
+    struct WorkerQueue {
+        std::mutex                        mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // The state is shared with the worker threads, so that a worker can outlive the executor if the last reference of the executor is released
+    // on the worker itself.
+    struct SharedState {
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::mutex                                sleepMutex;
+        std::condition_variable                   sleepCv;
+        std::atomic<uint64_t>                     pendingTaskCount{ 0 };
+        std::atomic<bool>                         stopping{ false };
+    };
+
+    static void workerLoop(std::shared_ptr<SharedState> state, uint32_t index);
+    static bool popTask(SharedState &state, uint32_t index, std::function<void()> &task);
+    static void pinThreadToCore(std::thread &thread, uint32_t core);
+
+private:
+    std::shared_ptr<SharedState> state_;
+    std::vector<std::thread>     threads_;
+    std::atomic<uint32_t>        nextQueue_;
+
+    static std::mutex                  instanceMutex_;
+    static std::weak_ptr<TaskExecutor> instanceWeakPtr_;
+};
+
+}  // namespace libobsensor
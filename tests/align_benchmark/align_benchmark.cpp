@@ -0,0 +1,170 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Align a synthetic depth frame to a synthetic color camera with 1, 2, 4 and 8 threads (SSE and AVX2), report the time per frame and check that
+// the output is bit-exact with the single thread SSE alignment.
+// usage: align_benchmark [frame count]
+
+#include "AlignImpl.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+struct AlignCase {
+    std::string             name;
+    int                     depthWidth, depthHeight;
+    int                     colorWidth, colorHeight;
+    OBCameraDistortionModel model;
+    bool                    gapFillCopy;
+};
+
+static OBCameraIntrinsic makeIntrinsic(int width, int height, float fovScale) {
+    OBCameraIntrinsic intrin = {};
+    intrin.width             = static_cast<int16_t>(width);
+    intrin.height            = static_cast<int16_t>(height);
+    intrin.fx                = width * fovScale;
+    intrin.fy                = width * fovScale;
+    intrin.cx                = width / 2.f - 0.7f;
+    intrin.cy                = height / 2.f + 1.3f;
+    return intrin;
+}
+
+static OBCameraDistortion makeDistortion(OBCameraDistortionModel model) {
+    OBCameraDistortion disto = {};
+    disto.model              = model;
+    switch(model) {
+    case OB_DISTORTION_BROWN_CONRADY:
+        disto.k1 = 0.08f, disto.k2 = -0.12f, disto.k3 = 0.03f, disto.p1 = 0.0004f, disto.p2 = -0.0003f;
+        break;
+    case OB_DISTORTION_BROWN_CONRADY_K6:
+        disto.k1 = 0.45f, disto.k2 = -0.02f, disto.k3 = -0.01f, disto.k4 = 0.8f, disto.k5 = 0.1f, disto.k6 = -0.02f, disto.p1 = 0.0002f, disto.p2 = 0.0001f;
+        break;
+    case OB_DISTORTION_KANNALA_BRANDT4:
+        disto.k1 = 0.02f, disto.k2 = -0.004f, disto.k3 = 0.001f, disto.k4 = -0.0002f;
+        break;
+    default:
+        break;
+    }
+    return disto;
+}
+
+// Slanted planes with steps (occlusions) and holes, in millimeter
+static std::vector<uint16_t> makeDepth(int width, int height) {
+    std::vector<uint16_t> depth(width * height);
+    for(int v = 0; v < height; v++) {
+        for(int u = 0; u < width; u++) {
+            int value = 800 + u / 2 + v / 3;
+            if(((u / 64) + (v / 48)) % 3 == 0) {
+                value -= 300;
+            }
+            if((u * 7 + v * 13) % 97 == 0 || (u > width / 2 && u < width / 2 + 20)) {
+                value = 0;
+            }
+            depth[v * width + u] = static_cast<uint16_t>(value);
+        }
+    }
+    return depth;
+}
+
+static void initialize(AlignImpl &impl, const AlignCase &alignCase) {
+    OBCameraDistortion depthDisto = {};
+    depthDisto.model              = OB_DISTORTION_BROWN_CONRADY;
+    depthDisto.k1                 = 0.01f;
+    OBExtrinsic extrin            = { { 0.9998f, -0.0175f, 0.0052f, 0.0174f, 0.9998f, 0.0087f, -0.0054f, -0.0086f, 0.9999f }, { -32.5f, 0.4f, 1.2f } };
+    impl.initialize(makeIntrinsic(alignCase.depthWidth, alignCase.depthHeight, 0.8f), depthDisto,
+                    makeIntrinsic(alignCase.colorWidth, alignCase.colorHeight, 0.75f), makeDistortion(alignCase.model), extrin, 1.0f, true,
+                    alignCase.gapFillCopy);
+}
+
+int main(int argc, char **argv) {
+    int frameCount = argc > 1 ? std::atoi(argv[1]) : 30;
+    if(frameCount <= 0) {
+        frameCount = 30;
+    }
+
+    const AlignCase cases[] = {
+        { "640x576->1920x1080 BC", 640, 576, 1920, 1080, OB_DISTORTION_BROWN_CONRADY, false },
+        { "1280x800->1280x720 BC copy", 1280, 800, 1280, 720, OB_DISTORTION_BROWN_CONRADY, true },
+        { "1024x1024->1920x1080 K6", 1024, 1024, 1920, 1080, OB_DISTORTION_BROWN_CONRADY_K6, false },
+        { "640x480->1280x720 KB4", 640, 480, 1280, 720, OB_DISTORTION_KANNALA_BRANDT4, false },
+    };
+    const uint32_t threadCounts[] = { 1, 2, 4, 8 };
+
+    std::cout << "AVX2 supported: " << (AlignImpl::isAVX2Supported() ? "yes" : "no") << std::endl;
+    std::cout << std::left << std::setw(30) << "case" << std::setw(6) << "simd" << std::setw(9) << "threads" << std::setw(12) << "D2C ms" << std::setw(12)
+              << "C2D ms" << "bit-exact" << std::endl;
+
+    bool allMatch = true;
+    for(const auto &alignCase: cases) {
+        auto                  depth     = makeDepth(alignCase.depthWidth, alignCase.depthHeight);
+        int                   colorSize = alignCase.colorWidth * alignCase.colorHeight;
+        int                   depthSize = alignCase.depthWidth * alignCase.depthHeight;
+        std::vector<uint8_t>  color(colorSize * 3);
+        for(int i = 0; i < colorSize * 3; i++) {
+            color[i] = static_cast<uint8_t>(i * 31 + i / alignCase.colorWidth);
+        }
+
+        // reference: the single thread SSE alignment
+        AlignImpl reference;
+        reference.setThreadCount(1);
+        reference.enableAVX2(false);
+        initialize(reference, alignCase);
+        std::vector<uint16_t> refD2C(colorSize);
+        std::vector<uint8_t>  refC2D(depthSize * 3);
+        reference.D2C(depth.data(), alignCase.depthWidth, alignCase.depthHeight, refD2C.data(), alignCase.colorWidth, alignCase.colorHeight);
+        reference.C2D(depth.data(), alignCase.depthWidth, alignCase.depthHeight, color.data(), refC2D.data(), alignCase.colorWidth, alignCase.colorHeight,
+                      OB_FORMAT_RGB);
+
+        for(int avx2 = 0; avx2 < 2; avx2++) {
+            if(avx2 && !AlignImpl::isAVX2Supported()) {
+                continue;
+            }
+            for(auto threadCount: threadCounts) {
+                AlignImpl impl;
+                impl.setThreadCount(threadCount);
+                impl.enableAVX2(avx2 != 0);
+                initialize(impl, alignCase);
+
+                std::vector<uint16_t> outD2C(colorSize);
+                std::vector<uint8_t>  outC2D(depthSize * 3);
+                bool                  match = true;
+
+                auto start = std::chrono::steady_clock::now();
+                for(int i = 0; i < frameCount; i++) {
+                    impl.D2C(depth.data(), alignCase.depthWidth, alignCase.depthHeight, outD2C.data(), alignCase.colorWidth, alignCase.colorHeight);
+                    if(i == 0) {
+                        match = match && memcmp(outD2C.data(), refD2C.data(), colorSize * sizeof(uint16_t)) == 0;
+                    }
+                }
+                double d2cMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frameCount;
+                // the band buffers are reused, check the last frame as well
+                match = match && memcmp(outD2C.data(), refD2C.data(), colorSize * sizeof(uint16_t)) == 0;
+
+                start = std::chrono::steady_clock::now();
+                for(int i = 0; i < frameCount; i++) {
+                    impl.C2D(depth.data(), alignCase.depthWidth, alignCase.depthHeight, color.data(), outC2D.data(), alignCase.colorWidth,
+                             alignCase.colorHeight, OB_FORMAT_RGB);
+                }
+                double c2dMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frameCount;
+                match        = match && memcmp(outC2D.data(), refC2D.data(), depthSize * 3) == 0;
+
+                allMatch = allMatch && match;
+                std::cout << std::left << std::setw(30) << alignCase.name << std::setw(6) << (avx2 ? "AVX2" : "SSE") << std::setw(9) << threadCount
+                          << std::setw(12) << std::fixed << std::setprecision(3) << d2cMs << std::setw(12) << c2dMs << (match ? "yes" : "NO") << std::endl;
+            }
+        }
+    }
+
+    if(!allMatch) {
+        std::cout << "FAILED: the output differs from the single thread SSE alignment" << std::endl;
+        return 1;
+    }
+    return 0;
+}
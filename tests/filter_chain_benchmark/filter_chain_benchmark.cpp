@@ -0,0 +1,202 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Run chains of N synthetic filters (one chain per simulated stream) on synthetic frames, with a dedicated thread per filter and with the shared
+// task executor, and report the end-to-end latency percentiles and the thread count of the process. Then check that a queue on the executor can be
+// stopped and flushed from its own callback.
+// usage: filter_chain_benchmark [chain count] [filters per chain] [fps] [duration seconds] [executor thread count]
+
+#include "FilterDecorator.hpp"
+#include "frame/FrameFactory.hpp"
+#include "frame/FrameQueue.hpp"
+#include "utils/TaskExecutor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+static uint64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int getProcessThreadCount() {
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string   line;
+    while(std::getline(status, line)) {
+        if(line.compare(0, 8, "Threads:") == 0) {
+            return std::atoi(line.c_str() + 8);
+        }
+    }
+#endif
+    return -1;
+}
+
+// Copy the frame and run a light pass over the data, as a typical filter does
+class SyntheticFilter : public FilterExtension {
+public:
+    explicit SyntheticFilter(const std::string &name) : FilterExtension(name) {}
+    ~SyntheticFilter() noexcept override {
+        reset();
+    }
+
+    void updateConfig(std::vector<std::string> &params) override {
+        (void)params;
+    }
+
+    const std::string &getConfigSchema() const override {
+        return schema_;
+    }
+
+    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override {
+        auto     outFrame = FrameFactory::createFrameFromOtherFrame(frame, true);
+        auto     data     = outFrame->getDataMutable();
+        uint32_t sum      = 0;
+        for(size_t i = 0; i < outFrame->getDataSize(); i += 16) {
+            sum += data[i];
+        }
+        data[0] = static_cast<uint8_t>(sum);
+        return outFrame;
+    }
+
+private:
+    std::string schema_;
+};
+
+struct BenchmarkResult {
+    std::vector<uint64_t> latenciesUs;
+    int                   threadCount;
+};
+
+BenchmarkResult runChains(int chainCount, int filterCount, int fps, int durationSec, std::shared_ptr<TaskExecutor> executor) {
+    BenchmarkResult result;
+    std::mutex      resultMutex;
+
+    std::vector<std::vector<std::shared_ptr<SyntheticFilter>>> chains(chainCount);
+    for(int c = 0; c < chainCount; c++) {
+        for(int f = 0; f < filterCount; f++) {
+            auto filter = std::make_shared<SyntheticFilter>("SyntheticFilter" + std::to_string(c) + "_" + std::to_string(f));
+            filter->setTaskExecutor(executor);
+            chains[c].push_back(filter);
+        }
+        for(int f = 0; f + 1 < filterCount; f++) {
+            auto next = chains[c][f + 1];
+            chains[c][f]->setCallback([next](std::shared_ptr<Frame> frame) { next->pushFrame(frame); });
+        }
+        chains[c].back()->setCallback([&result, &resultMutex](std::shared_ptr<Frame> frame) {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            result.latenciesUs.push_back(nowUs() - frame->getSystemTimeStampUsec());
+        });
+    }
+
+    // one producer per chain, as the capture thread of a stream does
+    std::vector<std::thread> producers;
+    for(int c = 0; c < chainCount; c++) {
+        producers.emplace_back([&chains, c, fps, durationSec]() {
+            auto interval = std::chrono::microseconds(1000000 / fps);
+            auto next     = std::chrono::steady_clock::now();
+            for(int i = 0; i < fps * durationSec; i++) {
+                auto frame = FrameFactory::createVideoFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 640, 480, 0);
+                frame->setNumber(i);
+                frame->setSystemTimeStampUsec(nowUs());
+                chains[c].front()->pushFrame(frame);
+                next += interval;
+                std::this_thread::sleep_until(next);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(durationSec * 500));
+    result.threadCount = getProcessThreadCount();
+    for(auto &producer: producers) {
+        producer.join();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));  // wait for the last frames
+    chains.clear();
+    return result;
+}
+
+void printResult(const std::string &mode, BenchmarkResult &result) {
+    auto &latencies = result.latenciesUs;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) { return latencies.empty() ? 0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    std::cout << mode << ", " << result.threadCount << ", " << latencies.size() << ", " << percentile(0.5) << ", " << percentile(0.9) << ", "
+              << percentile(0.99) << ", " << (latencies.empty() ? 0 : latencies.back()) << std::endl;
+}
+
+// Stop or flush the queue from its callback, which runs on the drain task and must not wait for itself
+bool checkStopFromCallback(std::shared_ptr<TaskExecutor> executor, bool flush) {
+    std::mutex              doneMutex;
+    std::condition_variable doneCv;
+    int                     calledCount = 0;
+    bool                    returned    = false;
+    FrameQueue<Frame>       queue(10);  // destroyed first, it waits for the drain task using the above
+    queue.setExecutor(executor);
+    for(int i = 0; i < 3; i++) {
+        queue.enqueue(FrameFactory::createVideoFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 64, 48, 0));
+    }
+    queue.start([&](std::shared_ptr<Frame> frame) {
+        (void)frame;
+        bool first = false;
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            first = calledCount++ == 0;
+        }
+        if(first) {
+            flush ? queue.flush() : queue.stop();
+            std::lock_guard<std::mutex> lock(doneMutex);
+            returned = true;
+            doneCv.notify_all();
+        }
+    });
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    bool ok = doneCv.wait_for(lock, std::chrono::seconds(5), [&returned]() { return returned; });
+    lock.unlock();
+    if(!ok) {
+        std::cout << "  FAILED: " << (flush ? "flush" : "stop") << " from the callback blocked" << std::endl;
+        std::terminate();  // the queue can not be destroyed while its drain task is blocked
+    }
+    queue.flush();  // wait for the drain task to finish
+    lock.lock();
+    int expectedCount = flush ? 3 : 1;  // a flush calls back the rest frames, a stop drops them
+    if(calledCount != expectedCount) {
+        std::cout << "  FAILED: " << (flush ? "flush" : "stop") << " from the callback called back " << calledCount << " frames, expected "
+                  << expectedCount << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int chainCount          = argc > 1 ? std::atoi(argv[1]) : 8;
+    int filterCount         = argc > 2 ? std::atoi(argv[2]) : 4;
+    int fps                 = argc > 3 ? std::atoi(argv[3]) : 30;
+    int durationSec         = argc > 4 ? std::atoi(argv[4]) : 5;
+    int executorThreadCount = argc > 5 ? std::atoi(argv[5]) : static_cast<int>(std::thread::hardware_concurrency());
+
+    std::cout << "chains: " << chainCount << ", filters per chain: " << filterCount << ", fps: " << fps << ", duration: " << durationSec << "s"
+              << std::endl;
+    std::cout << "mode, process threads, frames, p50 us, p90 us, p99 us, max us" << std::endl;
+
+    auto dedicatedResult = runChains(chainCount, filterCount, fps, durationSec, nullptr);
+    printResult("dedicated threads", dedicatedResult);
+
+    auto executor       = std::make_shared<TaskExecutor>(static_cast<uint32_t>(executorThreadCount), false);
+    auto executorResult = runChains(chainCount, filterCount, fps, durationSec, executor);
+    printResult("shared executor(" + std::to_string(executor->getThreadCount()) + " threads)", executorResult);
+
+    bool ok = checkStopFromCallback(executor, false);
+    ok &= checkStopFromCallback(executor, true);
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
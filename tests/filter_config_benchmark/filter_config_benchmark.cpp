@@ -0,0 +1,143 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the per-frame cost of the config check of FilterExtension, with the config unchanged and with a config value changed before every frame,
+// for a filter applying the typed config values and for a filter only supporting the string config (formatted and parsed on every change). Then
+// change the config from another thread while frames are processed, and check that the last values are applied.
+// usage: filter_config_benchmark [frame count]
+
+#include "FilterDecorator.hpp"
+#include "utils/StringUtils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+class ConfigFilter : public FilterExtension {
+public:
+    ConfigFilter(const std::string &name, bool typed) : FilterExtension(name), typed_(typed), updateCount_(0) {}
+    ~ConfigFilter() noexcept override {
+        reset();
+    }
+
+    void updateConfig(std::vector<std::string> &params) override {
+        values_.resize(params.size());
+        for(size_t i = 0; i < params.size(); i++) {
+            utils::string::cvt2Double(params[i], values_[i]);
+        }
+        updateCount_++;
+    }
+
+    bool updateTypedConfig(const FilterConfigValues &values) override {
+        if(!typed_) {
+            return false;
+        }
+        values_ = values;
+        updateCount_++;
+        return true;
+    }
+
+    const std::string &getConfigSchema() const override {
+        static const std::string schema = "min, int, 0, 16000, 1, 0, min depth range\n"
+                                          "max, int, 0, 16000, 1, 16000, max depth range\n"
+                                          "scale, float, 0.01, 100.0, 0.01, 1.0, value scale factor\n"
+                                          "alpha, float, 0.01, 1.0, 0.01, 0.5, smooth alpha\n"
+                                          "radius, int, 1, 8, 1, 1, filter radius\n"
+                                          "enable, boolean, 0, 1, 1, 1, enable the pass\n"
+                                          "mode, integer, 0, 2, 1, 0, output mode\n"
+                                          "offset, int, -16, 16, 1, 0, value offset";
+        return schema;
+    }
+
+    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override {
+        (void)frame;
+        return nullptr;
+    }
+
+    // What processFrame() does before processing each frame
+    void onFrame() {
+        checkAndUpdateConfig();
+    }
+
+    const FilterConfigValues &getValues() const {
+        return values_;
+    }
+
+    uint64_t getUpdateCount() const {
+        return updateCount_;
+    }
+
+private:
+    bool               typed_;
+    FilterConfigValues values_;
+    uint64_t           updateCount_;
+};
+
+static double measureNsPerFrame(ConfigFilter &filter, uint32_t frameCount, bool changeEveryFrame) {
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < frameCount; i++) {
+        if(changeEveryFrame) {
+            filter.setConfigValue("scale", 1.5 - (i & 1) * 0.5);
+        }
+        filter.onFrame();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frameCount;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+int main(int argc, char **argv) {
+    uint32_t frameCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    bool     ok         = true;
+
+    std::cout << "config, unchanged ns/frame, changed every frame ns/frame" << std::endl;
+    for(int typed = 1; typed >= 0; typed--) {
+        ConfigFilter filter(typed ? "TypedConfigFilter" : "StringConfigFilter", typed != 0);
+        filter.setConfigValueSync("max", 8000);
+        auto unchangedNs = measureNsPerFrame(filter, frameCount, false);
+        auto changedNs   = measureNsPerFrame(filter, frameCount / 10, true);
+        std::cout << (typed ? "typed" : "string") << ", " << unchangedNs << ", " << changedNs << std::endl;
+
+        ok &= check(filter.getValues().size() == 8, "config values not applied");
+        ok &= check(filter.getValues()[1] == 8000 && filter.getValues()[2] == filter.getConfigValue("scale"), "config values mismatch");
+        ok &= check(filter.getUpdateCount() == frameCount / 10 + 1, "config applied " + std::to_string(filter.getUpdateCount()) + " times");
+    }
+
+    // change the config on another thread while the frames are processed
+    ConfigFilter          filter("ConcurrentConfigFilter", true);
+    std::atomic<bool>     running(true);
+    std::atomic<uint64_t> processedCount(0);
+    std::thread           processThread([&]() {
+        while(running) {
+            filter.onFrame();
+            processedCount++;
+        }
+    });
+    for(uint32_t i = 0; i < frameCount / 10; i++) {
+        filter.setConfigValue("min", i % 16000);
+        filter.setConfigValue("alpha", 0.01 * (1 + i % 100));
+    }
+    filter.setConfigValueSync("offset", -3);
+    running = false;
+    processThread.join();
+
+    auto &values = filter.getValues();
+    ok &= check(values.size() == 8 && values[0] == filter.getConfigValue("min") && values[3] == filter.getConfigValue("alpha") && values[7] == -3,
+                "last config values not applied");
+    std::cout << "concurrent: " << frameCount / 10 << " x 2 changes, " << processedCount << " frames, config applied " << filter.getUpdateCount() << " times"
+              << std::endl;
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
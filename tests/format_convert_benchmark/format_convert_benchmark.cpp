@@ -0,0 +1,190 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Convert YUYV/UYVY/NV12 frames to RGB/BGR/RGBA/BGRA with the format converter for each resolution and thread count, and report the time per frame.
+// For the packed 4:2:2 formats, the former two-pass conversion through a temporary I420 buffer is measured as a baseline and the single-pass output is
+// checked to be close to it (they only differ by the vertical chroma subsampling of the I420 buffer). The outputs of the row stripes converted in
+// parallel are checked to be the same as the single thread conversion.
+// usage: format_convert_benchmark [frames per configuration]
+
+#include "publicfilters/FormatConverterProcess.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <libyuv.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+struct Conversion {
+    const char *name;
+    OBFormat    srcFormat;
+    OBFormat    dstFormat;
+    uint32_t    dstPixelSize;
+    // Former conversion through a temporary I420 buffer, null if there is no such baseline
+    std::function<void(const uint8_t *, uint8_t *, int, int)> twoPass;
+};
+
+static uint64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void packedToI420(OBFormat format, const uint8_t *src, std::vector<uint8_t> &i420, int width, int height) {
+    i420.resize(static_cast<size_t>(width) * height * 3 / 2);
+    auto y = i420.data();
+    auto u = y + width * height;
+    auto v = u + width * height / 4;
+    if(format == OB_FORMAT_YUYV) {
+        libyuv::YUY2ToI420(src, width * 2, y, width, u, width / 2, v, width / 2, width, height);
+    }
+    else {
+        libyuv::UYVYToI420(src, width * 2, y, width, u, width / 2, v, width / 2, width, height);
+    }
+}
+
+typedef int (*I420ToPackedFunc)(const uint8_t *, int, const uint8_t *, int, const uint8_t *, int, uint8_t *, int, int, int);
+
+static std::function<void(const uint8_t *, uint8_t *, int, int)> twoPassConversion(OBFormat srcFormat, I420ToPackedFunc toPacked, int dstPixelSize) {
+    return [srcFormat, toPacked, dstPixelSize](const uint8_t *src, uint8_t *dst, int width, int height) {
+        std::vector<uint8_t> i420;
+        packedToI420(srcFormat, src, i420, width, height);
+        auto y = i420.data();
+        auto u = y + width * height;
+        auto v = u + width * height / 4;
+        toPacked(y, width, u, width / 2, v, width / 2, dst, width * dstPixelSize, width, height);
+    };
+}
+
+// Smooth color gradients, encoded as YUYV/UYVY/NV12 with the chroma varying along both axes
+static std::vector<uint8_t> createSourceImage(OBFormat format, int width, int height) {
+    std::vector<uint8_t> data(format == OB_FORMAT_NV12 ? static_cast<size_t>(width) * height * 3 / 2 : static_cast<size_t>(width) * height * 2);
+    auto                 luma   = [&](int x, int y) { return static_cast<uint8_t>(16 + (x * 3 + y * 2) % 220); };
+    auto                 chromaU = [&](int x, int y) { return static_cast<uint8_t>(128 + 100 * std::sin(x * 0.01 + y * 0.013)); };
+    auto                 chromaV = [&](int x, int y) { return static_cast<uint8_t>(128 + 100 * std::cos(x * 0.017 - y * 0.011)); };
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x += 2) {
+            if(format == OB_FORMAT_NV12) {
+                data[y * width + x]     = luma(x, y);
+                data[y * width + x + 1] = luma(x + 1, y);
+                if(y % 2 == 0) {
+                    auto uv = &data[width * height + y / 2 * width + x];
+                    uv[0]   = chromaU(x, y);
+                    uv[1]   = chromaV(x, y);
+                }
+                continue;
+            }
+            auto    pixel = &data[(static_cast<size_t>(y) * width + x) * 2];
+            uint8_t yuyv[4] = { luma(x, y), chromaU(x, y), luma(x + 1, y), chromaV(x, y) };
+            if(format == OB_FORMAT_YUYV) {
+                memcpy(pixel, yuyv, 4);
+            }
+            else {
+                uint8_t uyvy[4] = { yuyv[1], yuyv[0], yuyv[3], yuyv[2] };
+                memcpy(pixel, uyvy, 4);
+            }
+        }
+    }
+    return data;
+}
+
+static double measureUs(int frameCount, const std::function<void()> &func) {
+    func();  // warm up
+    auto start = nowUs();
+    for(int i = 0; i < frameCount; i++) {
+        func();
+    }
+    return static_cast<double>(nowUs() - start) / frameCount;
+}
+
+int main(int argc, char **argv) {
+    int frameCount = argc > 1 ? std::atoi(argv[1]) : 30;
+    if(frameCount <= 0) {
+        frameCount = 30;
+    }
+
+    std::vector<Conversion> conversions = {
+        { "YUYV->RGB", OB_FORMAT_YUYV, OB_FORMAT_RGB, 3, twoPassConversion(OB_FORMAT_YUYV, libyuv::I420ToRAW, 3) },
+        { "YUYV->BGR", OB_FORMAT_YUYV, OB_FORMAT_BGR, 3, twoPassConversion(OB_FORMAT_YUYV, libyuv::I420ToRGB24, 3) },
+        { "YUYV->RGBA", OB_FORMAT_YUYV, OB_FORMAT_RGBA, 4, twoPassConversion(OB_FORMAT_YUYV, libyuv::I420ToABGR, 4) },
+        { "YUYV->BGRA", OB_FORMAT_YUYV, OB_FORMAT_BGRA, 4, twoPassConversion(OB_FORMAT_YUYV, libyuv::I420ToARGB, 4) },
+        { "UYVY->RGB", OB_FORMAT_UYVY, OB_FORMAT_RGB, 3, twoPassConversion(OB_FORMAT_UYVY, libyuv::I420ToRAW, 3) },
+        { "NV12->RGB", OB_FORMAT_NV12, OB_FORMAT_RGB, 3, nullptr },
+    };
+    const std::vector<std::pair<int, int>> resolutions  = { { 640, 480 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+    const std::vector<uint32_t>            threadCounts = { 1, 2, 4 };
+
+    bool ok = true;
+    std::cout << std::left << std::setw(12) << "conversion" << std::setw(12) << "resolution" << std::right << std::setw(12) << "two-pass";
+    for(auto threadCount: threadCounts) {
+        std::cout << std::setw(12) << (std::to_string(threadCount) + " thread(s)");
+    }
+    std::cout << "   (us per frame)" << std::endl;
+
+    for(auto &conversion: conversions) {
+        for(auto &resolution: resolutions) {
+            int  width   = resolution.first;
+            int  height  = resolution.second;
+            auto profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_COLOR, conversion.srcFormat, width, height, 30);
+            auto source  = FrameFactory::createFrameFromStreamProfile(profile);
+            auto image   = createSourceImage(conversion.srcFormat, width, height);
+            source->updateData(image.data(), image.size());
+
+            std::cout << std::left << std::setw(12) << conversion.name << std::setw(12) << (std::to_string(width) + "x" + std::to_string(height))
+                      << std::right << std::fixed << std::setprecision(0);
+
+            std::vector<uint8_t> twoPassOutput(static_cast<size_t>(width) * height * conversion.dstPixelSize);
+            if(conversion.twoPass) {
+                std::cout << std::setw(12) << measureUs(frameCount, [&]() { conversion.twoPass(image.data(), twoPassOutput.data(), width, height); });
+            }
+            else {
+                std::cout << std::setw(12) << "-";
+            }
+
+            std::vector<uint8_t> reference;
+            std::string          errors;
+            for(auto threadCount: threadCounts) {
+                FormatConverter converter;
+                converter.setConversion(conversion.srcFormat, conversion.dstFormat);
+                converter.setThreadCount(threadCount);
+                std::shared_ptr<Frame> output;
+                std::cout << std::setw(12) << measureUs(frameCount, [&]() { output = converter.process(source); });
+
+                if(!output || output->getDataSize() != twoPassOutput.size()) {
+                    errors += " no output with " + std::to_string(threadCount) + " thread(s);";
+                    continue;
+                }
+                if(reference.empty()) {
+                    reference.assign(output->getData(), output->getData() + output->getDataSize());
+                }
+                else if(memcmp(reference.data(), output->getData(), reference.size()) != 0) {
+                    errors += " output with " + std::to_string(threadCount) + " threads differs from single thread;";
+                }
+            }
+
+            // The single-pass conversion keeps the chroma of every row, so it only differs slightly from the two-pass one on smooth images
+            if(conversion.twoPass && !reference.empty()) {
+                int maxDiff = 0;
+                for(size_t i = 0; i < reference.size(); i++) {
+                    maxDiff = (std::max)(maxDiff, std::abs(static_cast<int>(reference[i]) - static_cast<int>(twoPassOutput[i])));
+                }
+                if(maxDiff > 16) {
+                    errors += " max diff to two-pass output " + std::to_string(maxDiff) + ";";
+                }
+            }
+            std::cout << (errors.empty() ? "" : "   FAILED:" + errors) << std::endl;
+            ok = ok && errors.empty();
+        }
+    }
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
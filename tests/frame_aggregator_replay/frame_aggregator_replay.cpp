@@ -0,0 +1,237 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Replay synthetic timestamp streams through the FrameAggregator and check the matching. Each stream has a nominal capture time per frame, a
+// capture jitter and a transport delay with jitter; the frames are pushed in the order of their arrival time, and the arrival time is fed as the
+// aggregator clock, so the run is deterministic for a given seed. The frame number is the nominal capture index, which is used to check that the
+// frames captured at the same time are matched into one frameset.
+// usage: frame_aggregator_replay [seed] [duration seconds]
+
+#include "FrameAggregator.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+struct StreamSpec {
+    std::shared_ptr<const StreamProfile> profile;
+    uint64_t                             intervalUs;
+    uint32_t                             captureJitterUs;
+    uint32_t                             delayUs;
+    uint32_t                             delayJitterUs;
+};
+
+struct ReplayEvent {
+    uint64_t    arrivalUs;
+    uint64_t    timestampUs;
+    uint64_t    nominalUs;
+    uint64_t    index;
+    size_t      streamIndex;
+    OBFrameType frameType;
+};
+
+// Deterministic generator, independent of the standard library implementation
+class Lcg {
+public:
+    explicit Lcg(uint32_t seed) : state_(seed * 2654435761u + 1) {}
+    int32_t next(uint32_t range) {  // [-range, range]
+        state_ = state_ * 1664525u + 1013904223u;
+        return range == 0 ? 0 : static_cast<int32_t>((state_ >> 8) % (2 * range + 1)) - static_cast<int32_t>(range);
+    }
+
+private:
+    uint32_t state_;
+};
+
+static std::vector<ReplayEvent> generateEvents(const std::vector<StreamSpec> &streams, uint32_t seed, uint32_t durationSec) {
+    const uint64_t           startUs = 1000000;  // leave room for the negative jitter
+    std::vector<ReplayEvent> events;
+    Lcg                      lcg(seed);
+    for(size_t s = 0; s < streams.size(); s++) {
+        auto &spec  = streams[s];
+        auto  count = durationSec * 1000000ull / spec.intervalUs;
+        for(uint64_t i = 0; i < count; i++) {
+            ReplayEvent event;
+            event.nominalUs   = startUs + i * spec.intervalUs;
+            event.timestampUs = event.nominalUs + lcg.next(spec.captureJitterUs);
+            event.arrivalUs   = event.timestampUs + spec.delayUs + lcg.next(spec.delayJitterUs);
+            event.index       = i;
+            event.streamIndex = s;
+            event.frameType   = utils::mapStreamTypeToFrameType(spec.profile->getType());
+            events.push_back(event);
+        }
+    }
+    // frames of a stream arrive in order, the transport jitter only reorders the frames of different streams
+    std::vector<uint64_t> lastArrival(streams.size(), 0);
+    std::stable_sort(events.begin(), events.end(), [](const ReplayEvent &x, const ReplayEvent &y) { return x.timestampUs < y.timestampUs; });
+    for(auto &event: events) {
+        event.arrivalUs                = std::max(event.arrivalUs, lastArrival[event.streamIndex]);
+        lastArrival[event.streamIndex] = event.arrivalUs;
+    }
+    std::stable_sort(events.begin(), events.end(), [](const ReplayEvent &x, const ReplayEvent &y) { return x.arrivalUs < y.arrivalUs; });
+    return events;
+}
+
+struct OutputFrame {
+    OBFrameType frameType;
+    uint64_t    number;
+    uint64_t    timestampUs;
+};
+
+struct ReplayResult {
+    std::vector<std::vector<OutputFrame>> framesets;
+    FrameAggregatorStatistics             statistics;
+};
+
+static ReplayResult replay(const std::vector<StreamSpec> &streams, const std::vector<ReplayEvent> &events, bool matchingRateFirst,
+                           OBFrameAggregateOutputMode outputMode) {
+    auto config = std::make_shared<Config>();
+    for(auto &spec: streams) {
+        config->enableStream(spec.profile);
+    }
+    config->setFrameAggregateOutputMode(outputMode);
+
+    ReplayResult    result;
+    uint64_t        nowUs = 0;
+    FrameAggregator aggregator;
+    aggregator.setClock([&nowUs]() { return nowUs; });
+    aggregator.enableFrameSync(FrameSyncModeSyncAccordingFrameTimestamp);
+    aggregator.updateConfig(config, matchingRateFirst);
+    aggregator.setCallback([&result](std::shared_ptr<const Frame> frame) {
+        auto                     frameSet = frame->as<FrameSet>();
+        std::vector<OutputFrame> outputFrames;
+        for(uint32_t i = 0; i < frameSet->getCount(); i++) {
+            auto subFrame = frameSet->getFrame(i);
+            outputFrames.push_back({ subFrame->getType(), subFrame->getNumber(), subFrame->getTimeStampUsec() });
+        }
+        result.framesets.push_back(outputFrames);
+    });
+
+    for(auto &event: events) {
+        nowUs      = event.arrivalUs;
+        auto frame = FrameFactory::createFrameFromStreamProfile(streams[event.streamIndex].profile);
+        frame->setNumber(event.index);
+        frame->setTimeStampUsec(event.timestampUs);
+        frame->setSystemTimeStampUsec(event.arrivalUs);
+        aggregator.pushFrame(frame);
+    }
+    result.statistics = aggregator.getStatistics();
+    aggregator.clearAllFrameQueue();
+    return result;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static void printStatistics(const FrameAggregatorStatistics &stat) {
+    auto count = stat.outputFramesetCount > 0 ? stat.outputFramesetCount : 1;
+    std::cout << "  input frames " << stat.inputFrameCount << ", framesets " << stat.outputFramesetCount << ", discarded framesets "
+              << stat.discardedFramesetCount << ", dropped frames " << stat.droppedFrameCount << std::endl;
+    std::cout << "  match latency avg " << stat.totalMatchLatencyUs / count << "us max " << stat.maxMatchLatencyUs << "us, timestamp spread avg "
+              << stat.totalTimestampSpreadUs / count << "us max " << stat.maxTimestampSpreadUs << "us" << std::endl;
+}
+
+// Frames of the same nominal capture time have the same index scaled by the interval ratio; every frame is output at most once and in order
+static bool checkFramesets(const ReplayResult &result, const std::vector<StreamSpec> &streams, OBFrameType refType, uint64_t maxSpreadUs,
+                           bool allTypesRequired) {
+    bool                            ok = true;
+    std::map<OBFrameType, uint64_t> intervals;
+    std::map<OBFrameType, int64_t>  lastNumbers;
+    for(auto &spec: streams) {
+        auto frameType         = utils::mapStreamTypeToFrameType(spec.profile->getType());
+        intervals[frameType]   = spec.intervalUs;
+        lastNumbers[frameType] = -1;
+    }
+
+    uint64_t mismatchCount = 0;
+    for(auto &frameset: result.framesets) {
+        uint64_t minTsp = UINT64_MAX, maxTsp = 0;
+        for(auto &frame: frameset) {
+            ok = check(static_cast<int64_t>(frame.number) > lastNumbers[frame.frameType], "frame output twice or out of order") && ok;
+            lastNumbers[frame.frameType] = static_cast<int64_t>(frame.number);
+            minTsp                       = std::min(minTsp, frame.timestampUs);
+            maxTsp                       = std::max(maxTsp, frame.timestampUs);
+        }
+        ok = check(maxTsp - minTsp <= maxSpreadUs, "timestamp spread " + std::to_string(maxTsp - minTsp) + "us of a frameset is too large") && ok;
+        ok = check(!allTypesRequired || frameset.size() == streams.size(), "incomplete frameset output") && ok;
+
+        auto refIter = std::find_if(frameset.begin(), frameset.end(), [refType](const OutputFrame &frame) { return frame.frameType == refType; });
+        if(refIter == frameset.end()) {
+            continue;
+        }
+        auto nominalUs = refIter->number * intervals[refType];
+        for(auto &frame: frameset) {
+            if(frame.frameType != OB_FRAME_ACCEL && frame.frameType != OB_FRAME_GYRO && frame.number * intervals[frame.frameType] != nominalUs) {
+                mismatchCount++;
+            }
+        }
+    }
+    ok = check(mismatchCount == 0, std::to_string(mismatchCount) + " frames matched with a frame of another capture time") && ok;
+    return ok;
+}
+
+static uint64_t digest(const ReplayResult &result) {
+    uint64_t hash = 1469598103934665603ull;
+    for(auto &frameset: result.framesets) {
+        for(auto &frame: frameset) {
+            hash = (hash ^ (frame.number * 131 + frame.frameType)) * 1099511628211ull;
+        }
+        hash = (hash ^ 0xff) * 1099511628211ull;
+    }
+    return hash;
+}
+
+int main(int argc, char **argv) {
+    uint32_t seed        = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1;
+    uint32_t durationSec = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 10;
+    if(durationSec == 0) {
+        durationSec = 10;
+    }
+    bool ok = true;
+
+    // 90fps IR and 30fps color (every third IR frame is captured with a color frame), 1kHz IMU. The color frame arrives much later than IR.
+    auto ir    = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_IR, OB_FORMAT_Y8, 320, 200, 90);
+    auto color = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_COLOR, OB_FORMAT_RGB, 320, 240, 30);
+    auto accel = StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_1_KHZ);
+    std::vector<StreamSpec> irColorImu = {
+        { ir, 11111, 300, 3000, 1500 },
+        { color, 33333, 300, 25000, 5000 },
+        { accel, 1000, 20, 1000, 500 },
+    };
+    std::vector<StreamSpec> irColor(irColorImu.begin(), irColorImu.begin() + 2);
+
+    std::cout << "IR 90fps + color 30fps + IMU 1kHz, match rate first, seed " << seed << std::endl;
+    auto events = generateEvents(irColorImu, seed, durationSec);
+    auto result = replay(irColorImu, events, true, OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION);
+    printStatistics(result.statistics);
+    ok = checkFramesets(result, irColorImu, OB_FRAME_COLOR, 5556, false) && ok;
+    ok = check(result.statistics.droppedFrameCount == 0, "frames dropped") && ok;
+    auto again = replay(irColorImu, events, true, OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION);
+    ok         = check(digest(result) == digest(again), "replay is not deterministic") && ok;
+
+    std::cout << "IR 90fps + color 30fps + IMU 1kHz, match precision first" << std::endl;
+    result = replay(irColorImu, events, false, OB_FRAME_AGGREGATE_OUTPUT_ANY_SITUATION);
+    printStatistics(result.statistics);
+    ok = checkFramesets(result, irColorImu, OB_FRAME_COLOR, 5556, false) && ok;
+
+    std::cout << "IR 90fps + color 30fps, all type frame required" << std::endl;
+    events = generateEvents(irColor, seed, durationSec);
+    result = replay(irColor, events, true, OB_FRAME_AGGREGATE_OUTPUT_ALL_TYPE_FRAME_REQUIRE);
+    printStatistics(result.statistics);
+    ok = checkFramesets(result, irColor, OB_FRAME_COLOR, 5556, true) && ok;
+    ok = check(result.statistics.outputFramesetCount + 1 >= durationSec * 30ull, "color frames not matched") && ok;
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the per-frame cost and the bytes copied to pass a frame through, with a deep copy and with a copy-on-write clone, and check that a
+// frame changed through the clone or through the source does not affect the other, also through the public C API, and that the point index of a
+// points frame is kept. Then run a chain of disabled and pass-through filters and check the bytes reported per stage.
+// usage: frame_cow_benchmark [frame count] [width] [height]
+
+#include "FilterDecorator.hpp"
+#include "frame/FrameFactory.hpp"
+
+#include <libobsensor/h/Error.h>
+#include <libobsensor/h/Filter.h>
+#include <libobsensor/h/Frame.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+// Output the input frame unchanged, as the filters do for the frames they do not support
+class PassThroughFilter : public FilterExtension {
+public:
+    PassThroughFilter(const std::string &name, bool deepCopy) : FilterExtension(name), deepCopy_(deepCopy) {}
+    ~PassThroughFilter() noexcept override {
+        reset();
+    }
+
+    void updateConfig(std::vector<std::string> &params) override {
+        (void)params;
+    }
+
+    const std::string &getConfigSchema() const override {
+        return schema_;
+    }
+
+    std::shared_ptr<Frame> process(std::shared_ptr<const Frame> frame) override {
+        return deepCopy_ ? FrameFactory::createFrameFromOtherFrame(frame, true) : FrameFactory::cloneFrame(frame);
+    }
+
+private:
+    bool        deepCopy_;
+    std::string schema_;
+};
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static void measurePassThrough(std::shared_ptr<const Frame> frame, uint32_t frameCount, bool deepCopy) {
+    auto &copyStatistics = getThreadFrameCopyStatistics();
+    auto  copiedBefore   = copyStatistics;
+    auto  start          = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < frameCount; i++) {
+        auto outFrame = deepCopy ? FrameFactory::createFrameFromOtherFrame(frame, true) : FrameFactory::cloneFrame(frame);
+        (void)outFrame;
+    }
+    auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frameCount;
+    std::cout << (deepCopy ? "deep copy" : "clone") << ", " << ns << ", " << (copyStatistics.dataBytes - copiedBefore.dataBytes) / frameCount << ", "
+              << (copyStatistics.metadataBytes - copiedBefore.metadataBytes) / frameCount << std::endl;
+}
+
+static bool checkCopyOnWrite(std::shared_ptr<Frame> frame) {
+    auto &copyStatistics = getThreadFrameCopyStatistics();
+    bool  ok             = true;
+
+    auto clone = FrameFactory::cloneFrame(frame);
+    ok &= check(clone->getData() == frame->getData() && clone->getDataSize() == frame->getDataSize(), "clone does not share the data");
+    ok &= check(clone->isDataShared() && clone->getNumber() == frame->getNumber() && clone->getFormat() == frame->getFormat(), "clone info mismatch");
+
+    // a clone of the clone still shares the data of the source frame
+    auto cloneOfClone = FrameFactory::cloneFrame(clone);
+    ok &= check(cloneOfClone->getData() == frame->getData(), "clone of the clone does not share the data");
+
+    auto copiedBefore = copyStatistics.dataBytes;
+    auto source       = frame->getData()[1];
+    auto data         = clone->getDataMutable();
+    data[1]           = static_cast<uint8_t>(source + 1);
+    ok &= check(data != frame->getData() && frame->getData()[1] == source && cloneOfClone->getData()[1] == source, "source changed by the clone");
+    ok &= check(memcmp(data + 2, frame->getData() + 2, frame->getDataSize() - 2) == 0, "data not copied on write");
+    ok &= check(copyStatistics.dataBytes - copiedBefore == frame->getDataSize(), "copy on write not counted");
+    ok &= check(!clone->isDataShared(), "clone still shared after the write");
+
+    // a write through the source frame does not change its clones either
+    auto sourceClone = FrameFactory::cloneFrame(frame);
+    auto sharedData  = frame->getData();
+    copiedBefore     = copyStatistics.dataBytes;
+    auto sourceData  = frame->getDataMutable();
+    sourceData[3]    = static_cast<uint8_t>(sharedData[3] + 1);
+    ok &= check(sourceData != sharedData && sourceClone->getData() == sharedData && cloneOfClone->getData() == sharedData, "source not copied on write");
+    ok &= check(sharedData[3] != sourceData[3] && memcmp(sourceData + 4, sharedData + 4, frame->getDataSize() - 4) == 0, "clone changed by the source");
+    ok &= check(copyStatistics.dataBytes - copiedBefore == frame->getDataSize() && !frame->isDataShared(), "source copy on write mismatch");
+
+    // concurrent writers of the same shared frame get the same copy
+    std::vector<std::thread>     writers;
+    std::vector<const uint8_t *> written(4, nullptr);
+    for(size_t i = 0; i < written.size(); i++) {
+        writers.emplace_back([&written, &sourceClone, i]() { written[i] = sourceClone->getDataMutable(); });
+    }
+    for(auto &writer: writers) {
+        writer.join();
+    }
+    for(auto ptr: written) {
+        ok &= check(ptr == written[0] && ptr != sharedData && sourceClone->getData() == ptr, "concurrent writers got different data");
+    }
+    ok &= check(cloneOfClone->getData() == sharedData && sharedData[3] != sourceData[3], "shared data changed by the concurrent writers");
+
+    // once the other frames are released, the data is changed in place
+    auto exclusive = FrameFactory::cloneFrame(sourceClone);
+    auto borrowed  = exclusive->getData();
+    sourceClone.reset();
+    copiedBefore = copyStatistics.dataBytes;
+    ok &= check(exclusive->getDataMutable() == borrowed && copyStatistics.dataBytes == copiedBefore, "exclusive data copied on write");
+
+    // the whole data is replaced without copying the shared data first
+    auto other = FrameFactory::cloneFrame(exclusive);
+    copiedBefore = copyStatistics.dataBytes;
+    std::vector<uint8_t> newData(exclusive->getDataSize(), 0x5a);
+    other->updateData(newData.data(), newData.size());
+    ok &= check(exclusive->getData()[0] != 0x5a && other->getData()[0] == 0x5a, "source changed by update data");
+    ok &= check(copyStatistics.dataBytes - copiedBefore == newData.size(), "shared data copied before update data");
+    return ok;
+}
+
+// The point index is stored out of the data size of the points frame, it must be kept by the clone, the copy on write and the deep copy
+static bool checkPointsFrameCopy() {
+    const uint32_t maxPointCount = 64;
+    const uint32_t pointCount    = 40;
+    auto           indexOffset   = maxPointCount * sizeof(OBPoint);
+    auto           points        = FrameFactory::createFrame(OB_FRAME_POINTS, OB_FORMAT_POINT, indexOffset + maxPointCount * sizeof(uint32_t));
+    auto           pointsData    = points->getDataMutable();
+    for(size_t i = 0; i < points->getDataBufSize(); i++) {
+        pointsData[i] = static_cast<uint8_t>(i * 3);
+    }
+    points->setDataSize(pointCount * sizeof(OBPoint));
+    points->as<PointsFrame>()->setPointIndexOffset(indexOffset);
+    points->as<PointsFrame>()->setCoordinateValueScale(0.25f);
+    auto index = points->as<PointsFrame>()->getPointIndexData();
+
+    auto checkCopied = [&](std::shared_ptr<Frame> copied, const std::string &name) {
+        auto copiedPoints = copied->as<PointsFrame>();
+        auto copiedIndex  = copiedPoints->getPointIndexData();
+        bool ok           = check(copiedPoints->getCoordinateValueScale() == 0.25f, name + " coordinate value scale mismatch");
+        ok &= check(copiedIndex != nullptr && memcmp(copiedIndex, index, pointCount * sizeof(uint32_t)) == 0, name + " point index mismatch");
+        return ok;
+    };
+
+    auto clone = FrameFactory::cloneFrame(points);
+    bool ok    = checkCopied(clone, "clone");
+    ok &= check(clone->as<PointsFrame>()->getPointIndexData() == index, "clone does not share the point index");
+    clone->getDataMutable()[0]++;
+    ok &= checkCopied(clone, "clone written") && check(clone->as<PointsFrame>()->getPointIndexData() != index, "point index not copied on write");
+    ok &= checkCopied(FrameFactory::cloneFrame(clone), "clone of the written clone");
+    ok &= checkCopied(FrameFactory::createFrameFromOtherFrame(points, true), "deep copy");
+    return ok;
+}
+
+static bool checkApiError(ob_error **error) {
+    if(*error) {
+        std::cout << "  FAILED: " << ob_error_get_message(*error) << std::endl;
+        ob_delete_error(*error);
+        *error = nullptr;
+        return false;
+    }
+    return true;
+}
+
+struct ApiOutput {
+    std::mutex              mutex;
+    std::condition_variable cv;
+    ob_frame               *frame = nullptr;
+};
+
+static void onApiOutput(ob_frame *frame, void *userData) {
+    auto                        output = static_cast<ApiOutput *>(userData);
+    std::lock_guard<std::mutex> lock(output->mutex);
+    output->frame = frame;
+    output->cv.notify_one();
+}
+
+// The output of a disabled filter shares the data of the input frame, a write through ob_frame_get_data() must not change the other frame
+static bool checkApiWrite() {
+    ob_error *error  = nullptr;
+    auto      source = ob_create_video_frame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 64, 48, 0, &error);
+    auto      filter = error ? nullptr : ob_create_filter("DecimationFilter", &error);
+    if(!checkApiError(&error)) {
+        return false;
+    }
+    ApiOutput output;
+    ob_filter_enable(filter, false, &error);
+    ob_filter_set_callback(filter, onApiOutput, &output, &error);
+    memset(ob_frame_get_data(source, &error), 0x11, ob_frame_get_data_size(source, &error));
+    bool ok = checkApiError(&error);
+
+    auto passThrough = [&]() {
+        std::unique_lock<std::mutex> lock(output.mutex);
+        output.frame = nullptr;
+        lock.unlock();
+        ob_filter_push_frame(filter, source, &error);
+        lock.lock();
+        output.cv.wait_for(lock, std::chrono::seconds(5), [&output]() { return output.frame != nullptr; });
+        auto frame = output.frame;
+        ok &= check(frame != nullptr, "frame lost by the disabled filter");
+        return frame;
+    };
+
+    // write through the output frame
+    auto passed = passThrough();
+    if(passed) {
+        ob_frame_get_data(passed, &error)[0] = 0x22;
+        ok &= check(ob_frame_get_data(source, &error)[0] == 0x11, "source changed through ob_frame_get_data of the output");
+        ob_delete_frame(passed, &error);
+    }
+
+    // write through the source frame
+    passed = passThrough();
+    if(passed) {
+        ob_frame_get_data(source, &error)[0] = 0x33;
+        ok &= check(ob_frame_get_data(passed, &error)[0] == 0x11, "output changed through ob_frame_get_data of the source");
+        ob_delete_frame(passed, &error);
+    }
+    ok &= checkApiError(&error);
+
+    ob_delete_filter(filter, &error);
+    ob_delete_frame(source, &error);
+    return checkApiError(&error) && ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t frameCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2000;
+    uint32_t width      = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1280;
+    uint32_t height     = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 800;
+    bool     ok         = true;
+
+    auto frame = FrameFactory::createVideoFrame(OB_FRAME_DEPTH, OB_FORMAT_Y16, width, height, 0);
+    auto data  = frame->getDataMutable();
+    for(size_t i = 0; i < frame->getDataSize(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    frame->setNumber(42);
+
+    std::cout << width << "x" << height << " Y16 frame, " << frame->getDataSize() << " bytes" << std::endl;
+    std::cout << "pass through, ns/frame, data bytes/frame, metadata bytes/frame" << std::endl;
+    measurePassThrough(frame, frameCount, true);
+    measurePassThrough(frame, frameCount, false);
+    ok &= checkCopyOnWrite(FrameFactory::createFrameFromOtherFrame(frame, true));
+    ok &= checkPointsFrameCopy();
+    ok &= checkApiWrite();
+
+    // disabled stages, pass-through stages and a copying stage, the frames are pushed one by one so that none is dropped
+    std::vector<std::shared_ptr<PassThroughFilter>> chain;
+    for(int i = 0; i < 4; i++) {
+        chain.push_back(std::make_shared<PassThroughFilter>("PassThroughFilter" + std::to_string(i), false));
+    }
+    chain[1]->enable(false);
+    chain[2]->enable(false);
+    chain.push_back(std::make_shared<PassThroughFilter>("CopyFilter", true));
+
+    std::mutex              outputMutex;
+    std::condition_variable outputCv;
+    std::shared_ptr<Frame>  outputFrame;
+    for(size_t i = 0; i + 1 < chain.size(); i++) {
+        auto next = chain[i + 1];
+        chain[i]->setCallback([next](std::shared_ptr<Frame> f) { next->pushFrame(f); });
+    }
+    chain.back()->setCallback([&](std::shared_ptr<Frame> f) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        outputFrame = f;
+        outputCv.notify_one();
+    });
+
+    uint32_t chainFrameCount = frameCount / 10 + 1;
+    auto     start           = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < chainFrameCount; i++) {
+        chain.front()->pushFrame(frame);
+        std::unique_lock<std::mutex> lock(outputMutex);
+        if(!outputCv.wait_for(lock, std::chrono::seconds(5), [&]() { return outputFrame != nullptr; })) {
+            ok &= check(false, "frame lost in the chain");
+            break;
+        }
+        ok &= check(outputFrame->getData() != frame->getData() && memcmp(outputFrame->getData(), frame->getData(), frame->getDataSize()) == 0,
+                    "output frame data mismatch");
+        outputFrame.reset();
+    }
+    auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / chainFrameCount;
+    std::cout << "chain of " << chain.size() << " stages, " << chainFrameCount << " frames, " << us << " us/frame" << std::endl;
+
+    std::cout << "stage, frames, data bytes, metadata bytes" << std::endl;
+    for(auto &filter: chain) {
+        auto statistics = filter->getCopyStatistics();
+        std::cout << filter->getName() << (filter->isEnabled() ? "" : " (disabled)") << ", " << statistics.frameCount << ", " << statistics.dataBytes
+                  << ", " << statistics.metadataBytes << std::endl;
+        ok &= check(statistics.frameCount == chainFrameCount, filter->getName() + " frame count mismatch");
+        auto expectedDataBytes = filter == chain.back() ? chainFrameCount * static_cast<uint64_t>(frame->getDataSize()) : 0;
+        ok &= check(statistics.dataBytes == expectedDataBytes, filter->getName() + " data bytes mismatch");
+    }
+    chain.clear();
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
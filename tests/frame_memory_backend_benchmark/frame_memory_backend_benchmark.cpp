@@ -0,0 +1,206 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Compare the Malloc and Arena frame memory backends: the allocation latency of filling the frame pool, and the dTLB misses of a processing pass
+// over the frame buffers (read by perf_event_open, reported as n/a if the perf events are not accessible). Also check that the arena reuses and merges
+// the released memory, so that the mapped size stays bounded when the frame sizes change.
+// usage: frame_memory_backend_benchmark [numa node] [rounds]
+
+#include "frame/FrameMemoryBackend.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+// Frame buffer sizes of a typical depth + color + IR pipeline: 1920x1080 RGB, 1280x800 Y16 depth, 1280x800 Y8 IR, and a small IMU frame
+static const size_t FRAME_SIZES[] = { 1920 * 1080 * 3, 1280 * 800 * 2, 1280 * 800, 256 };
+static const int    FRAMES_PER_SIZE = 30;
+
+class DtlbMissCounter {
+public:
+    DtlbMissCounter() {
+        perf_event_attr attr = {};
+        attr.type            = PERF_TYPE_HW_CACHE;
+        attr.size            = sizeof(attr);
+        attr.config          = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled        = 1;
+        attr.exclude_kernel  = 1;
+        attr.exclude_hv      = 1;
+        fd_                  = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~DtlbMissCounter() {
+        if(fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    bool isAvailable() const {
+        return fd_ >= 0;
+    }
+
+    void start() {
+        if(fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+        if(fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if(read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+        }
+        return count;
+    }
+
+private:
+    int fd_;
+};
+
+struct Block {
+    uint8_t *ptr;
+    size_t   size;
+};
+
+uint8_t *allocateOrExit(IFrameMemoryBackend &backend, size_t size) {
+    auto ptr = backend.allocate(size);
+    if(ptr == nullptr) {
+        std::cerr << backend.getName() << ": allocate failed! size=" << size << std::endl;
+        exit(-1);
+    }
+    return ptr;
+}
+
+void runBenchmark(IFrameMemoryBackend &backend, int rounds, DtlbMissCounter &counter) {
+    // 1. fill the pool with the frame buffers of all streams from a cold backend
+    std::vector<Block> blocks;
+    auto               begin = std::chrono::steady_clock::now();
+    for(int i = 0; i < FRAMES_PER_SIZE; i++) {
+        for(auto size: FRAME_SIZES) {
+            blocks.push_back({ allocateOrExit(backend, size), size });
+        }
+    }
+    auto coldAllocUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / blocks.size();
+
+    double   reuseAllocUs = 0;
+    uint64_t dtlbMisses   = 0;
+    uint64_t checksum     = 0;
+    for(int round = 0; round < rounds; round++) {
+        // 2. release half of the buffers and allocate them again, as the pool does after freeing the idle memory
+        for(size_t i = round % 2; i < blocks.size(); i += 2) {
+            backend.deallocate(blocks[i].ptr, blocks[i].size);
+        }
+        begin = std::chrono::steady_clock::now();
+        for(size_t i = round % 2; i < blocks.size(); i += 2) {
+            blocks[i].ptr = allocateOrExit(backend, blocks[i].size);
+        }
+        reuseAllocUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / (blocks.size() / 2);
+
+        // 3. the producer writes the frames, then the consumer reads them with a 64-byte stride, as a filter would do
+        for(auto &block: blocks) {
+            memset(block.ptr, round, block.size);
+        }
+        counter.start();
+        for(auto &block: blocks) {
+            for(size_t offset = 0; offset < block.size; offset += 64) {
+                checksum += block.ptr[offset];
+            }
+        }
+        dtlbMisses += counter.stop();
+    }
+
+    for(auto &block: blocks) {
+        backend.deallocate(block.ptr, block.size);
+    }
+
+    std::cout << backend.getName() << ", " << coldAllocUs << ", " << reuseAllocUs / rounds << ", ";
+    if(counter.isAvailable()) {
+        std::cout << dtlbMisses / rounds;
+    }
+    else {
+        std::cout << "n/a";
+    }
+    std::cout << "  (checksum " << checksum % 256 << ")" << std::endl;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+bool checkArenaReuse(int numaNode) {
+    const size_t            regionSize = 64 * 1024 * 1024;
+    ArenaFrameMemoryBackend arena(regionSize, numaNode);
+    bool                    ok = true;
+
+    // A smaller buffer takes the memory released by a larger one, and the rest of it stays available
+    auto large = allocateOrExit(arena, 1920 * 1080 * 3);
+    arena.deallocate(large, 1920 * 1080 * 3);
+    auto small = allocateOrExit(arena, 1280 * 800 * 2);
+    ok &= check(small == large, "the released memory is not reused by a smaller buffer");
+
+    // The neighbouring released buffers are merged into one block, which holds a buffer larger than each of them
+    auto next = allocateOrExit(arena, 1280 * 800 * 2);
+    arena.deallocate(small, 1280 * 800 * 2);
+    arena.deallocate(next, 1280 * 800 * 2);
+    auto merged = allocateOrExit(arena, 1280 * 800 * 4);
+    ok &= check(merged == small, "the neighbouring released buffers are not merged");
+    arena.deallocate(merged, 1280 * 800 * 4);
+
+    // Cycle through the stream resolutions with a pool of frames each time: the arena never needs more than the peak of the buffers in use
+    const size_t       sizes[] = { 1920 * 1080 * 3, 1280 * 720 * 3, 640 * 480 * 3, 1280 * 800 * 2, 848 * 480 * 2, 1920 * 1080 * 2 };
+    std::vector<Block> blocks;
+    for(int round = 0; round < 20; round++) {
+        for(auto size: sizes) {
+            for(auto &block: blocks) {
+                arena.deallocate(block.ptr, block.size);
+            }
+            blocks.clear();
+            for(int i = 0; i < 8; i++) {
+                blocks.push_back({ allocateOrExit(arena, size + 256 * i), size + 256 * i });
+            }
+        }
+    }
+    ok &= check(arena.getMappedSize() <= regionSize, "the mapped size grows with the resolution changes: " + std::to_string(arena.getMappedSize()));
+    for(auto &block: blocks) {
+        arena.deallocate(block.ptr, block.size);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int numaNode = argc > 1 ? std::atoi(argv[1]) : -1;
+    int rounds   = argc > 2 ? std::atoi(argv[2]) : 10;
+    if(rounds < 1) {
+        rounds = 1;
+    }
+
+    DtlbMissCounter counter;
+    std::cout << "backend, cold alloc us, reuse alloc us, dTLB read misses per pass" << std::endl;
+
+    MallocFrameMemoryBackend mallocBackend;
+    runBenchmark(mallocBackend, rounds, counter);
+
+    ArenaFrameMemoryBackend arenaBackend(64 * 1024 * 1024, numaNode);
+    runBenchmark(arenaBackend, rounds, counter);
+
+    bool ok = checkArenaReuse(numaNode);
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
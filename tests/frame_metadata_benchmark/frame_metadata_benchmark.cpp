@@ -0,0 +1,174 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the cost of reading all the metadata fields of a frame with the G330 color and depth metadata parsers: one getMetadataValue() per
+// field on the first query, the repeated queries served by the cached values, and the bulk getMetadataValues(). The values of the three ways
+// are checked to be the same, and a frame with short metadata is checked to report no field. A parser reading the device state is checked to be
+// queried per field only.
+// usage: frame_metadata_benchmark [frame count]
+
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "libobsensor/h/Property.h"
+#include "gemini330/G330FrameMetadataParserContainer.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+template <typename T> static std::vector<uint8_t> makeMetadata(uint32_t seed) {
+    std::vector<uint8_t> metadata(sizeof(T));
+    for(size_t i = 0; i < metadata.size(); i++) {
+        metadata[i] = static_cast<uint8_t>(seed * 31 + i * 7);
+    }
+    return metadata;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static bool run(const std::string &name, std::shared_ptr<IFrameMetadataParserContainer> parsers, const std::vector<uint8_t> &metadata,
+                uint32_t frameCount) {
+    auto profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_COLOR, OB_FORMAT_Y8, 16, 16, 30);
+    bool ok      = true;
+
+    std::vector<OBFrameMetadataType> types;
+    for(int type = 0; type < OB_FRAME_METADATA_TYPE_COUNT; type++) {
+        if(parsers->isContained(static_cast<OBFrameMetadataType>(type))) {
+            types.push_back(static_cast<OBFrameMetadataType>(type));
+        }
+    }
+
+    std::vector<std::shared_ptr<Frame>> frames;
+    for(uint32_t i = 0; i < frameCount; i++) {
+        auto frame = FrameFactory::createFrameFromStreamProfile(profile);
+        frame->updateMetadata(metadata.data(), metadata.size());
+        frame->registerMetadataParsers(parsers);
+        frames.push_back(frame);
+    }
+
+    // reference values decoded by the parsers directly
+    std::vector<int64_t> expected;
+    for(auto type: types) {
+        expected.push_back(parsers->get(type)->getValue(metadata.data(), metadata.size()));
+    }
+
+    std::vector<int64_t> values(frames.size() * types.size());
+    int64_t              sum   = 0;
+    auto                 begin = std::chrono::steady_clock::now();
+    for(size_t f = 0; f < frames.size(); f++) {
+        for(size_t i = 0; i < types.size(); i++) {
+            values[f * types.size() + i] = frames[f]->getMetadataValue(types[i]);
+        }
+    }
+    double firstUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    for(size_t i = 0; i < values.size(); i++) {
+        ok = check(values[i] == expected[i % types.size()], "value of type " + std::to_string(types[i % types.size()]) + " mismatch") && ok;
+    }
+
+    begin = std::chrono::steady_clock::now();
+    for(auto &frame: frames) {
+        for(auto type: types) {
+            sum += frame->hasMetadata(type) ? frame->getMetadataValue(type) : 0;
+        }
+    }
+    double cachedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+    // the bulk decode on frames with the metadata just updated, so that the cached values are not reused
+    for(auto &frame: frames) {
+        frame->updateMetadata(metadata.data(), metadata.size());
+    }
+    begin = std::chrono::steady_clock::now();
+    for(auto &frame: frames) {
+        sum += frame->getMetadataValues().values[types.front()];
+    }
+    double bulkUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    for(auto &frame: frames) {
+        auto &bulkValues = frame->getMetadataValues();
+        for(size_t i = 0; i < types.size(); i++) {
+            ok = check((bulkValues.supportedMask & (1ull << types[i])) != 0, "type " + std::to_string(types[i]) + " not decoded") && ok;
+            ok = check(bulkValues.values[types[i]] == expected[i], "bulk value of type " + std::to_string(types[i]) + " mismatch") && ok;
+        }
+    }
+
+    // short metadata holds no field, and the values are decoded again after the update
+    auto frame = frames.front();
+    frame->updateMetadata(metadata.data(), 12);
+    ok = check(frame->getMetadataValues().supportedMask == 0, "fields decoded from short metadata") && ok;
+    ok = check(!frame->hasMetadata(types.front()), "hasMetadata() of short metadata") && ok;
+    try {
+        frame->getMetadataValue(types.front());
+        ok = check(false, "getMetadataValue() of short metadata does not throw");
+    }
+    catch(const libobsensor_exception &) {
+    }
+    ok = check(!frame->hasMetadata(OB_FRAME_METADATA_TYPE_COUNT), "hasMetadata() of invalid type") && ok;
+
+    // the copied frame reuses the decoded values
+    frame->updateMetadata(metadata.data(), metadata.size());
+    frame->getMetadataValues();
+    auto copied = FrameFactory::createFrameFromStreamProfile(profile);
+    copied->copyInfoFromOther(frame);
+    ok = check(std::memcmp(&copied->getMetadataValues(), &frame->getMetadataValues(), sizeof(OBFrameMetadataValues)) == 0, "copied values mismatch") && ok;
+
+    std::cout << name << ": " << types.size() << " fields, per frame: first query " << firstUs / frameCount << "us, cached query " << cachedUs / frameCount
+              << "us, bulk decode " << bulkUs / frameCount << "us (checksum " << sum << ")" << std::endl;
+    return ok;
+}
+
+// Stands for a parser reading the device state, counts the queries
+class DeviceStateParser : public IFrameMetadataParser {
+public:
+    int64_t getValue(const uint8_t *metadata, size_t dataSize) override {
+        (void)metadata;
+        (void)dataSize;
+        return ++queryCount;
+    }
+
+    bool isSupported(const uint8_t *metadata, size_t dataSize) override {
+        (void)metadata;
+        (void)dataSize;
+        return true;
+    }
+
+    int64_t queryCount = 0;
+};
+
+static bool checkDeviceStateParser(const std::vector<uint8_t> &metadata) {
+    auto profile     = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_COLOR, OB_FORMAT_Y8, 16, 16, 30);
+    auto parsers     = std::make_shared<G330ColorFrameMetadataParserContainer>(nullptr);
+    auto stateParser = std::make_shared<DeviceStateParser>();
+    parsers->registerParser(OB_FRAME_METADATA_TYPE_ACTUAL_FRAME_RATE, stateParser);
+
+    auto frame = FrameFactory::createFrameFromStreamProfile(profile);
+    frame->updateMetadata(metadata.data(), metadata.size());
+    frame->registerMetadataParsers(parsers);
+    bool ok = check((frame->getMetadataValues().supportedMask & (1ull << OB_FRAME_METADATA_TYPE_ACTUAL_FRAME_RATE)) == 0, "device state decoded in bulk");
+    ok      = check(stateParser->queryCount == 0, "device state parser called by the bulk decode") && ok;
+    ok      = check(frame->hasMetadata(OB_FRAME_METADATA_TYPE_ACTUAL_FRAME_RATE), "hasMetadata() of the device state") && ok;
+    ok      = check(frame->getMetadataValue(OB_FRAME_METADATA_TYPE_ACTUAL_FRAME_RATE) == 1, "device state value mismatch") && ok;
+    ok      = check(frame->getMetadataValue(OB_FRAME_METADATA_TYPE_ACTUAL_FRAME_RATE) == 2, "device state value cached") && ok;
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t frameCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2000;
+    if(frameCount == 0) {
+        frameCount = 2000;
+    }
+    bool ok = true;
+    ok = run("G330 color", std::make_shared<G330ColorFrameMetadataParserContainer>(nullptr), makeMetadata<G330ColorUvcMetadata>(1), frameCount) && ok;
+    ok = run("G330 depth", std::make_shared<G330DepthFrameMetadataParserContainer>(nullptr), makeMetadata<G330DepthUvcMetadata>(2), frameCount) && ok;
+    ok = checkDeviceStateParser(makeMetadata<G330ColorUvcMetadata>(3)) && ok;
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
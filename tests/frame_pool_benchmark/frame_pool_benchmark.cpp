@@ -0,0 +1,95 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the frame acquire/reclaim throughput of the frame memory pool across N producer threads, and the pool misses (memory allocations) of
+// each round, which should be zero once the pool is warmed up.
+// usage: frame_pool_benchmark [max thread count] [iterations per thread]
+
+extern "C" {
+#include <libobsensor/h/Context.h>
+#include <libobsensor/h/Frame.h>
+#include <libobsensor/h/Error.h>
+}
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+void check_ob_error(ob_error **err) {
+    if(*err) {
+        std::cerr << "Error: " << ob_error_get_message(*err) << std::endl;
+        ob_delete_error(*err);
+        exit(-1);
+    }
+    *err = nullptr;
+}
+
+// Each producer keeps a few frames in flight to simulate the frame queues of the pipeline and filters
+static const int IN_FLIGHT_FRAME_COUNT = 4;
+
+void producer(int iterations, std::atomic<bool> *start) {
+    ob_error *err                             = nullptr;
+    ob_frame *inFlight[IN_FLIGHT_FRAME_COUNT] = { nullptr };
+    while(!start->load()) {
+        std::this_thread::yield();
+    }
+    for(int i = 0; i < iterations; i++) {
+        auto &slot = inFlight[i % IN_FLIGHT_FRAME_COUNT];
+        if(slot) {
+            ob_delete_frame(slot, &err);
+            check_ob_error(&err);
+        }
+        slot = ob_create_video_frame(OB_FRAME_DEPTH, OB_FORMAT_Y16, 640, 480, OB_DEFAULT_STRIDE_BYTES, &err);
+        check_ob_error(&err);
+    }
+    for(auto &slot: inFlight) {
+        if(slot) {
+            ob_delete_frame(slot, &err);
+            check_ob_error(&err);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = argc > 1 ? std::atoi(argv[1]) : 8;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+    ob_error   *err     = nullptr;
+    ob_context *context = ob_create_context(&err);
+    check_ob_error(&err);
+
+    // warm up the frame memory pool
+    std::atomic<bool> warmUp(true);
+    producer(1000, &warmUp);
+
+    std::cout << "threads, total frames, elapsed ms, frames/s, pool misses" << std::endl;
+    for(int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        auto statsBefore = ob_get_frame_memory_pool_statistics(context, &err);
+        check_ob_error(&err);
+
+        std::atomic<bool>        start(false);
+        std::vector<std::thread> threads;
+        for(int i = 0; i < threadCount; i++) {
+            threads.emplace_back(producer, iterations, &start);
+        }
+        auto begin = std::chrono::steady_clock::now();
+        start      = true;
+        for(auto &t: threads) {
+            t.join();
+        }
+        auto   elapsedMs   = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        double totalFrames = static_cast<double>(threadCount) * iterations;
+
+        auto statsAfter = ob_get_frame_memory_pool_statistics(context, &err);
+        check_ob_error(&err);
+        std::cout << threadCount << ", " << static_cast<uint64_t>(totalFrames) << ", " << elapsedMs << ", " << static_cast<uint64_t>(totalFrames * 1000.0 / elapsedMs)
+                  << ", " << statsAfter.missCount - statsBefore.missCount << std::endl;
+    }
+
+    ob_delete_context(context, &err);
+    check_ob_error(&err);
+    return 0;
+}
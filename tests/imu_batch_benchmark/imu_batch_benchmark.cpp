@@ -0,0 +1,183 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Correct synthetic IMU samples with the IMUCorrector, one frame set per sample as in the default output mode and one frame set per batch of samples
+// as in the batched output mode (OB_PROP_SDK_IMU_BATCH_SIZE_INT), report the cost per sample and check that both modes give the same values, also
+// after the IMUFrameReversion.
+// usage: imu_batch_benchmark [batch size] [sample count]
+
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "publicfilters/IMUCorrector.hpp"
+#include "publicfilters/IMUFrameReversion.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+struct Sample {
+    uint64_t timestampUs;
+    float    accel[3];
+    float    gyro[3];
+    float    temperature;
+};
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static bool nearlyEqual(float a, float b) {
+    return std::fabs(a - b) <= 1e-4f * (std::max)(1.0f, std::fabs(a));
+}
+
+int main(int argc, char **argv) {
+    uint32_t batchSize   = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100;
+    uint32_t sampleCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 20000;
+    sampleCount -= sampleCount % batchSize;
+
+    auto             accelProfile = StreamProfileFactory::createAccelStreamProfile(OB_ACCEL_FS_4g, OB_SAMPLE_RATE_1_KHZ);
+    auto             gyroProfile  = StreamProfileFactory::createGyroStreamProfile(OB_GYRO_FS_1000dps, OB_SAMPLE_RATE_1_KHZ);
+    OBAccelIntrinsic accelIntrinsic{};
+    OBGyroIntrinsic  gyroIntrinsic{};
+    const double     scaleMisalignment[9] = { 1.01, 0.002, -0.003, 0.001, 0.99, 0.004, -0.002, 0.003, 1.02 };
+    const double     bias[3]              = { 0.012, -0.021, 0.034 };
+    for(int i = 0; i < 9; i++) {
+        accelIntrinsic.scaleMisalignment[i] = scaleMisalignment[i];
+        gyroIntrinsic.scaleMisalignment[i]  = scaleMisalignment[i];
+    }
+    for(int i = 0; i < 3; i++) {
+        accelIntrinsic.bias[i] = bias[i];
+        gyroIntrinsic.bias[i]  = -bias[i];
+    }
+    accelProfile->bindIntrinsic(accelIntrinsic);
+    gyroProfile->bindIntrinsic(gyroIntrinsic);
+
+    std::mt19937                          rng(7);
+    std::uniform_real_distribution<float> dist(-4.0f, 4.0f);
+    std::vector<Sample>                   samples(sampleCount);
+    for(uint32_t i = 0; i < sampleCount; i++) {
+        samples[i] = { 1000000ull + i * 1000ull, { dist(rng), dist(rng), dist(rng) }, { dist(rng) * 100, dist(rng) * 100, dist(rng) * 100 }, 30.0f + i % 7 };
+    }
+
+    std::shared_ptr<IFilterBase> corrector = std::make_shared<IMUCorrector>();
+    bool                         ok        = true;
+
+    // Default output mode: one frame set of one accel and one gyro frame per sample
+    std::vector<std::shared_ptr<Frame>> singleResults;
+    singleResults.reserve(sampleCount);
+    auto start = std::chrono::steady_clock::now();
+    for(auto &sample: samples) {
+        auto frameSet  = FrameFactory::createFrameSet();
+        auto accel     = FrameFactory::createFrameFromStreamProfile(accelProfile);
+        auto gyro      = FrameFactory::createFrameFromStreamProfile(gyroProfile);
+        auto accelData = reinterpret_cast<AccelFrame::Data *>(accel->getDataMutable());
+        auto gyroData  = reinterpret_cast<GyroFrame::Data *>(gyro->getDataMutable());
+        accelData->value = { sample.accel[0], sample.accel[1], sample.accel[2] };
+        accelData->temp  = sample.temperature;
+        gyroData->value  = { sample.gyro[0], sample.gyro[1], sample.gyro[2] };
+        gyroData->temp   = sample.temperature;
+        accel->setTimeStampUsec(sample.timestampUs);
+        gyro->setTimeStampUsec(sample.timestampUs);
+        frameSet->pushFrame(std::move(accel));
+        frameSet->pushFrame(std::move(gyro));
+        singleResults.push_back(corrector->process(frameSet));
+    }
+    auto singleNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / sampleCount;
+
+    // Batched output mode: one frame set per batch, corrected in one pass over the sample arrays
+    std::vector<std::shared_ptr<Frame>> batchResults;
+    batchResults.reserve(sampleCount / batchSize);
+    start = std::chrono::steady_clock::now();
+    for(uint32_t first = 0; first < sampleCount; first += batchSize) {
+        auto frameSet   = FrameFactory::createFrameSet();
+        auto accel      = FrameFactory::createFrameFromStreamProfile(accelProfile, ImuSampleBatch::calcDataSize(batchSize));
+        auto gyro       = FrameFactory::createFrameFromStreamProfile(gyroProfile, ImuSampleBatch::calcDataSize(batchSize));
+        auto accelBatch = ImuSampleBatch::init(accel.get(), batchSize);
+        auto gyroBatch  = ImuSampleBatch::init(gyro.get(), batchSize);
+        for(uint32_t i = 0; i < batchSize; i++) {
+            auto &sample              = samples[first + i];
+            accelBatch.timestampUs[i] = sample.timestampUs;
+            accelBatch.x[i]           = sample.accel[0];
+            accelBatch.y[i]           = sample.accel[1];
+            accelBatch.z[i]           = sample.accel[2];
+            accelBatch.temperature[i] = sample.temperature;
+            gyroBatch.timestampUs[i]  = sample.timestampUs;
+            gyroBatch.x[i]            = sample.gyro[0];
+            gyroBatch.y[i]            = sample.gyro[1];
+            gyroBatch.z[i]            = sample.gyro[2];
+            gyroBatch.temperature[i]  = sample.temperature;
+        }
+        accel->setTimeStampUsec(accelBatch.timestampUs[batchSize - 1]);
+        gyro->setTimeStampUsec(gyroBatch.timestampUs[batchSize - 1]);
+        frameSet->pushFrame(std::move(accel));
+        frameSet->pushFrame(std::move(gyro));
+        batchResults.push_back(corrector->process(frameSet));
+    }
+    auto batchNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / sampleCount;
+
+    std::cout << sampleCount << " samples, per sample: " << singleNs << "ns in default mode, " << batchNs << "ns in batches of " << batchSize << std::endl;
+
+    uint32_t mismatchCount = 0;
+    for(uint32_t i = 0; i < sampleCount && mismatchCount < 5; i++) {
+        auto single       = singleResults[i]->as<FrameSet>();
+        auto batched      = batchResults[i / batchSize]->as<FrameSet>();
+        auto index        = i % batchSize;
+        auto singleAccel  = single->getFrame(OB_FRAME_ACCEL)->as<AccelFrame>()->getSamples();
+        auto batchedAccel = batched->getFrame(OB_FRAME_ACCEL)->as<AccelFrame>()->getSamples();
+        auto singleGyro   = single->getFrame(OB_FRAME_GYRO)->as<GyroFrame>()->getSamples();
+        auto batchedGyro  = batched->getFrame(OB_FRAME_GYRO)->as<GyroFrame>()->getSamples();
+        bool match        = singleAccel.count == 1 && batchedAccel.count == batchSize && batchedGyro.count == batchSize
+                     && singleAccel.timestampUs[0] == batchedAccel.timestampUs[index] && nearlyEqual(singleAccel.x[0], batchedAccel.x[index])
+                     && nearlyEqual(singleAccel.y[0], batchedAccel.y[index]) && nearlyEqual(singleAccel.z[0], batchedAccel.z[index])
+                     && nearlyEqual(singleGyro.x[0], batchedGyro.x[index]) && nearlyEqual(singleGyro.y[0], batchedGyro.y[index])
+                     && nearlyEqual(singleGyro.z[0], batchedGyro.z[index]) && singleGyro.temperature[0] == batchedGyro.temperature[index];
+        if(!check(match, "sample " + std::to_string(i) + " differs between the default and the batched mode")) {
+            mismatchCount++;
+        }
+    }
+    ok &= mismatchCount == 0;
+
+    // The value of a batched frame is the latest sample
+    auto lastBatch = batchResults.back()->as<FrameSet>()->getFrame(OB_FRAME_ACCEL)->as<AccelFrame>();
+    auto value     = const_cast<AccelFrame *>(lastBatch.get())->value();
+    auto last      = singleResults.back()->as<FrameSet>()->getFrame(OB_FRAME_ACCEL)->as<AccelFrame>()->getSamples();
+    ok &= check(nearlyEqual(value.x, last.x[0]) && nearlyEqual(value.y, last.y[0]) && nearlyEqual(value.z, last.z[0]),
+                "value of the batched frame is not the latest sample");
+    ok &= check(lastBatch->getTimeStampUsec() == last.timestampUs[0], "timestamp of the batched frame is not the latest sample");
+
+    // The IMUFrameReversion negates every sample of a batch, not only the value
+    std::shared_ptr<IFilterBase> reversion     = std::make_shared<IMUFrameReversion>();
+    uint32_t                     reverseErrors = 0;
+    for(uint32_t first = 0; first < sampleCount && reverseErrors < 5; first += batchSize) {
+        auto corrected = batchResults[first / batchSize]->as<FrameSet>();
+        auto reversed  = reversion->process(corrected)->as<FrameSet>();
+        for(auto frameType: { OB_FRAME_ACCEL, OB_FRAME_GYRO }) {
+            auto before   = ImuSampleBatch::get(corrected->getFrame(frameType).get());
+            auto frame    = reversed->getFrame(frameType);
+            auto after    = ImuSampleBatch::get(frame.get());
+            auto afterVal = reinterpret_cast<const AccelFrame::Data *>(frame->getData())->value;
+            bool match    = after.count == batchSize && afterVal.x == after.x[batchSize - 1] && afterVal.y == after.y[batchSize - 1]
+                         && afterVal.z == after.z[batchSize - 1];
+            for(uint32_t i = 0; match && i < batchSize; i++) {
+                match = after.x[i] == -before.x[i] && after.y[i] == -before.y[i] && after.z[i] == -before.z[i]
+                        && after.timestampUs[i] == before.timestampUs[i];
+            }
+            if(!check(match, "batch at sample " + std::to_string(first) + " is not reversed")) {
+                reverseErrors++;
+            }
+        }
+    }
+    ok &= reverseErrors == 0;
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
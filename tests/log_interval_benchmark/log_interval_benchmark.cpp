@@ -0,0 +1,112 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the per-call cost of the interval controlled logs (LOG_XXX_INTVL) when they are suppressed, as in the per-frame paths of a misbehaving
+// device, and check that every call is accounted for in the emitted logs and the summaries output by the background flusher.
+// usage: log_interval_benchmark [thread count] [call count per thread]
+
+#include "logger/Logger.hpp"
+#include "logger/LoggerInterval.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+static std::mutex               logMutex;
+static std::vector<std::string> logMessages;
+
+class PacketParser {
+public:
+    void onBadPacket(uint32_t index) {
+        LOG_WARN_INTVL_MS(200, "bad packet! index={}", index);
+    }
+};
+
+// Number of calls accounted for by the logs containing the tag: 1 for a plain log, N for the "[**N logs in" suffix
+static uint64_t countLoggedCalls(const std::string &tag) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    uint64_t                    total = 0;
+    for(auto &msg: logMessages) {
+        if(msg.find(tag) == std::string::npos) {
+            continue;
+        }
+        auto pos = msg.find("[**");
+        total += pos == std::string::npos ? 1 : std::strtoull(msg.c_str() + pos + 3, nullptr, 10);
+    }
+    return total;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+int main(int argc, char **argv) {
+    uint32_t threadCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 4;
+    uint32_t callCount   = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 2000000;
+
+    Logger::setFileLogConfig(OB_LOG_SEVERITY_OFF);
+    Logger::setConsoleLogSeverity(OB_LOG_SEVERITY_OFF);
+    Logger::setLogCallback(OB_LOG_SEVERITY_WARN, [](OBLogSeverity, const std::string &msg) {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logMessages.push_back(msg);
+    });
+    auto logger = Logger::getInstance();
+    bool ok     = true;
+
+    // Many threads hitting the same call site of the same object
+    PacketParser             parser;
+    std::vector<std::thread> threads;
+    auto                     start = std::chrono::steady_clock::now();
+    for(uint32_t t = 0; t < threadCount; t++) {
+        threads.emplace_back([&parser, callCount]() {
+            for(uint32_t i = 0; i < callCount; i++) {
+                parser.onBadPacket(i);
+            }
+        });
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+    auto   elapsed  = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    double perCall  = elapsed / callCount;
+    size_t logCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        logCount = logMessages.size();
+    }
+    std::cout << threadCount << " threads x " << callCount << " calls: " << perCall << "ns per call, " << logCount
+              << " logs emitted" << std::endl;
+
+    // The summary of the suppressed calls is output by the flusher without any further call, once the (possibly lengthened) interval expires
+    uint64_t expected = static_cast<uint64_t>(threadCount) * callCount;
+    for(int i = 0; i < 200 && countLoggedCalls("bad packet!") != expected; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ok &= check(countLoggedCalls("bad packet!") == expected, "calls lost before flush: " + std::to_string(countLoggedCalls("bad packet!")) + " of "
+                                                                  + std::to_string(expected));
+
+    // Another object at the same call site is controlled separately, so its first log is emitted immediately
+    PacketParser other;
+    auto         before = countLoggedCalls("index=4242");
+    other.onBadPacket(4242);
+    ok &= check(countLoggedCalls("index=4242") == before + 1, "log of another object suppressed");
+
+    // Pending summaries are output when the logger is destroyed
+    for(uint32_t i = 0; i < 10; i++) {
+        other.onBadPacket(i);
+    }
+    logger.reset();
+    ok &= check(countLoggedCalls("bad packet!") == expected + 11, "pending summary not flushed on logger destruction");
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Decode a set of MJPEG frames at 1080p and 4K to RGB and report the fps of each configuration: a TurboJPEG handle created for each frame (the
+// former behavior of the format converter), the format converter with its persistent handle, and the format converter filter decoding 1/2/4
+// consecutive frames in parallel. The outputs of all configurations are checked to be the same as the serial decoding and in the input order.
+// The MJPEG frames are encoded from synthetic images with TurboJPEG on startup, with the 4:2:2 subsampling used by the UVC color cameras.
+// The format converter decoding at 1/2, 1/4 and 1/8 of the resolution is checked to output the TurboJPEG scaled decoding with the scaled stream profile,
+// and to output the full resolution once switched to the MJPEG to NV12 conversion.
+// usage: mjpeg_decode_benchmark [frames per configuration]
+
+#include "FilterDecorator.hpp"
+#include "publicfilters/FormatConverterProcess.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+#include "stream/StreamProfile.hpp"
+
+#include <turbojpeg.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+static const int SOURCE_FRAME_COUNT = 4;
+static const int MAX_PENDING_FRAMES = 8;  // keep the frame queue of the filter (capacity 10) from dropping frames
+
+static uint64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Smooth gradients and waves with a little noise, which compresses to a size close to a camera image
+static std::vector<uint8_t> encodeSyntheticJpeg(int width, int height, int seed) {
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+    uint32_t             noise = 12345u + static_cast<uint32_t>(seed) * 7919u;
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            noise          = noise * 1103515245u + 12345u;
+            auto  n        = static_cast<int>((noise >> 16) & 0x0f) - 8;
+            float fx       = static_cast<float>(x) / width;
+            float fy       = static_cast<float>(y) / height;
+            auto  pixel    = &rgb[(static_cast<size_t>(y) * width + x) * 3];
+            auto  wave     = std::sin(fx * 40.0f + seed) * std::cos(fy * 25.0f - seed);
+            int   values[] = { static_cast<int>(255 * fx + 40 * wave) + n, static_cast<int>(255 * fy - 40 * wave) + n,
+                               static_cast<int>(128 + 100 * wave * fx) + n };
+            for(int c = 0; c < 3; c++) {
+                pixel[c] = static_cast<uint8_t>(values[c] < 0 ? 0 : (values[c] > 255 ? 255 : values[c]));
+            }
+        }
+    }
+
+    tjhandle       handle   = tjInitCompress();
+    unsigned char *jpegBuf  = nullptr;
+    unsigned long  jpegSize = 0;
+    if(tjCompress2(handle, rgb.data(), width, 0, height, TJPF_RGB, &jpegBuf, &jpegSize, TJSAMP_422, 90, TJFLAG_FASTDCT) != 0) {
+        std::cerr << "Failed to encode the test frame: " << tjGetErrorStr2(handle) << std::endl;
+        std::exit(1);
+    }
+    std::vector<uint8_t> jpeg(jpegBuf, jpegBuf + jpegSize);
+    tjFree(jpegBuf);
+    tjDestroy(handle);
+    return jpeg;
+}
+
+struct TestSet {
+    int                                  width;
+    int                                  height;
+    std::vector<std::shared_ptr<Frame>>  mjpegFrames;
+    std::vector<std::vector<uint8_t>>    references;  // serial decoding of each mjpeg frame
+    std::shared_ptr<const StreamProfile> profile;
+};
+
+static TestSet createTestSet(int width, int height) {
+    TestSet set;
+    set.width   = width;
+    set.height  = height;
+    auto profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_COLOR, OB_FORMAT_MJPG, width, height, 30);
+    profile->bindIntrinsic({ width * 0.7f, width * 0.7f, width * 0.5f - 3.0f, height * 0.5f + 2.0f, static_cast<int16_t>(width),
+                             static_cast<int16_t>(height) });
+    set.profile = profile;
+    size_t totalSize = 0;
+    for(int i = 0; i < SOURCE_FRAME_COUNT; i++) {
+        auto jpeg  = encodeSyntheticJpeg(width, height, i);
+        auto frame = FrameFactory::createFrameFromStreamProfile(set.profile);
+        frame->updateData(jpeg.data(), jpeg.size());
+        set.mjpegFrames.push_back(frame);
+        totalSize += jpeg.size();
+    }
+    std::cout << width << "x" << height << ": " << SOURCE_FRAME_COUNT << " mjpeg frames, average size " << totalSize / SOURCE_FRAME_COUNT / 1024 << " KB"
+              << std::endl;
+    return set;
+}
+
+static std::shared_ptr<Frame> getSourceFrame(const TestSet &set, int index) {
+    auto frame = FrameFactory::createFrameFromOtherFrame(set.mjpegFrames[index % SOURCE_FRAME_COUNT], true);
+    frame->setNumber(static_cast<uint64_t>(index));
+    return frame;
+}
+
+static bool checkOutput(const TestSet &set, const std::shared_ptr<Frame> &frame, int index) {
+    auto &reference = set.references[index % SOURCE_FRAME_COUNT];
+    return frame && frame->getNumber() == static_cast<uint64_t>(index) && frame->getDataSize() == reference.size()
+           && memcmp(frame->getData(), reference.data(), reference.size()) == 0;
+}
+
+static void report(const std::string &name, int frameCount, uint64_t elapsedUs, bool ok) {
+    std::cout << "  " << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(1) << std::setw(8)
+              << frameCount * 1000000.0 / elapsedUs << " fps" << (ok ? "" : "  MISMATCH") << std::endl;
+}
+
+static bool runHandlePerFrame(const TestSet &set, int frameCount) {
+    std::vector<uint8_t> rgb(static_cast<size_t>(set.width) * set.height * 3);
+    bool                 ok    = true;
+    auto                 start = nowUs();
+    for(int i = 0; i < frameCount; i++) {
+        auto     frame  = getSourceFrame(set, i);
+        tjhandle handle = tjInitDecompress();
+        tjDecompress2(handle, frame->getData(), static_cast<unsigned long>(frame->getDataSize()), rgb.data(), set.width, 0, set.height, TJPF_RGB,
+                      TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE);
+        tjDestroy(handle);
+        ok = ok && memcmp(rgb.data(), set.references[i % SOURCE_FRAME_COUNT].data(), rgb.size()) == 0;
+    }
+    report("handle per frame", frameCount, nowUs() - start, ok);
+    return ok;
+}
+
+static bool runConverter(const TestSet &set, int frameCount) {
+    auto converter = std::make_shared<FormatConverter>();
+    converter->setConversion(OB_FORMAT_MJPG, OB_FORMAT_RGB);
+    bool ok    = true;
+    auto start = nowUs();
+    for(int i = 0; i < frameCount; i++) {
+        ok = checkOutput(set, converter->process(getSourceFrame(set, i)), i) && ok;
+    }
+    report("persistent handle", frameCount, nowUs() - start, ok);
+    return ok;
+}
+
+static bool runConverterFilter(const TestSet &set, int frameCount, uint32_t threadCount) {
+    auto converter = std::make_shared<FormatConverter>();
+    converter->setConversion(OB_FORMAT_MJPG, OB_FORMAT_RGB);
+    auto filter = std::make_shared<FilterDecorator>("FormatConverter", converter);
+    filter->setProcessThreadCount(threadCount);
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    int                     outputCount = 0;
+    bool                    ok          = true;
+    filter->setCallback([&](std::shared_ptr<Frame> frame) {
+        bool frameOk = checkOutput(set, frame, outputCount);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ok = ok && frameOk;
+            outputCount++;
+        }
+        cv.notify_all();
+    });
+
+    auto start = nowUs();
+    for(int i = 0; i < frameCount; i++) {
+        auto frame = getSourceFrame(set, i);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]() { return i - outputCount < MAX_PENDING_FRAMES; });
+        }
+        filter->pushFrame(frame);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait_for(lock, std::chrono::seconds(60), [&]() { return outputCount == frameCount; });
+        ok = ok && outputCount == frameCount;
+    }
+    report("filter, " + std::to_string(threadCount) + " decode thread(s)", frameCount, nowUs() - start, ok);
+    filter.reset();
+    return ok;
+}
+
+static bool runScaledConverter(const TestSet &set, int frameCount, uint32_t scale) {
+    auto converter = std::make_shared<FormatConverter>();
+    converter->setConversion(OB_FORMAT_MJPG, OB_FORMAT_RGB);
+    converter->setDecodeScale(scale);
+
+    // Reference: TurboJPEG decoding at the same scaling factor
+    int                               width  = (set.width + static_cast<int>(scale) - 1) / static_cast<int>(scale);
+    int                               height = (set.height + static_cast<int>(scale) - 1) / static_cast<int>(scale);
+    std::vector<std::vector<uint8_t>> references;
+    tjhandle                          handle = tjInitDecompress();
+    for(auto &frame: set.mjpegFrames) {
+        std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+        tjDecompress2(handle, frame->getData(), static_cast<unsigned long>(frame->getDataSize()), rgb.data(), width, 0, height, TJPF_RGB,
+                      TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE);
+        references.push_back(rgb);
+    }
+    tjDestroy(handle);
+
+    bool ok    = true;
+    auto start = nowUs();
+    for(int i = 0; i < frameCount; i++) {
+        auto  frame     = converter->process(getSourceFrame(set, i));
+        auto &reference = references[i % SOURCE_FRAME_COUNT];
+        ok              = ok && frame && frame->getDataSize() == reference.size() && memcmp(frame->getData(), reference.data(), reference.size()) == 0;
+    }
+    auto elapsedUs = nowUs() - start;
+
+    // The output profile has the scaled resolution and the intrinsics of the scaled pixel grid
+    auto frame = converter->process(getSourceFrame(set, 0));
+    if(frame) {
+        auto videoFrame = frame->as<VideoFrame>();
+        auto src        = set.profile->as<VideoStreamProfile>()->getIntrinsic();
+        auto dst        = frame->getStreamProfile()->as<VideoStreamProfile>()->getIntrinsic();
+        ok              = ok && videoFrame->getWidth() == static_cast<uint32_t>(width) && videoFrame->getHeight() == static_cast<uint32_t>(height)
+             && dst.width == width && dst.height == height && std::fabs(dst.fx * scale - src.fx) < 1e-3f && std::fabs(dst.fy * scale - src.fy) < 1e-3f
+             && std::fabs((dst.cx + 0.5f) * scale - 0.5f - src.cx) < 1e-3f && std::fabs((dst.cy + 0.5f) * scale - 0.5f - src.cy) < 1e-3f;
+    }
+
+    // Switching the config to a conversion without scaled decoding outputs the full resolution again
+    converter->updateTypedConfig({ static_cast<double>(FORMAT_MJPG_TO_NV12), static_cast<double>(scale) });
+    auto nv12Frame = converter->process(getSourceFrame(set, 0));
+    if(nv12Frame) {
+        auto videoFrame = nv12Frame->as<VideoFrame>();
+        auto nv12Size   = static_cast<size_t>(set.width) * set.height * 3 / 2;
+        ok              = ok && nv12Frame->getFormat() == OB_FORMAT_NV12 && videoFrame->getWidth() == static_cast<uint32_t>(set.width)
+             && videoFrame->getHeight() == static_cast<uint32_t>(set.height) && nv12Frame->getDataBufSize() >= nv12Size;
+    }
+    report("persistent handle, 1/" + std::to_string(scale) + " scale", frameCount, elapsedUs, ok && frame && nv12Frame);
+    return ok && frame && nv12Frame;
+}
+
+int main(int argc, char **argv) {
+    int frameCount = argc > 1 ? std::atoi(argv[1]) : 60;
+    if(frameCount <= 0) {
+        frameCount = 60;
+    }
+
+    bool ok = true;
+    for(auto &resolution: { std::make_pair(1920, 1080), std::make_pair(3840, 2160) }) {
+        auto set = createTestSet(resolution.first, resolution.second);
+
+        FormatConverter referenceConverter;
+        referenceConverter.setConversion(OB_FORMAT_MJPG, OB_FORMAT_RGB);
+        for(auto &mjpegFrame: set.mjpegFrames) {
+            auto rgbFrame = referenceConverter.process(mjpegFrame);
+            if(!rgbFrame) {
+                std::cerr << "Failed to decode the test frame" << std::endl;
+                return 1;
+            }
+            set.references.emplace_back(rgbFrame->getData(), rgbFrame->getData() + rgbFrame->getDataSize());
+        }
+
+        ok = runHandlePerFrame(set, frameCount) && ok;
+        ok = runConverter(set, frameCount) && ok;
+        for(uint32_t threadCount: { 1u, 2u, 4u }) {
+            ok = runConverterFilter(set, frameCount, threadCount) && ok;
+        }
+        for(uint32_t scale: { 2u, 4u, 8u }) {
+            ok = runScaledConverter(set, frameCount, scale) && ok;
+        }
+    }
+
+    std::cout << (ok ? "All outputs match the serial decoding" : "Output mismatch!") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Replay synthetic framesets of several devices through the MultiDeviceFrameAggregator and check the grouping. Each device captures at the same
+// nominal times with a capture jitter; the device timestamp has a per-device offset and the global timestamp is the nominal time plus the jitter.
+// The framesets are pushed in the order of their arrival time on a single thread, so the run is deterministic for a given seed. The frame number
+// is the nominal capture index, which is used to check that the framesets captured at the same time are grouped together.
+// usage: multi_device_frame_aggregator [seed] [duration seconds]
+
+#include "MultiDeviceFrameAggregator.hpp"
+#include "frame/FrameFactory.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+struct SourceSpec {
+    uint32_t captureJitterUs;
+    uint32_t delayUs;
+    uint32_t delayJitterUs;
+    uint32_t dropPercent;      // framesets lost by the device
+    uint64_t stallBeginUs;     // framesets captured in [stallBeginUs, stallEndUs) are not delivered
+    uint64_t stallEndUs;
+    uint64_t lateBeginUs;      // framesets captured in [lateBeginUs, lateEndUs) are delivered lateDelayUs later
+    uint64_t lateEndUs;
+    uint64_t lateDelayUs;
+    bool     globalTimestamp;  // false if the device does not support the global timestamp
+};
+
+struct ReplayEvent {
+    uint64_t arrivalUs;
+    uint64_t timestampUs;
+    uint64_t index;
+    uint32_t sourceIndex;
+};
+
+// Deterministic generator, independent of the standard library implementation
+class Lcg {
+public:
+    explicit Lcg(uint32_t seed) : state_(seed * 2654435761u + 1) {}
+    uint32_t nextU32() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return state_ >> 8;
+    }
+    int32_t next(uint32_t range) {  // [-range, range]
+        auto value = nextU32();
+        return range == 0 ? 0 : static_cast<int32_t>(value % (2 * range + 1)) - static_cast<int32_t>(range);
+    }
+
+private:
+    uint32_t state_;
+};
+
+static const uint64_t START_US    = 1000000;  // leave room for the negative jitter
+static const uint64_t INTERVAL_US = 33333;
+
+static std::vector<ReplayEvent> generateEvents(const std::vector<SourceSpec> &sources, uint32_t seed, uint32_t durationSec,
+                                               std::vector<bool> &completeIndices) {
+    std::vector<ReplayEvent> events;
+    Lcg                      lcg(seed);
+    auto                     count = durationSec * 1000000ull / INTERVAL_US;
+    completeIndices.assign(count, true);
+    for(uint32_t s = 0; s < sources.size(); s++) {
+        auto    &spec      = sources[s];
+        uint64_t lastArrival = 0;
+        for(uint64_t i = 0; i < count; i++) {
+            auto nominalUs = START_US + i * INTERVAL_US;
+            if(lcg.nextU32() % 100 < spec.dropPercent || (nominalUs >= spec.stallBeginUs && nominalUs < spec.stallEndUs)) {
+                completeIndices[i] = false;
+                continue;
+            }
+            ReplayEvent event;
+            event.timestampUs = nominalUs + lcg.next(spec.captureJitterUs);
+            event.arrivalUs   = event.timestampUs + spec.delayUs + lcg.next(spec.delayJitterUs);
+            if(nominalUs >= spec.lateBeginUs && nominalUs < spec.lateEndUs) {
+                event.arrivalUs += spec.lateDelayUs;
+            }
+            // framesets of a device arrive in order
+            event.arrivalUs   = std::max(event.arrivalUs, lastArrival);
+            lastArrival       = event.arrivalUs;
+            event.index       = i;
+            event.sourceIndex = s;
+            events.push_back(event);
+        }
+    }
+    std::stable_sort(events.begin(), events.end(), [](const ReplayEvent &x, const ReplayEvent &y) { return x.arrivalUs < y.arrivalUs; });
+    return events;
+}
+
+struct ReplayResult {
+    std::vector<std::vector<uint64_t>> groups;  // the frame numbers of the framesets of each composite frameset, by source index
+    uint64_t                           maxSpreadUs;
+    uint64_t                           maxPendingCount;
+    uint64_t                           maxLatencyUs;  // the newest pushed timestamp minus the timestamp of the group when it is output
+    double                             pushCostUs;
+    OBMultiDeviceFrameSyncStatistics   statistics;
+};
+
+static ReplayResult replay(const std::vector<SourceSpec> &sources, const std::vector<ReplayEvent> &events, const OBMultiDeviceFrameSyncConfig &config) {
+    auto profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_COLOR, OB_FORMAT_Y8, 16, 16, 30);
+
+    ReplayResult result     = {};
+    uint64_t     newestUs   = 0;
+    auto         sourceCount = static_cast<uint32_t>(sources.size());
+
+    MultiDeviceFrameAggregator aggregator(sourceCount);
+    aggregator.setConfig(config);
+    aggregator.setCallback([&](std::shared_ptr<const Frame> frame) {
+        auto                  composite = frame->as<FrameSet>();
+        std::vector<uint64_t> numbers;
+        uint64_t              minTsp = UINT64_MAX, maxTsp = 0;
+        for(uint32_t i = 0; i < composite->getCount(); i++) {
+            auto frameset = composite->getFrame(static_cast<int>(i))->as<FrameSet>();
+            auto subFrame = frameset->getFrame(OB_FRAME_COLOR);
+            numbers.push_back(subFrame->getNumber());
+            minTsp = std::min(minTsp, subFrame->getGlobalTimeStampUsec());
+            maxTsp = std::max(maxTsp, subFrame->getGlobalTimeStampUsec());
+        }
+        result.groups.push_back(numbers);
+        result.maxSpreadUs  = std::max(result.maxSpreadUs, maxTsp - minTsp);
+        result.maxLatencyUs = std::max(result.maxLatencyUs, newestUs - composite->getTimeStampUsec());
+    });
+
+    // build the framesets beforehand, only the pushing is timed
+    std::vector<std::shared_ptr<const Frame>> framesets;
+    for(auto &event: events) {
+        auto frame = FrameFactory::createFrameFromStreamProfile(profile);
+        frame->setNumber(event.index);
+        frame->setTimeStampUsec(event.timestampUs + event.sourceIndex * 123456789ull);  // device clocks are not aligned
+        frame->setSystemTimeStampUsec(event.arrivalUs);
+        frame->setGlobalTimeStampUsec(sources[event.sourceIndex].globalTimestamp ? event.timestampUs : 0);
+        auto frameset = FrameFactory::createFrameSet();
+        frameset->pushFrame(std::move(frame));
+        framesets.push_back(frameset);
+    }
+
+    double totalUs = 0;
+    for(size_t i = 0; i < events.size(); i++) {
+        newestUs   = std::max(newestUs, events[i].timestampUs);
+        auto begin = std::chrono::steady_clock::now();
+        aggregator.pushFrameset(events[i].sourceIndex, std::move(framesets[i]));
+        totalUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+        auto stat    = aggregator.getStatistics();
+        auto pending = stat.inputFramesetCount - stat.outputFramesetCount * sourceCount - stat.droppedFramesetCount;
+        result.maxPendingCount = std::max(result.maxPendingCount, pending);
+    }
+    result.pushCostUs = events.empty() ? 0 : totalUs / events.size();
+    result.statistics = aggregator.getStatistics();
+    return result;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static void printResult(const ReplayResult &result) {
+    auto &stat = result.statistics;
+    std::cout << "  input framesets " << stat.inputFramesetCount << ", composite framesets " << stat.outputFramesetCount << ", dropped framesets "
+              << stat.droppedFramesetCount << std::endl;
+    std::cout << "  timestamp spread max " << stat.maxTimestampSpreadUs << "us, output latency max " << result.maxLatencyUs << "us, pending framesets max "
+              << result.maxPendingCount << ", push cost avg " << result.pushCostUs << "us" << std::endl;
+}
+
+// Every composite frameset is complete, holds the framesets of one capture time, and is output in order
+static bool checkResult(const ReplayResult &result, const std::vector<SourceSpec> &sources, const OBMultiDeviceFrameSyncConfig &config,
+                        const std::vector<bool> &completeIndices, uint64_t maxMissingGroups) {
+    bool     ok        = true;
+    int64_t  lastIndex = -1;
+    uint64_t mismatch  = 0;
+    for(auto &group: result.groups) {
+        ok = check(group.size() == sources.size(), "incomplete composite frameset") && ok;
+        for(auto number: group) {
+            mismatch += number != group.front() ? 1 : 0;
+        }
+        ok        = check(static_cast<int64_t>(group.front()) > lastIndex, "composite frameset output twice or out of order") && ok;
+        lastIndex = static_cast<int64_t>(group.front());
+        ok        = check(completeIndices[group.front()], "composite frameset of a capture time with missing framesets") && ok;
+    }
+    ok = check(mismatch == 0, std::to_string(mismatch) + " framesets grouped with a frameset of another capture time") && ok;
+    ok = check(result.maxSpreadUs <= config.toleranceUs, "timestamp spread " + std::to_string(result.maxSpreadUs) + "us exceeds the tolerance") && ok;
+
+    auto &stat    = result.statistics;
+    auto  pending = stat.inputFramesetCount - stat.outputFramesetCount * sources.size() - stat.droppedFramesetCount;
+    ok            = check(pending <= sources.size() * (config.maxLatencyUs / INTERVAL_US + 2), "pending framesets not bounded by the max latency") && ok;
+    ok = check(result.maxPendingCount <= sources.size() * (config.maxLatencyUs / INTERVAL_US + 2), "pending framesets not bounded by the max latency") && ok;
+
+    auto expected = static_cast<uint64_t>(std::count(completeIndices.begin(), completeIndices.end(), true));
+    ok            = check(stat.outputFramesetCount <= expected && stat.outputFramesetCount + maxMissingGroups >= expected,
+                          std::to_string(expected - stat.outputFramesetCount) + " complete capture times not grouped") && ok;
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    uint32_t seed        = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1;
+    uint32_t durationSec = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 10;
+    if(durationSec < 4) {
+        durationSec = 10;
+    }
+    bool ok     = true;
+    auto config = MultiDeviceFrameAggregator::getDefaultConfig();
+
+    // 8 devices at 30fps with different transport delays, all delivered
+    SourceSpec base = { 1000, 5000, 3000, 0, 0, 0, 0, 0, 0, true };
+    std::vector<SourceSpec> sources(8, base);
+    for(uint32_t i = 0; i < sources.size(); i++) {
+        sources[i].delayUs = 5000 + i * 4000;
+    }
+    std::vector<bool> completeIndices;
+    std::cout << "8 devices 30fps, seed " << seed << std::endl;
+    auto events = generateEvents(sources, seed, durationSec, completeIndices);
+    auto result = replay(sources, events, config);
+    printResult(result);
+    ok = checkResult(result, sources, config, completeIndices, 0) && ok;
+    ok = check(result.statistics.droppedFramesetCount == 0, "framesets dropped") && ok;
+
+    // one device loses framesets, one stalls for a second and one delivers the framesets of a second half a second late
+    auto faulty            = sources;
+    faulty[2].dropPercent  = 5;
+    faulty[4].stallBeginUs = START_US + 2000000;
+    faulty[4].stallEndUs   = START_US + 3000000;
+    faulty[6].lateBeginUs  = START_US + 1000000;
+    faulty[6].lateEndUs    = START_US + 2000000;
+    faulty[6].lateDelayUs  = 500000;
+    std::cout << "8 devices 30fps, lost, stalled and late framesets" << std::endl;
+    events = generateEvents(faulty, seed, durationSec, completeIndices);
+    result = replay(faulty, events, config);
+    printResult(result);
+    // the framesets delivered late can not be grouped, nor the framesets of the other devices captured at that time
+    ok = checkResult(result, faulty, config, completeIndices, (faulty[6].lateEndUs - faulty[6].lateBeginUs + faulty[6].lateDelayUs) / INTERVAL_US + 2) && ok;
+    ok = check(result.statistics.droppedFramesetCount > 0, "dropped framesets not counted") && ok;
+    ok = check(result.maxLatencyUs <= config.maxLatencyUs + config.toleranceUs, "composite frameset output later than the max latency") && ok;
+
+    // a device without global timestamp falls back to the device timestamp, which is not aligned with the other devices
+    auto mixed               = sources;
+    mixed[1].globalTimestamp = false;
+    std::cout << "8 devices 30fps, one without global timestamp" << std::endl;
+    events = generateEvents(mixed, seed, durationSec, completeIndices);
+    result = replay(mixed, events, config);
+    printResult(result);
+    ok = check(result.statistics.outputFramesetCount == 0, "framesets of unaligned clocks grouped") && ok;
+    ok = check(result.maxPendingCount <= mixed.size() * (config.maxLatencyUs / INTERVAL_US + 2), "pending framesets not bounded by the max latency") && ok;
+
+    // dozens of devices
+    std::vector<SourceSpec> many(48, base);
+    for(uint32_t i = 0; i < many.size(); i++) {
+        many[i].delayUs = 5000 + (i % 8) * 4000;
+    }
+    std::cout << "48 devices 30fps" << std::endl;
+    events = generateEvents(many, seed, durationSec, completeIndices);
+    result = replay(many, events, config);
+    printResult(result);
+    ok = checkResult(result, many, config, completeIndices, 0) && ok;
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,378 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Generate the point cloud of a synthetic depth frame with 1, 2, 4 and 8 threads in each output layout (xyz, xyz rgb, planar xyz, half float xyz and
+// the compact xyz / xyz rgb with point index), report the time per frame and check that the output is bit-exact with the scalar point cloud generation.
+// The RGBD point cloud of YUYV/NV12 color images, sampled without the RGB conversion of the whole image, is compared with the former conversion by libyuv
+// followed by the RGB point cloud: the points must be the same and the colors close (the fixed point conversions differ by a few levels).
+// usage: pointcloud_benchmark [frame count]
+
+#include "utils/CoordinateUtil.hpp"
+#include "utils/CpuFeatures.hpp"
+#include "utils/TaskExecutor.hpp"
+
+#include <libyuv.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+struct PointCloudCase {
+    std::string            name;
+    int                    width, height;
+    float                  scale;
+    OBCoordinateSystemType type;
+};
+
+// The scalar point cloud generation, the reference of the vectorized one
+static void scalarDepthToPointCloud(const OBXYTables &xyTables, const uint16_t *depth, const uint8_t *color, float *out, int stride, float scale,
+                                    OBCoordinateSystemType type, float colorDivCoeff) {
+    int coefficient = type == OB_LEFT_HAND_COORDINATE_SYSTEM ? -1 : 1;
+    for(int i = 0; i < xyTables.width * xyTables.height; i++) {
+        float *point = out + stride * i;
+        float  xTab  = xyTables.xTable[i];
+        if(!std::isnan(xTab) && depth[i] != 65535) {
+            float z  = (float)depth[i];
+            point[0] = xTab * z * scale;
+            point[1] = xyTables.yTable[i] * z * coefficient * scale;
+            point[2] = z * scale;
+            if(color) {
+                point[3] = color[3 * i + 0] / colorDivCoeff;
+                point[4] = color[3 * i + 1] / colorDivCoeff;
+                point[5] = color[3 * i + 2] / colorDivCoeff;
+            }
+        }
+        else {
+            memset(point, 0, stride * sizeof(float));
+        }
+    }
+}
+
+// IEEE 754 binary16, round to nearest even
+static uint16_t referenceFloatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    int      exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+    if(((bits >> 23) & 0xff) == 0xff) {
+        return sign | (mantissa ? static_cast<uint16_t>(0x7e00 | (mantissa >> 13)) : 0x7c00);
+    }
+
+    // the value in units of the half float ulp: 2^(exponent - 25) for normal numbers, 2^-24 for subnormal numbers
+    uint64_t significand = (bits & 0x7fffffff) ? (mantissa | 0x800000) : 0;
+    int      shift       = exponent > 0 ? 13 : 14 - exponent;
+    if(shift > 40) {
+        return sign;
+    }
+    uint64_t half = significand >> shift;
+    uint64_t rest = significand & ((1ull << shift) - 1);
+    if(rest > (1ull << (shift - 1)) || (rest == (1ull << (shift - 1)) && (half & 1))) {
+        half++;
+    }
+    if(exponent > 0) {
+        half += static_cast<uint64_t>(exponent - 1) << 10;  // the implicit bit of the significand adds the last exponent step
+    }
+    return half >= 0x7c00 ? static_cast<uint16_t>(sign | 0x7c00) : static_cast<uint16_t>(sign | half);
+}
+
+// Slanted planes with steps, holes (0) and invalid pixels (65535), in millimeter
+static std::vector<uint16_t> makeDepth(int width, int height) {
+    std::vector<uint16_t> depth(width * height);
+    for(int v = 0; v < height; v++) {
+        for(int u = 0; u < width; u++) {
+            int value = 800 + u / 2 + v / 3;
+            if(((u / 64) + (v / 48)) % 3 == 0) {
+                value -= 300;
+            }
+            if((u * 7 + v * 13) % 97 == 0) {
+                value = 0;
+            }
+            if((u * 5 + v * 11) % 89 == 0) {
+                value = 65535;
+            }
+            depth[v * width + u] = static_cast<uint16_t>(value);
+        }
+    }
+    return depth;
+}
+
+// Smooth color gradients as YUYV or NV12
+static std::vector<uint8_t> makeYUVColor(OBFormat format, int width, int height) {
+    std::vector<uint8_t> data(format == OB_FORMAT_NV12 ? width * height * 3 / 2 : width * height * 2);
+    for(int v = 0; v < height; v++) {
+        for(int u = 0; u < width; u += 2) {
+            auto y0 = static_cast<uint8_t>(16 + (u * 3 + v * 2) % 220);
+            auto y1 = static_cast<uint8_t>(16 + ((u + 1) * 3 + v * 2) % 220);
+            auto cb = static_cast<uint8_t>(128 + 100 * std::sin(u * 0.01 + v * 0.013));
+            auto cr = static_cast<uint8_t>(128 + 100 * std::cos(u * 0.017 - v * 0.011));
+            if(format == OB_FORMAT_NV12) {
+                data[v * width + u]     = y0;
+                data[v * width + u + 1] = y1;
+                if(v % 2 == 0) {
+                    data[width * height + v / 2 * width + u]     = cb;
+                    data[width * height + v / 2 * width + u + 1] = cr;
+                }
+            }
+            else {
+                uint8_t pair[4] = { y0, cb, y1, cr };
+                memcpy(&data[(v * width + u) * 2], pair, sizeof(pair));
+            }
+        }
+    }
+    return data;
+}
+
+// The former RGBD point cloud of the YUV color images: the whole image converted to RGB by libyuv, then the RGB point cloud
+static void convertYUVToRGB(OBFormat format, const uint8_t *src, uint8_t *rgb, std::vector<uint8_t> &argb, int width, int height) {
+    if(format == OB_FORMAT_NV12) {
+        libyuv::NV12ToRAW(src, width, src + width * height, width, rgb, width * 3, width, height);
+        return;
+    }
+    argb.resize(width * height * 4);
+    libyuv::YUY2ToARGB(src, width * 2, argb.data(), width * 4, width, height);
+    libyuv::ARGBToRAW(argb.data(), width * 4, rgb, width * 3, width, height);
+}
+
+// Maximum difference of the colors (0 to 255) of the points, or -1 if the xyz differ
+static int compareYUVPoints(const std::vector<float> &out, const std::vector<float> &ref, size_t pointCount) {
+    int maxDiff = 0;
+    for(size_t i = 0; i < pointCount; i++) {
+        if(memcmp(&out[6 * i], &ref[6 * i], 3 * sizeof(float)) != 0) {
+            return -1;
+        }
+        for(int k = 3; k < 6; k++) {
+            maxDiff = std::max(maxDiff, static_cast<int>(std::lround(std::fabs(out[6 * i + k] - ref[6 * i + k]))));
+        }
+    }
+    return maxDiff;
+}
+
+static bool runYUVColorCase(const PointCloudCase &pointCloudCase, OBXYTables &xyTables, const std::vector<uint16_t> &depth, OBFormat format, int frameCount) {
+    int  width     = pointCloudCase.width;
+    int  height    = pointCloudCase.height;
+    int  pixelSize = width * height;
+    auto yuv       = makeYUVColor(format, width, height);
+
+    std::vector<uint8_t>  rgb(pixelSize * 3), argb;
+    std::vector<float>    refRGBD(pixelSize * 6), outRGBD(pixelSize * 6), refCompact(pixelSize * 6), outCompact(pixelSize * 6);
+    std::vector<uint32_t> refIndex(pixelSize), outIndex(pixelSize);
+    uint32_t              refCount = 0, outCount = 0;
+    RGBDColorImage        colorImage = { format, yuv.data(), width, height };
+
+    auto measure = [frameCount](const std::function<void()> &func) {
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < frameCount; i++) {
+            func();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frameCount;
+    };
+    double convertMs = measure([&]() {
+        convertYUVToRGB(format, yuv.data(), rgb.data(), argb, width, height);
+        CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables, depth.data(), rgb.data(), refRGBD.data(), pointCloudCase.scale, pointCloudCase.type);
+    });
+    double fusedMs = measure([&]() {
+        CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables, depth.data(), colorImage, outRGBD.data(), pointCloudCase.scale, pointCloudCase.type);
+    });
+    double convertCompactMs = measure([&]() {
+        convertYUVToRGB(format, yuv.data(), rgb.data(), argb, width, height);
+        refCount = CoordinateUtil::transformationDepthToCompactRGBDPointCloud(&xyTables, depth.data(), rgb.data(), refCompact.data(), refIndex.data(),
+                                                                              pointCloudCase.scale, pointCloudCase.type);
+    });
+    double fusedCompactMs = measure([&]() {
+        outCount = CoordinateUtil::transformationDepthToCompactRGBDPointCloud(&xyTables, depth.data(), colorImage, outCompact.data(), outIndex.data(),
+                                                                              pointCloudCase.scale, pointCloudCase.type);
+    });
+
+    int  diff        = compareYUVPoints(outRGBD, refRGBD, pixelSize);
+    int  compactDiff = outCount == refCount ? compareYUVPoints(outCompact, refCompact, refCount) : -1;
+    bool match = diff >= 0 && diff <= 3 && compactDiff >= 0 && compactDiff <= 3 && memcmp(outIndex.data(), refIndex.data(), refCount * sizeof(uint32_t)) == 0;
+    std::cout << std::left << std::setw(22) << pointCloudCase.name << std::setw(7) << (format == OB_FORMAT_NV12 ? "NV12" : "YUYV") << std::setw(12)
+              << std::fixed << std::setprecision(3) << convertMs << std::setw(10) << fusedMs << std::setw(12) << convertCompactMs << std::setw(10)
+              << fusedCompactMs << std::max(diff, compactDiff) << (match ? "" : "  MISMATCH") << std::endl;
+    return match;
+}
+
+int main(int argc, char **argv) {
+    int frameCount = argc > 1 ? std::atoi(argv[1]) : 30;
+    if(frameCount <= 0) {
+        frameCount = 30;
+    }
+
+    const PointCloudCase cases[] = {
+        { "1024x1024 mm right", 1024, 1024, 1.0f, OB_RIGHT_HAND_COORDINATE_SYSTEM },
+        { "1280x800 m left", 1280, 800, 0.001f, OB_LEFT_HAND_COORDINATE_SYSTEM },
+        { "641x479 m right", 641, 479, 0.001f, OB_RIGHT_HAND_COORDINATE_SYSTEM },
+    };
+    const uint32_t threadCounts[] = { 1, 2, 4, 8 };
+
+    std::cout << "AVX2 supported: " << (utils::isAVX2Supported() ? "yes" : "no") << ", F16C supported: " << (utils::isAVX2F16CSupported() ? "yes" : "no")
+              << std::endl;
+    std::cout << std::left << std::setw(22) << "case" << std::setw(9) << "threads" << std::setw(10) << "xyz ms" << std::setw(10) << "rgbd ms" << std::setw(11)
+              << "planar ms" << std::setw(10) << "half ms" << std::setw(12) << "compact ms" << std::setw(14) << "compact rgbd" << "bit-exact" << std::endl;
+
+    bool                               allMatch = true;
+    std::vector<std::vector<uint16_t>> depths;
+    std::vector<std::vector<float>>    tables;
+    std::vector<OBXYTables>            xyTablesList;
+    tables.reserve(sizeof(cases) / sizeof(cases[0]));
+    for(const auto &pointCloudCase: cases) {
+        int width     = pointCloudCase.width;
+        int height    = pointCloudCase.height;
+        int pixelSize = width * height;
+
+        OBCameraIntrinsic intrinsic = {};
+        intrinsic.width             = static_cast<int16_t>(width);
+        intrinsic.height            = static_cast<int16_t>(height);
+        intrinsic.fx = intrinsic.fy = width * 0.8f;
+        intrinsic.cx                = width / 2.f - 0.7f;
+        intrinsic.cy                = height / 2.f + 1.3f;
+        OBCameraDistortion distortion = {};
+        distortion.model              = OB_DISTORTION_BROWN_CONRADY;
+        distortion.k1                 = 0.01f;
+
+        uint32_t           tablesSize = pixelSize * 2;
+        std::vector<float> tablesData(tablesSize);
+        OBXYTables         xyTables;
+        if(!CoordinateUtil::transformationInitXYTables(intrinsic, distortion, tablesData.data(), &tablesSize, &xyTables)) {
+            std::cout << "FAILED: init xy tables of " << pointCloudCase.name << std::endl;
+            return 1;
+        }
+        // the pixels out of the undistortion range
+        for(int i = 0; i < pixelSize; i += 37) {
+            xyTables.xTable[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+        tables.push_back(tablesData);
+        xyTablesList.push_back({ tables.back().data() + (xyTables.xTable - tablesData.data()), tables.back().data() + (xyTables.yTable - tablesData.data()),
+                                 width, height });
+
+        auto depth = makeDepth(width, height);
+        depths.push_back(depth);
+        std::vector<uint8_t> color(pixelSize * 3);
+        for(int i = 0; i < pixelSize * 3; i++) {
+            color[i] = static_cast<uint8_t>(i * 31 + i / width);
+        }
+
+        // reference: the scalar generation
+        std::vector<float> refXYZ(pixelSize * 3);
+        std::vector<float> refRGBD(pixelSize * 6);
+        scalarDepthToPointCloud(xyTables, depth.data(), nullptr, refXYZ.data(), 3, pointCloudCase.scale, pointCloudCase.type, 1.0f);
+        scalarDepthToPointCloud(xyTables, depth.data(), color.data(), refRGBD.data(), 6, pointCloudCase.scale, pointCloudCase.type, 255.0f);
+        std::vector<float>    refPlanar(pixelSize * 3);
+        std::vector<uint16_t> refHalf(pixelSize * 3);
+        for(int i = 0; i < pixelSize; i++) {
+            for(int k = 0; k < 3; k++) {
+                refPlanar[k * pixelSize + i] = refXYZ[3 * i + k];
+                refHalf[3 * i + k]           = referenceFloatToHalf(refXYZ[3 * i + k]);
+            }
+        }
+        // compact: the valid points with non-zero depth
+        std::vector<float>    refCompactXYZ;
+        std::vector<float>    refCompactRGBD;
+        std::vector<uint32_t> refPointIndex;
+        for(int i = 0; i < pixelSize; i++) {
+            if(!std::isnan(xyTables.xTable[i]) && depth[i] != 0 && depth[i] != 65535) {
+                refCompactXYZ.insert(refCompactXYZ.end(), refXYZ.begin() + 3 * i, refXYZ.begin() + 3 * i + 3);
+                refCompactRGBD.insert(refCompactRGBD.end(), refRGBD.begin() + 6 * i, refRGBD.begin() + 6 * i + 6);
+                refPointIndex.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        for(auto threadCount: threadCounts) {
+            std::unique_ptr<TaskExecutor> executor;
+            if(threadCount > 1) {
+                executor.reset(new TaskExecutor(threadCount - 1, false));
+            }
+
+            std::vector<float>    outXYZ(pixelSize * 3);
+            std::vector<float>    outRGBD(pixelSize * 6);
+            std::vector<float>    outPlanar(pixelSize * 3);
+            std::vector<uint16_t> outHalf(pixelSize * 3);
+            std::vector<float>    outCompactXYZ(pixelSize * 3);
+            std::vector<float>    outCompactRGBD(pixelSize * 6);
+            std::vector<uint32_t> outPointIndex(pixelSize);
+            std::vector<uint32_t> outRGBDPointIndex(pixelSize);
+            uint32_t              compactCount     = 0;
+            uint32_t              compactRGBDCount = 0;
+
+            auto measure = [frameCount](const std::function<void()> &func) {
+                auto start = std::chrono::steady_clock::now();
+                for(int i = 0; i < frameCount; i++) {
+                    func();
+                }
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frameCount;
+            };
+            double xyzMs = measure([&]() {
+                CoordinateUtil::transformationDepthToPointCloud(&xyTables, depth.data(), outXYZ.data(), pointCloudCase.scale, pointCloudCase.type,
+                                                                executor.get());
+            });
+            double rgbdMs = measure([&]() {
+                CoordinateUtil::transformationDepthToRGBDPointCloud(&xyTables, depth.data(), color.data(), outRGBD.data(), pointCloudCase.scale,
+                                                                    pointCloudCase.type, true, executor.get());
+            });
+            double planarMs = measure([&]() {
+                CoordinateUtil::transformationDepthToPlanarPointCloud(&xyTables, depth.data(), outPlanar.data(), outPlanar.data() + pixelSize,
+                                                                      outPlanar.data() + pixelSize * 2, pointCloudCase.scale, pointCloudCase.type,
+                                                                      executor.get());
+            });
+            double halfMs = measure([&]() {
+                CoordinateUtil::transformationDepthToHalfPointCloud(&xyTables, depth.data(), outHalf.data(), pointCloudCase.scale, pointCloudCase.type,
+                                                                    executor.get());
+            });
+            double compactMs = measure([&]() {
+                compactCount = CoordinateUtil::transformationDepthToCompactPointCloud(&xyTables, depth.data(), outCompactXYZ.data(), outPointIndex.data(),
+                                                                                      pointCloudCase.scale, pointCloudCase.type, executor.get());
+            });
+            double compactRGBDMs = measure([&]() {
+                compactRGBDCount = CoordinateUtil::transformationDepthToCompactRGBDPointCloud(&xyTables, depth.data(), color.data(), outCompactRGBD.data(),
+                                                                                              outRGBDPointIndex.data(), pointCloudCase.scale,
+                                                                                              pointCloudCase.type, true, executor.get());
+            });
+
+            bool match = memcmp(outXYZ.data(), refXYZ.data(), refXYZ.size() * sizeof(float)) == 0
+                         && memcmp(outRGBD.data(), refRGBD.data(), refRGBD.size() * sizeof(float)) == 0
+                         && memcmp(outPlanar.data(), refPlanar.data(), refPlanar.size() * sizeof(float)) == 0
+                         && memcmp(outHalf.data(), refHalf.data(), refHalf.size() * sizeof(uint16_t)) == 0 && compactCount == refPointIndex.size()
+                         && memcmp(outCompactXYZ.data(), refCompactXYZ.data(), refCompactXYZ.size() * sizeof(float)) == 0
+                         && memcmp(outPointIndex.data(), refPointIndex.data(), refPointIndex.size() * sizeof(uint32_t)) == 0
+                         && compactRGBDCount == refPointIndex.size()
+                         && memcmp(outCompactRGBD.data(), refCompactRGBD.data(), refCompactRGBD.size() * sizeof(float)) == 0
+                         && memcmp(outRGBDPointIndex.data(), refPointIndex.data(), refPointIndex.size() * sizeof(uint32_t)) == 0;
+
+            allMatch = allMatch && match;
+            std::cout << std::left << std::setw(22) << pointCloudCase.name << std::setw(9) << threadCount << std::setw(10) << std::fixed << std::setprecision(3)
+                      << xyzMs << std::setw(10) << rgbdMs << std::setw(11) << planarMs << std::setw(10) << halfMs << std::setw(12) << compactMs << std::setw(14)
+                      << compactRGBDMs << (match ? "yes" : "NO") << std::endl;
+        }
+    }
+
+    // the YUV color sampling of the RGBD point cloud (single thread), the 4:2:x formats need an even resolution
+    std::cout << std::endl
+              << std::left << std::setw(22) << "case" << std::setw(7) << "color" << std::setw(12) << "convert ms" << std::setw(10) << "fused ms" << std::setw(12)
+              << "convert cpt" << std::setw(10) << "fused cpt" << "max color diff" << std::endl;
+    for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        if(cases[i].width % 2 != 0 || cases[i].height % 2 != 0) {
+            continue;
+        }
+        for(auto format: { OB_FORMAT_YUYV, OB_FORMAT_NV12 }) {
+            allMatch = runYUVColorCase(cases[i], xyTablesList[i], depths[i], format, frameCount) && allMatch;
+        }
+    }
+
+    if(!allMatch) {
+        std::cout << "FAILED: the output differs from the scalar point cloud generation" << std::endl;
+        return 1;
+    }
+    return 0;
+}
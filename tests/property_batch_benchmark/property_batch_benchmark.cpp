@@ -0,0 +1,255 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Apply a property configuration through the vendor protocol to a loopback device port which simulates the transfer latency and the busy responses of
+// a device, one property at a time against a batch, and on several devices sequentially against concurrently.
+// usage: property_batch_benchmark [property count] [device count] [transfer latency us]
+
+#include "component/property/PropertyServer.hpp"
+#include "component/property/VendorPropertyAccessor.hpp"
+#include "protocol/Protocol.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+const uint32_t FIRST_PROPERTY_ID = 1000;
+const int32_t  MAX_VALUE         = 100;
+
+// Answers the get/set property requests from an in-memory property table
+class LoopbackVendorPort : public IVendorDataPort {
+public:
+    explicit LoopbackVendorPort(uint32_t latencyUs) : latencyUs_(latencyUs), transferCount(0), busyResponses(0) {}
+
+    std::shared_ptr<const SourcePortInfo> getSourcePortInfo() const override {
+        return nullptr;
+    }
+
+    uint32_t sendAndReceive(const uint8_t *sendData, uint32_t sendLen, uint8_t *recvData, uint32_t exceptedRecvLen) override {
+        (void)sendLen;
+        (void)exceptedRecvLen;
+        std::this_thread::sleep_for(std::chrono::microseconds(latencyUs_));
+        transferCount++;
+
+        auto reqHeader              = reinterpret_cast<const protocol::ReqHeader *>(sendData);
+        auto respHeader             = reinterpret_cast<protocol::RespHeader *>(recvData);
+        respHeader->magic           = HP_RESPONSE_MAGIC;
+        respHeader->opcode          = reqHeader->opcode;
+        respHeader->requestId       = reqHeader->requestId;
+        respHeader->errorCode       = protocol::HP_RESP_OK;
+        respHeader->sizeInHalfWords = sizeof(respHeader->errorCode) / 2;
+        if(busyResponses > 0) {
+            busyResponses--;
+            respHeader->errorCode = protocol::HP_RESP_ERROR_DEVICE_BUSY;
+            return sizeof(protocol::RespHeader);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(reqHeader->opcode == protocol::OPCODE_SET_PROPERTY) {
+            auto req = reinterpret_cast<const protocol::SetPropertyReq *>(sendData);
+            if(req->value < 0 || req->value > MAX_VALUE) {
+                const char msg[]            = "value out of range";
+                respHeader->errorCode       = protocol::HP_RESP_ERROR_INVALID_REQUEST;
+                respHeader->sizeInHalfWords = static_cast<uint16_t>((sizeof(respHeader->errorCode) + sizeof(msg)) / 2);
+                memcpy(recvData + sizeof(protocol::RespHeader), msg, sizeof(msg));
+                return static_cast<uint32_t>(sizeof(protocol::RespHeader) + sizeof(msg));
+            }
+            values_[req->propertyId] = req->value;
+            return sizeof(protocol::SetPropertyResp);
+        }
+
+        auto req                    = reinterpret_cast<const protocol::GetPropertyReq *>(sendData);
+        auto resp                   = reinterpret_cast<protocol::GetPropertyResp *>(recvData);
+        resp->data.cur              = values_[req->propertyId];
+        resp->data.max              = MAX_VALUE;
+        resp->data.min              = 0;
+        resp->data.def              = 0;
+        resp->data.step             = 1;
+        respHeader->sizeInHalfWords = static_cast<uint16_t>((sizeof(respHeader->errorCode) + sizeof(protocol::PropertyData)) / 2);
+        return sizeof(protocol::GetPropertyResp);
+    }
+
+private:
+    uint32_t                    latencyUs_;
+    std::mutex                  mutex_;
+    std::map<uint32_t, int32_t> values_;
+
+public:
+    std::atomic<uint32_t> transferCount;
+    std::atomic<uint32_t> busyResponses;
+};
+
+struct LoopbackDevice {
+    std::shared_ptr<LoopbackVendorPort> port;
+    std::shared_ptr<PropertyServer>     propertyServer;
+};
+
+static LoopbackDevice createDevice(uint32_t propertyCount, uint32_t latencyUs) {
+    LoopbackDevice device;
+    device.port           = std::make_shared<LoopbackVendorPort>(latencyUs);
+    device.propertyServer = std::make_shared<PropertyServer>(nullptr);
+    auto accessor         = std::make_shared<VendorPropertyAccessor>(nullptr, device.port);
+    for(uint32_t i = 0; i < propertyCount; i++) {
+        device.propertyServer->registerProperty(FIRST_PROPERTY_ID + i, "rw", "rw", accessor);
+    }
+    return device;
+}
+
+// Write the configuration and read it back with the ranges
+static std::vector<OBPropertyOperation> createConfiguration(uint32_t propertyCount, int32_t valueOffset) {
+    std::vector<OBPropertyOperation> operations;
+    for(uint32_t i = 0; i < propertyCount; i++) {
+        OBPropertyOperation op;
+        memset(&op, 0, sizeof(op));
+        op.id             = static_cast<OBPropertyID>(FIRST_PROPERTY_ID + i);
+        op.operation      = OB_PROPERTY_OPERATION_SET;
+        op.value.intValue = static_cast<int32_t>(i + valueOffset) % MAX_VALUE;
+        operations.push_back(op);
+    }
+    for(auto operation: { OB_PROPERTY_OPERATION_GET_RANGE, OB_PROPERTY_OPERATION_GET }) {
+        for(uint32_t i = 0; i < propertyCount; i++) {
+            OBPropertyOperation op;
+            memset(&op, 0, sizeof(op));
+            op.id        = static_cast<OBPropertyID>(FIRST_PROPERTY_ID + i);
+            op.operation = operation;
+            operations.push_back(op);
+        }
+    }
+    return operations;
+}
+
+static bool checkResults(const std::vector<OBPropertyOperation> &operations, uint32_t propertyCount, int32_t valueOffset) {
+    for(size_t i = propertyCount; i < operations.size(); i++) {
+        auto &op = operations[i];
+        if(op.status != OB_STATUS_OK || op.value.intValue != static_cast<int32_t>(op.id - FIRST_PROPERTY_ID + valueOffset) % MAX_VALUE) {
+            return false;
+        }
+        if(op.operation == OB_PROPERTY_OPERATION_GET_RANGE && op.max.intValue != MAX_VALUE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// One call (and lock) of the property server per operation, as the applications do with the single property api
+static void applyOneByOne(LoopbackDevice &device, std::vector<OBPropertyOperation> &operations) {
+    for(auto &op: operations) {
+        if(op.operation == OB_PROPERTY_OPERATION_SET) {
+            device.propertyServer->setPropertyValueT(op.id, op.value.intValue, PROP_ACCESS_USER);
+        }
+        else if(op.operation == OB_PROPERTY_OPERATION_GET) {
+            op.value.intValue = device.propertyServer->getPropertyValueT<int32_t>(op.id, PROP_ACCESS_USER);
+        }
+        else {
+            auto range        = device.propertyServer->getPropertyRangeT<int32_t>(op.id, PROP_ACCESS_USER);
+            op.value.intValue = range.cur;
+            op.max.intValue   = range.max;
+        }
+        op.status = OB_STATUS_OK;
+    }
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+int main(int argc, char **argv) {
+    uint32_t propertyCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 30;
+    uint32_t deviceCount   = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 8;
+    uint32_t latencyUs     = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 1000;
+    bool     ok            = true;
+
+    std::vector<LoopbackDevice> devices;
+    for(uint32_t i = 0; i < deviceCount; i++) {
+        devices.push_back(createDevice(propertyCount, latencyUs));
+    }
+
+    // One device: the repeated reads of the batch reuse the response of the first read
+    auto &device     = devices.front();
+    auto  operations = createConfiguration(propertyCount, 1);
+    auto  start      = std::chrono::steady_clock::now();
+    applyOneByOne(device, operations);
+    auto oneByOneMs        = elapsedMs(start);
+    auto oneByOneTransfers = device.port->transferCount.exchange(0);
+    ok &= check(checkResults(operations, propertyCount, 1), "wrong one by one results");
+
+    operations = createConfiguration(propertyCount, 2);
+    start      = std::chrono::steady_clock::now();
+    ok &= check(device.propertyServer->executePropertyOperations(operations.data(), static_cast<uint32_t>(operations.size()), PROP_ACCESS_USER) == 0,
+                "batch operations failed");
+    auto batchMs        = elapsedMs(start);
+    auto batchTransfers = device.port->transferCount.exchange(0);
+    ok &= check(checkResults(operations, propertyCount, 2), "wrong batch results");
+    ok &= check(batchTransfers == propertyCount * 2, "repeated reads not reused: " + std::to_string(batchTransfers) + " transfers");
+    std::cout << operations.size() << " operations: one by one " << oneByOneMs << "ms (" << oneByOneTransfers << " transfers), batch " << batchMs << "ms ("
+              << batchTransfers << " transfers)" << std::endl;
+
+    // A failed operation does not stop the batch
+    operations[0].value.intValue = MAX_VALUE + 1;
+    operations[1].id             = static_cast<OBPropertyID>(FIRST_PROPERTY_ID + propertyCount);  // not registered
+    ok &= check(device.propertyServer->executePropertyOperations(operations.data(), static_cast<uint32_t>(operations.size()), PROP_ACCESS_USER) == 2,
+                "failed operations not counted");
+    ok &= check(operations[0].status == OB_STATUS_ERROR && operations[1].status == OB_STATUS_ERROR && operations[2].status == OB_STATUS_OK,
+                "wrong status of the operations");
+
+    // A busy device is retried after a short delay instead of a fixed 100ms
+    device.port->busyResponses = 1;
+    start                      = std::chrono::steady_clock::now();
+    device.propertyServer->getPropertyValueT<int32_t>(FIRST_PROPERTY_ID, PROP_ACCESS_USER);
+    auto busyMs = elapsedMs(start);
+    std::cout << "request retried after a busy response: " << busyMs << "ms" << std::endl;
+    ok &= check(busyMs < 50, "busy retry too slow");
+    device.port->busyResponses = HP_NOT_READY_RETRIES;
+    try {
+        device.propertyServer->getPropertyValueT<int32_t>(FIRST_PROPERTY_ID, PROP_ACCESS_USER);
+        ok &= check(false, "busy device not reported");
+    }
+    catch(const std::exception &) {
+    }
+    device.port->busyResponses = 0;
+
+    // Several devices, one after the other and concurrently (as ob_devices_execute_property_operations does)
+    std::vector<std::vector<OBPropertyOperation>> deviceOperations(deviceCount, createConfiguration(propertyCount, 3));
+    start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < deviceCount; i++) {
+        devices[i].propertyServer->executePropertyOperations(deviceOperations[i].data(), static_cast<uint32_t>(deviceOperations[i].size()), PROP_ACCESS_USER);
+    }
+    auto sequentialMs = elapsedMs(start);
+
+    deviceOperations.assign(deviceCount, createConfiguration(propertyCount, 4));
+    std::vector<std::thread> threads;
+    start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < deviceCount; i++) {
+        threads.emplace_back([&devices, &deviceOperations, i]() {
+            devices[i].propertyServer->executePropertyOperations(deviceOperations[i].data(), static_cast<uint32_t>(deviceOperations[i].size()),
+                                                                 PROP_ACCESS_USER);
+        });
+    }
+    for(auto &thread: threads) {
+        thread.join();
+    }
+    auto concurrentMs = elapsedMs(start);
+    for(auto &ops: deviceOperations) {
+        ok &= check(checkResults(ops, propertyCount, 4), "wrong concurrent batch results");
+    }
+    std::cout << deviceCount << " devices: sequential " << sequentialMs << "ms, concurrent " << concurrentMs << "ms" << std::endl;
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the cost of the property reads served from the cache of the property server against the reads going to an accessor which simulates the
+// control transfer round-trip of a device, and check the cache policies (static, until write, ttl) and the invalidation on writes.
+// usage: property_cache_benchmark [read count] [accessor latency us]
+
+#include "component/property/PropertyServer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace libobsensor;
+
+class FakeDeviceAccessor : public IBasicPropertyAccessor, public IStructureDataAccessor {
+public:
+    explicit FakeDeviceAccessor(uint32_t latencyUs) : latencyUs_(latencyUs), readCount(0), intValue_(0), data_(16, 0) {}
+
+    void setPropertyValue(uint32_t propertyId, const OBPropertyValue &value) override {
+        (void)propertyId;
+        roundTrip();
+        intValue_ = value.intValue;
+    }
+
+    void getPropertyValue(uint32_t propertyId, OBPropertyValue *value) override {
+        (void)propertyId;
+        roundTrip();
+        readCount++;
+        value->intValue = intValue_;
+    }
+
+    void getPropertyRange(uint32_t propertyId, OBPropertyRange *range) override {
+        (void)propertyId;
+        roundTrip();
+        readCount++;
+        range->cur.intValue  = intValue_;
+        range->min.intValue  = 0;
+        range->max.intValue  = 100;
+        range->step.intValue = 1;
+        range->def.intValue  = 0;
+    }
+
+    void setStructureData(uint32_t propertyId, const std::vector<uint8_t> &data) override {
+        (void)propertyId;
+        roundTrip();
+        data_ = data;
+    }
+
+    const std::vector<uint8_t> &getStructureData(uint32_t propertyId) override {
+        (void)propertyId;
+        roundTrip();
+        readCount++;
+        data_[0]++;  // changes on every device read, like the temperature
+        return data_;
+    }
+
+private:
+    void roundTrip() {
+        if(latencyUs_) {
+            std::this_thread::sleep_for(std::chrono::microseconds(latencyUs_));
+        }
+    }
+
+    uint32_t latencyUs_;
+
+public:
+    std::atomic<uint32_t> readCount;
+
+private:
+    int32_t              intValue_;
+    std::vector<uint8_t> data_;
+};
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static int32_t readInt(PropertyServer &server, uint32_t propertyId) {
+    OBPropertyValue value;
+    server.getPropertyValue(propertyId, &value, PROP_ACCESS_USER);
+    return value.intValue;
+}
+
+int main(int argc, char **argv) {
+    uint32_t readCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000;
+    uint32_t latencyUs = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 500;
+    bool     ok        = true;
+
+    auto           accessor = std::make_shared<FakeDeviceAccessor>(latencyUs);
+    PropertyServer server(nullptr);
+    server.registerProperty(OB_PROP_LASER_CONTROL_INT, "rw", "rw", accessor);
+    server.registerProperty(OB_PROP_LDP_BOOL, "rw", "rw", accessor, { PROP_CACHE_UNTIL_WRITE, 0 });
+    server.aliasProperty(OB_PROP_LASER_BOOL, OB_PROP_LDP_BOOL);
+    server.registerProperty(OB_STRUCT_VERSION, "r", "r", accessor, { PROP_CACHE_STATIC, 0 });
+    server.registerProperty(OB_STRUCT_DEVICE_TEMPERATURE, "r", "r", accessor, { PROP_CACHE_TTL, 100 });
+
+    // Uncached reads against cached reads of the same accessor
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < readCount; i++) {
+        readInt(server, OB_PROP_LASER_CONTROL_INT);
+    }
+    auto uncachedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / readCount;
+    start           = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < readCount; i++) {
+        readInt(server, OB_PROP_LDP_BOOL);
+    }
+    auto cachedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / readCount;
+    std::cout << readCount << " reads: " << uncachedNs << "ns per uncached read, " << cachedNs << "ns per cached read" << std::endl;
+
+    auto statistics = server.getPropertyCacheStatistics(OB_PROP_LDP_BOOL);
+    ok &= check(statistics.missCount == 1 && statistics.hitCount == readCount - 1, "unexpected statistics of the cached property");
+    ok &= check(server.getPropertyCacheStatistics(OB_PROP_LASER_CONTROL_INT).missCount == 0, "uncached property counted");
+
+    // A write through the server drops the cache of the other properties too, and the alias shares the cache of its property
+    server.setPropertyValue(OB_PROP_LASER_CONTROL_INT, { 42 }, PROP_ACCESS_USER);
+    auto reads = accessor->readCount.load();
+    ok &= check(readInt(server, OB_PROP_LASER_BOOL) == 42, "stale value read after a write");
+    ok &= check(readInt(server, OB_PROP_LDP_BOOL) == 42 && accessor->readCount == reads + 1, "alias does not share the cache");
+
+    // The access callbacks see the cached range reads as well as the device ones
+    uint32_t rangeCallbackCount = 0;
+    server.registerAccessCallback(OB_PROP_LDP_BOOL, [&rangeCallbackCount](uint32_t, const uint8_t *, size_t dataSize, PropertyOperationType operationType) {
+        if(operationType == PROP_OP_READ && dataSize == sizeof(OBPropertyRange)) {
+            rangeCallbackCount++;
+        }
+    });
+    OBPropertyRange range;
+    server.getPropertyRange(OB_PROP_LDP_BOOL, &range, PROP_ACCESS_USER);
+    server.getPropertyRange(OB_PROP_LDP_BOOL, &range, PROP_ACCESS_USER);
+    ok &= check(range.max.intValue == 100 && accessor->readCount == reads + 2, "range not cached");
+    ok &= check(rangeCallbackCount == 2, "access callbacks not called for every range read");
+
+    // Static values survive the writes, the ttl values expire
+    auto version = server.getStructureData(OB_STRUCT_VERSION, PROP_ACCESS_USER);
+    server.setPropertyValue(OB_PROP_LASER_CONTROL_INT, { 1 }, PROP_ACCESS_USER);
+    ok &= check(server.getStructureData(OB_STRUCT_VERSION, PROP_ACCESS_USER) == version, "static value dropped by a write");
+
+    auto temperature = server.getStructureData(OB_STRUCT_DEVICE_TEMPERATURE, PROP_ACCESS_USER);
+    ok &= check(server.getStructureData(OB_STRUCT_DEVICE_TEMPERATURE, PROP_ACCESS_USER) == temperature, "ttl value not cached");
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ok &= check(server.getStructureData(OB_STRUCT_DEVICE_TEMPERATURE, PROP_ACCESS_USER) != temperature, "ttl value not expired");
+
+    // The explicit invalidation drops the static values too
+    reads = accessor->readCount.load();
+    server.invalidatePropertyCache();
+    server.getStructureData(OB_STRUCT_VERSION, PROP_ACCESS_USER);
+    ok &= check(accessor->readCount == reads + 1, "static value not dropped by the invalidation");
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Measure the per-lookup cost of the stream profile intrinsics and extrinsics with many registered stream profiles, as with many devices
+// enumerated. Each simulated device has depth, color and IR profiles: the depth profiles share the extrinsics of the base depth profile, the color
+// profiles are bound to the base color profile, and the base color profile is bound to the base depth profile. The lookups are checked against
+// the registered and composed extrinsics, also after re-registering the extrinsics of a device and while re-binding the intrinsics of a profile.
+// usage: stream_params_benchmark [profile count] [lookup count]
+
+#include "stream/StreamProfileFactory.hpp"
+#include "stream/StreamExtrinsicsManager.hpp"
+#include "stream/StreamIntrinsicsManager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libobsensor;
+
+static const uint32_t PROFILES_PER_DEVICE = 40;
+
+struct DeviceProfiles {
+    std::vector<std::shared_ptr<VideoStreamProfile>> depthProfiles;
+    std::vector<std::shared_ptr<VideoStreamProfile>> colorProfiles;
+    std::vector<std::shared_ptr<VideoStreamProfile>> irProfiles;
+    OBExtrinsic                                      depthToColor;
+    OBExtrinsic                                      irToDepth;
+};
+
+static OBExtrinsic makeExtrinsic(float angle, float tx, float ty) {
+    float c = std::cos(angle), s = std::sin(angle);
+    return { { c, -s, 0, s, c, 0, 0, 0, 1 }, { tx, ty, 0 } };
+}
+
+static OBExtrinsic multiply(const OBExtrinsic &a, const OBExtrinsic &b) {  // a * b, apply b first
+    OBExtrinsic r;
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            r.rot[i * 3 + j] = a.rot[i * 3] * b.rot[j] + a.rot[i * 3 + 1] * b.rot[3 + j] + a.rot[i * 3 + 2] * b.rot[6 + j];
+        }
+        r.trans[i] = a.trans[i] + a.rot[i * 3] * b.trans[0] + a.rot[i * 3 + 1] * b.trans[1] + a.rot[i * 3 + 2] * b.trans[2];
+    }
+    return r;
+}
+
+static bool near(const OBExtrinsic &a, const OBExtrinsic &b) {
+    for(int i = 0; i < 9; i++) {
+        if(std::fabs(a.rot[i] - b.rot[i]) > 1e-4f) {
+            return false;
+        }
+    }
+    for(int i = 0; i < 3; i++) {
+        if(std::fabs(a.trans[i] - b.trans[i]) > 1e-2f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool check(bool condition, const std::string &msg) {
+    if(!condition) {
+        std::cout << "  FAILED: " << msg << std::endl;
+    }
+    return condition;
+}
+
+static std::shared_ptr<VideoStreamProfile> createProfile(OBStreamType type, uint32_t index) {
+    auto sp = StreamProfileFactory::createVideoStreamProfile(type, OB_FORMAT_Y16, 640 + index, 480, 30);
+    sp->bindIntrinsic({ 500.0f + index, 500.0f, 320.0f, 240.0f, static_cast<int16_t>(640 + index), 480 });
+    sp->bindDistortion({ 0.1f, 0.01f, 0, 0, 0, 0, 0, 0, OB_DISTORTION_BROWN_CONRADY });
+    return sp;
+}
+
+int main(int argc, char **argv) {
+    uint32_t profileCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10000;
+    uint32_t lookupCount  = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1000000;
+    if(profileCount < PROFILES_PER_DEVICE) {
+        profileCount = 10000;
+    }
+    if(lookupCount == 0) {
+        lookupCount = 1000000;
+    }
+    bool ok          = true;
+    auto deviceCount = profileCount / PROFILES_PER_DEVICE;
+
+    auto                        begin = std::chrono::steady_clock::now();
+    std::vector<DeviceProfiles> devices(deviceCount);
+    for(uint32_t d = 0; d < deviceCount; d++) {
+        auto &device        = devices[d];
+        device.depthToColor = makeExtrinsic(0.01f * (d % 7), -25.0f - d % 5, 0.5f);
+        device.irToDepth    = makeExtrinsic(0.0f, -50.0f, 0.0f);
+        for(uint32_t i = 0; i < PROFILES_PER_DEVICE / 2; i++) {
+            auto sp = createProfile(OB_STREAM_DEPTH, i);
+            if(i > 0) {
+                sp->bindSameExtrinsicTo(device.depthProfiles.front());
+            }
+            device.depthProfiles.push_back(sp);
+        }
+        for(uint32_t i = 0; i < PROFILES_PER_DEVICE / 4; i++) {
+            auto sp = createProfile(OB_STREAM_COLOR, i);
+            if(i == 0) {
+                device.depthProfiles.front()->bindExtrinsicTo(sp, device.depthToColor);
+            }
+            else {
+                sp->bindSameExtrinsicTo(device.colorProfiles.front());
+            }
+            device.colorProfiles.push_back(sp);
+        }
+        for(uint32_t i = 0; i < PROFILES_PER_DEVICE / 4; i++) {
+            auto sp = createProfile(OB_STREAM_IR_RIGHT, i);
+            if(i == 0) {
+                sp->bindExtrinsicTo(device.depthProfiles.front(), device.irToDepth);
+            }
+            else {
+                sp->bindSameExtrinsicTo(device.irProfiles.front());
+            }
+            device.irProfiles.push_back(sp);
+        }
+    }
+    double registerUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+    // the lookups walk the devices so that they don't hit the same profiles
+    double sum = 0;
+    begin      = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < lookupCount; i++) {
+        auto &device = devices[i % deviceCount];
+        auto &sp     = device.depthProfiles[(i / deviceCount) % device.depthProfiles.size()];
+        sum += sp->getIntrinsic().fx + sp->getDistortion().k1;
+    }
+    double intrinsicNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / lookupCount;
+
+    begin = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < lookupCount; i++) {
+        auto &device = devices[i % deviceCount];
+        auto &from   = device.irProfiles[(i / deviceCount) % device.irProfiles.size()];
+        auto &to     = device.colorProfiles[(i / deviceCount) % device.colorProfiles.size()];
+        sum += from->getExtrinsicTo(to).trans[0];
+    }
+    double extrinsicNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / lookupCount;
+
+    // the intrinsics and the direct, inverse and composed extrinsics
+    for(uint32_t d = 0; d < deviceCount; d++) {
+        auto &device = devices[d];
+        auto  depth  = device.depthProfiles.back();
+        auto  color  = device.colorProfiles.back();
+        auto  ir     = device.irProfiles.back();
+        ok           = check(depth->getIntrinsic().fx == 500.0f + PROFILES_PER_DEVICE / 2 - 1, "intrinsic mismatch") && ok;
+        ok           = check(near(depth->getExtrinsicTo(color), device.depthToColor), "depth to color extrinsic mismatch") && ok;
+        ok           = check(near(multiply(color->getExtrinsicTo(depth), device.depthToColor), IdentityExtrinsics), "color to depth extrinsic mismatch") && ok;
+        ok = check(near(ir->getExtrinsicTo(color), multiply(device.depthToColor, device.irToDepth)), "ir to color extrinsic mismatch") && ok;
+        ok = check(near(depth->getExtrinsicTo(device.depthProfiles.front()), IdentityExtrinsics), "depth to depth extrinsic mismatch") && ok;
+        if(!ok) {
+            break;
+        }
+    }
+
+    // re-registering the extrinsics invalidates the cached ones
+    auto &device      = devices.front();
+    auto  newExtrinsic = makeExtrinsic(0.2f, 10.0f, 20.0f);
+    device.depthProfiles.front()->bindExtrinsicTo(device.colorProfiles.front(), newExtrinsic);
+    ok = check(near(device.depthProfiles.front()->getExtrinsicTo(device.colorProfiles.front()), newExtrinsic), "re-registered extrinsic not updated") && ok;
+    auto newIntrinsic = device.depthProfiles.front()->getIntrinsic();
+    newIntrinsic.fx   = 321.0f;
+    device.depthProfiles.front()->bindIntrinsic(newIntrinsic);
+    ok = check(device.depthProfiles.front()->getIntrinsic().fx == 321.0f, "re-registered intrinsic not updated") && ok;
+
+    // the intrinsics re-bound while they are read: each read sees a whole parameter set, the replaced sets are released along the way
+    std::atomic<bool>     rebinding(true);
+    std::atomic<uint32_t> tornReads(0);
+    auto                  profile = device.irProfiles.front();
+    std::thread           reader([&]() {
+        while(rebinding) {
+            auto intrinsic = profile->getIntrinsic();
+            if(intrinsic.fy != intrinsic.fx * 2) {
+                tornReads++;
+            }
+        }
+    });
+    for(int i = 0; i < 100000; i++) {
+        profile->bindIntrinsic({ static_cast<float>(i), static_cast<float>(i) * 2, 320.0f, 240.0f, 640, 480 });
+    }
+    rebinding = false;
+    reader.join();
+    ok = check(tornReads == 0, "torn intrinsics read while re-binding") && ok;
+
+    // the extrinsics of the profiles of different devices are not connected
+    ok = check(deviceCount < 2 || !StreamExtrinsicsManager::getInstance()->hasExtrinsics(devices[0].depthProfiles[0], devices[1].colorProfiles[0]),
+               "profiles of different devices connected") && ok;
+
+    std::cout << deviceCount * PROFILES_PER_DEVICE << " profiles of " << deviceCount << " devices registered in " << registerUs / 1000 << "ms" << std::endl;
+    std::cout << "intrinsic + distortion lookup " << intrinsicNs << "ns, ir to color extrinsic lookup " << extrinsicNs << "ns (checksum " << sum << ")"
+              << std::endl;
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
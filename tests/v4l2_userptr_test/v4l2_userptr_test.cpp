@@ -0,0 +1,179 @@
+// Copyright (c) Orbbec Inc. All Rights Reserved.
+// Licensed under the MIT License.
+
+// Test the buffer lifecycle of V4L2 USERPTR capture mode on a mock V4L2 driver, no camera is required.
+
+#include "V4lUserPtrBufferQueue.hpp"
+#include "stream/StreamProfileFactory.hpp"
+
+#include <errno.h>
+#include <unistd.h>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace libobsensor;
+
+#define CHECK(cond)                                                                                \
+    do {                                                                                           \
+        if(!(cond)) {                                                                              \
+            std::cerr << "Check failed: " #cond << " at " << __FILE__ << ":" << __LINE__ << std::endl; \
+            exit(-1);                                                                              \
+        }                                                                                          \
+    } while(0)
+
+// Mock V4L2 driver: keeps the queued buffers in order, "fills" the buffer with a pattern on VIDIOC_DQBUF and records all ioctl calls
+class MockV4l2Driver {
+public:
+    int ioctl(int fd, unsigned long request, void *arg) {
+        (void)fd;
+        switch(request) {
+        case VIDIOC_REQBUFS: {
+            auto req = static_cast<v4l2_requestbuffers *>(arg);
+            if(req->memory != V4L2_MEMORY_USERPTR) {
+                errno = EINVAL;
+                return -1;
+            }
+            record("REQBUFS", req->count);
+            userPtrs.assign(req->count, 0);
+            queued.clear();
+            return 0;
+        }
+        case VIDIOC_QBUF: {
+            auto buf = static_cast<v4l2_buffer *>(arg);
+            if(buf->memory != V4L2_MEMORY_USERPTR || buf->index >= userPtrs.size() || buf->m.userptr == 0) {
+                errno = EINVAL;
+                return -1;
+            }
+            for(auto index: queued) {
+                if(index == buf->index) {
+                    errno = EINVAL;  // already queued
+                    return -1;
+                }
+            }
+            record("QBUF", buf->index);
+            userPtrs[buf->index] = buf->m.userptr;
+            queued.push_back(buf->index);
+            return 0;
+        }
+        case VIDIOC_DQBUF: {
+            auto buf = static_cast<v4l2_buffer *>(arg);
+            if(queued.empty()) {
+                errno = EAGAIN;
+                return -1;
+            }
+            auto index = queued.front();
+            queued.pop_front();
+            record("DQBUF", index);
+            auto data = reinterpret_cast<uint8_t *>(userPtrs[index]);
+            for(uint32_t i = 0; i < frameBytes; i++) {
+                data[i] = static_cast<uint8_t>(sequence + i);
+            }
+            buf->index     = index;
+            buf->bytesused = frameBytes;
+            buf->sequence  = sequence++;
+            return 0;
+        }
+        default:
+            errno = ENOTTY;
+            return -1;
+        }
+    }
+
+    std::string popLog() {
+        std::string ret = log.str();
+        log.str("");
+        return ret;
+    }
+
+private:
+    void record(const char *name, uint32_t value) {
+        log << name << ":" << value << " ";
+    }
+
+public:
+    uint32_t                   frameBytes = 0;
+    uint32_t                   sequence   = 0;
+    std::vector<unsigned long> userPtrs;
+    std::deque<uint32_t>       queued;
+    std::ostringstream         log;
+};
+
+int main() {
+    const uint32_t width = 64, height = 48, bufferCount = 4;
+    auto           profile = StreamProfileFactory::createVideoStreamProfile(OB_STREAM_DEPTH, OB_FORMAT_Y16, width, height, 30);
+
+    MockV4l2Driver driver;
+    driver.frameBytes = width * height * 2;
+    auto ioctlFunc    = [&driver](int fd, unsigned long request, void *arg) { return driver.ioctl(fd, request, arg); };
+    auto queue        = std::make_shared<V4lUserPtrBufferQueue>(3, bufferCount, driver.frameBytes, ioctlFunc);
+
+    // 1. request buffers and queue all of them to driver in index order, the user pointers should be page aligned
+    CHECK(queue->requestBuffers());
+    CHECK(driver.popLog() == "REQBUFS:4 ");
+    queue->start();
+    CHECK(driver.popLog() == "QBUF:0 QBUF:1 QBUF:2 QBUF:3 ");
+    for(auto ptr: driver.userPtrs) {
+        CHECK(ptr % static_cast<unsigned long>(sysconf(_SC_PAGESIZE)) == 0);
+    }
+
+    // 2. the frame wraps the kernel-filled memory, and the buffer is not re-queued while the frame is alive
+    v4l2_buffer buf = {};
+    CHECK(queue->dequeue(buf));
+    auto frame = queue->wrapFrame(buf, profile);
+    CHECK(reinterpret_cast<unsigned long>(frame->getData()) == driver.userPtrs[0]);
+    CHECK(frame->getDataSize() == driver.frameBytes);
+    CHECK(frame->getData()[1] == 1);
+    CHECK(frame->getType() == OB_FRAME_DEPTH);
+    CHECK(driver.queued.size() == bufferCount - 1);
+    driver.popLog();
+    frame.reset();
+    CHECK(driver.popLog() == "QBUF:0 ");
+
+    // 3. driver starves while all frames are held by user, buffers are re-queued in frame release order
+    std::vector<std::shared_ptr<Frame>> heldFrames;
+    while(queue->dequeue(buf)) {
+        heldFrames.push_back(queue->wrapFrame(buf, profile));
+    }
+    CHECK(heldFrames.size() == bufferCount);
+    CHECK(driver.popLog() == "DQBUF:1 DQBUF:2 DQBUF:3 DQBUF:0 ");
+    heldFrames[2].reset();
+    heldFrames[0].reset();
+    CHECK(driver.popLog() == "QBUF:3 QBUF:1 ");
+
+    // 4. empty buffers are re-queued directly without frame
+    CHECK(queue->dequeue(buf));
+    queue->requeue(buf.index);
+    CHECK(driver.popLog() == "DQBUF:3 QBUF:3 ");
+
+    // 5. the copied frames own their data and give the buffer back to driver at once
+    CHECK(queue->getQueuedBufferCount() == 2);
+    CHECK(queue->dequeue(buf));
+    CHECK(queue->getQueuedBufferCount() == 1);
+    auto copied = queue->copyFrame(buf, profile);
+    CHECK(driver.popLog() == "DQBUF:1 QBUF:1 ");
+    CHECK(queue->getQueuedBufferCount() == 2);
+    CHECK(reinterpret_cast<unsigned long>(copied->getData()) != driver.userPtrs[1]);
+    CHECK(copied->getDataSize() == driver.frameBytes);
+    CHECK(copied->getData()[1] == static_cast<uint8_t>(buf.sequence + 1));
+    CHECK(copied->getType() == OB_FRAME_DEPTH);
+    copied.reset();
+    CHECK(driver.popLog().empty());
+
+    // 6. frames released after stop do not queue buffers back, memory keeps alive until the last frame is released
+    queue->stop();
+    queue->releaseBuffers();
+    CHECK(driver.popLog() == "REQBUFS:0 ");
+    std::weak_ptr<V4lUserPtrBufferQueue> weakQueue = queue;
+    queue.reset();
+    CHECK(!weakQueue.expired());
+    CHECK(heldFrames[1]->getData()[0] == static_cast<uint8_t>(2));
+    heldFrames.clear();
+    CHECK(driver.popLog().empty());
+    CHECK(weakQueue.expired());
+
+    std::cout << "v4l2_userptr_test passed!" << std::endl;
+    return 0;
+}